@@ -26,6 +26,8 @@ public class ModuleBuilderEditor : ModuleRules
 			new string[]
 			{
 				"Core",
+				// 公开头文件使用启动记录的数据结构
+				"ModuleBuilderStartup",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -43,13 +45,21 @@ public class ModuleBuilderEditor : ModuleRules
 				"LevelEditor",
 				"InputCore",
 				"Projects",
-				"Json"
+				"Json",
+				"ApplicationCore"
 				
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
 		
+		// 新模块热加载前检查 Live Coding 会话（WITH_LIVE_CODING 由 Target.bWithLiveCoding 决定）
+		if (Target.bWithLiveCoding)
+		{
+			PrivateIncludePathModuleNames.Add("LiveCoding");
+		}
+		
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
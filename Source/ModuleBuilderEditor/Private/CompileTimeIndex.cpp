@@ -0,0 +1,776 @@
+#include "CompileTimeIndex.h"
+#include "ModuleBuilderCache.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleDependencyGraph.h"
+#include "SourceRewrite.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include <atomic>
+
+namespace CompileTimeIndexPrivate
+{
+
+using namespace ModuleBuilder;
+
+// 缓存文件格式，结构变化时递增
+static constexpr uint32 GCompileTimeCacheMagic = 0x4D424354; // 'MBCT'
+static constexpr int32 GCompileTimeCacheVersion = 2;
+
+// 工程外的头文件只保留解析耗时不少于 1 ms 的，工程内的全部保留
+static constexpr int64 GMinExternalIncludeMicros = 1000;
+
+// 每个模块列出的头文件数
+static constexpr int32 GModuleTopHeaders = 3;
+
+// 建议的阈值
+static constexpr double GFrontendHeavyShare = 0.7;
+static constexpr double GHeaderHeavyShare = 0.15;
+static constexpr double GBackendHeavyShare = 0.5;
+static constexpr double GModuleHeavyShare = 0.25;
+static constexpr int32 GSplitMinUnits = 4;
+
+// 缓存中的一个 .json；非追踪文件也记录，下次不再读取
+struct FCachedCompileUnit
+{
+	FString Path;
+	int64 TimestampTicks = 0;
+	int64 FileSize = 0;
+	bool bTrace = false;
+	int64 FrontendMicros = 0;
+	int64 BackendMicros = 0;
+	int64 TotalMicros = 0;
+	TArray<int32> IncludePaths;
+	TArray<int64> IncludeMicros;
+	bool bHasDependencies = false;
+	TArray<int32> Dependencies;
+
+	friend FArchive& operator<<(FArchive& Ar, FCachedCompileUnit& Entry)
+	{
+		Ar << Entry.Path;
+		Ar << Entry.TimestampTicks;
+		Ar << Entry.FileSize;
+		Ar << Entry.bTrace;
+		Ar << Entry.FrontendMicros;
+		Ar << Entry.BackendMicros;
+		Ar << Entry.TotalMicros;
+		Ar << Entry.IncludePaths;
+		Ar << Entry.IncludeMicros;
+		Ar << Entry.bHasDependencies;
+		Ar << Entry.Dependencies;
+		return Ar;
+	}
+};
+
+// 扫描到的一个 .json
+struct FTraceFile
+{
+	FCompileTimeUnit Unit;
+	bool bTrace = false;
+};
+
+static FString FormatMicros(int64 Micros)
+{
+	return Micros >= 1000000
+		? FString::Printf(TEXT("%.2f s"), Micros / 1000000.0)
+		: FString::Printf(TEXT("%.0f ms"), Micros / 1000.0);
+}
+
+static double Share(int64 Part, int64 Whole)
+{
+	return Whole > 0 ? static_cast<double>(Part) / Whole : 0.0;
+}
+
+static FString NormalizeTracePath(const FString& Path)
+{
+	FString Result = Path;
+	FPaths::NormalizeFilename(Result);
+	FPaths::CollapseRelativeDirectories(Result);
+	return Result;
+}
+
+// 头文件所属的图内模块：模块目录最长的前缀
+static int32 FindOwnerModule(const TArray<FModuleNode>& Nodes, const FString& Path, TMap<FString, int32>& Memo)
+{
+	if (const int32* Found = Memo.Find(Path))
+	{
+		return *Found;
+	}
+
+	int32 Owner = INDEX_NONE;
+	int32 OwnerLen = 0;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FString& Dir = Nodes[Index].ModuleDir;
+		if (Dir.Len() > OwnerLen && Path.Len() > Dir.Len() && Path[Dir.Len()] == TEXT('/') && Path.StartsWith(Dir))
+		{
+			Owner = Index;
+			OwnerLen = Dir.Len();
+		}
+	}
+
+	Memo.Add(Path, Owner);
+	return Owner;
+}
+
+// 编译单元所在的中间目录即模块名：Intermediate/Build/<平台>/.../<配置>/<模块>/<源文件>.json
+static int32 FindUnitModule(const FModuleDependencyGraph& Graph, const FString& BuildDir, const FString& TracePath)
+{
+	for (FString Dir = FPaths::GetPath(TracePath); Dir.Len() > BuildDir.Len(); Dir = FPaths::GetPath(Dir))
+	{
+		const int32 Node = Graph.FindNode(FPaths::GetCleanFilename(Dir));
+		if (Node != INDEX_NONE)
+		{
+			return Node;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// clang 的 .d：make 规则 "目标: 依赖 \\ 依赖 ..."，路径中的空格写作 "\ "
+static bool ParseMakeDependencies(const FString& Text, TArray<FString>& OutPaths)
+{
+	// 目标后的冒号后面跟空白；Windows 盘符的冒号后面是斜杠
+	int32 Start = INDEX_NONE;
+	for (int32 Index = 0; Index + 1 < Text.Len(); ++Index)
+	{
+		if (Text[Index] == TEXT(':') && FChar::IsWhitespace(Text[Index + 1]))
+		{
+			Start = Index + 1;
+			break;
+		}
+	}
+	if (Start == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FString Current;
+	for (int32 Index = Start; Index <= Text.Len(); ++Index)
+	{
+		const TCHAR Char = Index < Text.Len() ? Text[Index] : TEXT('\n');
+		if (Char == TEXT('\\') && Index + 1 < Text.Len() && (Text[Index + 1] == TEXT(' ') || Text[Index + 1] == TEXT('#')))
+		{
+			Current.AppendChar(Text[++Index]);
+		}
+		else if (Char == TEXT('\\') && Index + 1 < Text.Len() && (Text[Index + 1] == TEXT('\n') || Text[Index + 1] == TEXT('\r')))
+		{
+			// 续行：跳过换行
+			Index += Text[Index + 1] == TEXT('\r') && Index + 2 < Text.Len() && Text[Index + 2] == TEXT('\n') ? 2 : 1;
+			continue;
+		}
+		else if (FChar::IsWhitespace(Char))
+		{
+			if (!Current.IsEmpty())
+			{
+				OutPaths.Add(MoveTemp(Current));
+				Current.Reset();
+			}
+			// 第一条规则之后的是 -MP 生成的空规则，不再读取
+			if (Char == TEXT('\n'))
+			{
+				break;
+			}
+		}
+		else
+		{
+			Current.AppendChar(Char);
+		}
+	}
+	return true;
+}
+
+// MSVC 的 .dep.json：{"Data": {"Includes": [...]}}
+static bool ParseJsonDependencies(const FString& Text, TArray<FString>& OutPaths)
+{
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+	const TSharedPtr<FJsonObject>* Data = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* Includes = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid()
+		|| !Root->TryGetObjectField(TEXT("Data"), Data) || !(*Data)->TryGetArrayField(TEXT("Includes"), Includes))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Includes)
+	{
+		FString Path;
+		if (Value.IsValid() && Value->TryGetString(Path))
+		{
+			OutPaths.Add(MoveTemp(Path));
+		}
+	}
+	return true;
+}
+
+// 读取 UBT 写在追踪旁的依赖列表：<源文件>.d 或 <源文件>.dep.json，只保留工程内的文件。
+// 追踪只记录超过时间粒度的头文件，依赖列表才是完整的包含集合
+static void LoadUnitDependencies(const FString& ProjectDir, FCompileTimeUnit& Unit)
+{
+	const FString Base = Unit.TracePath.LeftChop(5);
+
+	FString Text;
+	TArray<FString> Paths;
+	if (FFileHelper::LoadFileToString(Text, *(Base + TEXT(".d")), FFileHelper::EHashOptions::None, FILEREAD_Silent))
+	{
+		Unit.bHasDependencies = ParseMakeDependencies(Text, Paths);
+	}
+	else if (FFileHelper::LoadFileToString(Text, *(Base + TEXT(".dep.json")), FFileHelper::EHashOptions::None, FILEREAD_Silent))
+	{
+		Unit.bHasDependencies = ParseJsonDependencies(Text, Paths);
+	}
+
+	TSet<FString> Seen;
+	for (const FString& Path : Paths)
+	{
+		FString Normalized = NormalizeTracePath(FPaths::ConvertRelativePathToFull(Path));
+		bool bAlreadyInSet = false;
+		Seen.Add(Normalized, &bAlreadyInSet);
+		if (!bAlreadyInSet && Normalized.StartsWith(ProjectDir))
+		{
+			Unit.Dependencies.Add(MoveTemp(Normalized));
+		}
+	}
+}
+
+static void LoadCompileTimeCache(const FString& CachePath, TMap<FString, FTraceFile>& OutCache)
+{
+	TArray<FString> Strings;
+	TArray<FCachedCompileUnit> Entries;
+	if (!LoadIndexCache(CachePath, GCompileTimeCacheMagic, GCompileTimeCacheVersion, Strings, Entries))
+	{
+		return;
+	}
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	OutCache.Reserve(Entries.Num());
+	for (FCachedCompileUnit& Entry : Entries)
+	{
+		FTraceFile File;
+		File.bTrace = Entry.bTrace;
+		File.Unit.TracePath = FromCachePath(ProjectDir, Entry.Path);
+		File.Unit.TimestampTicks = Entry.TimestampTicks;
+		File.Unit.FileSize = Entry.FileSize;
+		File.Unit.FrontendMicros = Entry.FrontendMicros;
+		File.Unit.BackendMicros = Entry.BackendMicros;
+		File.Unit.TotalMicros = Entry.TotalMicros;
+		for (int32 Index = 0; Index < Entry.IncludePaths.Num() && Index < Entry.IncludeMicros.Num(); ++Index)
+		{
+			if (Strings.IsValidIndex(Entry.IncludePaths[Index]))
+			{
+				File.Unit.Includes.Add({ FromCachePath(ProjectDir, Strings[Entry.IncludePaths[Index]]), Entry.IncludeMicros[Index] });
+			}
+		}
+		File.Unit.bHasDependencies = Entry.bHasDependencies;
+		for (int32 Id : Entry.Dependencies)
+		{
+			if (Strings.IsValidIndex(Id))
+			{
+				File.Unit.Dependencies.Add(FromCachePath(ProjectDir, Strings[Id]));
+			}
+		}
+		OutCache.Add(File.Unit.TracePath, MoveTemp(File));
+	}
+}
+
+static int64 SaveCompileTimeCache(const FString& CachePath, const TArray<FTraceFile>& Files)
+{
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	// 同一个头文件出现在成百上千个编译单元中，只存一次
+	FCacheStringTable Strings;
+	TArray<FCachedCompileUnit> Entries;
+	Entries.Reserve(Files.Num());
+
+	for (const FTraceFile& File : Files)
+	{
+		FCachedCompileUnit& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Path = ToCachePath(ProjectDir, File.Unit.TracePath);
+		Entry.TimestampTicks = File.Unit.TimestampTicks;
+		Entry.FileSize = File.Unit.FileSize;
+		Entry.bTrace = File.bTrace;
+		Entry.FrontendMicros = File.Unit.FrontendMicros;
+		Entry.BackendMicros = File.Unit.BackendMicros;
+		Entry.TotalMicros = File.Unit.TotalMicros;
+		for (const FCompileTimeInclude& Include : File.Unit.Includes)
+		{
+			Entry.IncludePaths.Add(Strings.Add(ToCachePath(ProjectDir, Include.Path)));
+			Entry.IncludeMicros.Add(Include.Micros);
+		}
+		Entry.bHasDependencies = File.Unit.bHasDependencies;
+		for (const FString& Dependency : File.Unit.Dependencies)
+		{
+			Entry.Dependencies.Add(Strings.Add(ToCachePath(ProjectDir, Dependency)));
+		}
+	}
+
+	return SaveIndexCache(CachePath, GCompileTimeCacheMagic, GCompileTimeCacheVersion, Strings, Entries, TEXT("编译耗时"));
+}
+
+static FString DisplayHeaderPath(const TArray<FModuleNode>& Nodes, const FHeaderCompileCost& Cost)
+{
+	if (Cost.Module != INDEX_NONE)
+	{
+		const FModuleNode& Node = Nodes[Cost.Module];
+		return Node.Name / Cost.Path.RightChop(Node.ModuleDir.Len() + 1);
+	}
+
+	const FString EngineDir = FPaths::ConvertRelativePathToFull(FPaths::EngineDir());
+	return Cost.Path.StartsWith(EngineDir) ? TEXT("Engine/") + Cost.Path.RightChop(EngineDir.Len()) : Cost.Path;
+}
+
+} // namespace CompileTimeIndexPrivate
+
+bool FCompileTimeIndex::ParseTimeTrace(const FString& Text, const FString& ProjectDir, FCompileTimeUnit& Unit)
+{
+	using namespace CompileTimeIndexPrivate;
+
+	// 先按字符串判断，其他 JSON 不做完整解析
+	if (!Text.Contains(TEXT("\"traceEvents\"")))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Events = nullptr;
+	if (!Root->TryGetArrayField(TEXT("traceEvents"), Events))
+	{
+		return false;
+	}
+
+	// Total * 为 clang 汇总的事件，dur 为整个编译单元中该类事件的总耗时（微秒）
+	int64 ExecuteCompiler = 0;
+	TMap<FString, int64> IncludeMicros;
+
+	for (const TSharedPtr<FJsonValue>& Value : *Events)
+	{
+		const TSharedPtr<FJsonObject>* Event = nullptr;
+		FString Phase;
+		FString Name;
+		double Duration = 0.0;
+		if (!Value.IsValid() || !Value->TryGetObject(Event)
+			|| !(*Event)->TryGetStringField(TEXT("ph"), Phase) || Phase != TEXT("X")
+			|| !(*Event)->TryGetStringField(TEXT("name"), Name)
+			|| !(*Event)->TryGetNumberField(TEXT("dur"), Duration))
+		{
+			continue;
+		}
+
+		const int64 Micros = static_cast<int64>(Duration);
+		if (Name == TEXT("Total Frontend"))
+		{
+			Unit.FrontendMicros = Micros;
+		}
+		else if (Name == TEXT("Total Backend"))
+		{
+			Unit.BackendMicros = Micros;
+		}
+		else if (Name == TEXT("Total ExecuteCompiler"))
+		{
+			Unit.TotalMicros = Micros;
+		}
+		else if (Name == TEXT("ExecuteCompiler"))
+		{
+			ExecuteCompiler = FMath::Max(ExecuteCompiler, Micros);
+		}
+		else if (Name == TEXT("Source"))
+		{
+			const TSharedPtr<FJsonObject>* Args = nullptr;
+			FString Detail;
+			if ((*Event)->TryGetObjectField(TEXT("args"), Args) && (*Args)->TryGetStringField(TEXT("detail"), Detail))
+			{
+				IncludeMicros.FindOrAdd(NormalizeTracePath(Detail)) += Micros;
+			}
+		}
+	}
+
+	if (Unit.TotalMicros == 0)
+	{
+		Unit.TotalMicros = ExecuteCompiler > 0 ? ExecuteCompiler : Unit.FrontendMicros + Unit.BackendMicros;
+	}
+
+	for (const TPair<FString, int64>& Pair : IncludeMicros)
+	{
+		if (Pair.Key.StartsWith(ProjectDir) || Pair.Value >= GMinExternalIncludeMicros)
+		{
+			Unit.Includes.Add({ Pair.Key, Pair.Value });
+		}
+	}
+	Unit.Includes.Sort([](const FCompileTimeInclude& A, const FCompileTimeInclude& B) { return A.Micros > B.Micros; });
+	return true;
+}
+
+bool FCompileTimeIndex::ParseDependencyList(const FString& Text, bool bMakeFormat, TArray<FString>& OutPaths)
+{
+	using namespace CompileTimeIndexPrivate;
+
+	return bMakeFormat ? ParseMakeDependencies(Text, OutPaths) : ParseJsonDependencies(Text, OutPaths);
+}
+
+FString FCompileTimeIndex::GetCachePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("CompileTimeCache.bin"));
+}
+
+void FCompileTimeIndex::Build(const FModuleDependencyGraph& Graph, const FString& CachePath, FCompileTimeStats& OutStats)
+{
+	using namespace CompileTimeIndexPrivate;
+
+	MODULEBUILDER_SCOPE("CompileTimes");
+
+	const double StartTime = FPlatformTime::Seconds();
+	OutStats = FCompileTimeStats();
+	Units.Reset();
+
+	TMap<FString, FTraceFile> Cache;
+	LoadCompileTimeCache(CachePath, Cache);
+
+	// 1）工程与各插件的 Intermediate/Build，只做目录遍历和 stat
+	TSet<FString> BuildDirs;
+	for (const FModuleNode& Node : Graph.GetNodes())
+	{
+		FString Root;
+		FString Descriptor;
+		if (ModuleBuilder::FindModuleContainer(Node.ModuleDir, Root, Descriptor))
+		{
+			BuildDirs.Add(FPaths::ConvertRelativePathToFull(Root / TEXT("Intermediate") / TEXT("Build")));
+		}
+	}
+
+	TArray<FTraceFile> Files;
+	{
+		MODULEBUILDER_SCOPE("CompileTimes.Enumerate");
+		for (const FString& BuildDir : BuildDirs)
+		{
+			IFileManager::Get().IterateDirectoryStatRecursively(*BuildDir, [&Graph, &BuildDir, &Files, &OutStats](const TCHAR* Path, const FFileStatData& StatData)
+			{
+				const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+
+				// MSVC 的 .dep.json 是依赖列表，不是耗时记录
+				if (StatData.bIsDirectory || !FullPath.EndsWith(TEXT(".json")) || FullPath.EndsWith(TEXT(".dep.json")))
+				{
+					return true;
+				}
+
+				const int32 Module = FindUnitModule(Graph, BuildDir, FullPath);
+				if (Module == INDEX_NONE)
+				{
+					++OutStats.Unowned;
+					return true;
+				}
+
+				FTraceFile& File = Files.AddDefaulted_GetRef();
+				File.Unit.TracePath = FullPath;
+				File.Unit.SourceName = FPaths::GetCleanFilename(FullPath).LeftChop(5);
+				File.Unit.Module = Module;
+				File.Unit.TimestampTicks = StatData.ModificationTime.GetTicks();
+				File.Unit.FileSize = StatData.FileSize;
+				return true;
+			});
+		}
+	}
+
+	// 2）时间戳和大小都没变的直接复用缓存，其余并行解析
+	std::atomic<int32> Parsed { 0 };
+	{
+		MODULEBUILDER_SCOPE("CompileTimes.Parse");
+
+		const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+		ParallelFor(Files.Num(), [&Files, &Cache, &Parsed, &ProjectDir](int32 Index)
+		{
+			FTraceFile& File = Files[Index];
+			const FTraceFile* Cached = Cache.Find(File.Unit.TracePath);
+
+			if (Cached && Cached->Unit.TimestampTicks == File.Unit.TimestampTicks && Cached->Unit.FileSize == File.Unit.FileSize)
+			{
+				File.bTrace = Cached->bTrace;
+				File.Unit.FrontendMicros = Cached->Unit.FrontendMicros;
+				File.Unit.BackendMicros = Cached->Unit.BackendMicros;
+				File.Unit.TotalMicros = Cached->Unit.TotalMicros;
+				File.Unit.Includes = Cached->Unit.Includes;
+				File.Unit.bHasDependencies = Cached->Unit.bHasDependencies;
+				File.Unit.Dependencies = Cached->Unit.Dependencies;
+				return;
+			}
+
+			FString Text;
+			File.bTrace = FFileHelper::LoadFileToString(Text, *File.Unit.TracePath) && ParseTimeTrace(Text, ProjectDir, File.Unit);
+			if (File.bTrace)
+			{
+				LoadUnitDependencies(ProjectDir, File.Unit);
+			}
+			++Parsed;
+		});
+	}
+
+	OutStats.Parsed = Parsed.load();
+
+	bool bCacheStale = OutStats.Parsed > 0 || Cache.Num() != Files.Num();
+	for (const FTraceFile& File : Files)
+	{
+		bCacheStale |= !Cache.Contains(File.Unit.TracePath);
+	}
+	if (!CachePath.IsEmpty() && bCacheStale)
+	{
+		OutStats.CacheBytes = SaveCompileTimeCache(CachePath, Files);
+	}
+	else
+	{
+		OutStats.CacheBytes = FMath::Max<int64>(0, IFileManager::Get().FileSize(*CachePath));
+	}
+
+	// 3）同一模块的同一源文件在多个 Target / 配置下都有记录时只取最新的
+	TMap<FString, int32> Latest;
+	for (FTraceFile& File : Files)
+	{
+		if (!File.bTrace)
+		{
+			++OutStats.Skipped;
+			continue;
+		}
+
+		const FString Key = FString::Printf(TEXT("%d/%s"), File.Unit.Module, *File.Unit.SourceName);
+		if (const int32* Existing = Latest.Find(Key))
+		{
+			++OutStats.Duplicates;
+			if (Units[*Existing].TimestampTicks >= File.Unit.TimestampTicks)
+			{
+				continue;
+			}
+			Units[*Existing] = MoveTemp(File.Unit);
+			continue;
+		}
+		Latest.Add(Key, Units.Add(MoveTemp(File.Unit)));
+	}
+
+	for (const FCompileTimeUnit& Unit : Units)
+	{
+		OutStats.Newest = FMath::Max(OutStats.Newest, FDateTime(Unit.TimestampTicks));
+		OutStats.NoDependencies += Unit.bHasDependencies ? 0 : 1;
+	}
+	OutStats.TraceFiles = Units.Num();
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+TArray<FModuleCompileCost> FCompileTimeIndex::ComputeModuleCosts(const FModuleDependencyGraph& Graph) const
+{
+	using namespace CompileTimeIndexPrivate;
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	TArray<FModuleCompileCost> Costs;
+	Costs.SetNum(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Costs[Index].Module = Index;
+	}
+
+	TArray<TSet<int32>> RebuildModules;
+	RebuildModules.SetNum(Nodes.Num());
+	TMap<FString, int32> Owners;
+
+	for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+	{
+		const FCompileTimeUnit& Unit = Units[UnitIndex];
+		FModuleCompileCost& Cost = Costs[Unit.Module];
+		++Cost.Units;
+		Cost.FrontendMicros += Unit.FrontendMicros;
+		Cost.BackendMicros += Unit.BackendMicros;
+		Cost.TotalMicros += Unit.TotalMicros;
+		if (Cost.SlowestUnit == INDEX_NONE || Units[Cost.SlowestUnit].TotalMicros < Unit.TotalMicros)
+		{
+			Cost.SlowestUnit = UnitIndex;
+		}
+
+		// 依赖列表中有哪些模块的头文件，这些模块的头文件一变本编译单元就要重编；
+		// 追踪中的 Source 事件有时间粒度，漏掉的头文件同样会触发重编，不能用来判断
+		TSet<int32> Included;
+		for (const FString& Dependency : Unit.Dependencies)
+		{
+			const int32 Owner = FindOwnerModule(Nodes, Dependency, Owners);
+			if (Owner != INDEX_NONE)
+			{
+				Included.Add(Owner);
+			}
+		}
+		for (int32 Owner : Included)
+		{
+			++Costs[Owner].RebuildUnits;
+			Costs[Owner].RebuildMicros += Unit.TotalMicros;
+			if (Owner != Unit.Module)
+			{
+				RebuildModules[Owner].Add(Unit.Module);
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Costs[Index].RebuildModules = RebuildModules[Index].Num();
+	}
+	return Costs;
+}
+
+TArray<FHeaderCompileCost> FCompileTimeIndex::ComputeHeaderCosts(const FModuleDependencyGraph& Graph, int32 OnlyModule) const
+{
+	using namespace CompileTimeIndexPrivate;
+
+	TMap<FString, FHeaderCompileCost> ByPath;
+	for (const FCompileTimeUnit& Unit : Units)
+	{
+		if (OnlyModule != INDEX_NONE && Unit.Module != OnlyModule)
+		{
+			continue;
+		}
+		for (const FCompileTimeInclude& Include : Unit.Includes)
+		{
+			FHeaderCompileCost& Cost = ByPath.FindOrAdd(Include.Path);
+			++Cost.Units;
+			Cost.TotalMicros += Include.Micros;
+		}
+	}
+
+	TMap<FString, int32> Owners;
+	TArray<FHeaderCompileCost> Costs;
+	Costs.Reserve(ByPath.Num());
+	for (TPair<FString, FHeaderCompileCost>& Pair : ByPath)
+	{
+		Pair.Value.Path = Pair.Key;
+		Pair.Value.Module = FindOwnerModule(Graph.GetNodes(), Pair.Key, Owners);
+		Costs.Add(MoveTemp(Pair.Value));
+	}
+	Costs.Sort([](const FHeaderCompileCost& A, const FHeaderCompileCost& B) { return A.TotalMicros > B.TotalMicros; });
+	return Costs;
+}
+
+FString FCompileTimeIndex::BuildReport(const FModuleDependencyGraph& Graph, const FCompileTimeStats& Stats, const FString& OnlyModule, int32 MaxHeaders) const
+{
+	using namespace CompileTimeIndexPrivate;
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	const int32 OnlyNode = OnlyModule.IsEmpty() ? INDEX_NONE : Graph.FindNode(OnlyModule);
+	if (!OnlyModule.IsEmpty() && OnlyNode == INDEX_NONE)
+	{
+		return TEXT("没有找到模块：") + OnlyModule + TEXT("\n");
+	}
+
+	FString Report = TEXT("== 编译耗时（clang -ftime-trace）==\n");
+	if (Units.Num() == 0)
+	{
+		Report += TEXT("  没有找到 -ftime-trace 记录。用 clang 编译时在 Target.cs 中加入 AdditionalCompilerArguments = \"-ftime-trace\"，\n");
+		Report += TEXT("  重新编译后每个编译单元会在 Intermediate/Build 下的 .o 旁边生成同名 .json\n");
+		Report += FString::Printf(TEXT("  非追踪的 .json %d 个，无法归到模块的 %d 个\n"), Stats.Skipped, Stats.Unowned);
+		return Report;
+	}
+
+	const TArray<FModuleCompileCost> ModuleCosts = ComputeModuleCosts(Graph);
+
+	int64 Frontend = 0;
+	int64 Backend = 0;
+	int64 Total = 0;
+	int32 Modules = 0;
+	for (const FModuleCompileCost& Cost : ModuleCosts)
+	{
+		Frontend += Cost.FrontendMicros;
+		Backend += Cost.BackendMicros;
+		Total += Cost.TotalMicros;
+		Modules += Cost.Units > 0 ? 1 : 0;
+	}
+
+	Report += FString::Printf(TEXT("  %d 个编译单元，%d 个模块，最新记录 %s；合计 %s（前端 %s，后端 %s）\n"),
+		Stats.TraceFiles, Modules, *Stats.Newest.ToString(TEXT("%Y-%m-%d %H:%M")), *FormatMicros(Total), *FormatMicros(Frontend), *FormatMicros(Backend));
+	Report += FString::Printf(TEXT("  重新解析 %d 个，非追踪文件 %d 个，其他 Target / 配置的旧记录 %d 个，无法归到模块的 %d 个；缓存 %s，用时 %.2f 秒\n"),
+		Stats.Parsed, Stats.Skipped, Stats.Duplicates, Stats.Unowned, *FormatBytes(Stats.CacheBytes), Stats.Seconds);
+	Report += TEXT("  头文件耗时含其嵌套包含；名为 Module.*.cpp 的编译单元是 unity 合并后的文件\n");
+	if (Stats.NoDependencies > 0)
+	{
+		Report += FString::Printf(TEXT("  %d 个编译单元旁没有 UBT 的 .d / .dep.json 依赖列表，不计入头文件改动后的重编耗时\n"), Stats.NoDependencies);
+	}
+
+	// 模块：按总编译耗时
+	TArray<FModuleCompileCost> ByTotal = ModuleCosts;
+	ByTotal.RemoveAll([OnlyNode](const FModuleCompileCost& Cost) { return Cost.Units == 0 || (OnlyNode != INDEX_NONE && Cost.Module != OnlyNode); });
+	ByTotal.Sort([](const FModuleCompileCost& A, const FModuleCompileCost& B) { return A.TotalMicros > B.TotalMicros; });
+
+	Report += TEXT("\n== 模块（按总编译耗时）==\n");
+	for (const FModuleCompileCost& Cost : ByTotal)
+	{
+		const FModuleNode& Node = Nodes[Cost.Module];
+		const FCompileTimeUnit& Slowest = Units[Cost.SlowestUnit];
+		Report += FString::Printf(TEXT("  %s：%s（占 %.0f%%），前端 %s（%.0f%%），后端 %s；%d 个编译单元，平均 %s，最慢 %s %s\n"),
+			*Node.Name, *FormatMicros(Cost.TotalMicros), Share(Cost.TotalMicros, Total) * 100.0,
+			*FormatMicros(Cost.FrontendMicros), Share(Cost.FrontendMicros, Cost.TotalMicros) * 100.0, *FormatMicros(Cost.BackendMicros),
+			Cost.Units, *FormatMicros(Cost.AverageUnitMicros()), *Slowest.SourceName, *FormatMicros(Slowest.TotalMicros));
+
+		const TArray<FHeaderCompileCost> Headers = ComputeHeaderCosts(Graph, Cost.Module);
+		TArray<FString> Top;
+		for (int32 Index = 0; Index < Headers.Num() && Index < GModuleTopHeaders; ++Index)
+		{
+			Top.Add(FString::Printf(TEXT("%s %s ×%d"), *DisplayHeaderPath(Nodes, Headers[Index]), *FormatMicros(Headers[Index].TotalMicros), Headers[Index].Units));
+		}
+		if (Top.Num() > 0)
+		{
+			Report += TEXT("    耗时最多的头文件：") + FString::Join(Top, TEXT("，")) + TEXT("\n");
+		}
+
+		// 前端为主且集中在少数头文件：PCH 或减少包含
+		if (Share(Cost.FrontendMicros, Cost.TotalMicros) >= GFrontendHeavyShare && Headers.Num() > 0
+			&& Share(Headers[0].TotalMicros, Cost.FrontendMicros) >= GHeaderHeavyShare)
+		{
+			Report += FString::Printf(TEXT("    建议：%s 占前端耗时 %.0f%%，放入 PCH（见 预编译头建议）或在头文件中改用前置声明\n"),
+				*DisplayHeaderPath(Nodes, Headers[0]), Share(Headers[0].TotalMicros, Cost.FrontendMicros) * 100.0);
+		}
+		if (Share(Cost.BackendMicros, Cost.TotalMicros) >= GBackendHeavyShare)
+		{
+			Report += FString::Printf(TEXT("    建议：后端（优化与代码生成）占 %.0f%%，检查 %s 中的大型模板实例化与强制内联，或把它拆成多个 .cpp\n"),
+				Share(Cost.BackendMicros, Cost.TotalMicros) * 100.0, *Slowest.SourceName);
+		}
+		if (Share(Cost.TotalMicros, Total) >= GModuleHeavyShare && Cost.Units >= GSplitMinUnits)
+		{
+			Report += TEXT("    建议：单个模块占全部编译耗时的比例过高，考虑按包含关系拆分（见 模块拆分）\n");
+		}
+	}
+
+	// 模块：头文件改动后的重编耗时
+	TArray<FModuleCompileCost> ByRebuild = ModuleCosts;
+	ByRebuild.RemoveAll([OnlyNode](const FModuleCompileCost& Cost) { return Cost.RebuildUnits == 0 || (OnlyNode != INDEX_NONE && Cost.Module != OnlyNode); });
+	ByRebuild.Sort([](const FModuleCompileCost& A, const FModuleCompileCost& B) { return A.RebuildMicros > B.RebuildMicros; });
+
+	Report += TEXT("\n== 模块（按头文件改动后的重编耗时）==\n");
+	for (const FModuleCompileCost& Cost : ByRebuild)
+	{
+		Report += FString::Printf(TEXT("  %s：改动头文件重编 %s，%d 个编译单元，涉及其他模块 %d 个；只改一个 .cpp 平均 %s\n"),
+			*Nodes[Cost.Module].Name, *FormatMicros(Cost.RebuildMicros), Cost.RebuildUnits, Cost.RebuildModules, *FormatMicros(Cost.AverageUnitMicros()));
+		if (Cost.RebuildModules > 0 && Cost.RebuildMicros >= 2 * FMath::Max<int64>(Cost.TotalMicros, 1))
+		{
+			Report += TEXT("    建议：公开头文件被其他模块广泛包含，把实现细节移到 Private 或精简公开头文件\n");
+		}
+	}
+
+	Report += TEXT("\n== 耗时最多的头文件（所有编译单元累计）==\n");
+	int32 Listed = 0;
+	for (const FHeaderCompileCost& Cost : ComputeHeaderCosts(Graph, OnlyNode))
+	{
+		if (Listed++ == MaxHeaders)
+		{
+			break;
+		}
+		Report += FString::Printf(TEXT("  %s：%s，%d 个编译单元，平均 %s\n"),
+			*DisplayHeaderPath(Nodes, Cost), *FormatMicros(Cost.TotalMicros), Cost.Units, *FormatMicros(Cost.TotalMicros / FMath::Max(Cost.Units, 1)));
+	}
+	return Report;
+}
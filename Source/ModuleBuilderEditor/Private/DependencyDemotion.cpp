@@ -0,0 +1,636 @@
+#include "DependencyDemotion.h"
+#include "IncludeResolver.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "TextDiff.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+namespace DependencyDemotionPrivate
+{
+
+static bool IsPublicFolderPath(const FString& ModuleDir, const FString& Path)
+{
+	for (const TCHAR* Folder : GetPublicTopFolders())
+	{
+		if (Path.StartsWith(ModuleDir / Folder + TEXT("/")))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool HasPublicFolder(const FString& ModuleDir)
+{
+	for (const TCHAR* Folder : GetPublicTopFolders())
+	{
+		if (IFileManager::Get().DirectoryExists(*(ModuleDir / Folder)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool IsOwnedBy(const FString& Include, const FString& DependencyDir)
+{
+	for (const TCHAR* Folder : GetPublicTopFolders())
+	{
+		if (FPaths::FileExists(DependencyDir / Folder / Include))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool AnyOwnedBy(const TSet<FString>& Includes, const FString& DependencyDir)
+{
+	for (const FString& Include : Includes)
+	{
+		if (IsOwnedBy(Include, DependencyDir))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static void CollectIncludes(const TArray<FString>& Files, TSet<FString>& OutIncludes)
+{
+	TArray<FString> Includes;
+	for (const FString& File : Files)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *File))
+		{
+			continue;
+		}
+
+		Includes.Reset();
+		FModuleDependencyGraph::ParseIncludes(Text, Includes);
+		for (const FString& Include : Includes)
+		{
+			if (!Include.EndsWith(TEXT(".generated.h")))
+			{
+				OutIncludes.Add(Include);
+			}
+		}
+	}
+}
+
+// 沿 Public 依赖判断 Consumer 是否能看到 Target；SkipModule 的 SkipDependency 公开边视为已降级
+static bool CanSee(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, int32 Consumer,
+	const FString& Target, const FString& SkipModule, const FString& SkipDependency)
+{
+	const FModuleNode& ConsumerNode = Graph.GetNodes()[Consumer];
+
+	TArray<FString> Queue;
+	TSet<FString> Visited;
+	for (const FString& Dep : ConsumerNode.PublicDependencies)
+	{
+		Queue.Add(Dep);
+	}
+	for (const FString& Dep : ConsumerNode.PrivateDependencies)
+	{
+		Queue.Add(Dep);
+	}
+
+	while (Queue.Num() > 0)
+	{
+		const FString Name = Queue.Pop(EAllowShrinking::No);
+		if (Name == Target)
+		{
+			return true;
+		}
+
+		bool bAlreadyInSet = false;
+		Visited.Add(Name, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			continue;
+		}
+
+		const int32 NodeIndex = Graph.FindNode(Name);
+		const TArray<FString>& PublicDependencies = NodeIndex != INDEX_NONE
+			? Graph.GetNodes()[NodeIndex].PublicDependencies
+			: External.GetPublicDependencies(Name);
+
+		for (const FString& Dep : PublicDependencies)
+		{
+			if (Name == SkipModule && Dep == SkipDependency)
+			{
+				continue;
+			}
+			Queue.Add(Dep);
+		}
+	}
+
+	return false;
+}
+
+static int32 LineStart(const FString& Text, int32 Pos)
+{
+	while (Pos > 0 && Text[Pos - 1] != TEXT('\n'))
+	{
+		--Pos;
+	}
+	return Pos;
+}
+
+// Pos 之前同一行只有空白时返回该缩进，否则返回空
+static FString LineIndentBefore(const FString& Text, int32 Pos)
+{
+	const int32 Begin = LineStart(Text, Pos);
+	for (int32 Index = Begin; Index < Pos; ++Index)
+	{
+		if (Text[Index] != TEXT(' ') && Text[Index] != TEXT('\t'))
+		{
+			return FString();
+		}
+	}
+	return Text.Mid(Begin, Pos - Begin);
+}
+
+static void Splice(FString& Text, int32 Begin, int32 End, const FString& Insert)
+{
+	Text = Text.Left(Begin) + Insert + Text.Mid(End);
+}
+
+// 从列表中删掉一个字符串及其分隔逗号；独占一行时整行删除
+static void RemoveLiteral(FString& Text, const FBuildCsDependencyList& List, int32 LiteralIndex)
+{
+	const FBuildCsLiteral& Literal = List.Literals[LiteralIndex];
+	int32 Begin = Literal.Begin;
+	int32 End = Literal.End;
+
+	int32 Pos = End;
+	while (Pos < Text.Len() && (Text[Pos] == TEXT(' ') || Text[Pos] == TEXT('\t'))) ++Pos;
+
+	if (Pos < Text.Len() && Text[Pos] == TEXT(','))
+	{
+		End = Pos + 1;
+
+		int32 LineEnd = End;
+		while (LineEnd < Text.Len() && (Text[LineEnd] == TEXT(' ') || Text[LineEnd] == TEXT('\t') || Text[LineEnd] == TEXT('\r'))) ++LineEnd;
+
+		const bool bOwnLine = LineEnd < Text.Len() && Text[LineEnd] == TEXT('\n')
+			&& (Begin == LineStart(Text, Begin) || !LineIndentBefore(Text, Begin).IsEmpty());
+		if (bOwnLine)
+		{
+			Begin = LineStart(Text, Begin);
+			End = LineEnd + 1;
+		}
+	}
+	else if (LiteralIndex > 0)
+	{
+		// 最后一项：连同前一个逗号一起删
+		int32 Comma = Begin;
+		while (Comma > List.Literals[LiteralIndex - 1].End && Text[Comma - 1] != TEXT(','))
+		{
+			--Comma;
+		}
+		if (Comma > List.Literals[LiteralIndex - 1].End)
+		{
+			Begin = Comma - 1;
+		}
+	}
+
+	Splice(Text, Begin, End, FString());
+}
+
+static bool InsertDependency(FString& Text, const FString& Dependency, bool bPublic, FString& OutError)
+{
+	TArray<FBuildCsDependencyList> Lists;
+	FModuleDependencyGraph::ParseBuildCsLists(Text, Lists);
+
+	const FString Eol = Text.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+	const FString Quoted = TEXT("\"") + Dependency + TEXT("\"");
+
+	for (const FBuildCsDependencyList& List : Lists)
+	{
+		if (List.bPublic != bPublic || !List.bAddRange)
+		{
+			continue;
+		}
+
+		if (List.Literals.Num() > 0)
+		{
+			// 沿用最后一项的写法：独占一行则换行对齐，否则同行追加
+			const FBuildCsLiteral& Last = List.Literals.Last();
+			const FString Indent = LineIndentBefore(Text, Last.Begin);
+			Splice(Text, Last.End, Last.End, Indent.IsEmpty()
+				? TEXT(", ") + Quoted
+				: TEXT(",") + Eol + Indent + Quoted);
+			return true;
+		}
+
+		const int32 Brace = Text.Find(TEXT("{"), ESearchCase::CaseSensitive, ESearchDir::FromStart, List.ParenOpen);
+		if (Brace != INDEX_NONE && Brace < List.ParenClose)
+		{
+			Splice(Text, Brace + 1, Brace + 1, TEXT(" ") + Quoted + TEXT(" "));
+			return true;
+		}
+	}
+
+	// 没有可追加的同类列表：在最后一个依赖列表语句后新增一行
+	if (Lists.Num() == 0)
+	{
+		OutError = TEXT("Build.cs 中没有依赖列表");
+		return false;
+	}
+
+	const FBuildCsDependencyList& Anchor = Lists.Last();
+	const int32 Semicolon = Text.Find(TEXT(";"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Anchor.ParenClose);
+	if (Semicolon == INDEX_NONE)
+	{
+		OutError = TEXT("无法定位依赖列表语句结尾");
+		return false;
+	}
+
+	const FString Indent = LineIndentBefore(Text, Anchor.NameBegin);
+	Splice(Text, Semicolon + 1, Semicolon + 1,
+		Eol + Eol + Indent + (bPublic ? TEXT("PublicDependencyModuleNames.Add(") : TEXT("PrivateDependencyModuleNames.Add(")) + Quoted + TEXT(");"));
+	return true;
+}
+
+} // namespace DependencyDemotionPrivate
+
+void AnalyzeDependencyDemotions(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, FDemotionAnalysis& OutAnalysis)
+{
+	using namespace DependencyDemotionPrivate;
+
+	OutAnalysis = FDemotionAnalysis();
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	struct FModuleScan
+	{
+		bool bSkipped = false;
+		TArray<FString> Unresolved;
+		TArray<FDependencyDemotion> Demotions;
+	};
+
+	TArray<FModuleScan> Scans;
+	Scans.SetNum(Nodes.Num());
+
+	// 各模块的源码扫描互不相关
+	ParallelFor(Nodes.Num(), [&Nodes, &Graph, &External, &Scans](int32 Index)
+	{
+		const FModuleNode& Node = Nodes[Index];
+		FModuleScan& Scan = Scans[Index];
+
+		if (Node.PublicDependencies.Num() == 0)
+		{
+			return;
+		}
+
+		if (!HasPublicFolder(Node.ModuleDir))
+		{
+			Scan.bSkipped = true;
+			return;
+		}
+
+		TArray<FString> Files;
+		IFileManager::Get().FindFilesRecursive(Files, *Node.ModuleDir, TEXT("*.*"), true, false);
+
+		TArray<FString> PublicFiles;
+		TArray<FString> PrivateFiles;
+		for (const FString& File : Files)
+		{
+			const FString Extension = FPaths::GetExtension(File);
+			if (Extension != TEXT("h") && Extension != TEXT("hpp") && Extension != TEXT("inl") && Extension != TEXT("cpp"))
+			{
+				continue;
+			}
+			(IsPublicFolderPath(Node.ModuleDir, File) ? PublicFiles : PrivateFiles).Add(File);
+		}
+
+		TSet<FString> PublicIncludes;
+		TSet<FString> PrivateIncludes;
+		CollectIncludes(PublicFiles, PublicIncludes);
+		CollectIncludes(PrivateFiles, PrivateIncludes);
+
+		for (const FString& Dependency : Node.PublicDependencies)
+		{
+			const int32 DependencyNode = Graph.FindNode(Dependency);
+			const FString DependencyDir = DependencyNode != INDEX_NONE
+				? Nodes[DependencyNode].ModuleDir
+				: External.FindModuleDir(Dependency);
+
+			if (DependencyDir.IsEmpty())
+			{
+				Scan.Unresolved.Add(Node.Name + TEXT(": ") + Dependency);
+				continue;
+			}
+
+			if (AnyOwnedBy(PublicIncludes, DependencyDir))
+			{
+				continue;
+			}
+
+			FDependencyDemotion& Demotion = Scan.Demotions.AddDefaulted_GetRef();
+			Demotion.ModuleName = Node.Name;
+			Demotion.BuildCsPath = Node.BuildCsPath;
+			Demotion.Dependency = Dependency;
+			Demotion.bUsedPrivately = AnyOwnedBy(PrivateIncludes, DependencyDir);
+		}
+	});
+
+	// 下游估算要按需解析引擎模块的 Build.cs，串行执行
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		FModuleScan& Scan = Scans[Index];
+		if (Scan.bSkipped)
+		{
+			OutAnalysis.SkippedModules.Add(Nodes[Index].Name);
+			continue;
+		}
+
+		OutAnalysis.Unresolved.Append(Scan.Unresolved);
+
+		if (Scan.Demotions.Num() == 0)
+		{
+			continue;
+		}
+
+		const TSet<int32> Exposure = Graph.GetRebuildExposure(Index);
+
+		for (FDependencyDemotion& Demotion : Scan.Demotions)
+		{
+			for (int32 Consumer : Exposure)
+			{
+				if (!CanSee(Graph, External, Consumer, Demotion.Dependency, Demotion.ModuleName, Demotion.Dependency))
+				{
+					Demotion.DownstreamModules.Add(Nodes[Consumer].Name);
+					Demotion.DownstreamTranslationUnits += Nodes[Consumer].SourceFiles;
+				}
+			}
+			Demotion.DownstreamModules.Sort();
+
+			OutAnalysis.Demotions.Add(MoveTemp(Demotion));
+		}
+	}
+
+	OutAnalysis.Demotions.Sort([](const FDependencyDemotion& A, const FDependencyDemotion& B)
+	{
+		return A.DownstreamTranslationUnits > B.DownstreamTranslationUnits;
+	});
+}
+
+bool DemoteDependenciesInBuildCs(const FString& InText, const TArray<FString>& Dependencies, FString& OutText, FString& OutError)
+{
+	using namespace DependencyDemotionPrivate;
+
+	OutText = InText;
+
+	for (const FString& Dependency : Dependencies)
+	{
+		TArray<FBuildCsDependencyList> Lists;
+		FModuleDependencyGraph::ParseBuildCsLists(OutText, Lists);
+
+		bool bAlreadyPrivate = false;
+		const FBuildCsDependencyList* PublicList = nullptr;
+		int32 LiteralIndex = INDEX_NONE;
+
+		for (const FBuildCsDependencyList& List : Lists)
+		{
+			const int32 Found = List.Literals.IndexOfByPredicate([&Dependency](const FBuildCsLiteral& Literal) { return Literal.Name == Dependency; });
+			if (Found == INDEX_NONE)
+			{
+				continue;
+			}
+			if (!List.bPublic)
+			{
+				bAlreadyPrivate = true;
+			}
+			else if (!PublicList)
+			{
+				PublicList = &List;
+				LiteralIndex = Found;
+			}
+		}
+
+		if (!PublicList)
+		{
+			OutError = FString::Printf(TEXT("Public 依赖列表中没有 %s"), *Dependency);
+			return false;
+		}
+
+		// PublicDependencyModuleNames.Add("X") 直接改成 Private
+		if (!PublicList->bAddRange && PublicList->Literals.Num() == 1 && !bAlreadyPrivate)
+		{
+			Splice(OutText, PublicList->NameBegin, PublicList->NameBegin + FCString::Strlen(TEXT("PublicDependencyModuleNames")),
+				TEXT("PrivateDependencyModuleNames"));
+			continue;
+		}
+
+		RemoveLiteral(OutText, *PublicList, LiteralIndex);
+
+		if (!bAlreadyPrivate && !InsertDependency(OutText, Dependency, false, OutError))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool AddDependenciesToBuildCs(const FString& InText, const TArray<FString>& Dependencies, bool bPublic, FString& OutText, FString& OutError)
+{
+	using namespace DependencyDemotionPrivate;
+
+	OutText = InText;
+
+	for (const FString& Dependency : Dependencies)
+	{
+		TArray<FBuildCsDependencyList> Lists;
+		FModuleDependencyGraph::ParseBuildCsLists(OutText, Lists);
+
+		bool bListedPublic = false;
+		const FBuildCsDependencyList* PrivateList = nullptr;
+		int32 LiteralIndex = INDEX_NONE;
+
+		for (const FBuildCsDependencyList& List : Lists)
+		{
+			const int32 Found = List.Literals.IndexOfByPredicate([&Dependency](const FBuildCsLiteral& Literal) { return Literal.Name == Dependency; });
+			if (Found == INDEX_NONE)
+			{
+				continue;
+			}
+			if (List.bPublic)
+			{
+				bListedPublic = true;
+			}
+			else if (!PrivateList)
+			{
+				PrivateList = &List;
+				LiteralIndex = Found;
+			}
+		}
+
+		// 已有同等或更强的可见性
+		if (bListedPublic || (PrivateList && !bPublic))
+		{
+			continue;
+		}
+
+		// 需要 Public 但只在 Private 中：移过去
+		if (PrivateList)
+		{
+			RemoveLiteral(OutText, *PrivateList, LiteralIndex);
+		}
+
+		if (!InsertDependency(OutText, Dependency, bPublic, OutError))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RemoveDependenciesFromBuildCs(const FString& InText, const TArray<FString>& Dependencies, FString& OutText, FString& OutError)
+{
+	using namespace DependencyDemotionPrivate;
+
+	OutText = InText;
+
+	// 同一依赖可能出现在多个列表中，每删一处重新解析
+	while (true)
+	{
+		TArray<FBuildCsDependencyList> Lists;
+		FModuleDependencyGraph::ParseBuildCsLists(OutText, Lists);
+
+		const FBuildCsDependencyList* Found = nullptr;
+		int32 LiteralIndex = INDEX_NONE;
+		for (const FBuildCsDependencyList& List : Lists)
+		{
+			LiteralIndex = List.Literals.IndexOfByPredicate([&Dependencies](const FBuildCsLiteral& Literal) { return Dependencies.Contains(Literal.Name); });
+			if (LiteralIndex != INDEX_NONE)
+			{
+				Found = &List;
+				break;
+			}
+		}
+
+		if (!Found)
+		{
+			return true;
+		}
+
+		if (Found->bAddRange || Found->Literals.Num() > 1)
+		{
+			RemoveLiteral(OutText, *Found, LiteralIndex);
+			continue;
+		}
+
+		const int32 Semicolon = OutText.Find(TEXT(";"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Found->ParenClose);
+		if (Semicolon == INDEX_NONE)
+		{
+			OutError = TEXT("无法定位依赖列表语句结尾");
+			return false;
+		}
+
+		// 语句独占一行时连同缩进和换行一起删
+		int32 Begin = Found->NameBegin;
+		int32 End = Semicolon + 1;
+		if (!LineIndentBefore(OutText, Begin).IsEmpty() || Begin == LineStart(OutText, Begin))
+		{
+			int32 LineEnd = End;
+			while (LineEnd < OutText.Len() && (OutText[LineEnd] == TEXT(' ') || OutText[LineEnd] == TEXT('\t') || OutText[LineEnd] == TEXT('\r'))) ++LineEnd;
+			if (LineEnd >= OutText.Len() || OutText[LineEnd] == TEXT('\n'))
+			{
+				Begin = LineStart(OutText, Begin);
+				End = FMath::Min(LineEnd + 1, OutText.Len());
+			}
+		}
+		Splice(OutText, Begin, End, FString());
+	}
+}
+
+bool ApplyDependencyDemotions(const TArray<FDependencyDemotion>& Demotions, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors)
+{
+	TMap<FString, TArray<FString>> ByBuildCs;
+	for (const FDependencyDemotion& Demotion : Demotions)
+	{
+		ByBuildCs.FindOrAdd(Demotion.BuildCsPath).AddUnique(Demotion.Dependency);
+	}
+
+	for (const TPair<FString, TArray<FString>>& Pair : ByBuildCs)
+	{
+		FString Text;
+		bool bHasBom = false;
+		if (!LoadTextPreservingEncoding(Pair.Key, Text, bHasBom))
+		{
+			OutErrors.Add(TEXT("读取失败：") + Pair.Key);
+			continue;
+		}
+
+		FString NewText;
+		FString Error;
+		if (!DemoteDependenciesInBuildCs(Text, Pair.Value, NewText, Error))
+		{
+			OutErrors.Add(Pair.Key + TEXT("：") + Error);
+			continue;
+		}
+
+		OutDiff += MakeUnifiedDiff(Pair.Key, Text, NewText);
+
+		if (bDryRun || NewText.Equals(Text, ESearchCase::CaseSensitive))
+		{
+			continue;
+		}
+
+		if (!SaveTextPreservingEncoding(Pair.Key, NewText, bHasBom))
+		{
+			OutErrors.Add(TEXT("写入失败：") + Pair.Key);
+		}
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+FString FormatDemotionReport(const FDemotionAnalysis& Analysis)
+{
+	FString Report = FString::Printf(TEXT("可降为 Private 的 Public 依赖：%d 条\n\n"), Analysis.Demotions.Num());
+
+	for (const FDependencyDemotion& Demotion : Analysis.Demotions)
+	{
+		Report += FString::Printf(TEXT("  %s -> %s  %s\n"),
+			*Demotion.ModuleName, *Demotion.Dependency,
+			Demotion.bUsedPrivately ? TEXT("（仅 Private 使用）") : TEXT("（未发现包含，仍保留为 Private 以免链接失败）"));
+
+		Report += FString::Printf(TEXT("      %s 头文件变化时少重编 %d 个模块、约 %d 个 .cpp"),
+			*Demotion.Dependency, Demotion.DownstreamModules.Num(), Demotion.DownstreamTranslationUnits);
+		if (Demotion.DownstreamModules.Num() > 0)
+		{
+			Report += TEXT("：") + FString::Join(Demotion.DownstreamModules, TEXT(", "));
+		}
+		Report += TEXT("\n");
+	}
+
+	if (Analysis.Unresolved.Num() > 0)
+	{
+		Report += FString::Printf(TEXT("\n找不到源码、无法判断的依赖：%d 条\n"), Analysis.Unresolved.Num());
+		for (const FString& Entry : Analysis.Unresolved)
+		{
+			Report += TEXT("  ") + Entry + TEXT("\n");
+		}
+	}
+
+	if (Analysis.SkippedModules.Num() > 0)
+	{
+		Report += TEXT("\n没有 Public/Classes 目录、已跳过：") + FString::Join(Analysis.SkippedModules, TEXT(", ")) + TEXT("\n");
+	}
+
+	return Report;
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,661 @@
+#include "DescriptorPatcher.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleGenerator.h"
+
+namespace ModuleBuilder
+{
+namespace DescriptorPatcherPrivate
+{
+
+// ===== 轻量 JSON 扫描：只跳过值、记录位置，不分配 DOM =====
+
+static void SkipWhitespace(const FString& Text, int32& Pos)
+{
+	while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos]))
+	{
+		++Pos;
+	}
+}
+
+static bool ReadString(const FString& Text, int32& Pos, FString& OutValue)
+{
+	if (Pos >= Text.Len() || Text[Pos] != TEXT('"'))
+	{
+		return false;
+	}
+
+	++Pos;
+	OutValue.Reset();
+
+	while (Pos < Text.Len())
+	{
+		const TCHAR C = Text[Pos++];
+		if (C == TEXT('"'))
+		{
+			return true;
+		}
+
+		if (C != TEXT('\\'))
+		{
+			OutValue.AppendChar(C);
+			continue;
+		}
+
+		if (Pos >= Text.Len())
+		{
+			return false;
+		}
+
+		const TCHAR Escaped = Text[Pos++];
+		switch (Escaped)
+		{
+		case TEXT('n'): OutValue.AppendChar(TEXT('\n')); break;
+		case TEXT('r'): OutValue.AppendChar(TEXT('\r')); break;
+		case TEXT('t'): OutValue.AppendChar(TEXT('\t')); break;
+		case TEXT('b'): OutValue.AppendChar(TEXT('\b')); break;
+		case TEXT('f'): OutValue.AppendChar(TEXT('\f')); break;
+		case TEXT('u'):
+			if (Pos + 4 > Text.Len())
+			{
+				return false;
+			}
+			OutValue.AppendChar(static_cast<TCHAR>(FParse::HexNumber(*Text.Mid(Pos, 4))));
+			Pos += 4;
+			break;
+		default:
+			OutValue.AppendChar(Escaped);
+			break;
+		}
+	}
+
+	return false;
+}
+
+static bool SkipValue(const FString& Text, int32& Pos);
+
+// Pos 指向 {，返回时指向 } 之后；Func(Key, KeyBegin, ValueBegin, ValueEnd)
+static bool ForEachMember(const FString& Text, int32& Pos, TFunctionRef<void(const FString&, int32, int32, int32)> Func)
+{
+	if (Pos >= Text.Len() || Text[Pos] != TEXT('{'))
+	{
+		return false;
+	}
+
+	++Pos;
+	SkipWhitespace(Text, Pos);
+	if (Pos < Text.Len() && Text[Pos] == TEXT('}'))
+	{
+		++Pos;
+		return true;
+	}
+
+	FString Key;
+	while (true)
+	{
+		SkipWhitespace(Text, Pos);
+
+		const int32 KeyBegin = Pos;
+		if (!ReadString(Text, Pos, Key))
+		{
+			return false;
+		}
+
+		SkipWhitespace(Text, Pos);
+		if (Pos >= Text.Len() || Text[Pos] != TEXT(':'))
+		{
+			return false;
+		}
+
+		++Pos;
+		SkipWhitespace(Text, Pos);
+
+		const int32 ValueBegin = Pos;
+		if (!SkipValue(Text, Pos))
+		{
+			return false;
+		}
+
+		Func(Key, KeyBegin, ValueBegin, Pos);
+
+		SkipWhitespace(Text, Pos);
+		if (Pos >= Text.Len())
+		{
+			return false;
+		}
+		if (Text[Pos] == TEXT(','))
+		{
+			++Pos;
+			continue;
+		}
+		if (Text[Pos] == TEXT('}'))
+		{
+			++Pos;
+			return true;
+		}
+		return false;
+	}
+}
+
+// Pos 指向 [，返回时指向 ] 之后；Func(ElementBegin, ElementEnd)
+static bool ForEachElement(const FString& Text, int32& Pos, TFunctionRef<void(int32, int32)> Func)
+{
+	if (Pos >= Text.Len() || Text[Pos] != TEXT('['))
+	{
+		return false;
+	}
+
+	++Pos;
+	SkipWhitespace(Text, Pos);
+	if (Pos < Text.Len() && Text[Pos] == TEXT(']'))
+	{
+		++Pos;
+		return true;
+	}
+
+	while (true)
+	{
+		SkipWhitespace(Text, Pos);
+
+		const int32 ElementBegin = Pos;
+		if (!SkipValue(Text, Pos))
+		{
+			return false;
+		}
+
+		Func(ElementBegin, Pos);
+
+		SkipWhitespace(Text, Pos);
+		if (Pos >= Text.Len())
+		{
+			return false;
+		}
+		if (Text[Pos] == TEXT(','))
+		{
+			++Pos;
+			continue;
+		}
+		if (Text[Pos] == TEXT(']'))
+		{
+			++Pos;
+			return true;
+		}
+		return false;
+	}
+}
+
+static bool SkipValue(const FString& Text, int32& Pos)
+{
+	SkipWhitespace(Text, Pos);
+	if (Pos >= Text.Len())
+	{
+		return false;
+	}
+
+	switch (Text[Pos])
+	{
+	case TEXT('"'):
+	{
+		FString Dummy;
+		return ReadString(Text, Pos, Dummy);
+	}
+	case TEXT('{'):
+		return ForEachMember(Text, Pos, [](const FString&, int32, int32, int32) {});
+	case TEXT('['):
+		return ForEachElement(Text, Pos, [](int32, int32) {});
+	default:
+		break;
+	}
+
+	// 数字 / true / false / null
+	const int32 Begin = Pos;
+	while (Pos < Text.Len()
+		&& !FChar::IsWhitespace(Text[Pos])
+		&& Text[Pos] != TEXT(',')
+		&& Text[Pos] != TEXT('}')
+		&& Text[Pos] != TEXT(']'))
+	{
+		++Pos;
+	}
+	return Pos > Begin;
+}
+
+// ===== 格式探测 =====
+
+// Pos 所在行的前导缩进；Pos 之前同一行有其他内容时返回空
+static FString LineIndentBefore(const FString& Text, int32 Pos)
+{
+	int32 Index = Pos;
+	while (Index > 0 && (Text[Index - 1] == TEXT(' ') || Text[Index - 1] == TEXT('\t')))
+	{
+		--Index;
+	}
+	if (Index > 0 && Text[Index - 1] != TEXT('\n'))
+	{
+		return FString();
+	}
+	return Text.Mid(Index, Pos - Index);
+}
+
+// 按 RFC 8259 转义：引号、反斜杠与全部控制字符
+static FString EscapeJsonString(const FString& Value)
+{
+	FString Out;
+	Out.Reserve(Value.Len());
+	for (const TCHAR C : Value)
+	{
+		switch (C)
+		{
+		case TEXT('"'):  Out += TEXT("\\\""); break;
+		case TEXT('\\'): Out += TEXT("\\\\"); break;
+		case TEXT('\b'): Out += TEXT("\\b"); break;
+		case TEXT('\f'): Out += TEXT("\\f"); break;
+		case TEXT('\n'): Out += TEXT("\\n"); break;
+		case TEXT('\r'): Out += TEXT("\\r"); break;
+		case TEXT('\t'): Out += TEXT("\\t"); break;
+		default:
+			if (C < 0x20)
+			{
+				Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(C));
+			}
+			else
+			{
+				Out.AppendChar(C);
+			}
+			break;
+		}
+	}
+	return Out;
+}
+
+struct FEntryStyle
+{
+	FString Eol = TEXT("\n");
+	FString KeyIndent;   // Modules 键所在缩进
+	FString EntryIndent; // 数组元素缩进
+	FString FieldIndent; // 元素内字段缩进
+	bool bMultiline = true;
+};
+
+static FEntryStyle DetectEntryStyle(const FString& Text, const FDescriptorLayout& Layout)
+{
+	FEntryStyle Style;
+	Style.Eol = Text.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+	Style.bMultiline = Text.Contains(TEXT("\n"));
+
+	// 根成员缩进即一级缩进单位
+	int32 FirstKey = Layout.RootOpen + 1;
+	SkipWhitespace(Text, FirstKey);
+	FString Unit = LineIndentBefore(Text, FirstKey);
+	if (Unit.IsEmpty())
+	{
+		Unit = TEXT("\t");
+	}
+
+	Style.KeyIndent = Layout.ModulesKey != INDEX_NONE ? LineIndentBefore(Text, Layout.ModulesKey) : Unit;
+
+	if (Layout.Modules.Num() > 0)
+	{
+		// 沿用已有条目的写法
+		const FDescriptorModuleSpan& First = Layout.Modules[0];
+		Style.EntryIndent = LineIndentBefore(Text, First.Begin);
+
+		int32 FirstField = First.Begin + 1;
+		SkipWhitespace(Text, FirstField);
+		Style.FieldIndent = LineIndentBefore(Text, FirstField);
+
+		const int32 EntryNewline = Text.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, First.Begin);
+		Style.bMultiline = EntryNewline != INDEX_NONE && EntryNewline < First.End;
+	}
+	else
+	{
+		Style.EntryIndent = Style.KeyIndent + Unit;
+		Style.FieldIndent = Style.EntryIndent + Unit;
+	}
+
+	return Style;
+}
+
+static FString FormatEntry(const FNewModuleParams& Params, const FEntryStyle& Style)
+{
+	const FString ModuleType   = Params.ModuleType.IsEmpty()   ? TEXT("Runtime") : Params.ModuleType;
+	const FString LoadingPhase = Params.LoadingPhase.IsEmpty() ? TEXT("Default") : Params.LoadingPhase;
+
+	const FString Fields[] =
+	{
+		FString::Printf(TEXT("\"Name\": \"%s\""),         *EscapeJsonString(Params.ModuleName)),
+		FString::Printf(TEXT("\"Type\": \"%s\""),         *EscapeJsonString(ModuleType)),
+		FString::Printf(TEXT("\"LoadingPhase\": \"%s\""), *EscapeJsonString(LoadingPhase)),
+	};
+
+	FString Entry = TEXT("{");
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Fields); ++Index)
+	{
+		if (Style.bMultiline)
+		{
+			Entry += Style.Eol + Style.FieldIndent + Fields[Index];
+		}
+		else
+		{
+			Entry += TEXT(" ") + Fields[Index];
+		}
+		if (Index + 1 < UE_ARRAY_COUNT(Fields))
+		{
+			Entry += TEXT(",");
+		}
+	}
+	Entry += Style.bMultiline ? Style.Eol + Style.EntryIndent + TEXT("}") : FString(TEXT(" }"));
+	return Entry;
+}
+
+} // namespace DescriptorPatcherPrivate
+
+// ===== 对外接口 =====
+
+bool ScanDescriptorLayout(const FString& Text, FDescriptorLayout& OutLayout, FString& OutError)
+{
+	OutLayout = FDescriptorLayout();
+
+	int32 Pos = 0;
+	DescriptorPatcherPrivate::SkipWhitespace(Text, Pos);
+	if (Pos >= Text.Len() || Text[Pos] != TEXT('{'))
+	{
+		OutError = TEXT("描述文件根节点不是 JSON 对象。");
+		return false;
+	}
+
+	OutLayout.RootOpen = Pos;
+
+	const bool bRootOk = DescriptorPatcherPrivate::ForEachMember(Text, Pos, [&OutLayout, &Text](const FString& Key, int32 KeyBegin, int32 ValueBegin, int32 ValueEnd)
+	{
+		OutLayout.LastMemberEnd = ValueEnd;
+		if (Key == TEXT("Modules"))
+		{
+			OutLayout.ModulesKey = KeyBegin;
+			if (Text[ValueBegin] == TEXT('['))
+			{
+				OutLayout.ArrayOpen  = ValueBegin;
+				OutLayout.ArrayClose = ValueEnd - 1;
+			}
+		}
+	});
+
+	if (!bRootOk)
+	{
+		OutError = TEXT("JSON 解析失败。");
+		return false;
+	}
+
+	OutLayout.RootClose = Pos - 1;
+
+	if (OutLayout.ArrayOpen == INDEX_NONE)
+	{
+		return true;
+	}
+
+	int32 ArrayPos = OutLayout.ArrayOpen;
+	DescriptorPatcherPrivate::ForEachElement(Text, ArrayPos, [&OutLayout, &Text](int32 ElementBegin, int32 ElementEnd)
+	{
+		FDescriptorModuleSpan& Span = OutLayout.Modules.AddDefaulted_GetRef();
+		Span.Begin = ElementBegin;
+		Span.End   = ElementEnd;
+
+		if (Text[ElementBegin] != TEXT('{'))
+		{
+			return;
+		}
+
+		int32 ObjectPos = ElementBegin;
+		DescriptorPatcherPrivate::ForEachMember(Text, ObjectPos, [&Span, &Text](const FString& Key, int32, int32 ValueBegin, int32)
+		{
+			if (Key == TEXT("Name"))
+			{
+				int32 NamePos = ValueBegin;
+				DescriptorPatcherPrivate::ReadString(Text, NamePos, Span.Name);
+			}
+		});
+	});
+
+	return true;
+}
+
+bool PatchDescriptorText(const FString& InText, const TArray<FNewModuleParams>& NewModules, FString& OutText, FString& OutError)
+{
+	FDescriptorLayout Layout;
+	if (!ScanDescriptorLayout(InText, Layout, OutError))
+	{
+		return false;
+	}
+
+	// 追加第二个 "Modules" 会产生重复的键
+	if (Layout.ModulesKey != INDEX_NONE && Layout.ArrayOpen == INDEX_NONE)
+	{
+		OutError = TEXT("描述文件中的 Modules 不是数组，请手动修正。");
+		return false;
+	}
+
+	TSet<FString> ExistingNames;
+	for (const FDescriptorModuleSpan& Span : Layout.Modules)
+	{
+		ExistingNames.Add(Span.Name);
+	}
+
+	for (const FNewModuleParams& Params : NewModules)
+	{
+		bool bAlreadyInSet = false;
+		ExistingNames.Add(Params.ModuleName, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			OutError = TEXT("描述文件中已存在同名模块：") + Params.ModuleName;
+			return false;
+		}
+	}
+
+	if (NewModules.Num() == 0)
+	{
+		OutText = InText;
+		return true;
+	}
+
+	const DescriptorPatcherPrivate::FEntryStyle Style = DescriptorPatcherPrivate::DetectEntryStyle(InText, Layout);
+	const FString Separator = Style.bMultiline ? TEXT(",") + Style.Eol + Style.EntryIndent : FString(TEXT(", "));
+
+	FString Entries;
+	for (const FNewModuleParams& Params : NewModules)
+	{
+		if (!Entries.IsEmpty())
+		{
+			Entries += Separator;
+		}
+		Entries += DescriptorPatcherPrivate::FormatEntry(Params, Style);
+	}
+
+	// 空数组内容：换行 + 条目 + 换行回到键的缩进
+	const FString EmptyArrayBody = Style.bMultiline
+		? Style.Eol + Style.EntryIndent + Entries + Style.Eol + Style.KeyIndent
+		: Entries;
+
+	int32 SpliceBegin = INDEX_NONE;
+	int32 SpliceEnd = INDEX_NONE;
+	FString Insert;
+
+	if (Layout.Modules.Num() > 0)
+	{
+		SpliceBegin = SpliceEnd = Layout.Modules.Last().End;
+		Insert = Separator + Entries;
+	}
+	else if (Layout.ArrayOpen != INDEX_NONE)
+	{
+		SpliceBegin = Layout.ArrayOpen + 1;
+		SpliceEnd = Layout.ArrayClose;
+		Insert = EmptyArrayBody;
+	}
+	else
+	{
+		const FString ModulesMember = TEXT("\"Modules\": [") + EmptyArrayBody + TEXT("]");
+		const FString MemberBreak = Style.bMultiline ? Style.Eol + Style.KeyIndent : FString(TEXT(" "));
+
+		if (Layout.LastMemberEnd != INDEX_NONE)
+		{
+			SpliceBegin = SpliceEnd = Layout.LastMemberEnd;
+			Insert = TEXT(",") + MemberBreak + ModulesMember;
+		}
+		else
+		{
+			SpliceBegin = Layout.RootOpen + 1;
+			SpliceEnd = Layout.RootClose;
+			Insert = MemberBreak + ModulesMember + (Style.bMultiline ? Style.Eol : FString(TEXT(" ")));
+		}
+	}
+
+	OutText.Reset(InText.Len() + Insert.Len());
+	OutText.Append(*InText, SpliceBegin);
+	OutText.Append(Insert);
+	OutText.Append(*InText + SpliceEnd, InText.Len() - SpliceEnd);
+	return true;
+}
+
+bool RemoveModulesFromDescriptorText(const FString& InText, const TArray<FString>& ModuleNames, FString& OutText, FString& OutError)
+{
+	OutText = InText;
+
+	// 每删一项重新扫描，位置始终与当前文本一致
+	while (true)
+	{
+		FDescriptorLayout Layout;
+		if (!ScanDescriptorLayout(OutText, Layout, OutError))
+		{
+			return false;
+		}
+
+		const int32 Index = Layout.Modules.IndexOfByPredicate([&ModuleNames](const FDescriptorModuleSpan& Span) { return ModuleNames.Contains(Span.Name); });
+		if (Index == INDEX_NONE)
+		{
+			return true;
+		}
+
+		int32 RemoveBegin = INDEX_NONE;
+		int32 RemoveEnd = INDEX_NONE;
+
+		if (Layout.Modules.Num() == 1)
+		{
+			// 唯一的条目：留下空数组
+			RemoveBegin = Layout.ArrayOpen + 1;
+			RemoveEnd = Layout.ArrayClose;
+		}
+		else if (Index + 1 < Layout.Modules.Num())
+		{
+			// 连同逗号删到下一项开头，下一项沿用本项的缩进
+			RemoveBegin = Layout.Modules[Index].Begin;
+			RemoveEnd = Layout.Modules[Index + 1].Begin;
+		}
+		else
+		{
+			// 最后一项：从上一项末尾删起，去掉它后面的逗号
+			RemoveBegin = Layout.Modules[Index - 1].End;
+			RemoveEnd = Layout.Modules[Index].End;
+		}
+
+		OutText = OutText.Left(RemoveBegin) + OutText.Mid(RemoveEnd);
+	}
+}
+
+bool SetDescriptorModuleField(const FString& InText, const FString& ModuleName, const FString& Key, const FString& Value, FString& OutText, FString& OutError)
+{
+	FDescriptorLayout Layout;
+	if (!ScanDescriptorLayout(InText, Layout, OutError))
+	{
+		return false;
+	}
+
+	const FDescriptorModuleSpan* Span = Layout.Modules.FindByPredicate([&ModuleName](const FDescriptorModuleSpan& Existing) { return Existing.Name == ModuleName; });
+	if (!Span || InText[Span->Begin] != TEXT('{'))
+	{
+		OutError = TEXT("描述文件中没有模块：") + ModuleName;
+		return false;
+	}
+
+	int32 ValueBegin = INDEX_NONE;
+	int32 ValueEnd = INDEX_NONE;
+	int32 LastValueEnd = INDEX_NONE;
+	int32 LastKeyBegin = INDEX_NONE;
+
+	int32 Pos = Span->Begin;
+	DescriptorPatcherPrivate::ForEachMember(InText, Pos, [&](const FString& MemberKey, int32 KeyBegin, int32 MemberValueBegin, int32 MemberValueEnd)
+	{
+		if (MemberKey == Key)
+		{
+			ValueBegin = MemberValueBegin;
+			ValueEnd = MemberValueEnd;
+		}
+		LastKeyBegin = KeyBegin;
+		LastValueEnd = MemberValueEnd;
+	});
+
+	const FString Quoted = TEXT("\"") + DescriptorPatcherPrivate::EscapeJsonString(Value) + TEXT("\"");
+
+	if (ValueBegin != INDEX_NONE)
+	{
+		OutText = InText.Left(ValueBegin) + Quoted + InText.Mid(ValueEnd);
+		return true;
+	}
+
+	if (LastValueEnd == INDEX_NONE)
+	{
+		OutError = TEXT("模块条目为空：") + ModuleName;
+		return false;
+	}
+
+	// 与上一个字段同一写法：独占一行则换行对齐
+	const FString Indent = DescriptorPatcherPrivate::LineIndentBefore(InText, LastKeyBegin);
+	const FString Eol = InText.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+	const FString Member = FString::Printf(TEXT("\"%s\": %s"), *DescriptorPatcherPrivate::EscapeJsonString(Key), *Quoted);
+	OutText = InText.Left(LastValueEnd) + (Indent.IsEmpty() ? FString(TEXT(", ")) : TEXT(",") + Eol + Indent) + Member + InText.Mid(LastValueEnd);
+	return true;
+}
+
+bool PatchDescriptorFile(const FString& DescriptorPath, const TArray<FNewModuleParams>& NewModules, FDescriptorPatchResult& OutResult, FString& OutError)
+{
+	OutResult = FDescriptorPatchResult();
+
+	FString Text;
+	bool bHasBom = false;
+	{
+		MODULEBUILDER_SCOPE("Descriptor.Read");
+		if (!LoadTextPreservingEncoding(DescriptorPath, Text, bHasBom))
+		{
+			OutError = TEXT("读取描述文件失败：") + DescriptorPath;
+			return false;
+		}
+	}
+
+	FString NewText;
+	{
+		MODULEBUILDER_SCOPE("Descriptor.Patch");
+		if (!PatchDescriptorText(Text, NewModules, NewText, OutError))
+		{
+			return false;
+		}
+	}
+
+	OutResult.bChanged = !NewText.Equals(Text, ESearchCase::CaseSensitive);
+	if (!OutResult.bChanged)
+	{
+		// 内容一致就不碰文件，时间戳不变，UBT makefile 继续有效
+		return true;
+	}
+
+	{
+		MODULEBUILDER_SCOPE("Descriptor.Write");
+		if (!SaveTextPreservingEncoding(DescriptorPath, NewText, bHasBom))
+		{
+			OutError = TEXT("写入描述文件失败：") + DescriptorPath;
+			return false;
+		}
+	}
+	MODULEBUILDER_COUNT(DescriptorsPatched, 1);
+
+	OutResult.bWritten = true;
+	return true;
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,461 @@
+#include "IncludeGraphIndex.h"
+#include "IncludeResolver.h"
+#include "ModuleBuilderCache.h"
+#include "ModuleDependencyGraph.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <atomic>
+
+namespace IncludeGraphIndexPrivate
+{
+
+using namespace ModuleBuilder;
+
+// 缓存文件格式，结构变化时递增
+static constexpr uint32 GIncludeCacheMagic = 0x4D424947; // 'MBIG'
+static constexpr int32 GIncludeCacheVersion = 1;
+
+// 缓存中的一个文件；路径相对工程目录，包含原文存为字符串表下标
+struct FCachedIncludeEntry
+{
+	FString Path;
+	int64 TimestampTicks = 0;
+	int64 FileSize = 0;
+	uint32 ContentHash = 0;
+	TArray<int32> Includes;
+
+	friend FArchive& operator<<(FArchive& Ar, FCachedIncludeEntry& Entry)
+	{
+		Ar << Entry.Path;
+		Ar << Entry.TimestampTicks;
+		Ar << Entry.FileSize;
+		Ar << Entry.ContentHash;
+		Ar << Entry.Includes;
+		return Ar;
+	}
+};
+
+static bool IsIndexedExtension(const FString& Extension, bool& bOutSource)
+{
+	bOutSource = Extension == TEXT("cpp") || Extension == TEXT("c") || Extension == TEXT("cc");
+	return bOutSource || Extension == TEXT("h") || Extension == TEXT("hpp") || Extension == TEXT("inl");
+}
+
+static void LoadIncludeCache(const FString& CachePath, TMap<FString, FIncludeGraphFile>& OutCache)
+{
+	TArray<FString> Strings;
+	TArray<FCachedIncludeEntry> Entries;
+	if (!LoadIndexCache(CachePath, GIncludeCacheMagic, GIncludeCacheVersion, Strings, Entries))
+	{
+		return;
+	}
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	OutCache.Reserve(Entries.Num());
+	for (FCachedIncludeEntry& Entry : Entries)
+	{
+		FIncludeGraphFile File;
+		File.Path = FromCachePath(ProjectDir, Entry.Path);
+		File.TimestampTicks = Entry.TimestampTicks;
+		File.FileSize = Entry.FileSize;
+		File.ContentHash = Entry.ContentHash;
+		for (int32 Id : Entry.Includes)
+		{
+			if (Strings.IsValidIndex(Id))
+			{
+				File.Includes.Add(Strings[Id]);
+			}
+		}
+		OutCache.Add(File.Path, MoveTemp(File));
+	}
+}
+
+static int64 SaveIncludeCache(const FString& CachePath, const TArray<FIncludeGraphFile>& Files)
+{
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	// 同一个头文件名会被成百上千个文件包含，只存一次
+	FCacheStringTable Strings;
+	TArray<FCachedIncludeEntry> Entries;
+	Entries.Reserve(Files.Num());
+
+	for (const FIncludeGraphFile& File : Files)
+	{
+		FCachedIncludeEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Path = ToCachePath(ProjectDir, File.Path);
+		Entry.TimestampTicks = File.TimestampTicks;
+		Entry.FileSize = File.FileSize;
+		Entry.ContentHash = File.ContentHash;
+		for (const FString& Include : File.Includes)
+		{
+			Entry.Includes.Add(Strings.Add(Include));
+		}
+	}
+
+	return SaveIndexCache(CachePath, GIncludeCacheMagic, GIncludeCacheVersion, Strings, Entries, TEXT("包含图"));
+}
+
+} // namespace IncludeGraphIndexPrivate
+
+FString FIncludeGraphIndex::GetCachePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("IncludeGraphCache.bin"));
+}
+
+int32 FIncludeGraphIndex::FindFile(const FString& Path) const
+{
+	const int32* Found = FileByPath.Find(Path);
+	return Found ? *Found : INDEX_NONE;
+}
+
+void FIncludeGraphIndex::Build(const FModuleDependencyGraph& Graph, const FString& CachePath, FIncludeIndexStats& OutStats)
+{
+	using namespace IncludeGraphIndexPrivate;
+
+	const double StartTime = FPlatformTime::Seconds();
+	OutStats = FIncludeIndexStats();
+
+	TMap<FString, FIncludeGraphFile> Cache;
+	LoadIncludeCache(CachePath, Cache);
+
+	// 1）只做目录遍历和 stat，不读文件内容
+	Files.Reset();
+	FileByPath.Reset();
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		IFileManager::Get().IterateDirectoryStatRecursively(*Nodes[NodeIndex].ModuleDir, [this, NodeIndex](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			bool bSource = false;
+			if (StatData.bIsDirectory || !IsIndexedExtension(FPaths::GetExtension(Path), bSource))
+			{
+				return true;
+			}
+
+			const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+			if (!FileByPath.Contains(FullPath))
+			{
+				FIncludeGraphFile& File = Files.AddDefaulted_GetRef();
+				File.Path = FullPath;
+				File.Module = NodeIndex;
+				File.bSource = bSource;
+				File.TimestampTicks = StatData.ModificationTime.GetTicks();
+				File.FileSize = StatData.FileSize;
+				FileByPath.Add(FullPath, Files.Num() - 1);
+			}
+			return true;
+		});
+	}
+
+	// 2）时间戳和大小都没变的直接复用缓存，其余并行读取 + 哈希 + 解析
+	std::atomic<int32> Parsed { 0 };
+	std::atomic<int32> Rehashed { 0 };
+
+	ParallelFor(Files.Num(), [this, &Cache, &Parsed, &Rehashed](int32 Index)
+	{
+		FIncludeGraphFile& File = Files[Index];
+		const FIncludeGraphFile* Cached = Cache.Find(File.Path);
+
+		if (Cached && Cached->TimestampTicks == File.TimestampTicks && Cached->FileSize == File.FileSize)
+		{
+			File.ContentHash = Cached->ContentHash;
+			File.Includes = Cached->Includes;
+			return;
+		}
+
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *File.Path))
+		{
+			return;
+		}
+
+		File.ContentHash = FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+
+		// 时间戳变了但内容相同（例如重新检出），沿用解析结果
+		if (Cached && Cached->ContentHash == File.ContentHash)
+		{
+			File.Includes = Cached->Includes;
+			++Rehashed;
+			return;
+		}
+
+		FString Text;
+		FFileHelper::BufferToString(Text, Bytes.GetData(), Bytes.Num());
+		FModuleDependencyGraph::ParseIncludes(Text, File.Includes);
+		++Parsed;
+	});
+
+	OutStats.Files = Files.Num();
+	OutStats.Parsed = Parsed.load();
+	OutStats.Rehashed = Rehashed.load();
+	for (const TPair<FString, FIncludeGraphFile>& Pair : Cache)
+	{
+		OutStats.Removed += FileByPath.Contains(Pair.Key) ? 0 : 1;
+	}
+
+	// 有新解析、内容未变但时间戳更新、或文件被删除时才重写缓存
+	if (!CachePath.IsEmpty() && (OutStats.Parsed > 0 || OutStats.Rehashed > 0 || OutStats.Removed > 0 || Cache.Num() != Files.Num()))
+	{
+		OutStats.CacheBytes = SaveIncludeCache(CachePath, Files);
+	}
+	else
+	{
+		OutStats.CacheBytes = FMath::Max<int64>(0, IFileManager::Get().FileSize(*CachePath));
+	}
+
+	// 3）解析包含路径（不缓存：依赖关系变化时同一句 #include 会解析到不同文件）
+	Resolve(Graph);
+
+	for (const FIncludeGraphFile& File : Files)
+	{
+		OutStats.Edges += File.Resolved.Num() + File.External.Num();
+		OutStats.UnresolvedEdges += File.External.Num();
+	}
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void FIncludeGraphIndex::Resolve(const FModuleDependencyGraph& Graph)
+{
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	TArray<TArray<int32>> ModuleFiles;
+	ModuleFiles.SetNum(Nodes.Num());
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		ModuleFiles[Files[Index].Module].Add(Index);
+	}
+
+	// 与 PCH 建议相同的解析规则；文件是否存在只查已索引的文件，不访问磁盘
+	ParallelFor(Nodes.Num(), [this, &Graph, &Nodes, &ModuleFiles](int32 NodeIndex)
+	{
+		if (ModuleFiles[NodeIndex].Num() == 0)
+		{
+			return;
+		}
+
+		FIncludeResolver Resolver(FIncludeResolver::GetSearchDirs(Graph, nullptr, Nodes[NodeIndex]),
+			[this](const FString& Path) { return FileByPath.Contains(Path); });
+
+		for (const int32 Index : ModuleFiles[NodeIndex])
+		{
+			FIncludeGraphFile& File = Files[Index];
+			File.Resolved.Reset();
+			File.External.Reset();
+
+			const FString FromDir = FPaths::GetPath(File.Path);
+			for (const FString& Include : File.Includes)
+			{
+				// 生成的头文件不在 Source 下，也不计入开销
+				if (Include.EndsWith(TEXT(".generated.h")))
+				{
+					continue;
+				}
+
+				const FString Resolved = Resolver.Resolve(Include, FromDir);
+				const int32* Found = Resolved.IsEmpty() ? nullptr : FileByPath.Find(Resolved);
+				if (Found && *Found != Index)
+				{
+					File.Resolved.AddUnique(*Found);
+				}
+				else if (!Found)
+				{
+					File.External.AddUnique(Include);
+				}
+			}
+		}
+	});
+
+	Includers.Reset();
+	Includers.SetNum(Files.Num());
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		for (int32 Included : Files[Index].Resolved)
+		{
+			Includers[Included].Add(Index);
+		}
+	}
+}
+
+TArray<int32> FIncludeGraphIndex::GetClosure(int32 File) const
+{
+	TBitArray<> Visited(false, Files.Num());
+	TArray<int32> Closure;
+	TArray<int32> Stack = { File };
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Current = Stack.Pop(EAllowShrinking::No);
+		if (Visited[Current])
+		{
+			continue;
+		}
+		Visited[Current] = true;
+		Closure.Add(Current);
+		Stack.Append(Files[Current].Resolved);
+	}
+
+	Closure.Sort();
+	return Closure;
+}
+
+FHeaderIncludeCost FIncludeGraphIndex::GetHeaderCost(int32 File) const
+{
+	FHeaderIncludeCost Cost;
+	Cost.File = File;
+
+	TSet<FString> External;
+	for (int32 Included : GetClosure(File))
+	{
+		++Cost.ClosureFiles;
+		Cost.ClosureBytes += Files[Included].FileSize;
+		External.Append(Files[Included].External);
+	}
+	Cost.ExternalIncludes = External.Num();
+
+	// 沿反向边找出会受影响的编译单元
+	TBitArray<> Visited(false, Files.Num());
+	TArray<int32> Stack = { File };
+	while (Stack.Num() > 0)
+	{
+		const int32 Current = Stack.Pop(EAllowShrinking::No);
+		if (Visited[Current])
+		{
+			continue;
+		}
+		Visited[Current] = true;
+		Cost.IncludingSources += Files[Current].bSource ? 1 : 0;
+		Stack.Append(Includers[Current]);
+	}
+	return Cost;
+}
+
+FModuleIncludeCost FIncludeGraphIndex::GetModuleCost(int32 Module) const
+{
+	FModuleIncludeCost Cost;
+	Cost.Module = Module;
+
+	TSet<FString> External;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		const FIncludeGraphFile& File = Files[Index];
+		if (File.Module != Module)
+		{
+			continue;
+		}
+		if (!File.bSource)
+		{
+			++Cost.Headers;
+			continue;
+		}
+
+		++Cost.SourceFiles;
+		for (int32 Included : GetClosure(Index))
+		{
+			const FIncludeGraphFile& Header = Files[Included];
+			External.Append(Header.External);
+			if (Included == Index)
+			{
+				continue;
+			}
+			Cost.ParsedBytes += Header.FileSize;
+			Cost.CrossModuleBytes += Header.Module != Module ? Header.FileSize : 0;
+		}
+	}
+	Cost.ExternalIncludes = External.Num();
+	return Cost;
+}
+
+TArray<FHeaderIncludeCost> FIncludeGraphIndex::ComputeHeaderCosts() const
+{
+	TArray<int32> Headers;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (!Files[Index].bSource)
+		{
+			Headers.Add(Index);
+		}
+	}
+
+	TArray<FHeaderIncludeCost> Costs;
+	Costs.SetNum(Headers.Num());
+	ParallelFor(Headers.Num(), [this, &Headers, &Costs](int32 Index)
+	{
+		Costs[Index] = GetHeaderCost(Headers[Index]);
+	});
+
+	Costs.Sort([](const FHeaderIncludeCost& A, const FHeaderIncludeCost& B) { return A.TotalParsedBytes() > B.TotalParsedBytes(); });
+	return Costs;
+}
+
+FString FIncludeGraphIndex::BuildReport(const FModuleDependencyGraph& Graph, const FIncludeIndexStats& Stats, const FString& OnlyModule, int32 MaxHeaders) const
+{
+	using namespace IncludeGraphIndexPrivate;
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	const int32 OnlyNode = OnlyModule.IsEmpty() ? INDEX_NONE : Graph.FindNode(OnlyModule);
+	if (!OnlyModule.IsEmpty() && OnlyNode == INDEX_NONE)
+	{
+		return TEXT("没有找到模块：") + OnlyModule + TEXT("\n");
+	}
+
+	int32 Sources = 0;
+	for (const FIncludeGraphFile& File : Files)
+	{
+		Sources += File.bSource ? 1 : 0;
+	}
+
+	FString Report = TEXT("== 头文件包含索引 ==\n");
+	Report += FString::Printf(TEXT("  %d 个文件（.cpp %d 个），%d 条包含边，其中 %d 条指向工程外\n"),
+		Stats.Files, Sources, Stats.Edges, Stats.UnresolvedEdges);
+	Report += FString::Printf(TEXT("  重新解析 %d 个，内容未变 %d 个，已删除 %d 个；缓存 %s，用时 %.2f 秒\n"),
+		Stats.Parsed, Stats.Rehashed, Stats.Removed, *FormatBytes(Stats.CacheBytes), Stats.Seconds);
+	Report += TEXT("  开销只统计工程与插件内的文件；引擎头文件按不同包含的种数计\n");
+
+	// 模块：按各 .cpp 传递包含的字节数
+	TArray<FModuleIncludeCost> ModuleCosts;
+	ModuleCosts.SetNum(Nodes.Num());
+	ParallelFor(Nodes.Num(), [this, &ModuleCosts](int32 NodeIndex)
+	{
+		ModuleCosts[NodeIndex] = GetModuleCost(NodeIndex);
+	});
+	ModuleCosts.Sort([](const FModuleIncludeCost& A, const FModuleIncludeCost& B) { return A.ParsedBytes > B.ParsedBytes; });
+
+	Report += TEXT("\n== 模块（按各 .cpp 传递包含的字节数）==\n");
+	for (const FModuleIncludeCost& Cost : ModuleCosts)
+	{
+		if ((OnlyNode != INDEX_NONE && Cost.Module != OnlyNode) || Cost.SourceFiles + Cost.Headers == 0)
+		{
+			continue;
+		}
+		Report += FString::Printf(TEXT("  %s：.cpp %d，头文件 %d，解析 %s（跨模块 %s），平均每个 .cpp %s，外部包含 %d 种\n"),
+			*Nodes[Cost.Module].Name, Cost.SourceFiles, Cost.Headers, *FormatBytes(Cost.ParsedBytes), *FormatBytes(Cost.CrossModuleBytes),
+			*FormatBytes(Cost.SourceFiles > 0 ? Cost.ParsedBytes / Cost.SourceFiles : 0), Cost.ExternalIncludes);
+	}
+
+	Report += TEXT("\n== 开销最大的头文件（闭包大小 × 受影响的 .cpp 数）==\n");
+	int32 Listed = 0;
+	for (const FHeaderIncludeCost& Cost : ComputeHeaderCosts())
+	{
+		const FIncludeGraphFile& File = Files[Cost.File];
+		if ((OnlyNode != INDEX_NONE && File.Module != OnlyNode) || Cost.IncludingSources == 0)
+		{
+			continue;
+		}
+		if (Listed++ == MaxHeaders)
+		{
+			break;
+		}
+
+		const FModuleNode& Node = Nodes[File.Module];
+		Report += FString::Printf(TEXT("  %s/%s：闭包 %d 个文件 %s，外部包含 %d 种；%d 个 .cpp 受影响，合计 %s\n"),
+			*Node.Name, *File.Path.RightChop(Node.ModuleDir.Len() + 1), Cost.ClosureFiles, *FormatBytes(Cost.ClosureBytes),
+			Cost.ExternalIncludes, Cost.IncludingSources, *FormatBytes(Cost.TotalParsedBytes()));
+	}
+	return Report;
+}
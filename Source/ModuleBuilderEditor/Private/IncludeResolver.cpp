@@ -0,0 +1,247 @@
+#include "IncludeResolver.h"
+#include "ModuleDependencyGraph.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+
+const TCHAR* const GModuleTopFolders[4] = { TEXT("Public"), TEXT("Classes"), TEXT("Internal"), TEXT("Private") };
+
+FString GetIncludeKey(const FString& ModuleDir, const FString& Path, bool* bOutPublic)
+{
+	const FString Relative = Path.RightChop(ModuleDir.Len() + 1);
+	if (bOutPublic)
+	{
+		*bOutPublic = false;
+	}
+
+	int32 Slash = INDEX_NONE;
+	if (Relative.FindChar(TEXT('/'), Slash))
+	{
+		const FString Top = Relative.Left(Slash);
+		for (const TCHAR* Folder : GModuleTopFolders)
+		{
+			if (Top == Folder)
+			{
+				if (bOutPublic)
+				{
+					*bOutPublic = Top != TEXT("Private");
+				}
+				return Relative.RightChop(Slash + 1);
+			}
+		}
+	}
+	return Relative;
+}
+
+void FindModuleFiles(const FString& ModuleDir, const TCHAR* Extension, TArray<FString>& OutFiles)
+{
+	TArray<FString> Dirs = { ModuleDir };
+	while (Dirs.Num() > 0)
+	{
+		const FString Dir = Dirs.Pop(EAllowShrinking::No);
+
+		TArray<FString> SubDirs;
+		TArray<FString> Files;
+		bool bNestedModule = false;
+		IFileManager::Get().IterateDirectory(*Dir, [&SubDirs, &Files, &bNestedModule, Extension](const TCHAR* Path, bool bIsDirectory)
+		{
+			const FString Entry = Path;
+			if (bIsDirectory)
+			{
+				SubDirs.Add(Entry);
+			}
+			else if (Entry.EndsWith(TEXT(".Build.cs")))
+			{
+				bNestedModule = true;
+			}
+			else if (Entry.EndsWith(Extension))
+			{
+				Files.Add(Entry);
+			}
+			return true;
+		});
+
+		if (bNestedModule && Dir != ModuleDir)
+		{
+			continue;
+		}
+		OutFiles.Append(MoveTemp(Files));
+		Dirs.Append(MoveTemp(SubDirs));
+	}
+}
+
+} // namespace ModuleBuilder
+
+FIncludeResolver::FIncludeResolver(TArray<FString> InSearchDirs, FFileExists InFileExists)
+	: SearchDirs(MoveTemp(InSearchDirs))
+	, FileExistsFunc(MoveTemp(InFileExists))
+{
+}
+
+TArray<FString> FIncludeResolver::GetSearchDirs(const FModuleDependencyGraph& Graph, FExternalModuleIndex* External, const FModuleNode& Node)
+{
+	TArray<FString> Dirs;
+	for (const TCHAR* Folder : ModuleBuilder::GModuleTopFolders)
+	{
+		Dirs.Add(Node.ModuleDir / Folder);
+	}
+	Dirs.Add(Node.ModuleDir);
+	Dirs.Add(FPaths::GetPath(Node.ModuleDir));
+
+	// 直接依赖 + 沿 Public 依赖传递可见的模块
+	TArray<FString> Queue = Node.PublicDependencies;
+	Queue.Append(Node.PrivateDependencies);
+	TSet<FString> Visited;
+
+	while (Queue.Num() > 0)
+	{
+		const FString Name = Queue.Pop(EAllowShrinking::No);
+
+		bool bAlreadyInSet = false;
+		Visited.Add(Name, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			continue;
+		}
+
+		const int32 NodeIndex = Graph.FindNode(Name);
+		const FString ModuleDir = NodeIndex != INDEX_NONE ? Graph.GetNodes()[NodeIndex].ModuleDir : External ? External->FindModuleDir(Name) : FString();
+		if (ModuleDir.IsEmpty())
+		{
+			continue;
+		}
+
+		for (const TCHAR* Folder : ModuleBuilder::GetPublicTopFolders())
+		{
+			const FString Dir = ModuleDir / Folder;
+			if (IFileManager::Get().DirectoryExists(*Dir))
+			{
+				Dirs.Add(Dir);
+			}
+		}
+		Dirs.AddUnique(FPaths::GetPath(ModuleDir));
+
+		if (NodeIndex != INDEX_NONE)
+		{
+			Queue.Append(Graph.GetNodes()[NodeIndex].PublicDependencies);
+		}
+		else if (External)
+		{
+			Queue.Append(External->GetPublicDependencies(Name));
+		}
+	}
+
+	return Dirs;
+}
+
+bool FIncludeResolver::FileExists(const FString& Path) const
+{
+	return FileExistsFunc ? FileExistsFunc(Path) : FPaths::FileExists(Path);
+}
+
+FString FIncludeResolver::Resolve(const FString& Include, const FString& FromDir)
+{
+	// 引号包含优先相对当前文件
+	const FString Local = FPaths::ConvertRelativePathToFull(FromDir / Include);
+	if (FileExists(Local))
+	{
+		return Local;
+	}
+
+	if (const FString* Cached = ResolveCache.Find(Include))
+	{
+		return *Cached;
+	}
+
+	const bool bParentRelative = Include.Contains(TEXT(".."));
+	FString Found;
+	for (const FString& Dir : SearchDirs)
+	{
+		FString Candidate = Dir / Include;
+		if (bParentRelative)
+		{
+			FPaths::CollapseRelativeDirectories(Candidate);
+		}
+		if (FileExists(Candidate))
+		{
+			Found = Candidate;
+			break;
+		}
+	}
+
+	ResolveCache.Add(Include, Found);
+	return Found;
+}
+
+const TSet<FString>& FIncludeResolver::GetClosure(const FString& Path)
+{
+	if (const TSet<FString>* Cached = ClosureCache.Find(Path))
+	{
+		return *Cached;
+	}
+
+	TSet<FString> Closure;
+	TArray<FString> Stack = { Path };
+	while (Stack.Num() > 0)
+	{
+		const FString Current = Stack.Pop(EAllowShrinking::No);
+
+		bool bAlreadyInSet = false;
+		Closure.Add(Current, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			continue;
+		}
+
+		const FString FromDir = FPaths::GetPath(Current);
+		for (const FString& Include : GetFileIncludes(Current))
+		{
+			const FString Resolved = Resolve(Include, FromDir);
+			if (!Resolved.IsEmpty())
+			{
+				Stack.Add(Resolved);
+			}
+		}
+	}
+
+	return ClosureCache.Add(Path, MoveTemp(Closure));
+}
+
+int64 FIncludeResolver::GetFileSize(const FString& Path)
+{
+	if (const int64* Cached = SizeCache.Find(Path))
+	{
+		return *Cached;
+	}
+	return SizeCache.Add(Path, FMath::Max<int64>(0, IFileManager::Get().FileSize(*Path)));
+}
+
+int64 FIncludeResolver::GetBytes(const TSet<FString>& Files)
+{
+	int64 Bytes = 0;
+	for (const FString& File : Files)
+	{
+		Bytes += GetFileSize(File);
+	}
+	return Bytes;
+}
+
+const TArray<FString>& FIncludeResolver::GetFileIncludes(const FString& Path)
+{
+	if (const TArray<FString>* Cached = IncludeCache.Find(Path))
+	{
+		return *Cached;
+	}
+
+	TArray<FString> Includes;
+	FString Text;
+	if (FFileHelper::LoadFileToString(Text, *Path))
+	{
+		FModuleDependencyGraph::ParseIncludes(Text, Includes);
+	}
+	return IncludeCache.Add(Path, MoveTemp(Includes));
+}
@@ -0,0 +1,517 @@
+#include "LoadingPhaseAdvisor.h"
+#include "DescriptorPatcher.h"
+#include "ModuleDependencyGraph.h"
+#include "SourceRewrite.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#define LOCTEXT_NAMESPACE "ModuleBuilderLoadingPhase"
+
+namespace ModuleBuilder
+{
+namespace LoadingPhaseAdvisorPrivate
+{
+
+static const TCHAR* const GOnDemandPhase = TEXT("None");
+static const TCHAR* const GDeferredPhase = TEXT("PostEngineInit");
+
+// 报告中最多列出的字符串引用
+static constexpr int32 GMaxListedReferences = 5;
+
+/**
+ * 分析用的模块信息
+ */
+struct FModuleLoadInfo
+{
+	// 在描述文件的 Modules 中列出；没有列出的模块不会自动加载
+	bool bListed = false;
+
+	bool bPrimaryGameModule = false;
+	bool bHasReflectedTypes = false;
+
+	// StartupModule 函数体的非空行数
+	int32 StartupLines = 0;
+	bool bHasShutdownCode = false;
+};
+
+static bool IsEditorType(const FString& Type)
+{
+	return Type.StartsWith(TEXT("Editor")) || Type == TEXT("UncookedOnly") || Type == TEXT("DeveloperTool");
+}
+
+static bool IsOnDemand(const FString& Phase)
+{
+	return Phase == GOnDemandPhase;
+}
+
+static int32 CountCodeLines(const FString& Body)
+{
+	TArray<FString> Lines;
+	Body.ParseIntoArrayLines(Lines, true);
+	return Lines.Num();
+}
+
+static void ReadModuleSources(const FString& ModuleDir, FModuleLoadInfo& OutInfo)
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *ModuleDir, TEXT("*.*"), true, false);
+
+	for (const FString& File : Files)
+	{
+		const FString Extension = FPaths::GetExtension(File);
+		const bool bHeader = Extension == TEXT("h") || Extension == TEXT("hpp");
+		if (!bHeader && Extension != TEXT("cpp"))
+		{
+			continue;
+		}
+
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *File))
+		{
+			continue;
+		}
+
+		if (bHeader && !OutInfo.bHasReflectedTypes)
+		{
+			TArray<TPair<FString, FString>> Types;
+			FindReflectedTypes(Text, Types);
+			OutInfo.bHasReflectedTypes = Types.Num() > 0;
+		}
+
+		OutInfo.bPrimaryGameModule |= Text.Contains(TEXT("IMPLEMENT_PRIMARY_GAME_MODULE"), ESearchCase::CaseSensitive);
+
+		if (Text.Contains(TEXT("StartupModule"), ESearchCase::CaseSensitive))
+		{
+			OutInfo.StartupLines += CountCodeLines(FindModuleFunctionBody(Text, TEXT("StartupModule")));
+		}
+		if (Text.Contains(TEXT("ShutdownModule"), ESearchCase::CaseSensitive))
+		{
+			OutInfo.bHasShutdownCode |= !FindModuleFunctionBody(Text, TEXT("ShutdownModule")).IsEmpty();
+		}
+	}
+}
+
+// 路径所属的图内模块（最长的模块目录前缀）
+static int32 FindOwnerModule(const TArray<FModuleNode>& Nodes, const FString& Path)
+{
+	int32 Best = INDEX_NONE;
+	int32 BestLen = 0;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FString& Dir = Nodes[Index].ModuleDir;
+		if (Dir.Len() > BestLen && Path.StartsWith(Dir + TEXT("/")))
+		{
+			Best = Index;
+			BestLen = Dir.Len();
+		}
+	}
+	return Best;
+}
+
+// 其他模块源码中按名字加载各模块的位置（LoadModule、GetModuleChecked 等调用的参数）
+static void FindNameReferences(const TArray<FModuleNode>& Nodes, TArray<TArray<FString>>& OutReferences)
+{
+	OutReferences.SetNum(Nodes.Num());
+
+	TArray<FString> Dirs;
+	TArray<FTextRewriteRule> Rules;
+	for (const FModuleNode& Node : Nodes)
+	{
+		Dirs.Add(Node.ModuleDir);
+		Rules.Add({ ETextRewriteKind::ModuleLoadArgument, Node.Name, FString(), ETextRewriteFiles::Code });
+	}
+
+	TArray<FString> Files;
+	CollectRewritableFiles(Dirs, Files);
+
+	TArray<FRuleMatchedFile> Hits;
+	FRewriteScanStats Stats;
+	MatchFiles(Files, Rules, Hits, Stats);
+
+	for (const FRuleMatchedFile& Hit : Hits)
+	{
+		const int32 Owner = FindOwnerModule(Nodes, Hit.Path);
+		for (const int32 Rule : Hit.Rules)
+		{
+			if (Rule != Owner)
+			{
+				OutReferences[Rule].Add(Hit.Path);
+			}
+		}
+	}
+}
+
+static double SumProjectMilliseconds(const FModuleLoadSession& Session, const TArray<FLoadingPhaseRecommendation>& Recommendations)
+{
+	double Total = 0.0;
+	for (const FLoadingPhaseRecommendation& Recommendation : Recommendations)
+	{
+		if (const FModuleLoadSample* Sample = Session.FindSample(Recommendation.ModuleName))
+		{
+			Total += Sample->Milliseconds;
+		}
+	}
+	return Total;
+}
+
+static FString DescribeMilliseconds(const FLoadingPhaseRecommendation& Recommendation)
+{
+	if (Recommendation.MeasuredMs < 0.0)
+	{
+		return TEXT("未记录");
+	}
+	return FString::Printf(TEXT("%s%.1f ms"), Recommendation.bUpperBound ? TEXT("≤") : TEXT(""), Recommendation.MeasuredMs);
+}
+
+} // namespace LoadingPhaseAdvisorPrivate
+
+FString GetLoadingPhaseBaselinePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("LoadingPhaseBaseline.bin"));
+}
+
+void AnalyzeLoadingPhases(const FModuleDependencyGraph& Graph, const FString& SessionPath, FLoadingPhaseAnalysis& OutAnalysis)
+{
+	using namespace LoadingPhaseAdvisorPrivate;
+
+	OutAnalysis = FLoadingPhaseAnalysis();
+	OutAnalysis.bHasSession = !SessionPath.IsEmpty() && FModuleLoadRecorder::LoadSession(SessionPath, OutAnalysis.Session);
+	OutAnalysis.bHasBaseline = FModuleLoadRecorder::LoadSession(GetLoadingPhaseBaselinePath(), OutAnalysis.Baseline);
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	TArray<FLoadingPhaseRecommendation> Recommendations;
+	Recommendations.SetNum(Nodes.Num());
+	TArray<FModuleLoadInfo> Infos;
+	Infos.SetNum(Nodes.Num());
+
+	// 1）描述文件条目：同一描述文件只读一次
+	TMap<FString, TArray<FString>> ListedByDescriptor;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		FLoadingPhaseRecommendation& Recommendation = Recommendations[Index];
+		Recommendation.ModuleName = Nodes[Index].Name;
+
+		FString Root;
+		if (!FindModuleContainer(Nodes[Index].ModuleDir, Root, Recommendation.DescriptorPath))
+		{
+			continue;
+		}
+
+		if (!ListedByDescriptor.Contains(Recommendation.DescriptorPath))
+		{
+			TArray<FString>& Listed = ListedByDescriptor.Add(Recommendation.DescriptorPath);
+			FString Text;
+			FDescriptorLayout Layout;
+			FString Error;
+			if (FFileHelper::LoadFileToString(Text, *Recommendation.DescriptorPath) && ScanDescriptorLayout(Text, Layout, Error))
+			{
+				for (const FDescriptorModuleSpan& Span : Layout.Modules)
+				{
+					Listed.Add(Span.Name);
+				}
+			}
+		}
+
+		Infos[Index].bListed = ListedByDescriptor[Recommendation.DescriptorPath].Contains(Recommendation.ModuleName);
+		ReadDescriptorModuleEntry(Recommendation.DescriptorPath, Recommendation.ModuleName, Recommendation.ModuleType, Recommendation.CurrentPhase);
+		Recommendation.SuggestedPhase = Recommendation.CurrentPhase;
+	}
+
+	// 2）源码：反射类型与 StartupModule 内容，按模块并行
+	ParallelFor(Nodes.Num(), [&Nodes, &Infos](int32 Index)
+	{
+		ReadModuleSources(Nodes[Index].ModuleDir, Infos[Index]);
+	});
+
+	TArray<TArray<FString>> NameReferences;
+	FindNameReferences(Nodes, NameReferences);
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		FLoadingPhaseRecommendation& Recommendation = Recommendations[Index];
+		for (const FString& Path : NameReferences[Index])
+		{
+			const int32 Owner = FindOwnerModule(Nodes, Path);
+			Recommendation.NameReferences.AddUnique(Owner != INDEX_NONE ? Nodes[Owner].Name : Path);
+		}
+
+		if (const FModuleLoadSample* Sample = OutAnalysis.bHasSession ? OutAnalysis.Session.FindSample(Recommendation.ModuleName) : nullptr)
+		{
+			Recommendation.MeasuredMs = Sample->Milliseconds;
+			Recommendation.bUpperBound = Sample->bUpperBound;
+		}
+	}
+
+	// 3）建议：依赖方按建议后的阶段计算，一个模块改为按需加载后它的依赖也可能跟着改，迭代到不再变化
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+
+		for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+		{
+			FLoadingPhaseRecommendation& Recommendation = Recommendations[Index];
+			const FModuleLoadInfo& Info = Infos[Index];
+			if (!Info.bListed || IsOnDemand(Recommendation.CurrentPhase))
+			{
+				continue;
+			}
+
+			// 启动时加载的依赖方及其中最早的阶段
+			Recommendation.BootDependents.Reset();
+			ELoadingPhase::Type EarliestDependent = ELoadingPhase::Max;
+			for (const int32 Dependent : Graph.GetDependents(Index))
+			{
+				const FLoadingPhaseRecommendation& Other = Recommendations[Dependent];
+				if (Infos[Dependent].bListed && !IsOnDemand(Other.SuggestedPhase))
+				{
+					Recommendation.BootDependents.Add(Other.ModuleName);
+					EarliestDependent = FMath::Min(EarliestDependent, ParseLoadingPhase(Other.SuggestedPhase));
+				}
+			}
+
+			const ELoadingPhase::Type Current = ParseLoadingPhase(Recommendation.CurrentPhase);
+			FString Suggested = Recommendation.CurrentPhase;
+			TArray<FString> Reasons;
+
+			if (Info.bPrimaryGameModule)
+			{
+				Reasons.Add(TEXT("游戏主模块，由引擎直接加载"));
+			}
+			else if (Info.bHasReflectedTypes)
+			{
+				Reasons.Add(TEXT("含 UCLASS / USTRUCT 等反射类型：资源或配置可能在启动期引用这些类型，保持不变"));
+			}
+			else if (Info.StartupLines == 0 && !Info.bHasShutdownCode)
+			{
+				if (Recommendation.BootDependents.Num() > 0)
+				{
+					Reasons.Add(FString::Printf(TEXT("StartupModule 为空，但被启动时加载的 %s 依赖，动态库随其映射，按需加载省不了时间"),
+						*FString::Join(Recommendation.BootDependents, TEXT(", "))));
+				}
+				else if (Recommendation.NameReferences.Num() == 0)
+				{
+					// 改成按需加载后没有代码会去加载它，不给出阶段建议
+					Reasons.Add(TEXT("StartupModule 为空、没有反射类型，启动时没有模块依赖它，也没有按名字加载它的代码：可能已经不再使用，"
+						"可以考虑合并或删除；阶段保持不变"));
+				}
+				else
+				{
+					Suggested = GOnDemandPhase;
+					Reasons.Add(TEXT("StartupModule 为空、没有反射类型，启动时也没有模块依赖它，由按名字加载的代码在使用时加载：改为按需加载，省去启动时映射动态库"));
+					if (!IsEditorType(Recommendation.ModuleType))
+					{
+						Reasons.Add(TEXT("运行时模块：打包后的游戏同样不再在启动时加载"));
+					}
+				}
+			}
+			else if (IsEditorType(Recommendation.ModuleType) && (Current == ELoadingPhase::Default || Current == ELoadingPhase::PostDefault))
+			{
+				if (EarliestDependent < ELoadingPhase::PostEngineInit)
+				{
+					Reasons.Add(FString::Printf(TEXT("有启动代码（%d 行），但被 %s 阶段加载的模块依赖，不能推迟"),
+						Info.StartupLines, ELoadingPhase::ToString(EarliestDependent)));
+				}
+				else
+				{
+					Suggested = GDeferredPhase;
+					Reasons.Add(FString::Printf(TEXT("编辑器模块有启动代码（%d 行）：推迟到引擎初始化完成之后，不再占用启动关键路径；请确认启动代码不依赖更早的阶段"),
+						Info.StartupLines));
+				}
+			}
+			else if (Info.StartupLines > 0 || Info.bHasShutdownCode)
+			{
+				Reasons.Add(IsEditorType(Recommendation.ModuleType)
+					? FString::Printf(TEXT("有启动代码，当前阶段 %s 是有意提前或已经足够晚，保持不变"), *Recommendation.CurrentPhase)
+					: TEXT("运行时模块有启动代码：推迟会改变游戏中的初始化顺序，保持不变"));
+			}
+
+			if (Suggested != Recommendation.SuggestedPhase)
+			{
+				Recommendation.SuggestedPhase = Suggested;
+				bChanged = true;
+			}
+			Recommendation.Reasons = MoveTemp(Reasons);
+		}
+	}
+
+	// 只报告会在启动时加载（或已是按需加载）的模块
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		if (Infos[Index].bListed)
+		{
+			OutAnalysis.Recommendations.Add(MoveTemp(Recommendations[Index]));
+		}
+	}
+
+	OutAnalysis.Recommendations.Sort([](const FLoadingPhaseRecommendation& A, const FLoadingPhaseRecommendation& B)
+	{
+		if (A.NeedsChange() != B.NeedsChange())
+		{
+			return A.NeedsChange();
+		}
+		return A.MeasuredMs > B.MeasuredMs;
+	});
+}
+
+bool ApplyLoadingPhases(const FLoadingPhaseAnalysis& Analysis, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors)
+{
+	TArray<FPendingTextEdit> Edits;
+	for (const FLoadingPhaseRecommendation& Recommendation : Analysis.Recommendations)
+	{
+		if (!Recommendation.NeedsChange())
+		{
+			continue;
+		}
+
+		FPendingTextEdit* Descriptor = FindOrLoadPendingEdit(Edits, Recommendation.DescriptorPath, false, OutErrors);
+		if (!Descriptor)
+		{
+			continue;
+		}
+
+		FString Patched;
+		FString Error;
+		if (!SetDescriptorModuleField(Descriptor->NewText, Recommendation.ModuleName, TEXT("LoadingPhase"), Recommendation.SuggestedPhase, Patched, Error))
+		{
+			OutErrors.Add(Recommendation.DescriptorPath + TEXT("：") + Error);
+			continue;
+		}
+		Descriptor->NewText = Patched;
+	}
+
+	OutDiff += MakePendingDiff(Edits);
+
+	if (!bDryRun && OutErrors.Num() == 0)
+	{
+		SavePendingEdits(Edits, OutErrors);
+
+		// 修改前的启动记录作为基线，下次启动后的报告与它对比
+		if (OutErrors.Num() == 0 && Analysis.bHasSession && Edits.Num() > 0)
+		{
+			const FString BaselinePath = GetLoadingPhaseBaselinePath();
+			if (!FModuleLoadRecorder::SaveSession(Analysis.Session, BaselinePath))
+			{
+				OutErrors.Add(TEXT("写入基线失败：") + BaselinePath);
+			}
+		}
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+FString FormatLoadingPhaseReport(const FLoadingPhaseAnalysis& Analysis)
+{
+	using namespace LoadingPhaseAdvisorPrivate;
+
+	const TArray<FLoadingPhaseRecommendation>& Recommendations = Analysis.Recommendations;
+
+	int32 OnDemandCount = 0;
+	int32 DeferredCount = 0;
+	double RemovedMs = 0.0;
+	double DeferredMs = 0.0;
+	double RuntimeRemovedMs = 0.0;
+	for (const FLoadingPhaseRecommendation& Recommendation : Recommendations)
+	{
+		if (!Recommendation.NeedsChange())
+		{
+			continue;
+		}
+
+		const double Ms = FMath::Max(0.0, Recommendation.MeasuredMs);
+		if (IsOnDemand(Recommendation.SuggestedPhase))
+		{
+			++OnDemandCount;
+			RemovedMs += Ms;
+			RuntimeRemovedMs += IsEditorType(Recommendation.ModuleType) ? 0.0 : Ms;
+		}
+		else
+		{
+			++DeferredCount;
+			DeferredMs += Ms;
+		}
+	}
+
+	FString Report = FString::Printf(TEXT("模块 %d 个；建议按需加载 %d 个，推迟到 PostEngineInit %d 个\n"), Recommendations.Num(), OnDemandCount, DeferredCount);
+
+	if (Analysis.bHasSession)
+	{
+		const double ProjectMs = SumProjectMilliseconds(Analysis.Session, Recommendations);
+		Report += FString::Printf(TEXT("上次启动（%s）：总耗时 %.2f 秒，工程 / 插件模块加载 %.1f ms\n"),
+			*Analysis.Session.Timestamp.ToString(), Analysis.Session.BootSeconds, ProjectMs);
+		Report += FString::Printf(TEXT("应用后预计：启动时不再加载 %.1f ms（其中运行时模块 %.1f ms，打包游戏同样受益），推迟到引擎初始化之后 %.1f ms；工程模块在启动关键路径上的加载 %.1f → %.1f ms\n"),
+			RemovedMs, RuntimeRemovedMs, DeferredMs, ProjectMs, FMath::Max(0.0, ProjectMs - RemovedMs - DeferredMs));
+	}
+	else
+	{
+		Report += TEXT("没有启动记录：重启编辑器一次后再分析可得到各模块的加载耗时，当前只按源码给出建议\n");
+	}
+
+	if (Analysis.bHasBaseline && Analysis.bHasSession && Analysis.Session.Timestamp > Analysis.Baseline.Timestamp)
+	{
+		const double BeforeMs = SumProjectMilliseconds(Analysis.Baseline, Recommendations);
+		const double AfterMs = SumProjectMilliseconds(Analysis.Session, Recommendations);
+		Report += FString::Printf(TEXT("与上次应用前（%s）对比：总耗时 %.2f → %.2f 秒，工程 / 插件模块加载 %.1f → %.1f ms\n"),
+			*Analysis.Baseline.Timestamp.ToString(), Analysis.Baseline.BootSeconds, Analysis.Session.BootSeconds, BeforeMs, AfterMs);
+	}
+	Report += TEXT("\n");
+
+	for (const FLoadingPhaseRecommendation& Recommendation : Recommendations)
+	{
+		const FString Phase = Recommendation.NeedsChange()
+			? Recommendation.CurrentPhase + TEXT(" -> ") + Recommendation.SuggestedPhase
+			: Recommendation.CurrentPhase;
+
+		Report += FString::Printf(TEXT("%s %s（%s，%s）%s\n"),
+			Recommendation.NeedsChange() ? TEXT("*") : TEXT(" "),
+			*Recommendation.ModuleName, *Recommendation.ModuleType, *DescribeMilliseconds(Recommendation), *Phase);
+
+		for (const FString& Reason : Recommendation.Reasons)
+		{
+			Report += TEXT("    - ") + Reason + TEXT("\n");
+		}
+
+		if (Recommendation.NameReferences.Num() > 0)
+		{
+			TArray<FString> Listed(Recommendation.NameReferences.GetData(), FMath::Min(Recommendation.NameReferences.Num(), GMaxListedReferences));
+			Report += FString::Printf(TEXT("    - 按名字引用它的模块：%s%s\n"), *FString::Join(Listed, TEXT(", ")),
+				Recommendation.NameReferences.Num() > GMaxListedReferences ? TEXT(" ……") : TEXT(""));
+		}
+	}
+
+	return Report;
+}
+
+FText GetLoadingPhaseGuidance(const FString& Phase, const FString& ModuleType)
+{
+	using namespace LoadingPhaseAdvisorPrivate;
+
+	if (Phase == TEXT("PostEngineInit"))
+	{
+		return LOCTEXT("GuidancePostEngineInit", "引擎初始化完成后加载，不占用启动关键路径。只注册菜单、细节面板、资源动作等编辑器扩展的模块推荐使用。");
+	}
+	if (Phase == TEXT("PreDefault"))
+	{
+		return LOCTEXT("GuidancePreDefault", "早于 Default 加载。只有其他模块在自己的 StartupModule 中就要用到它时才需要，否则会拖长启动。");
+	}
+	if (Phase == TEXT("PostDefault"))
+	{
+		return LOCTEXT("GuidancePostDefault", "在所有 Default 模块之后加载，可以使用它们注册的内容；仍在引擎初始化完成之前。");
+	}
+	if (Phase == GOnDemandPhase)
+	{
+		return IsEditorType(ModuleType)
+			? LOCTEXT("GuidanceNoneEditor", "启动时不加载，首次被依赖或 LoadModule 时才加载。适合没有启动代码、只被按需调用的模块；含 UCLASS 等反射类型的模块不要选择。")
+			: LOCTEXT("GuidanceNoneRuntime", "启动时不加载，首次被依赖或 LoadModule 时才加载；打包后的游戏同样如此。含 UCLASS 等反射类型的模块不要选择。");
+	}
+	return IsEditorType(ModuleType)
+		? LOCTEXT("GuidanceDefaultEditor", "引擎初始化期间加载，大多数模块的默认选择。编辑器模块若只注册 UI 扩展，可改用 PostEngineInit 缩短启动。")
+		: LOCTEXT("GuidanceDefault", "引擎初始化期间加载，大多数模块的默认选择。");
+}
+
+} // namespace ModuleBuilder
+
+#undef LOCTEXT_NAMESPACE
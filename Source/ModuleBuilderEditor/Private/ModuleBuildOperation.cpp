@@ -0,0 +1,134 @@
+#include "ModuleBuildOperation.h"
+#include "ModuleBuilderEditor.h"
+#include "ModuleStaging.h"
+#include "ModuleTemplate.h"
+
+#include "Async/Async.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+
+// 同一描述文件可能被多个窗口同时修改，串行化读-改-写
+static FCriticalSection GModuleDescriptorLock;
+
+TSharedRef<FModuleBuildOperation, ESPMode::ThreadSafe> FModuleBuildOperation::Launch(const FNewModuleParams& Params, const FTargetResolveResult& Target,
+	const TSharedPtr<FModuleOperationTiming, ESPMode::ThreadSafe>& Timing)
+{
+	TSharedRef<FModuleBuildOperation, ESPMode::ThreadSafe> Operation = MakeShared<FModuleBuildOperation, ESPMode::ThreadSafe>(Params, Target,
+		Timing.IsValid() ? Timing.ToSharedRef() : FModuleOperationTiming::Create(TEXT("AddModule ") + Params.ModuleName));
+	Operation->bRunning.store(true);
+
+	// 插件列表只能在游戏线程读取；只有自定义的 PCH 头文件需要查找所属模块时才收集
+	if (ModuleBuilder::GetUnknownPCHHeaders(Params).Num() > 0)
+	{
+		Operation->PCHSearchRoots = FModuleDependencyGraph::GetProjectSourceRoots();
+		Operation->PCHSearchRoots.Append(FExternalModuleIndex::GetEngineSourceRoots());
+	}
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Operation]()
+	{
+		Operation->Run();
+	});
+
+	return Operation;
+}
+
+FModuleBuildOperation::FModuleBuildOperation(const FNewModuleParams& InParams, const FTargetResolveResult& InTarget, const TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe>& InTiming)
+	: Params(InParams)
+	, Target(InTarget)
+	, Timing(InTiming)
+{
+}
+
+FText FModuleBuildOperation::GetStatusText() const
+{
+	FScopeLock Lock(&StatusLock);
+	return FText::FromString(Status);
+}
+
+void FModuleBuildOperation::SetStage(float InProgress, const FString& InStatus)
+{
+	Progress.store(InProgress);
+
+	FScopeLock Lock(&StatusLock);
+	Status = InStatus;
+}
+
+void FModuleBuildOperation::Run()
+{
+	FModuleOperationTimingScope TimingScope(Timing);
+
+	SetStage(0.05f, TEXT("生成模块文件内容…"));
+
+	FModuleTemplateLibrary::Get().Refresh();
+
+	if (PCHSearchRoots.Num() > 0)
+	{
+		FExternalModuleIndex Index;
+		Index.Build(PCHSearchRoots);
+		ModuleBuilder::ResolvePCHHeaderOwners(Params, Index);
+	}
+
+	TArray<FGeneratedModuleFile> Files;
+	ModuleBuilder::RenderModuleFiles(Target.ContainerRoot, Params, Files);
+
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+	ModuleBuilder::GetModuleDependencies(Params, PublicDependencies, PrivateDependencies);
+	UE_LOG(LogModuleBuilder, Log, TEXT("%s：公开依赖 %s，私有依赖 %s"),
+		*Params.ModuleName, *FString::Join(PublicDependencies, TEXT(", ")), *FString::Join(PrivateDependencies, TEXT(", ")));
+
+	SetStage(0.2f, TEXT("检查目标文件…"));
+
+	// 先全部暂存在内存中，写盘前不碰磁盘
+	FModuleStagingArea Staging;
+	FString Error;
+	if (!ModuleBuilder::StageModuleFiles(Staging, Files, Error))
+	{
+		Finish(false, TEXT("生成模块文件失败：\n") + Error);
+		return;
+	}
+
+	// 写盘之后就不再响应取消
+	if (IsCancelRequested())
+	{
+		Finish(false, TEXT("已取消。"));
+		return;
+	}
+
+	SetStage(0.5f, TEXT("写入模块文件与描述文件…"));
+
+	{
+		FScopeLock Lock(&GModuleDescriptorLock);
+		MODULEBUILDER_SCOPE("Descriptor.Locked");
+
+		if (!ModuleBuilder::StageModulesInDescriptor(Staging, Target.DescriptorPath, { Params }, Error))
+		{
+			Finish(false, TEXT("更新描述文件失败：\n") + Error);
+			return;
+		}
+
+		// 模块文件与描述文件一起写盘，任一失败都会恢复原状
+		FStagingFlushResult Flush;
+		if (!Staging.Flush(Flush, Error))
+		{
+			Finish(false, TEXT("写入失败，未留下任何文件：\n") + Error);
+			return;
+		}
+		bInvalidatedMakefile.store(Flush.WrittenFiles.Contains(FPaths::ConvertRelativePathToFull(Target.DescriptorPath)));
+	}
+
+	SetStage(1.f, TEXT("完成"));
+	Finish(true, FString());
+}
+
+void FModuleBuildOperation::Finish(bool bSuccess, const FString& Message)
+{
+	Timing->Finish(bSuccess);
+
+	AsyncTask(ENamedThreads::GameThread, [Self = AsShared(), bSuccess, Message]()
+	{
+		Self->bRunning.store(false);
+		Self->CompletedEvent.Broadcast(bSuccess, Message);
+	});
+}
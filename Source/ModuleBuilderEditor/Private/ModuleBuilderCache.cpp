@@ -0,0 +1,34 @@
+#include "ModuleBuilderCache.h"
+
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+
+FString FormatBytes(int64 Bytes)
+{
+	return Bytes >= 1024 * 1024
+		? FString::Printf(TEXT("%.1f MB"), Bytes / (1024.0 * 1024.0))
+		: FString::Printf(TEXT("%.1f KB"), Bytes / 1024.0);
+}
+
+FString ToCachePath(const FString& ProjectDir, const FString& Path)
+{
+	return Path.StartsWith(ProjectDir) ? Path.RightChop(ProjectDir.Len()) : Path;
+}
+
+FString FromCachePath(const FString& ProjectDir, const FString& Path)
+{
+	return FPaths::IsRelative(Path) ? ProjectDir + Path : Path;
+}
+
+int32 FCacheStringTable::Add(const FString& String)
+{
+	if (const int32* Id = Ids.Find(String))
+	{
+		return *Id;
+	}
+	return Ids.Add(String, Strings.Add(String));
+}
+
+} // namespace ModuleBuilder
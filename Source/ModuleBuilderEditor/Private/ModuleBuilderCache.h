@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleBuilderEditor.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * 各索引写在 Intermediate/ModuleBuilder 下的缓存共用的读写与格式化
+ *
+ * 文件依次为 Magic、Version、字符串表与条目数组；格式不符时按没有缓存处理。
+ * 工程内的路径相对工程目录保存，同一字符串只存一次，条目中保存字符串表下标。
+ */
+namespace ModuleBuilder
+{
+	FString FormatBytes(int64 Bytes);
+
+	FString ToCachePath(const FString& ProjectDir, const FString& Path);
+	FString FromCachePath(const FString& ProjectDir, const FString& Path);
+
+	// 写缓存时的字符串表
+	class FCacheStringTable
+	{
+	public:
+		int32 Add(const FString& String);
+
+		TArray<FString> Strings;
+
+	private:
+		TMap<FString, int32> Ids;
+	};
+
+	template <typename EntryType>
+	bool LoadIndexCache(const FString& CachePath, uint32 Magic, int32 Version, TArray<FString>& OutStrings, TArray<EntryType>& OutEntries)
+	{
+		TArray<uint8> Bytes;
+		if (CachePath.IsEmpty() || !FFileHelper::LoadFileToArray(Bytes, *CachePath, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(Bytes);
+
+		uint32 FileMagic = 0;
+		int32 FileVersion = 0;
+		Reader << FileMagic;
+		Reader << FileVersion;
+		if (FileMagic != Magic || FileVersion != Version)
+		{
+			return false;
+		}
+
+		Reader << OutStrings;
+		Reader << OutEntries;
+		if (Reader.IsError())
+		{
+			OutStrings.Reset();
+			OutEntries.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	// 返回写入的字节数；失败时记录警告，What 为缓存的名称
+	template <typename EntryType>
+	int64 SaveIndexCache(const FString& CachePath, uint32 Magic, int32 Version, FCacheStringTable& Strings, TArray<EntryType>& Entries, const TCHAR* What)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+
+		Writer << Magic;
+		Writer << Version;
+		Writer << Strings.Strings;
+		Writer << Entries;
+
+		if (!FFileHelper::SaveArrayToFile(Bytes, *CachePath))
+		{
+			UE_LOG(LogModuleBuilder, Warning, TEXT("写入%s缓存失败：%s"), What, *CachePath);
+		}
+		return Bytes.Num();
+	}
+}
@@ -0,0 +1,579 @@
+#include "ModuleBuilderCommandlet.h"
+#include "ModuleBuilderEditor.h"
+#include "CompileTimeIndex.h"
+#include "DependencyDemotion.h"
+#include "IncludeGraphIndex.h"
+#include "LoadingPhaseAdvisor.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "ModuleLoadRecorder.h"
+#include "ModuleNameIndex.h"
+#include "ModuleMerger.h"
+#include "ModuleRefactor.h"
+#include "ModuleTemplate.h"
+#include "ModuleSplitter.h"
+#include "PCHAdvisor.h"
+#include "PluginDescriptorScanner.h"
+#include "StartupProfiler.h"
+#include "UnityBuildAdvisor.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UModuleBuilderCommandlet::UModuleBuilderCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UModuleBuilderCommandlet::Main(const FString& Params)
+{
+	FString ManifestPath;
+	if (FParse::Value(*Params, TEXT("Manifest="), ManifestPath))
+	{
+		return RunManifest(ManifestPath, FParse::Param(*Params, TEXT("DryRun")));
+	}
+
+	if (FParse::Param(*Params, TEXT("Graph")))
+	{
+		FString OutPath;
+		FParse::Value(*Params, TEXT("Out="), OutPath);
+		return RunGraph(OutPath);
+	}
+
+	if (FParse::Param(*Params, TEXT("Demote")))
+	{
+		return RunDemote(FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("SuggestPCH")))
+	{
+		FString ModuleName;
+		FParse::Value(*Params, TEXT("Module="), ModuleName);
+		return RunSuggestPCH(ModuleName);
+	}
+
+	if (FParse::Param(*Params, TEXT("Includes")))
+	{
+		FString ModuleName;
+		FParse::Value(*Params, TEXT("Module="), ModuleName);
+		return RunIncludes(ModuleName);
+	}
+
+	if (FParse::Param(*Params, TEXT("Unity")))
+	{
+		return RunUnity(FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("Split")))
+	{
+		FString ModuleName;
+		FParse::Value(*Params, TEXT("Module="), ModuleName);
+		int32 MaxClusters = FModuleSplitOptions().MaxClusters;
+		FParse::Value(*Params, TEXT("Clusters="), MaxClusters);
+		return RunSplit(ModuleName, MaxClusters, FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("Merge")))
+	{
+		FString TargetModule;
+		FString ModuleList;
+		FParse::Value(*Params, TEXT("Into="), TargetModule);
+		FParse::Value(*Params, TEXT("Modules="), ModuleList, false);
+
+		TArray<FString> SourceModules;
+		ModuleList.ParseIntoArray(SourceModules, TEXT(","));
+		for (FString& Name : SourceModules)
+		{
+			Name.TrimStartAndEndInline();
+		}
+		return RunMerge(TargetModule, SourceModules, FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("Rename")))
+	{
+		FString OldName;
+		FString NewName;
+		FParse::Value(*Params, TEXT("Module="), OldName);
+		FParse::Value(*Params, TEXT("NewName="), NewName);
+		return RunRename(OldName, NewName, FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("MoveFiles")))
+	{
+		FModuleFileMoveRequest Request;
+		FString FileList;
+		FParse::Value(*Params, TEXT("From="), Request.FromModule);
+		FParse::Value(*Params, TEXT("To="), Request.ToModule);
+		FParse::Value(*Params, TEXT("Files="), FileList, false);
+		FParse::Value(*Params, TEXT("Folder="), Request.DestinationFolder);
+
+		FileList.ParseIntoArray(Request.Files, TEXT(","));
+		for (FString& File : Request.Files)
+		{
+			File.TrimStartAndEndInline();
+		}
+		return RunMoveFiles(Request, FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("LoadingPhases")))
+	{
+		return RunLoadingPhases(FParse::Param(*Params, TEXT("Apply")));
+	}
+
+	if (FParse::Param(*Params, TEXT("CompileTimes")))
+	{
+		FString ModuleName;
+		FParse::Value(*Params, TEXT("Module="), ModuleName);
+		return RunCompileTimes(ModuleName);
+	}
+
+	if (FParse::Param(*Params, TEXT("StartupProfile")))
+	{
+		FString ModuleName;
+		FParse::Value(*Params, TEXT("Module="), ModuleName);
+		return RunStartupProfile(ModuleName);
+	}
+
+	if (FParse::Param(*Params, TEXT("ExportTemplates")))
+	{
+		return RunExportTemplates();
+	}
+
+	UE_LOG(LogModuleBuilder, Error, TEXT("用法：-run=ModuleBuilder -Manifest=<清单.json> [-DryRun] | -Graph [-Out=<报告.txt>] | -Demote [-Apply] | -SuggestPCH [-Module=<模块名>] | -Includes [-Module=<模块名>] | -Unity [-Apply] | -Split -Module=<模块名> [-Clusters=<N>] [-Apply] | -Merge -Into=<目标模块> -Modules=<模块1,模块2> [-Apply] | -Rename -Module=<旧名> -NewName=<新名> [-Apply] | -MoveFiles -From=<模块A> -To=<模块B> -Files=<文件1,文件2> [-Folder=<目标目录>] [-Apply] | -LoadingPhases [-Apply] | -CompileTimes [-Module=<模块名>] | -StartupProfile [-Module=<模块名>] | -ExportTemplates"));
+	return 1;
+}
+
+int32 UModuleBuilderCommandlet::RunManifest(const FString& InManifestPath, bool bDryRun)
+{
+	const FString ManifestPath = FPaths::ConvertRelativePathToFull(InManifestPath);
+
+	TArray<FNewModuleParams> Modules;
+	FString Error;
+	if (!ModuleBuilder::LoadModuleManifest(ManifestPath, Modules, Error))
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("清单 %s：共 %d 个模块"), *ManifestPath, Modules.Num());
+
+	// 清单里可能指向未启用的插件
+	FPluginDescriptorScanner::Get().ScanBlocking();
+	FModuleNameIndex::Get().BuildBlocking();
+
+	FModuleBatchResult Result;
+	ModuleBuilder::GenerateModuleBatch(Modules, Result, bDryRun);
+
+	if (bDryRun)
+	{
+		TArray<FString> Lines;
+		Result.Diff.ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+		}
+	}
+
+	for (const FString& Name : Result.SucceededModules)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s：%s"), bDryRun ? TEXT("将生成") : TEXT("已生成"), *Name);
+	}
+	for (const FString& Message : Result.Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Message);
+	}
+
+	for (const FString& DescriptorPath : Result.MakefileInvalidations)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("描述文件已更新，下次编译 UBT 会重新生成 makefile：%s"), *DescriptorPath);
+	}
+
+	if (bDryRun)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("预览模式，未写盘：可生成 %d，失败 %d；去掉 -DryRun 后一次性写盘"),
+			Result.SucceededModules.Num(), Modules.Num() - Result.SucceededModules.Num());
+		return Result.Errors.Num() == 0 ? 0 : 1;
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("完成：成功 %d，失败 %d，写回描述文件 %d 个；一次性写入 %d 个文件，用时 %.3f 秒"),
+		Result.SucceededModules.Num(), Modules.Num() - Result.SucceededModules.Num(), Result.DescriptorsWritten, Result.FilesWritten, Result.FlushSeconds);
+
+	return Result.Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunGraph(const FString& OutPath)
+{
+	// 未启用的插件也参与分析
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	const FString Report = Graph.BuildReport();
+
+	if (OutPath.IsEmpty())
+	{
+		TArray<FString> Lines;
+		Report.ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+		}
+	}
+	else
+	{
+		const FString FullPath = FPaths::ConvertRelativePathToFull(OutPath);
+		if (!FFileHelper::SaveStringToFile(Report, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8))
+		{
+			UE_LOG(LogModuleBuilder, Error, TEXT("写入报告失败：%s"), *FullPath);
+			return 1;
+		}
+		UE_LOG(LogModuleBuilder, Display, TEXT("依赖分析报告已写入：%s"), *FullPath);
+	}
+
+	// 存在依赖环时返回非零，便于 CI 拦截
+	return Graph.FindCycles().Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunDemote(bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	FExternalModuleIndex External;
+	External.Build(FExternalModuleIndex::GetEngineSourceRoots());
+
+	FDemotionAnalysis Analysis;
+	ModuleBuilder::AnalyzeDependencyDemotions(Graph, External, Analysis);
+
+	FString Diff;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyDependencyDemotions(Analysis.Demotions, !bApply, Diff, Errors);
+
+	TArray<FString> Lines;
+	(ModuleBuilder::FormatDemotionReport(Analysis) + TEXT("\n") + Diff).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Error : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已改写 Build.cs。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunSuggestPCH(const FString& ModuleName)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	FExternalModuleIndex External;
+	External.Build(FExternalModuleIndex::GetEngineSourceRoots());
+
+	TArray<FString> Lines;
+	ModuleBuilder::BuildPCHReport(Graph, External, ModuleName).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+
+	return ModuleName.IsEmpty() || Graph.FindNode(ModuleName) != INDEX_NONE ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunIncludes(const FString& ModuleName)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	FIncludeGraphIndex Index;
+	FIncludeIndexStats Stats;
+	Index.Build(Graph, FIncludeGraphIndex::GetCachePath(), Stats);
+
+	TArray<FString> Lines;
+	Index.BuildReport(Graph, Stats, ModuleName).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+
+	return ModuleName.IsEmpty() || Graph.FindNode(ModuleName) != INDEX_NONE ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunUnity(bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	TArray<FUnityRecommendation> Recommendations;
+	ModuleBuilder::AnalyzeUnitySettings(Graph, Recommendations);
+
+	FString Diff;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyUnityRecommendations(Recommendations, !bApply, Diff, Errors);
+
+	TArray<FString> Lines;
+	(ModuleBuilder::FormatUnityReport(Recommendations) + TEXT("\n") + Diff).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Error : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已改写 Build.cs。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunSplit(const FString& ModuleName, int32 MaxClusters, bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	TArray<FString> Lines;
+	if (ModuleName.IsEmpty())
+	{
+		ModuleBuilder::FormatSplitCandidates(Graph).ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+		}
+		return 1;
+	}
+
+	FExternalModuleIndex External;
+	External.Build(FExternalModuleIndex::GetEngineSourceRoots());
+
+	FModuleSplitOptions Options;
+	Options.MaxClusters = MaxClusters;
+
+	FModuleSplitPlan Plan;
+	FString Error;
+	if (!ModuleBuilder::PlanModuleSplit(Graph, External, ModuleName, Options, Plan, Error))
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	FString Log;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyModuleSplit(Plan, !bApply, Log, Errors);
+
+	(ModuleBuilder::FormatSplitPlan(Plan) + TEXT("\n") + Log).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Message : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Message);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已拆分；重新生成项目文件后编译。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunMerge(const FString& TargetModule, const TArray<FString>& SourceModules, bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	TArray<FString> Lines;
+	if (TargetModule.IsEmpty() || SourceModules.Num() == 0)
+	{
+		ModuleBuilder::FormatMergeCandidates(Graph).ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+		}
+		return 1;
+	}
+
+	FModuleMergePlan Plan;
+	FString Error;
+	if (!ModuleBuilder::PlanModuleMerge(Graph, TargetModule, SourceModules, FModuleMergeOptions(), Plan, Error))
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	FString Log;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyModuleMerge(Plan, !bApply, Log, Errors);
+
+	(ModuleBuilder::FormatMergePlan(Plan) + TEXT("\n") + Log).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Message : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Message);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已合并；重新生成项目文件后编译。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunRename(const FString& OldName, const FString& NewName, bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	const TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+	FModuleDependencyGraph Graph;
+	Graph.Build(Roots);
+
+	FModuleRefactorPlan Plan;
+	FString Error;
+	if (!ModuleBuilder::PlanModuleRename(Graph, Roots, OldName, NewName, Plan, Error))
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+	return ApplyRefactor(Plan, bApply);
+}
+
+int32 UModuleBuilderCommandlet::RunMoveFiles(const FModuleFileMoveRequest& Request, bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	const TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+	FModuleDependencyGraph Graph;
+	Graph.Build(Roots);
+
+	FModuleRefactorPlan Plan;
+	FString Error;
+	if (Request.Files.Num() == 0 || !ModuleBuilder::PlanModuleFileMove(Graph, Roots, Request, Plan, Error))
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), Error.IsEmpty() ? TEXT("请用 -Files= 指定要移动的文件") : *Error);
+		return 1;
+	}
+	return ApplyRefactor(Plan, bApply);
+}
+
+int32 UModuleBuilderCommandlet::ApplyRefactor(const FModuleRefactorPlan& Plan, bool bApply)
+{
+	FString Log;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyModuleRefactor(Plan, !bApply, Log, Errors);
+
+	TArray<FString> Lines;
+	(ModuleBuilder::FormatRefactorPlan(Plan) + TEXT("\n") + Log).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Message : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Message);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已改写；重新生成项目文件后编译。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunLoadingPhases(bool bApply)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	// 使用编辑器上次启动时写下的记录
+	FLoadingPhaseAnalysis Analysis;
+	ModuleBuilder::AnalyzeLoadingPhases(Graph, FModuleLoadRecorder::GetSessionPath(), Analysis);
+
+	FString Diff;
+	TArray<FString> Errors;
+	ModuleBuilder::ApplyLoadingPhases(Analysis, !bApply, Diff, Errors);
+
+	TArray<FString> Lines;
+	(ModuleBuilder::FormatLoadingPhaseReport(Analysis) + TEXT("\n") + Diff).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+	for (const FString& Error : Errors)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+	}
+
+	UE_LOG(LogModuleBuilder, Display, TEXT("%s"), bApply ? TEXT("已改写描述文件；重启编辑器后生效。") : TEXT("预览模式，未写盘；加 -Apply 应用。"));
+	return Errors.Num() == 0 ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunCompileTimes(const FString& ModuleName)
+{
+	FPluginDescriptorScanner::Get().ScanBlocking();
+
+	FModuleDependencyGraph Graph;
+	Graph.Build(FModuleDependencyGraph::GetProjectSourceRoots());
+
+	FCompileTimeIndex Index;
+	FCompileTimeStats Stats;
+	Index.Build(Graph, FCompileTimeIndex::GetCachePath(), Stats);
+
+	TArray<FString> Lines;
+	Index.BuildReport(Graph, Stats, ModuleName).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+
+	return ModuleName.IsEmpty() || Graph.FindNode(ModuleName) != INDEX_NONE ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunStartupProfile(const FString& ModuleName)
+{
+	// 记录来自上次编辑器启动，Commandlet 自身不记录
+	FStartupProfile Profile;
+	ModuleBuilder::AnalyzeStartupProfile(FModuleLoadRecorder::GetHistoryPath(), ModuleBuilder::GetProjectAndPluginModules(), Profile);
+
+	TArray<FString> Lines;
+	ModuleBuilder::FormatStartupProfileReport(Profile, ModuleName).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("%s"), *Line);
+	}
+
+	return Profile.GetLatest() ? 0 : 1;
+}
+
+int32 UModuleBuilderCommandlet::RunExportTemplates()
+{
+	TArray<FString> Written;
+	FString Error;
+	const bool bSuccess = FModuleTemplateLibrary::Get().ExportBuiltInTemplates(Written, Error);
+
+	for (const FString& Path : Written)
+	{
+		UE_LOG(LogModuleBuilder, Display, TEXT("已导出：%s"), *Path);
+	}
+	UE_LOG(LogModuleBuilder, Display, TEXT("模板目录 %s：导出 %d 个，已有的文件未覆盖"), *FModuleTemplateLibrary::GetTemplateDir(), Written.Num());
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+	return 0;
+}
@@ -1,344 +1,895 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ModuleBuilderEditor.h"
+#include "CompileTimeIndex.h"
+#include "DependencyDemotion.h"
+#include "IncludeGraphIndex.h"
+#include "LoadingPhaseAdvisor.h"
+#include "ModuleBuildOperation.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleCompileOperation.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "ModuleLoadRecorder.h"
+#include "ModuleMerger.h"
+#include "ModuleNameIndex.h"
+#include "ModuleRefactor.h"
+#include "ModuleSplitter.h"
+#include "PCHAdvisor.h"
+#include "PluginDescriptorScanner.h"
+#include "ProjectPluginIndex.h"
 #include "SAddModuleWindow.h"
+#include "SModuleReportWindow.h"
+#include "StartupProfiler.h"
+#include "UnityBuildAdvisor.h"
 
 #include "Framework/Application/SlateApplication.h"
-#include "HAL/FileManager.h"
-#include "Interfaces/IPluginManager.h"
-#include "Misc/FileHelper.h"
+#include "Framework/Docking/TabManager.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Misc/App.h"
 #include "Misc/Paths.h"
 #include "Misc/MessageDialog.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
 #include "ToolMenus.h"
 #include "Widgets/Layout/SBox.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "Widgets/SWindow.h"
 
 #define LOCTEXT_NAMESPACE "ModuleBuilder"
 
-struct FTargetResolveResult
-{
-	FString ContainerRoot;   // ProjectRoot 或 PluginRoot
-	FString DescriptorPath;  // .uproject 或 .uplugin
-	bool bIsProject = true;
-};
+DEFINE_LOG_CATEGORY(LogModuleBuilder);
+
+// ===== 模块实现 =====
 
-static bool ResolveTargetFromParams(const FNewModuleParams& Params, FTargetResolveResult& Out, FString& OutError)
+void FModuleBuilderEditorModule::StartupModule()
 {
-	if (Params.TargetType == EModuleTargetType::Project)
+	FProjectPluginIndex::Get().Initialize();
+	FModuleNameIndex::Get().Initialize();
+
+	// Commandlet 自行同步扫描
+	if (!IsRunningCommandlet())
 	{
-		Out.bIsProject = true;
-		Out.ContainerRoot = FPaths::ProjectDir();
-		Out.DescriptorPath = FPaths::GetProjectFilePath();
-		return true;
+		FPluginDescriptorScanner::Get().StartScan();
+		FModuleNameIndex::Get().StartBuild();
 	}
 
-	if (Params.TargetType == EModuleTargetType::ProjectPlugin)
-	{
-		TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(Params.TargetPluginName);
-		if (!Plugin.IsValid())
-		{
-			OutError = TEXT("未找到目标插件：") + Params.TargetPluginName;
-			return false;
-		}
+	UToolMenus::RegisterStartupCallback(
+		FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FModuleBuilderEditorModule::RegisterMenus)
+	);
+}
 
-		Out.bIsProject = false;
-		Out.ContainerRoot = Plugin->GetBaseDir();
-		Out.DescriptorPath = Plugin->GetDescriptorFileName();
-		return true;
-	}
+void FModuleBuilderEditorModule::ShutdownModule()
+{
+	UToolMenus::UnRegisterStartupCallback(this);
+	UToolMenus::UnregisterOwner(this);
+
+	// 析构时结束仍在运行的 UBT
+	ActiveCompiles.Reset();
 
-	OutError = TEXT("未知的目标类型。");
-	return false;
+	FModuleNameIndex::Get().Shutdown();
+	FProjectPluginIndex::Get().Shutdown();
 }
 
-static FString MakeBuildCsText(const FString& ModuleName, bool bIsEditorModule)
+void FModuleBuilderEditorModule::RegisterMenus()
 {
-	FString Text;
-	Text += TEXT("using UnrealBuildTool;\n\n");
-	Text += FString::Printf(TEXT("public class %s : ModuleRules\n{\n"), *ModuleName);
-	Text += FString::Printf(TEXT("\tpublic %s(ReadOnlyTargetRules Target) : base(Target)\n\t{\n"), *ModuleName);
-	Text += TEXT("\t\tPCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;\n\n");
-
-	Text += TEXT("\t\tPublicDependencyModuleNames.AddRange(new string[]\n\t\t{\n");
-	Text += TEXT("\t\t\t\"Core\",\n");
-	Text += TEXT("\t\t\t\"CoreUObject\",\n");
-	Text += TEXT("\t\t\t\"Engine\"\n");
-	Text += TEXT("\t\t});\n\n");
-
-	if (bIsEditorModule)
+	UToolMenus* Menus = UToolMenus::Get();
+	if (!Menus) return;
+
+	if (UToolMenu* ToolsMenu = Menus->ExtendMenu("LevelEditor.MainMenu.Tools"))
 	{
-		Text += TEXT("\t\tPrivateDependencyModuleNames.AddRange(new string[]\n\t\t{\n");
-		Text += TEXT("\t\t\t\"UnrealEd\",\n");
-		Text += TEXT("\t\t\t\"Slate\",\n");
-		Text += TEXT("\t\t\t\"SlateCore\",\n");
-		Text += TEXT("\t\t\t\"ToolMenus\"\n");
-		Text += TEXT("\t\t});\n\n");
+		FToolMenuSection& Section = ToolsMenu->FindOrAddSection("ModuleBuilder");
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.AddModule",
+			LOCTEXT("AddModuleMenu", "添加 C++ 模块"),
+			LOCTEXT("AddModuleTooltip", "创建并注册一个新的 C++ 模块"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Plus"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickAddModule))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.DependencyGraph",
+			LOCTEXT("DependencyGraphMenu", "模块依赖分析"),
+			LOCTEXT("DependencyGraphTooltip", "分析工程与插件模块的依赖环、Public 依赖扇出与编译关键路径"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Search"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickDependencyGraph))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.DemoteDependencies",
+			LOCTEXT("DemoteDependenciesMenu", "依赖降级（Public → Private）"),
+			LOCTEXT("DemoteDependenciesTooltip", "找出公开头文件没有用到的 Public 依赖，预览并改写 Build.cs"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Filter"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickDemoteDependencies))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.SuggestPCH",
+			LOCTEXT("SuggestPCHMenu", "预编译头建议"),
+			LOCTEXT("SuggestPCHTooltip", "按各模块 .cpp 的实际包含频率建议 PCH 内容，并估算可省的头文件解析量"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Info"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickSuggestPCH))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.IncludeIndex",
+			LOCTEXT("IncludeIndexMenu", "头文件包含分析"),
+			LOCTEXT("IncludeIndexTooltip", "增量索引工程与插件的全部 #include，统计每个头文件与模块的传递包含开销"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Search"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickIncludeIndex))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.UnitySettings",
+			LOCTEXT("UnitySettingsMenu", "Unity Build 设置建议"),
+			LOCTEXT("UnitySettingsTooltip", "按源文件数量与行数建议各模块的 unity / PCH 阈值，并可批量写回 Build.cs"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Settings"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickUnitySettings))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.SplitModule",
+			LOCTEXT("SplitModuleMenu", "模块拆分"),
+			LOCTEXT("SplitModuleTooltip", "按模块内的 #include 关系把大模块拆成若干内聚的小模块，并估算头文件改动的重编范围"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Duplicate"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickSplitModule))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.MergeModules",
+			LOCTEXT("MergeModulesMenu", "模块合并"),
+			LOCTEXT("MergeModulesTooltip", "把若干小模块并入一个目标模块，减少链接的二进制与编辑器启动时加载的动态库"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Plus"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickMergeModules))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.RefactorModule",
+			LOCTEXT("RefactorModuleMenu", "模块重命名 / 移动文件"),
+			LOCTEXT("RefactorModuleTooltip", "重命名模块或把文件移到另一个模块，并行改写全部 #include、API 宏、Build.cs 与描述文件"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Edit"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickRefactorModule))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.LoadingPhases",
+			LOCTEXT("LoadingPhasesMenu", "加载阶段优化"),
+			LOCTEXT("LoadingPhasesTooltip", "按上次启动实测的模块加载耗时，把启动时无人引用的模块改为按需加载、把编辑器模块推迟到 PostEngineInit"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Recent"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickLoadingPhases))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.CompileTimes",
+			LOCTEXT("CompileTimesMenu", "编译耗时分析"),
+			LOCTEXT("CompileTimesTooltip", "汇总 clang -ftime-trace 记录，按模块与头文件统计前端 / 后端编译耗时与头文件改动后的重编耗时"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Info"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickCompileTimes))
+		);
+
+		Section.AddMenuEntry(
+			"ModuleBuilder.StartupProfile",
+			LOCTEXT("StartupProfileMenu", "启动耗时分析"),
+			LOCTEXT("StartupProfileTooltip", "历次编辑器启动中各加载阶段与工程 / 插件模块的映射、StartupModule 耗时，标出比之前变慢的模块"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Recent"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickStartupProfile))
+		);
 	}
 
-	Text += TEXT("\t}\n}\n");
-	return Text;
+	Menus->RefreshAllWidgets();
 }
 
-static FString MakeModuleHeaderText(const FString& ModuleName)
+void FModuleBuilderEditorModule::OnClickAddModule()
 {
-	return FString::Printf(TEXT(
-R"(#pragma once
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(LOCTEXT("AddModuleWindowTitle", "添加 C++ 模块"))
+		.SizingRule(ESizingRule::Autosized)
+		.SupportsMaximize(false)
+		.SupportsMinimize(false);
+
+	Window->SetContent(
+		SNew(SBox)
+		.MinDesiredWidth(520.f)
+		[
+			SNew(SAddModuleWindow)
+			.ParentWindow(Window)
+			.OnConfirm(FOnConfirmModule::CreateRaw(this, &FModuleBuilderEditorModule::HandleConfirm))
+		]
+	);
 
-#include "Modules/ModuleManager.h"
+	FSlateApplication::Get().AddWindow(Window);
+}
 
-/**
- * %s 模块
- */
-class F%sModule : public IModuleInterface
+void FModuleBuilderEditorModule::OnClickDependencyGraph()
 {
-public:
-    virtual void StartupModule() override;
-    virtual void ShutdownModule() override;
-};
-)"), *ModuleName, *ModuleName);
+	SModuleReportWindow::Open(
+		LOCTEXT("DependencyGraphWindowTitle", "模块依赖分析"),
+		FOnPrepareReport::CreateLambda([]() -> TFunction<FString()>
+		{
+			// 插件列表只能在游戏线程读取，解析 Build.cs 放到工作线程
+			TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+			return [Roots = MoveTemp(Roots)]()
+			{
+				FModuleDependencyGraph Graph;
+				Graph.Build(Roots);
+				return Graph.BuildReport();
+			};
+		})
+	);
 }
 
-static FString MakeModuleCppText(const FString& ModuleName)
+void FModuleBuilderEditorModule::OnClickDemoteDependencies()
 {
-	return FString::Printf(TEXT(
-R"(#include "%s.h"
-#include "Modules/ModuleManager.h"
+	// bApply 为 false 时只输出报告与 diff
+	auto MakeDemotionTask = [](bool bApply) -> TFunction<FString()>
+	{
+		TArray<FModuleSourceRoot> ProjectRoots = FModuleDependencyGraph::GetProjectSourceRoots();
+		TArray<FModuleSourceRoot> EngineRoots = FExternalModuleIndex::GetEngineSourceRoots();
 
-void F%sModule::StartupModule()
-{
-    // 模块启动时调用
+		return [ProjectRoots = MoveTemp(ProjectRoots), EngineRoots = MoveTemp(EngineRoots), bApply]()
+		{
+			FModuleDependencyGraph Graph;
+			Graph.Build(ProjectRoots);
+
+			FExternalModuleIndex External;
+			External.Build(EngineRoots);
+
+			FDemotionAnalysis Analysis;
+			ModuleBuilder::AnalyzeDependencyDemotions(Graph, External, Analysis);
+
+			FString Diff;
+			TArray<FString> Errors;
+			ModuleBuilder::ApplyDependencyDemotions(Analysis.Demotions, !bApply, Diff, Errors);
+
+			FString Report = ModuleBuilder::FormatDemotionReport(Analysis);
+			Report += bApply ? TEXT("\n== 已写回 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Diff;
+			for (const FString& Error : Errors)
+			{
+				Report += TEXT("错误：") + Error + TEXT("\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("DemoteDependenciesWindowTitle", "依赖降级（Public → Private）"),
+		FOnPrepareReport::CreateLambda([MakeDemotionTask]() { return MakeDemotionTask(false); }),
+		LOCTEXT("ApplyDemotions", "应用修改"),
+		FOnPrepareReport::CreateLambda([MakeDemotionTask]() -> TFunction<FString()>
+		{
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo,
+				LOCTEXT("ConfirmDemotions", "将按预览改写各模块的 Build.cs，并在下次编译时生效。是否继续？"));
+			return Answer == EAppReturnType::Yes ? MakeDemotionTask(true) : nullptr;
+		})
+	);
 }
 
-void F%sModule::ShutdownModule()
+void FModuleBuilderEditorModule::OnClickSuggestPCH()
 {
-    // 模块关闭时调用
+	SModuleReportWindow::Open(
+		LOCTEXT("SuggestPCHWindowTitle", "预编译头建议"),
+		FOnPrepareReport::CreateLambda([]() -> TFunction<FString()>
+		{
+			TArray<FModuleSourceRoot> ProjectRoots = FModuleDependencyGraph::GetProjectSourceRoots();
+			TArray<FModuleSourceRoot> EngineRoots = FExternalModuleIndex::GetEngineSourceRoots();
+
+			return [ProjectRoots = MoveTemp(ProjectRoots), EngineRoots = MoveTemp(EngineRoots)]()
+			{
+				FModuleDependencyGraph Graph;
+				Graph.Build(ProjectRoots);
+
+				FExternalModuleIndex External;
+				External.Build(EngineRoots);
+
+				return ModuleBuilder::BuildPCHReport(Graph, External);
+			};
+		})
+	);
 }
 
-IMPLEMENT_MODULE(F%sModule, %s)
-)"), *ModuleName, *ModuleName, *ModuleName, *ModuleName, *ModuleName);
+void FModuleBuilderEditorModule::OnClickIncludeIndex()
+{
+	// 输入框中的模块名，为空时报告全部模块；只在游戏线程读写
+	TSharedRef<FString> ModuleName = MakeShared<FString>();
+
+	SModuleReportWindow::Open(
+		LOCTEXT("IncludeIndexWindowTitle", "头文件包含分析"),
+		FOnPrepareReport::CreateLambda([ModuleName]() -> TFunction<FString()>
+		{
+			TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+			const FString CachePath = FIncludeGraphIndex::GetCachePath();
+
+			return [Roots = MoveTemp(Roots), CachePath, Name = *ModuleName]()
+			{
+				FModuleDependencyGraph Graph;
+				Graph.Build(Roots);
+
+				FIncludeGraphIndex Index;
+				FIncludeIndexStats Stats;
+				Index.Build(Graph, CachePath, Stats);
+				return Index.BuildReport(Graph, Stats, Name);
+			};
+		}),
+		FText::GetEmpty(),
+		FOnPrepareReport(),
+		LOCTEXT("IncludeIndexHint", "模块名（留空为全部模块）"),
+		FOnTextChanged::CreateLambda([ModuleName](const FText& Text)
+		{
+			*ModuleName = Text.ToString().TrimStartAndEnd();
+		})
+	);
 }
 
-static bool SaveTextChecked(const FString& Path, const FString& Text, FString& OutError)
+void FModuleBuilderEditorModule::OnClickUnitySettings()
 {
-	const bool bOk = FFileHelper::SaveStringToFile(Text, *Path);
-	if (!bOk)
+	auto MakeUnityTask = [](bool bApply) -> TFunction<FString()>
 	{
-		OutError = TEXT("写入文件失败：") + Path;
-	}
-	return bOk;
+		TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+
+		return [Roots = MoveTemp(Roots), bApply]()
+		{
+			FModuleDependencyGraph Graph;
+			Graph.Build(Roots);
+
+			TArray<FUnityRecommendation> Recommendations;
+			ModuleBuilder::AnalyzeUnitySettings(Graph, Recommendations);
+
+			FString Diff;
+			TArray<FString> Errors;
+			ModuleBuilder::ApplyUnityRecommendations(Recommendations, !bApply, Diff, Errors);
+
+			FString Report = ModuleBuilder::FormatUnityReport(Recommendations);
+			Report += bApply ? TEXT("\n== 已写回 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Diff;
+			for (const FString& Error : Errors)
+			{
+				Report += TEXT("错误：") + Error + TEXT("\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("UnitySettingsWindowTitle", "Unity Build 设置建议"),
+		FOnPrepareReport::CreateLambda([MakeUnityTask]() { return MakeUnityTask(false); }),
+		LOCTEXT("ApplyUnitySettings", "全部应用"),
+		FOnPrepareReport::CreateLambda([MakeUnityTask]() -> TFunction<FString()>
+		{
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo,
+				LOCTEXT("ConfirmUnitySettings", "将按预览改写所有需要调整的 Build.cs，下次编译时 UBT 会重新生成 makefile。是否继续？"));
+			return Answer == EAppReturnType::Yes ? MakeUnityTask(true) : nullptr;
+		})
+	);
 }
 
-static bool GenerateModuleFilesToTarget(const FString& ContainerRoot, const FString& ModuleName, bool bIsEditorModule, FString& OutError)
+void FModuleBuilderEditorModule::OnClickSplitModule()
 {
-	const FString SourceDir = FPaths::ConvertRelativePathToFull(ContainerRoot / TEXT("Source"));
-	const FString ModuleDir = FPaths::ConvertRelativePathToFull(SourceDir / ModuleName);
+	// 输入框中的模块名，只在游戏线程读写
+	TSharedRef<FString> ModuleName = MakeShared<FString>();
 
-	const FString PublicDir  = ModuleDir / TEXT("Public");
-	const FString PrivateDir = ModuleDir / TEXT("Private");
-
-	if (!IFileManager::Get().MakeDirectory(*PublicDir, true))
+	auto MakeSplitTask = [ModuleName](bool bApply) -> TFunction<FString()>
 	{
-		OutError = TEXT("创建目录失败：") + PublicDir;
-		return false;
-	}
+		TArray<FModuleSourceRoot> ProjectRoots = FModuleDependencyGraph::GetProjectSourceRoots();
+		TArray<FModuleSourceRoot> EngineRoots = FExternalModuleIndex::GetEngineSourceRoots();
 
-	if (!IFileManager::Get().MakeDirectory(*PrivateDir, true))
-	{
-		OutError = TEXT("创建目录失败：") + PrivateDir;
-		return false;
-	}
+		return [ProjectRoots = MoveTemp(ProjectRoots), EngineRoots = MoveTemp(EngineRoots), Name = *ModuleName, bApply]()
+		{
+			FModuleDependencyGraph Graph;
+			Graph.Build(ProjectRoots);
 
-	const FString BuildCsPath = ModuleDir / (ModuleName + TEXT(".Build.cs"));
-	const FString HPath       = PublicDir / (ModuleName + TEXT(".h"));
-	const FString CppPath     = PrivateDir / (ModuleName + TEXT(".cpp"));
+			if (Name.IsEmpty())
+			{
+				return ModuleBuilder::FormatSplitCandidates(Graph);
+			}
 
-	if (FPaths::FileExists(BuildCsPath) || FPaths::FileExists(HPath) || FPaths::FileExists(CppPath))
-	{
-		OutError = TEXT("目标文件已存在，未进行覆盖。");
-		return false;
-	}
+			FExternalModuleIndex External;
+			External.Build(EngineRoots);
+
+			FModuleSplitPlan Plan;
+			FString Error;
+			if (!ModuleBuilder::PlanModuleSplit(Graph, External, Name, FModuleSplitOptions(), Plan, Error))
+			{
+				return Error + TEXT("\n");
+			}
 
-	if (!SaveTextChecked(BuildCsPath, MakeBuildCsText(ModuleName, bIsEditorModule), OutError)) return false;
-	if (!SaveTextChecked(HPath,       MakeModuleHeaderText(ModuleName),            OutError)) return false;
-	if (!SaveTextChecked(CppPath,     MakeModuleCppText(ModuleName),               OutError)) return false;
+			FString Log;
+			TArray<FString> Errors;
+			const bool bSuccess = ModuleBuilder::ApplyModuleSplit(Plan, !bApply, Log, Errors);
 
-	return true;
+			FString Report = ModuleBuilder::FormatSplitPlan(Plan);
+			Report += bApply ? TEXT("\n== 已拆分 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Log;
+			for (const FString& Message : Errors)
+			{
+				Report += TEXT("错误：") + Message + TEXT("\n");
+			}
+			if (bApply && bSuccess)
+			{
+				Report += TEXT("\n请重新生成项目文件并编译；拆分出的模块需要重启编辑器后加载。\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("SplitModuleWindowTitle", "模块拆分"),
+		FOnPrepareReport::CreateLambda([MakeSplitTask]() { return MakeSplitTask(false); }),
+		LOCTEXT("ApplySplit", "拆分"),
+		FOnPrepareReport::CreateLambda([MakeSplitTask, ModuleName]() -> TFunction<FString()>
+		{
+			if (ModuleName->IsEmpty())
+			{
+				FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("SplitNeedsModule", "请先输入要拆分的模块名。"));
+				return nullptr;
+			}
+
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo, FText::Format(
+				LOCTEXT("ConfirmSplit", "将按预览生成新模块、移动 {0} 的源文件并改写相关 Build.cs 与描述文件。建议先提交版本控制。是否继续？"),
+				FText::FromString(*ModuleName)));
+			return Answer == EAppReturnType::Yes ? MakeSplitTask(true) : nullptr;
+		}),
+		LOCTEXT("SplitModuleHint", "模块名"),
+		FOnTextChanged::CreateLambda([ModuleName](const FText& Text)
+		{
+			*ModuleName = Text.ToString().TrimStartAndEnd();
+		})
+	);
 }
 
-static bool AddModuleToDescriptor(
-	const FString& DescriptorPath,
-	const FString& ModuleName,
-	const FString& InModuleType,
-	const FString& InLoadingPhase,
-	FString& OutError)
+void FModuleBuilderEditorModule::OnClickMergeModules()
 {
-	FString JsonText;
-	if (!FFileHelper::LoadFileToString(JsonText, *DescriptorPath))
-	{
-		OutError = TEXT("读取描述文件失败：") + DescriptorPath;
-		return false;
-	}
+	// 输入框中的模块名：第一个为目标，其余并入目标；只在游戏线程读写
+	TSharedRef<TArray<FString>> ModuleNames = MakeShared<TArray<FString>>();
 
-	TSharedPtr<FJsonObject> Root;
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
-	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	auto MakeMergeTask = [ModuleNames](bool bApply) -> TFunction<FString()>
 	{
-		OutError = TEXT("JSON 解析失败。");
-		return false;
-	}
+		TArray<FModuleSourceRoot> ProjectRoots = FModuleDependencyGraph::GetProjectSourceRoots();
 
-	const FString ModuleType   = InModuleType.IsEmpty()   ? TEXT("Runtime") : InModuleType;
-	const FString LoadingPhase = InLoadingPhase.IsEmpty() ? TEXT("Default") : InLoadingPhase;
+		return [ProjectRoots = MoveTemp(ProjectRoots), Names = *ModuleNames, bApply]()
+		{
+			FModuleDependencyGraph Graph;
+			Graph.Build(ProjectRoots);
 
-	TArray<TSharedPtr<FJsonValue>> Modules;
-	if (Root->HasTypedField<EJson::Array>(TEXT("Modules")))
-	{
-		Modules = Root->GetArrayField(TEXT("Modules"));
-	}
+			if (Names.Num() < 2)
+			{
+				return ModuleBuilder::FormatMergeCandidates(Graph);
+			}
 
-	for (const TSharedPtr<FJsonValue>& V : Modules)
-	{
-		const TSharedPtr<FJsonObject>* ObjPtr = nullptr;
-		if (V.IsValid() && V->TryGetObject(ObjPtr) && ObjPtr && ObjPtr->IsValid())
-		{
-			FString Name;
-			if ((*ObjPtr)->TryGetStringField(TEXT("Name"), Name) && Name == ModuleName)
+			FModuleMergePlan Plan;
+			FString Error;
+			if (!ModuleBuilder::PlanModuleMerge(Graph, Names[0], TArray<FString>(Names.GetData() + 1, Names.Num() - 1), FModuleMergeOptions(), Plan, Error))
 			{
-				OutError = TEXT("描述文件中已存在同名模块：") + ModuleName;
-				return false;
+				return Error + TEXT("\n");
 			}
-		}
-	}
 
-	TSharedPtr<FJsonObject> NewMod = MakeShared<FJsonObject>();
-	NewMod->SetStringField(TEXT("Name"), ModuleName);
-	NewMod->SetStringField(TEXT("Type"), ModuleType);
-	NewMod->SetStringField(TEXT("LoadingPhase"), LoadingPhase);
+			FString Log;
+			TArray<FString> Errors;
+			const bool bSuccess = ModuleBuilder::ApplyModuleMerge(Plan, !bApply, Log, Errors);
 
-	Modules.Add(MakeShared<FJsonValueObject>(NewMod));
-	Root->SetArrayField(TEXT("Modules"), Modules);
+			FString Report = ModuleBuilder::FormatMergePlan(Plan);
+			Report += bApply ? TEXT("\n== 已合并 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Log;
+			for (const FString& Message : Errors)
+			{
+				Report += TEXT("错误：") + Message + TEXT("\n");
+			}
+			if (bApply && bSuccess)
+			{
+				Report += TEXT("\n请重新生成项目文件并编译；被合并的模块在重启编辑器前仍保持加载。\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("MergeModulesWindowTitle", "模块合并"),
+		FOnPrepareReport::CreateLambda([MakeMergeTask]() { return MakeMergeTask(false); }),
+		LOCTEXT("ApplyMerge", "合并"),
+		FOnPrepareReport::CreateLambda([MakeMergeTask, ModuleNames]() -> TFunction<FString()>
+		{
+			if (ModuleNames->Num() < 2)
+			{
+				FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("MergeNeedsModules", "请先输入目标模块和要并入的模块，用逗号分隔。"));
+				return nullptr;
+			}
+
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo, FText::Format(
+				LOCTEXT("ConfirmMerge", "将按预览把模块移入 {0}，删除原模块并改写相关 Build.cs 与描述文件。建议先提交版本控制。是否继续？"),
+				FText::FromString((*ModuleNames)[0])));
+			return Answer == EAppReturnType::Yes ? MakeMergeTask(true) : nullptr;
+		}),
+		LOCTEXT("MergeModulesHint", "目标模块, 模块1, 模块2"),
+		FOnTextChanged::CreateLambda([ModuleNames](const FText& Text)
+		{
+			Text.ToString().ParseIntoArray(*ModuleNames, TEXT(","));
+			for (FString& Name : *ModuleNames)
+			{
+				Name.TrimStartAndEndInline();
+			}
+			ModuleNames->RemoveAll([](const FString& Name) { return Name.IsEmpty(); });
+		})
+	);
+}
 
-	FString OutJson;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJson);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+void FModuleBuilderEditorModule::OnClickRefactorModule()
+{
+	// 输入："旧名 > 新名" 重命名；"模块A > 模块B : 文件1, 文件2" 移动文件。只在游戏线程读写
+	TSharedRef<FString> Input = MakeShared<FString>();
 
-	if (!FFileHelper::SaveStringToFile(OutJson, *DescriptorPath))
+	auto MakeRefactorTask = [Input](bool bApply) -> TFunction<FString()>
 	{
-		OutError = TEXT("写入描述文件失败：") + DescriptorPath;
-		return false;
-	}
+		TArray<FModuleSourceRoot> ProjectRoots = FModuleDependencyGraph::GetProjectSourceRoots();
 
-	return true;
-}
+		return [ProjectRoots = MoveTemp(ProjectRoots), Text = *Input, bApply]()
+		{
+			FString Modules;
+			FString FileList;
+			if (!Text.Split(TEXT(":"), &Modules, &FileList))
+			{
+				Modules = Text;
+			}
 
-// ===== 模块实现 =====
+			FString Left;
+			FString Right;
+			if (!Modules.Split(TEXT(">"), &Left, &Right))
+			{
+				return FString(TEXT("请输入 \"旧名 > 新名\" 或 \"模块A > 模块B : 文件1, 文件2\"（文件路径相对模块A目录）。\n"));
+			}
+			Left.TrimStartAndEndInline();
+			Right.TrimStartAndEndInline();
 
-void FModuleBuilderEditorModule::StartupModule()
-{
-	UToolMenus::RegisterStartupCallback(
-		FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FModuleBuilderEditorModule::RegisterMenus)
+			FModuleDependencyGraph Graph;
+			Graph.Build(ProjectRoots);
+
+			FModuleRefactorPlan Plan;
+			FString Error;
+			bool bPlanned = false;
+			if (FileList.IsEmpty())
+			{
+				bPlanned = ModuleBuilder::PlanModuleRename(Graph, ProjectRoots, Left, Right, Plan, Error);
+			}
+			else
+			{
+				FModuleFileMoveRequest Request;
+				Request.FromModule = Left;
+				Request.ToModule = Right;
+				FileList.ParseIntoArray(Request.Files, TEXT(","));
+				for (FString& File : Request.Files)
+				{
+					File.TrimStartAndEndInline();
+				}
+				Request.Files.RemoveAll([](const FString& File) { return File.IsEmpty(); });
+				bPlanned = ModuleBuilder::PlanModuleFileMove(Graph, ProjectRoots, Request, Plan, Error);
+			}
+			if (!bPlanned)
+			{
+				return Error + TEXT("\n");
+			}
+
+			FString Log;
+			TArray<FString> Errors;
+			const bool bSuccess = ModuleBuilder::ApplyModuleRefactor(Plan, !bApply, Log, Errors);
+
+			FString Report = ModuleBuilder::FormatRefactorPlan(Plan);
+			Report += bApply ? TEXT("\n== 已改写 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Log;
+			for (const FString& Message : Errors)
+			{
+				Report += TEXT("错误：") + Message + TEXT("\n");
+			}
+			if (bApply && bSuccess)
+			{
+				Report += TEXT("\n请重新生成项目文件并编译。\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("RefactorModuleWindowTitle", "模块重命名 / 移动文件"),
+		FOnPrepareReport::CreateLambda([MakeRefactorTask]() { return MakeRefactorTask(false); }),
+		LOCTEXT("ApplyRefactor", "改写"),
+		FOnPrepareReport::CreateLambda([MakeRefactorTask, Input]() -> TFunction<FString()>
+		{
+			if (!Input->Contains(TEXT(">")))
+			{
+				FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("RefactorNeedsInput", "请先输入 \"旧名 > 新名\" 或 \"模块A > 模块B : 文件1, 文件2\"。"));
+				return nullptr;
+			}
+
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo,
+				LOCTEXT("ConfirmRefactor", "将按预览移动文件并改写所有引用它们的源码、Build.cs 与描述文件。建议先提交版本控制。是否继续？"));
+			return Answer == EAppReturnType::Yes ? MakeRefactorTask(true) : nullptr;
+		}),
+		LOCTEXT("RefactorModuleHint", "旧名 > 新名，或 模块A > 模块B : Public/X.h, Private/X.cpp"),
+		FOnTextChanged::CreateLambda([Input](const FText& Text)
+		{
+			*Input = Text.ToString().TrimStartAndEnd();
+		})
 	);
 }
 
-void FModuleBuilderEditorModule::ShutdownModule()
+void FModuleBuilderEditorModule::OnClickLoadingPhases()
 {
-	UToolMenus::UnRegisterStartupCallback(this);
-	UToolMenus::UnregisterOwner(this);
-}
+	auto MakeLoadingPhaseTask = [](bool bApply) -> TFunction<FString()>
+	{
+		TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
 
-void FModuleBuilderEditorModule::RegisterMenus()
-{
-	UToolMenus* Menus = UToolMenus::Get();
-	if (!Menus) return;
+		return [Roots = MoveTemp(Roots), bApply]()
+		{
+			FModuleDependencyGraph Graph;
+			Graph.Build(Roots);
 
-	if (UToolMenu* ToolsMenu = Menus->ExtendMenu("LevelEditor.MainMenu.Tools"))
-	{
-		FToolMenuSection& Section = ToolsMenu->FindOrAddSection("ModuleBuilder");
+			FLoadingPhaseAnalysis Analysis;
+			ModuleBuilder::AnalyzeLoadingPhases(Graph, FModuleLoadRecorder::GetSessionPath(), Analysis);
 
-		Section.AddMenuEntry(
-			"ModuleBuilder.AddModule",
-			LOCTEXT("AddModuleMenu", "添加 C++ 模块"),
-			LOCTEXT("AddModuleTooltip", "创建并注册一个新的 C++ 模块"),
-			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Plus"),
-			FUIAction(FExecuteAction::CreateRaw(this, &FModuleBuilderEditorModule::OnClickAddModule))
-		);
-	}
+			FString Diff;
+			TArray<FString> Errors;
+			const bool bSuccess = ModuleBuilder::ApplyLoadingPhases(Analysis, !bApply, Diff, Errors);
 
-	Menus->RefreshAllWidgets();
+			FString Report = ModuleBuilder::FormatLoadingPhaseReport(Analysis);
+			Report += bApply ? TEXT("\n== 已写回 ==\n") : TEXT("\n== 预览（未写盘）==\n");
+			Report += Diff;
+			for (const FString& Error : Errors)
+			{
+				Report += TEXT("错误：") + Error + TEXT("\n");
+			}
+			if (bApply && bSuccess)
+			{
+				Report += TEXT("\n重启编辑器后生效；再次打开本窗口可对比修改前后的启动耗时。\n");
+			}
+			return Report;
+		};
+	};
+
+	SModuleReportWindow::Open(
+		LOCTEXT("LoadingPhasesWindowTitle", "加载阶段优化"),
+		FOnPrepareReport::CreateLambda([MakeLoadingPhaseTask]() { return MakeLoadingPhaseTask(false); }),
+		LOCTEXT("ApplyLoadingPhases", "全部应用"),
+		FOnPrepareReport::CreateLambda([MakeLoadingPhaseTask]() -> TFunction<FString()>
+		{
+			const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo,
+				LOCTEXT("ConfirmLoadingPhases", "将按预览改写描述文件中模块的 LoadingPhase。改为 None 的模块只在首次被使用时加载，请确认没有依赖其启动时加载的代码。是否继续？"));
+			return Answer == EAppReturnType::Yes ? MakeLoadingPhaseTask(true) : nullptr;
+		})
+	);
 }
 
-void FModuleBuilderEditorModule::OnClickAddModule()
+void FModuleBuilderEditorModule::OnClickCompileTimes()
 {
-	TSharedRef<SWindow> Window = SNew(SWindow)
-		.Title(LOCTEXT("AddModuleWindowTitle", "添加 C++ 模块"))
-		.SizingRule(ESizingRule::Autosized)
-		.SupportsMaximize(false)
-		.SupportsMinimize(false);
+	// 输入框中的模块名，为空时报告全部模块；只在游戏线程读写
+	TSharedRef<FString> ModuleName = MakeShared<FString>();
 
-	Window->SetContent(
-		SNew(SBox)
-		.MinDesiredWidth(520.f)
-		[
-			SNew(SAddModuleWindow)
-			.ParentWindow(Window)
-			.OnConfirm(FOnConfirmModule::CreateRaw(this, &FModuleBuilderEditorModule::HandleConfirm))
-		]
+	SModuleReportWindow::Open(
+		LOCTEXT("CompileTimesWindowTitle", "编译耗时分析"),
+		FOnPrepareReport::CreateLambda([ModuleName]() -> TFunction<FString()>
+		{
+			TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+			const FString CachePath = FCompileTimeIndex::GetCachePath();
+
+			return [Roots = MoveTemp(Roots), CachePath, Name = *ModuleName]()
+			{
+				FModuleDependencyGraph Graph;
+				Graph.Build(Roots);
+
+				FCompileTimeIndex Index;
+				FCompileTimeStats Stats;
+				Index.Build(Graph, CachePath, Stats);
+				return Index.BuildReport(Graph, Stats, Name);
+			};
+		}),
+		FText::GetEmpty(),
+		FOnPrepareReport(),
+		LOCTEXT("CompileTimesHint", "模块名（留空为全部模块）"),
+		FOnTextChanged::CreateLambda([ModuleName](const FText& Text)
+		{
+			*ModuleName = Text.ToString().TrimStartAndEnd();
+		})
 	);
+}
 
-	FSlateApplication::Get().AddWindow(Window);
+void FModuleBuilderEditorModule::OnClickStartupProfile()
+{
+	// 输入框中的模块名，为空时报告全部模块；只在游戏线程读写
+	TSharedRef<FString> ModuleName = MakeShared<FString>();
+
+	SModuleReportWindow::Open(
+		LOCTEXT("StartupProfileWindowTitle", "启动耗时分析"),
+		FOnPrepareReport::CreateLambda([ModuleName]() -> TFunction<FString()>
+		{
+			// 插件列表只能在游戏线程读取
+			TMap<FString, FString> Owners = ModuleBuilder::GetProjectAndPluginModules();
+			const FString HistoryPath = FModuleLoadRecorder::GetHistoryPath();
+
+			return [Owners = MoveTemp(Owners), HistoryPath, Name = *ModuleName]()
+			{
+				FStartupProfile Profile;
+				ModuleBuilder::AnalyzeStartupProfile(HistoryPath, Owners, Profile);
+				return ModuleBuilder::FormatStartupProfileReport(Profile, Name);
+			};
+		}),
+		FText::GetEmpty(),
+		FOnPrepareReport(),
+		LOCTEXT("StartupProfileHint", "模块名（留空为全部模块）"),
+		FOnTextChanged::CreateLambda([ModuleName](const FText& Text)
+		{
+			*ModuleName = Text.ToString().TrimStartAndEnd();
+		})
+	);
 }
 
-bool FModuleBuilderEditorModule::HandleConfirm(const FNewModuleParams& Params)
+TSharedPtr<FModuleBuildOperation, ESPMode::ThreadSafe> FModuleBuilderEditorModule::HandleConfirm(const FNewModuleParams& Params)
 {
+	FText NameError;
+	if (!FModuleNameIndex::Get().ValidateNewModuleName(Params.ModuleName, NameError))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, NameError);
+		return nullptr;
+	}
+
 	FString Error;
 	FTargetResolveResult Target;
 
-	if (!ResolveTargetFromParams(Params, Target, Error))
+	// 从确认开始计时，解析目标也计入本次操作
+	TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> Timing = FModuleOperationTiming::Create(TEXT("AddModule ") + Params.ModuleName);
+	bool bResolved = false;
+	{
+		FModuleOperationTimingScope TimingScope(Timing);
+		bResolved = ModuleBuilder::ResolveTargetFromParams(Params, Target, Error);
+	}
+	if (!bResolved)
 	{
+		Timing->Finish(false);
 		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Error));
-		return false;
+		return nullptr;
 	}
 
-	const bool bIsEditor = Params.ModuleType.Equals(TEXT("Editor"), ESearchCase::IgnoreCase);
+	// 目录创建、文件写入、描述文件修补都在工作线程执行，编辑器保持响应
+	TSharedRef<FModuleBuildOperation, ESPMode::ThreadSafe> Operation = FModuleBuildOperation::Launch(Params, Target, Timing);
+	Operation->OnCompleted().AddRaw(this, &FModuleBuilderEditorModule::HandleBuildCompleted, Operation.ToWeakPtr(), FPlatformTime::Seconds());
+
+	return Operation;
+}
 
-	if (!GenerateModuleFilesToTarget(Target.ContainerRoot, Params.ModuleName, bIsEditor, Error))
+void FModuleBuilderEditorModule::HandleBuildCompleted(bool bSuccess, const FString& Message, TWeakPtr<FModuleBuildOperation, ESPMode::ThreadSafe> WeakOperation, double ConfirmTime)
+{
+	TSharedPtr<FModuleBuildOperation, ESPMode::ThreadSafe> Operation = WeakOperation.Pin();
+	if (!Operation.IsValid())
 	{
-		FMessageDialog::Open(EAppMsgType::Ok,
-			FText::Format(
-				LOCTEXT("GenerateFailed", "生成模块文件失败：\n{0}"),
-				FText::FromString(Error)
-			)
-		);
-		return false;
+		return;
 	}
 
-	if (!AddModuleToDescriptor(Target.DescriptorPath, Params.ModuleName, Params.ModuleType, Params.LoadingPhase, Error))
+	if (!bSuccess)
 	{
-		FMessageDialog::Open(EAppMsgType::Ok,
-			FText::Format(
-				LOCTEXT("DescriptorFailed", "更新描述文件失败：\n{0}"),
-				FText::FromString(Error)
-			)
-		);
-		return false;
+		// 用户主动取消不再弹窗
+		if (!Operation->IsCancelRequested())
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+		}
+		return;
 	}
 
-	const FString ModuleDir = FPaths::ConvertRelativePathToFull(Target.ContainerRoot / TEXT("Source") / Params.ModuleName);
+	const FTargetResolveResult& Target = Operation->GetTarget();
+	const FNewModuleParams& Params = Operation->GetParams();
+
+	FModuleNameIndex::Get().AddModule(Params.ModuleName,
+		Target.bIsProject ? EModuleNameOwner::Project : EModuleNameOwner::ProjectPlugin,
+		Target.bIsProject ? FString(FApp::GetProjectName()) : Params.TargetPluginName);
+
+	if (Operation->InvalidatedMakefile())
+	{
+		UE_LOG(LogModuleBuilder, Log, TEXT("描述文件已更新，下次编译 UBT 会重新生成 makefile：%s"), *Target.DescriptorPath);
+	}
+
+	const FString ModuleDir = ModuleBuilder::GetModuleDir(Target.ContainerRoot, Params.ModuleName);
 	FPlatformProcess::ExploreFolder(*ModuleDir);
 
-	FMessageDialog::Open(EAppMsgType::Ok,
-		LOCTEXT("SuccessMessage",
-			"模块添加成功！\n\n"
-			"已生成模块文件，并更新描述文件（.uproject/.uplugin）。\n\n"
-			"建议下一步：\n"
-			"1）重新生成项目文件\n"
-			"2）编译一次（编辑器编译 / IDE Build）"
-		)
-	);
+	// 不再要求重新生成项目文件并全量编译或重启编辑器：UBT 只编译新模块，完成后直接加载
+	StartModuleCompile(Params.ModuleName, Target, FPlatformTime::Seconds() - ConfirmTime);
+}
+
+void FModuleBuilderEditorModule::StartModuleCompile(const FString& ModuleName, const FTargetResolveResult& Target, double GenerateSeconds)
+{
+	FString Error;
+	TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Operation = FModuleCompileOperation::Launch(ModuleName, Target, Error);
+	if (!Operation.IsValid())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::Format(
+			LOCTEXT("CompileLaunchFailed",
+				"模块添加成功，但无法在后台编译：\n{0}\n\n"
+				"请重新生成项目文件，再编译一次（编辑器编译 / IDE Build）。"),
+			FText::FromString(Error)));
+		return;
+	}
+
+	const FText Title = FText::Format(LOCTEXT("CompilingModule", "正在编译模块 {0}…"), FText::FromString(ModuleName));
+
+	TWeakPtr<FModuleCompileOperation, ESPMode::ThreadSafe> WeakOperation = Operation;
+
+	FNotificationInfo Info(Title);
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.bUseSuccessFailIcons = true;
+	Info.ExpireDuration = 8.f;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("CancelCompile", "取消"),
+		LOCTEXT("CancelCompileTooltip", "结束 UnrealBuildTool，已生成的模块文件保留"),
+		FSimpleDelegate::CreateLambda([WeakOperation]()
+		{
+			if (TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Pinned = WeakOperation.Pin())
+			{
+				Pinned->Cancel();
+			}
+		}),
+		SNotificationItem::CS_Pending));
+	Info.Hyperlink = FSimpleDelegate::CreateLambda([]()
+	{
+		FGlobalTabmanager::Get()->TryInvokeTab(FName(TEXT("OutputLog")));
+	});
+	Info.HyperlinkText = LOCTEXT("ShowCompileLog", "输出日志");
+
+	TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+	TWeakPtr<SNotificationItem> WeakNotification = Notification;
+
+	// 最近一行输出作为副标题，进度写进标题
+	Operation->OnOutput().AddLambda([WeakNotification, WeakOperation, ModuleName](const FString& Line)
+	{
+		TSharedPtr<SNotificationItem> Item = WeakNotification.Pin();
+		TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Pinned = WeakOperation.Pin();
+		if (!Item.IsValid() || !Pinned.IsValid())
+		{
+			return;
+		}
+
+		Item->SetSubText(FText::FromString(Line.TrimStartAndEnd()));
+		if (Pinned->GetProgress() > 0.f)
+		{
+			Item->SetText(FText::Format(LOCTEXT("CompilingModuleProgress", "正在编译模块 {0}（{1}）"),
+				FText::FromString(ModuleName), FText::AsPercent(Pinned->GetProgress())));
+		}
+	});
+
+	Operation->OnCompleted().AddLambda([this, WeakNotification, WeakOperation, ModuleName, GenerateSeconds](bool bSuccess, const FString& Message)
+	{
+		TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Pinned = WeakOperation.Pin();
+		const bool bCanceled = Pinned.IsValid() && Pinned->IsCancelRequested();
+
+		FModuleHotLoadTimings Timings = Pinned.IsValid() ? Pinned->GetTimings() : FModuleHotLoadTimings();
+		Timings.Generate = GenerateSeconds;
+		if (bSuccess)
+		{
+			UE_LOG(LogModuleBuilder, Log, TEXT("模块 %s 从确认到加载完成：%s"), *ModuleName, *Timings.ToString());
+		}
+
+		if (TSharedPtr<SNotificationItem> Item = WeakNotification.Pin())
+		{
+			if (bSuccess)
+			{
+				Item->SetText(FText::Format(LOCTEXT("ModuleCompiled", "模块 {0} 已编译并加载"), FText::FromString(ModuleName)));
+				Item->SetSubText(FText::FromString(Timings.ToString()));
+			}
+			else
+			{
+				Item->SetText(FText::Format(LOCTEXT("ModuleCompileFailed", "模块 {0} 编译未完成"), FText::FromString(ModuleName)));
+				Item->SetSubText(FText::FromString(Message));
+			}
+			Item->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+			Item->ExpireAndFadeout();
+		}
+
+		if (!bSuccess && !bCanceled)
+		{
+			UE_LOG(LogModuleBuilder, Warning, TEXT("%s"), *Message);
+		}
+
+		ActiveCompiles.Remove(Pinned);
+	});
 
-	return true;
+	ActiveCompiles.Add(Operation);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,191 @@
+#include "ModuleBuilderTrace.h"
+#include "ModuleBuilderEditor.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UE_TRACE_CHANNEL_DEFINE(ModuleBuilderChannel)
+
+TRACE_DECLARE_INT_COUNTER(ModuleBuilder_FilesWritten, TEXT("ModuleBuilder/FilesWritten"));
+TRACE_DECLARE_MEMORY_COUNTER(ModuleBuilder_BytesWritten, TEXT("ModuleBuilder/BytesWritten"));
+TRACE_DECLARE_INT_COUNTER(ModuleBuilder_DirsCreated, TEXT("ModuleBuilder/DirsCreated"));
+TRACE_DECLARE_INT_COUNTER(ModuleBuilder_DescriptorsPatched, TEXT("ModuleBuilder/DescriptorsPatched"));
+TRACE_DECLARE_INT_COUNTER(ModuleBuilder_PluginsScanned, TEXT("ModuleBuilder/PluginsScanned"));
+
+static TAutoConsoleVariable<bool> CVarModuleBuilderTimingCsv(
+	TEXT("ModuleBuilder.TimingCsv"),
+	false,
+	TEXT("把 ModuleBuilder 每次操作的分项耗时追加到 Saved/Logs/ModuleBuilderTimings.csv"));
+
+static thread_local FModuleOperationTiming* GCurrentTiming = nullptr;
+
+// CSV 可能被多个操作同时追加
+static FCriticalSection GTimingCsvLock;
+
+TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> FModuleOperationTiming::Create(const FString& Operation)
+{
+	return MakeShared<FModuleOperationTiming, ESPMode::ThreadSafe>(Operation);
+}
+
+FModuleOperationTiming* FModuleOperationTiming::GetCurrent()
+{
+	return GCurrentTiming;
+}
+
+bool FModuleOperationTiming::IsCsvEnabled()
+{
+	return CVarModuleBuilderTimingCsv.GetValueOnAnyThread() || FParse::Param(FCommandLine::Get(), TEXT("ModuleBuilderTimingCsv"));
+}
+
+FString FModuleOperationTiming::GetCsvPath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectLogDir() / TEXT("ModuleBuilderTimings.csv"));
+}
+
+FModuleOperationTiming::FModuleOperationTiming(const FString& InOperation)
+	: Operation(InOperation)
+	, Timestamp(FDateTime::Now())
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FModuleOperationTiming::AddStep(const TCHAR* Step, double Seconds)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FModuleOperationStep* Existing = Steps.FindByPredicate([Step](const FModuleOperationStep& Item) { return Item.Name == Step; });
+	if (!Existing)
+	{
+		Existing = &Steps.AddDefaulted_GetRef();
+		Existing->Name = Step;
+	}
+	Existing->Seconds += Seconds;
+	++Existing->Calls;
+}
+
+void FModuleOperationTiming::AddCount(const TCHAR* Counter, int64 Value)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TPair<FString, int64>* Existing = Counts.FindByPredicate([Counter](const TPair<FString, int64>& Item) { return Item.Key == Counter; });
+	if (Existing)
+	{
+		Existing->Value += Value;
+	}
+	else
+	{
+		Counts.Emplace(Counter, Value);
+	}
+}
+
+void FModuleOperationTiming::AddCountToCurrent(const TCHAR* Counter, int64 Value)
+{
+	if (GCurrentTiming)
+	{
+		GCurrentTiming->AddCount(Counter, Value);
+	}
+}
+
+void FModuleOperationTiming::Finish(bool bInSuccess)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bFinished)
+		{
+			return;
+		}
+		bFinished = true;
+		bSuccess = bInSuccess;
+		TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	UE_LOG(LogModuleBuilder, Log, TEXT("%s"), *FormatSummary());
+
+	if (!IsCsvEnabled())
+	{
+		return;
+	}
+
+	// 每个分项一行：时间, 机器, 操作, 成功, 类别, 名称, 次数 / 计数, 毫秒
+	FString Rows;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		const FString Prefix = FString::Printf(TEXT("%s,%s,\"%s\",%d"),
+			*Timestamp.ToIso8601(), FPlatformProcess::ComputerName(), *Operation.Replace(TEXT("\""), TEXT("\"\"")), bSuccess ? 1 : 0);
+
+		Rows += FString::Printf(TEXT("%s,Total,Total,1,%.3f\n"), *Prefix, TotalSeconds * 1000.0);
+		for (const FModuleOperationStep& Step : Steps)
+		{
+			Rows += FString::Printf(TEXT("%s,Step,%s,%d,%.3f\n"), *Prefix, *Step.Name, Step.Calls, Step.Seconds * 1000.0);
+		}
+		for (const TPair<FString, int64>& Count : Counts)
+		{
+			Rows += FString::Printf(TEXT("%s,Counter,%s,%lld,0\n"), *Prefix, *Count.Key, Count.Value);
+		}
+	}
+
+	FScopeLock CsvLock(&GTimingCsvLock);
+
+	const FString CsvPath = GetCsvPath();
+	if (!FPaths::FileExists(CsvPath))
+	{
+		Rows = TEXT("Timestamp,Machine,Operation,Success,Kind,Name,Count,Milliseconds\n") + Rows;
+	}
+	if (!FFileHelper::SaveStringToFile(Rows, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogModuleBuilder, Warning, TEXT("写入耗时 CSV 失败：%s"), *CsvPath);
+	}
+}
+
+FString FModuleOperationTiming::FormatSummary() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<FString> Parts;
+	for (const FModuleOperationStep& Step : Steps)
+	{
+		Parts.Add(Step.Calls > 1
+			? FString::Printf(TEXT("%s %.1f ms ×%d"), *Step.Name, Step.Seconds * 1000.0, Step.Calls)
+			: FString::Printf(TEXT("%s %.1f ms"), *Step.Name, Step.Seconds * 1000.0));
+	}
+	for (const TPair<FString, int64>& Count : Counts)
+	{
+		Parts.Add(FString::Printf(TEXT("%s=%lld"), *Count.Key, Count.Value));
+	}
+
+	return FString::Printf(TEXT("耗时 %s（%s）：总计 %.1f ms；%s"),
+		*Operation, bSuccess ? TEXT("成功") : TEXT("失败"), TotalSeconds * 1000.0, *FString::Join(Parts, TEXT("，")));
+}
+
+FModuleOperationTimingScope::FModuleOperationTimingScope(const TSharedPtr<FModuleOperationTiming, ESPMode::ThreadSafe>& InTiming)
+	: Timing(InTiming)
+	, Previous(GCurrentTiming)
+{
+	GCurrentTiming = Timing.Get();
+}
+
+FModuleOperationTimingScope::~FModuleOperationTimingScope()
+{
+	GCurrentTiming = Previous;
+}
+
+FModuleTimedStep::FModuleTimedStep(const TCHAR* InName)
+	: Name(InName)
+	, Timing(GCurrentTiming)
+	, StartTime(Timing ? FPlatformTime::Seconds() : 0.0)
+{
+}
+
+FModuleTimedStep::~FModuleTimedStep()
+{
+	if (Timing)
+	{
+		Timing->AddStep(Name, FPlatformTime::Seconds() - StartTime);
+	}
+}
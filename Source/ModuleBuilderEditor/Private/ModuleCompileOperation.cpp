@@ -0,0 +1,384 @@
+#include "ModuleCompileOperation.h"
+#include "ModuleBuilderEditor.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/MonitoredProcess.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_LIVE_CODING
+#include "ILiveCodingModule.h"
+#endif
+
+namespace ModuleCompileOperationPrivate
+{
+	// 失败时摘录到消息里的错误行上限
+	constexpr int32 MaxReportedErrors = 8;
+
+	// UBT -Progress 输出形如 "@progress 'Compiling C++ source code...' 45%"
+	bool ParseProgressLine(const FString& Line, float& OutProgress)
+	{
+		if (!Line.StartsWith(TEXT("@progress")))
+		{
+			return false;
+		}
+
+		FString Trimmed = Line.TrimEnd();
+		if (!Trimmed.EndsWith(TEXT("%")))
+		{
+			return false;
+		}
+
+		int32 Space = INDEX_NONE;
+		Trimmed.FindLastChar(TEXT(' '), Space);
+		const FString Percent = Trimmed.Mid(Space + 1, Trimmed.Len() - Space - 2);
+		if (Percent.IsEmpty() || !Percent.IsNumeric())
+		{
+			return false;
+		}
+
+		OutProgress = FMath::Clamp(FCString::Atof(*Percent) / 100.f, 0.f, 1.f);
+		return true;
+	}
+
+	bool IsErrorLine(const FString& Line)
+	{
+		return Line.Contains(TEXT(": error")) || Line.Contains(TEXT(": fatal error")) || Line.StartsWith(TEXT("ERROR:"));
+	}
+}
+
+FString FModuleHotLoadTimings::ToString() const
+{
+	return FString::Printf(TEXT("总计 %.1f 秒（生成 %.1f，编译 %.1f，登记 %.2f，加载 %.2f）"),
+		GetTotal(), Generate, Compile, Register, Load);
+}
+
+TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> FModuleCompileOperation::Launch(const FString& ModuleName, const FTargetResolveResult& Target, FString& OutError)
+{
+	check(IsInGameThread());
+
+	// 提前判断，免得等 UBT 启动后才报错
+	const FString LiveCodingBlocker = GetLiveCodingBlocker();
+	if (!LiveCodingBlocker.IsEmpty())
+	{
+		OutError = LiveCodingBlocker;
+		return nullptr;
+	}
+
+	FString Executable;
+	FString Arguments;
+	if (!MakeCommandLine(ModuleName, Executable, Arguments, OutError))
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FModuleCompileOperation, ESPMode::ThreadSafe> Operation = MakeShared<FModuleCompileOperation, ESPMode::ThreadSafe>(ModuleName, Target);
+	if (!Operation->Start(Executable, Arguments, OutError))
+	{
+		return nullptr;
+	}
+
+	return Operation;
+}
+
+bool FModuleCompileOperation::MakeCommandLine(const FString& ModuleName, FString& OutExecutable, FString& OutArguments, FString& OutError)
+{
+	const FString TargetName = FindEditorTargetName();
+	if (TargetName.IsEmpty())
+	{
+		OutError = TEXT("工程 Source 目录下没有 *Editor.Target.cs（纯蓝图工程），无法单独编译模块。\n请先重新生成项目文件并完整编译一次。");
+		return false;
+	}
+
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString EngineDir = FPaths::ConvertRelativePathToFull(FPaths::EngineDir());
+
+	// -Module 让 UBT 只执行该模块的动作；不加 -Manifest，makefile 随描述文件时间戳自动失效重建
+	const FString UBTArguments = FString::Printf(TEXT("%s %s %s -Project=\"%s\" -Module=%s -Progress -WaitMutex"),
+		*TargetName,
+		FPlatformMisc::GetUBTPlatform(),
+		FModuleManager::GetUBTConfiguration(),
+		*ProjectFile,
+		*ModuleName);
+
+#if PLATFORM_WINDOWS
+	OutExecutable = EngineDir / TEXT("Binaries/DotNET/UnrealBuildTool/UnrealBuildTool.exe");
+	OutArguments = UBTArguments;
+#else
+	const FString Script = EngineDir / TEXT("Build/BatchFiles") / FPlatformMisc::GetUBTPlatform() / TEXT("Build.sh");
+	OutExecutable = TEXT("/bin/sh");
+	OutArguments = FString::Printf(TEXT("\"%s\" %s"), *Script, *UBTArguments);
+#endif
+
+	if (!IFileManager::Get().FileExists(*OutExecutable))
+	{
+		OutError = FString::Printf(TEXT("找不到 UnrealBuildTool：%s"), *OutExecutable);
+		return false;
+	}
+
+	return true;
+}
+
+FString FModuleCompileOperation::FindEditorTargetName()
+{
+	TArray<FString> TargetFiles;
+	IFileManager::Get().FindFiles(TargetFiles, *(FPaths::GameSourceDir() / TEXT("*Editor.Target.cs")), true, false);
+	if (TargetFiles.IsEmpty())
+	{
+		return FString();
+	}
+
+	// 多个时优先与工程同名的那个
+	const FString Preferred = FString(FApp::GetProjectName()) + TEXT("Editor.Target.cs");
+	const FString& Chosen = TargetFiles.Contains(Preferred) ? Preferred : TargetFiles[0];
+	return Chosen.LeftChop(FCString::Strlen(TEXT(".Target.cs")));
+}
+
+FString FModuleCompileOperation::GetLiveCodingBlocker()
+{
+#if WITH_LIVE_CODING
+	// Live Coding 控制台持有编辑器 Target 的互斥锁；Live++ 只修补已加载模块的代码，无法引入新 DLL
+	ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME);
+	if (LiveCoding && LiveCoding->IsEnabledForSession() && LiveCoding->HasStarted())
+	{
+		return TEXT("Live Coding 会话进行中，UBT 无法单独编译新模块，Live Coding 也不能加载尚未加载过的模块。\n"
+			"请在编辑器偏好设置中关闭 Live Coding 并重启编辑器，或关闭编辑器后从 IDE 编译。");
+	}
+#endif
+	return FString();
+}
+
+FModuleCompileOperation::FModuleCompileOperation(const FString& InModuleName, const FTargetResolveResult& InTarget)
+	: ModuleName(InModuleName)
+	, Target(InTarget)
+	, Timing(FModuleOperationTiming::Create(TEXT("HotLoad ") + InModuleName))
+{
+}
+
+FModuleCompileOperation::~FModuleCompileOperation()
+{
+	// 编辑器关闭时不留下孤儿 UBT 进程
+	if (Process.IsValid() && Process->Update())
+	{
+		Process->Cancel(true);
+	}
+}
+
+bool FModuleCompileOperation::Start(const FString& Executable, const FString& Arguments, FString& OutError)
+{
+	UE_LOG(LogModuleBuilder, Log, TEXT("编译模块 %s：%s %s"), *ModuleName, *Executable, *Arguments);
+
+	Process = MakeShared<FMonitoredProcess>(Executable, Arguments, true, true);
+
+	// FMonitoredProcess 在自己的线程上回调，转回游戏线程再处理
+	TWeakPtr<FModuleCompileOperation, ESPMode::ThreadSafe> WeakSelf = AsShared();
+
+	Process->OnOutput().BindLambda([WeakSelf](FString Line)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakSelf, Line = MoveTemp(Line)]()
+		{
+			if (TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Self = WeakSelf.Pin())
+			{
+				Self->HandleOutputLine(Line);
+			}
+		});
+	});
+
+	Process->OnCompleted().BindLambda([WeakSelf](int32 ReturnCode)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakSelf, ReturnCode]()
+		{
+			if (TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Self = WeakSelf.Pin())
+			{
+				Self->HandleProcessCompleted(ReturnCode);
+			}
+		});
+	});
+
+	Process->OnCanceled().BindLambda([WeakSelf]()
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakSelf]()
+		{
+			if (TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Self = WeakSelf.Pin())
+			{
+				Self->Finish(false, TEXT("已取消编译。"));
+			}
+		});
+	});
+
+	if (!Process->Launch())
+	{
+		Process.Reset();
+		OutError = TEXT("无法启动 UnrealBuildTool。");
+		return false;
+	}
+
+	bRunning = true;
+	StartTime = FPlatformTime::Seconds();
+	return true;
+}
+
+void FModuleCompileOperation::Cancel()
+{
+	if (bRunning && Process.IsValid())
+	{
+		bCancelRequested = true;
+		Process->Cancel(true);
+	}
+}
+
+void FModuleCompileOperation::HandleOutputLine(const FString& Line)
+{
+	float NewProgress = 0.f;
+	if (ModuleCompileOperationPrivate::ParseProgressLine(Line, NewProgress))
+	{
+		Progress = NewProgress;
+		return;
+	}
+
+	UE_LOG(LogModuleBuilder, Log, TEXT("[UBT] %s"), *Line);
+	OutputLines.Add(Line);
+	OutputEvent.Broadcast(Line);
+}
+
+void FModuleCompileOperation::HandleProcessCompleted(int32 ReturnCode)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	if (ReturnCode != 0)
+	{
+		FString Message = FString::Printf(TEXT("编译失败（UBT 返回 %d）"), ReturnCode);
+
+		int32 Reported = 0;
+		for (const FString& Line : OutputLines)
+		{
+			if (ModuleCompileOperationPrivate::IsErrorLine(Line))
+			{
+				Message += TEXT("\n") + Line;
+				if (++Reported == ModuleCompileOperationPrivate::MaxReportedErrors)
+				{
+					break;
+				}
+			}
+		}
+
+		if (OutputLines.ContainsByPredicate([](const FString& Line) { return Line.Contains(TEXT("Live Coding")); }))
+		{
+			Message += TEXT("\n\nLive Coding 会话占用了编辑器 Target，UBT 拒绝在此时编译。请关闭 Live Coding 后重试。");
+		}
+
+		Finish(false, Message);
+		return;
+	}
+
+	Timings.Compile = FPlatformTime::Seconds() - StartTime;
+	Timing->AddStep(TEXT("HotLoad.Compile"), Timings.Compile);
+
+	FModuleOperationTimingScope TimingScope(Timing);
+
+	FString Error;
+	double PhaseStart = FPlatformTime::Seconds();
+	if (!RegisterCompiledModule(Error))
+	{
+		Finish(false, Error);
+		return;
+	}
+	Timings.Register = FPlatformTime::Seconds() - PhaseStart;
+
+	PhaseStart = FPlatformTime::Seconds();
+	if (!LoadCompiledModule(Error))
+	{
+		Finish(false, Error);
+		return;
+	}
+	Timings.Load = FPlatformTime::Seconds() - PhaseStart;
+
+	Finish(true, FString());
+}
+
+bool FModuleCompileOperation::RegisterCompiledModule(FString& OutError)
+{
+	MODULEBUILDER_SCOPE("HotLoad.Register");
+
+	FModuleManager& ModuleManager = FModuleManager::Get();
+
+	if (!Target.bIsProject)
+	{
+		const FString PluginName = FPaths::GetBaseFilename(Target.DescriptorPath);
+		TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(PluginName);
+
+		if (!Plugin.IsValid())
+		{
+			// 启动后才放进工程的插件：加入插件列表并挂载，挂载会登记二进制目录并按加载阶段加载其模块
+			MODULEBUILDER_SCOPE("HotLoad.MountPlugin");
+			IPluginManager::Get().AddToPluginsList(Target.DescriptorPath);
+			Plugin = IPluginManager::Get().MountNewlyCreatedPlugin(PluginName);
+			if (!Plugin.IsValid())
+			{
+				OutError = FString::Printf(TEXT("模块 %s 已编译，但无法挂载插件 %s。重启编辑器后会自动加载。"), *ModuleName, *PluginName);
+				return false;
+			}
+		}
+		else if (!Plugin->IsEnabled())
+		{
+			OutError = FString::Printf(TEXT("插件 %s 未启用，编辑器不会加载其模块。启用插件并重启编辑器后生效。"), *PluginName);
+			return false;
+		}
+		else if (Plugin->GetDescriptor().Modules.IsEmpty())
+		{
+			// 启动时没有代码模块的插件不会登记二进制目录
+			ModuleManager.AddBinariesDirectory(*(Plugin->GetBaseDir() / TEXT("Binaries") / FPlatformProcess::GetBinariesSubdirectory()), true);
+		}
+	}
+
+	// 启动时缓存的模块路径里没有新 DLL，按更新后的 .modules 清单重新查找
+	MODULEBUILDER_SCOPE("HotLoad.ResetModulePaths");
+	ModuleManager.ResetModulePathsCache();
+	return true;
+}
+
+bool FModuleCompileOperation::LoadCompiledModule(FString& OutError)
+{
+	MODULEBUILDER_SCOPE("HotLoad.LoadModule");
+
+	// 插件挂载时可能已按加载阶段加载
+	if (FModuleManager::Get().IsModuleLoaded(*ModuleName))
+	{
+		UE_LOG(LogModuleBuilder, Log, TEXT("模块 %s 已编译并加载"), *ModuleName);
+		return true;
+	}
+
+	EModuleLoadResult LoadResult = EModuleLoadResult::Success;
+	if (!FModuleManager::Get().LoadModuleWithFailureReason(*ModuleName, LoadResult))
+	{
+		OutError = FString::Printf(TEXT("模块 %s 已编译，但加载失败（EModuleLoadResult = %d）。重启编辑器后会自动加载。"),
+			*ModuleName, static_cast<int32>(LoadResult));
+		return false;
+	}
+
+	UE_LOG(LogModuleBuilder, Log, TEXT("模块 %s 已编译并加载"), *ModuleName);
+	return true;
+}
+
+void FModuleCompileOperation::Finish(bool bSuccess, const FString& Message)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	Progress = bSuccess ? 1.f : Progress;
+	Process.Reset();
+	Timing->Finish(bSuccess);
+
+	// 广播期间调用方可能释放最后一个引用
+	TSharedRef<FModuleCompileOperation, ESPMode::ThreadSafe> KeepAlive = AsShared();
+	CompletedEvent.Broadcast(bSuccess, Message);
+}
@@ -0,0 +1,739 @@
+#include "ModuleDependencyGraph.h"
+#include "IncludeResolver.h"
+#include "PluginDescriptorScanner.h"
+
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleDependencyGraphPrivate
+{
+
+// ===== Build.cs / 源文件解析 =====
+
+// 注释替换为空格（保留换行），字符串字面量原样保留，输出与输入逐字符对齐
+static FString BlankComments(const FString& Text, bool bKeepCharLiterals)
+{
+	FString Out = Text;
+
+	int32 Index = 0;
+	while (Index < Out.Len())
+	{
+		const TCHAR C = Out[Index];
+
+		if (C == TEXT('"') || (bKeepCharLiterals && C == TEXT('\'')))
+		{
+			++Index;
+			while (Index < Out.Len() && Out[Index] != C && Out[Index] != TEXT('\n'))
+			{
+				Index += Out[Index] == TEXT('\\') ? 2 : 1;
+			}
+			++Index;
+			continue;
+		}
+
+		if (C == TEXT('/') && Index + 1 < Out.Len() && Out[Index + 1] == TEXT('/'))
+		{
+			while (Index < Out.Len() && Out[Index] != TEXT('\n'))
+			{
+				Out[Index++] = TEXT(' ');
+			}
+			continue;
+		}
+
+		if (C == TEXT('/') && Index + 1 < Out.Len() && Out[Index + 1] == TEXT('*'))
+		{
+			while (Index < Out.Len())
+			{
+				const bool bEnd = Out[Index] == TEXT('*') && Index + 1 < Out.Len() && Out[Index + 1] == TEXT('/');
+				if (Out[Index] != TEXT('\n'))
+				{
+					Out[Index] = TEXT(' ');
+				}
+				++Index;
+				if (bEnd)
+				{
+					Out[Index++] = TEXT(' ');
+					break;
+				}
+			}
+			continue;
+		}
+
+		++Index;
+	}
+
+	return Out;
+}
+
+// 收集 ListName.Add(...) / ListName.AddRange(...) 调用及其中的字符串字面量
+static void ExtractDependencyLists(const FString& Code, const TCHAR* ListName, bool bPublic, TArray<FBuildCsDependencyList>& OutLists)
+{
+	const int32 NameLen = FCString::Strlen(ListName);
+
+	int32 Search = 0;
+	while (true)
+	{
+		const int32 Found = Code.Find(ListName, ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+		if (Found == INDEX_NONE)
+		{
+			return;
+		}
+		Search = Found + NameLen;
+
+		if (Found > 0 && (FChar::IsAlnum(Code[Found - 1]) || Code[Found - 1] == TEXT('_')))
+		{
+			continue;
+		}
+
+		int32 Pos = Search;
+		while (Pos < Code.Len() && FChar::IsWhitespace(Code[Pos])) ++Pos;
+		if (Pos >= Code.Len() || Code[Pos] != TEXT('.'))
+		{
+			continue;
+		}
+		++Pos;
+		while (Pos < Code.Len() && FChar::IsWhitespace(Code[Pos])) ++Pos;
+
+		const int32 MethodBegin = Pos;
+		while (Pos < Code.Len() && FChar::IsAlpha(Code[Pos])) ++Pos;
+		const FString Method = Code.Mid(MethodBegin, Pos - MethodBegin);
+		if (Method != TEXT("Add") && Method != TEXT("AddRange"))
+		{
+			continue;
+		}
+
+		while (Pos < Code.Len() && FChar::IsWhitespace(Code[Pos])) ++Pos;
+		if (Pos >= Code.Len() || Code[Pos] != TEXT('('))
+		{
+			continue;
+		}
+
+		FBuildCsDependencyList& List = OutLists.AddDefaulted_GetRef();
+		List.bPublic = bPublic;
+		List.bAddRange = Method == TEXT("AddRange");
+		List.NameBegin = Found;
+		List.ParenOpen = Pos;
+
+		int32 Depth = 0;
+		for (; Pos < Code.Len(); ++Pos)
+		{
+			const TCHAR C = Code[Pos];
+			if (C == TEXT('('))
+			{
+				++Depth;
+			}
+			else if (C == TEXT(')'))
+			{
+				if (--Depth == 0)
+				{
+					break;
+				}
+			}
+			else if (C == TEXT('"'))
+			{
+				const int32 LiteralBegin = Pos++;
+				while (Pos < Code.Len() && Code[Pos] != TEXT('"'))
+				{
+					Pos += Code[Pos] == TEXT('\\') ? 2 : 1;
+				}
+				const FString Literal = Code.Mid(LiteralBegin + 1, Pos - LiteralBegin - 1);
+				if (!Literal.IsEmpty())
+				{
+					List.Literals.Add({ Literal, LiteralBegin, Pos + 1 });
+				}
+			}
+		}
+		List.ParenClose = FMath::Min(Pos, Code.Len() - 1);
+		Search = Pos;
+	}
+}
+
+} // namespace ModuleDependencyGraphPrivate
+
+void FModuleDependencyGraph::ParseBuildCsLists(const FString& Text, TArray<FBuildCsDependencyList>& OutLists)
+{
+	using namespace ModuleDependencyGraphPrivate;
+
+	const FString Code = BlankComments(Text, false);
+	ExtractDependencyLists(Code, TEXT("PublicDependencyModuleNames"), true, OutLists);
+	ExtractDependencyLists(Code, TEXT("PrivateDependencyModuleNames"), false, OutLists);
+
+	OutLists.Sort([](const FBuildCsDependencyList& A, const FBuildCsDependencyList& B) { return A.NameBegin < B.NameBegin; });
+}
+
+void FModuleDependencyGraph::ParseBuildCs(const FString& Text, TArray<FString>& OutPublic, TArray<FString>& OutPrivate)
+{
+	TArray<FBuildCsDependencyList> Lists;
+	ParseBuildCsLists(Text, Lists);
+
+	for (const FBuildCsDependencyList& List : Lists)
+	{
+		for (const FBuildCsLiteral& Literal : List.Literals)
+		{
+			(List.bPublic ? OutPublic : OutPrivate).AddUnique(Literal.Name);
+		}
+	}
+
+	// 同时出现在两边的按 Public 处理
+	OutPrivate.RemoveAll([&OutPublic](const FString& Name) { return OutPublic.Contains(Name); });
+}
+
+void FModuleDependencyGraph::ParseBuildCsAssignments(const FString& Text, TArray<FBuildCsAssignment>& OutAssignments)
+{
+	using namespace ModuleDependencyGraphPrivate;
+
+	const FString Code = BlankComments(Text, false);
+
+	int32 Pos = 0;
+	while (Pos < Code.Len())
+	{
+		// 跳过字符串，只在语句起点找标识符
+		if (Code[Pos] == TEXT('"'))
+		{
+			++Pos;
+			while (Pos < Code.Len() && Code[Pos] != TEXT('"'))
+			{
+				Pos += Code[Pos] == TEXT('\\') ? 2 : 1;
+			}
+			++Pos;
+			continue;
+		}
+
+		const bool bIdentifierStart = (FChar::IsAlpha(Code[Pos]) || Code[Pos] == TEXT('_'))
+			&& (Pos == 0 || FChar::IsWhitespace(Code[Pos - 1]) || Code[Pos - 1] == TEXT(';') || Code[Pos - 1] == TEXT('{') || Code[Pos - 1] == TEXT('}'));
+		if (!bIdentifierStart)
+		{
+			++Pos;
+			continue;
+		}
+
+		const int32 KeyBegin = Pos;
+		while (Pos < Code.Len() && (FChar::IsAlnum(Code[Pos]) || Code[Pos] == TEXT('_')))
+		{
+			++Pos;
+		}
+		const int32 KeyEnd = Pos;
+
+		int32 Cursor = Pos;
+		while (Cursor < Code.Len() && FChar::IsWhitespace(Code[Cursor])) ++Cursor;
+		if (Cursor + 1 >= Code.Len() || Code[Cursor] != TEXT('=') || Code[Cursor + 1] == TEXT('='))
+		{
+			continue;
+		}
+		++Cursor;
+		while (Cursor < Code.Len() && FChar::IsWhitespace(Code[Cursor])) ++Cursor;
+
+		const int32 Semicolon = Code.Find(TEXT(";"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Cursor);
+		if (Semicolon == INDEX_NONE)
+		{
+			return;
+		}
+
+		int32 ValueEnd = Semicolon;
+		while (ValueEnd > Cursor && FChar::IsWhitespace(Code[ValueEnd - 1])) --ValueEnd;
+
+		FBuildCsAssignment& Assignment = OutAssignments.AddDefaulted_GetRef();
+		Assignment.Key = Code.Mid(KeyBegin, KeyEnd - KeyBegin);
+		Assignment.Value = Code.Mid(Cursor, ValueEnd - Cursor);
+		Assignment.StatementBegin = KeyBegin;
+		Assignment.ValueBegin = Cursor;
+		Assignment.ValueEnd = ValueEnd;
+		Assignment.StatementEnd = Semicolon + 1;
+
+		Pos = Semicolon + 1;
+	}
+}
+
+void FModuleDependencyGraph::ParseIncludes(const FString& Text, TArray<FString>& OutIncludes)
+{
+	using namespace ModuleDependencyGraphPrivate;
+
+	const FString Code = BlankComments(Text, true);
+
+	int32 LineBegin = 0;
+	while (LineBegin < Code.Len())
+	{
+		int32 LineEnd = Code.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, LineBegin);
+		if (LineEnd == INDEX_NONE)
+		{
+			LineEnd = Code.Len();
+		}
+
+		int32 Pos = LineBegin;
+		while (Pos < LineEnd && FChar::IsWhitespace(Code[Pos])) ++Pos;
+		if (Pos < LineEnd && Code[Pos] == TEXT('#'))
+		{
+			++Pos;
+			while (Pos < LineEnd && FChar::IsWhitespace(Code[Pos])) ++Pos;
+			if (FCString::Strncmp(*Code + Pos, TEXT("include"), 7) == 0)
+			{
+				Pos += 7;
+				while (Pos < LineEnd && FChar::IsWhitespace(Code[Pos])) ++Pos;
+
+				const TCHAR Close = Pos < LineEnd && Code[Pos] == TEXT('<') ? TEXT('>') : TEXT('"');
+				if (Pos < LineEnd && (Code[Pos] == TEXT('<') || Code[Pos] == TEXT('"')))
+				{
+					const int32 PathEnd = Code.Find(FString::Chr(Close), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos + 1);
+					if (PathEnd != INDEX_NONE && PathEnd < LineEnd)
+					{
+						OutIncludes.Add(Code.Mid(Pos + 1, PathEnd - Pos - 1));
+					}
+				}
+			}
+		}
+
+		LineBegin = LineEnd + 1;
+	}
+}
+
+// ===== 构建 =====
+
+TArray<FModuleSourceRoot> FModuleDependencyGraph::GetProjectSourceRoots()
+{
+	check(IsInGameThread());
+
+	TArray<FModuleSourceRoot> Roots;
+	TSet<FString> SeenDirs;
+
+	auto AddRoot = [&Roots, &SeenDirs](const FString& Dir, const FString& Owner)
+	{
+		const FString FullDir = FPaths::ConvertRelativePathToFull(Dir);
+		bool bAlreadyInSet = false;
+		SeenDirs.Add(FullDir, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Roots.Add({ FullDir, Owner });
+		}
+	};
+
+	AddRoot(FPaths::ProjectDir() / TEXT("Source"), FApp::GetProjectName());
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		if (Plugin->GetType() == EPluginType::Project)
+		{
+			AddRoot(Plugin->GetBaseDir() / TEXT("Source"), Plugin->GetName());
+		}
+	}
+
+	for (const FScannedPlugin& Scanned : FPluginDescriptorScanner::Get().GetPlugins())
+	{
+		AddRoot(Scanned.GetBaseDir() / TEXT("Source"), Scanned.Name);
+	}
+
+	return Roots;
+}
+
+void FModuleDependencyGraph::Build(const TArray<FModuleSourceRoot>& Roots)
+{
+	Nodes.Reset();
+	NodeByName.Reset();
+	Dependents.Reset();
+
+	for (const FModuleSourceRoot& Root : Roots)
+	{
+		TArray<FString> BuildFiles;
+		IFileManager::Get().FindFilesRecursive(BuildFiles, *Root.Dir, TEXT("*.Build.cs"), true, false);
+
+		for (const FString& BuildCsPath : BuildFiles)
+		{
+			FModuleNode& Node = Nodes.AddDefaulted_GetRef();
+			Node.BuildCsPath = BuildCsPath;
+			Node.ModuleDir = FPaths::GetPath(BuildCsPath);
+			Node.Name = FPaths::GetCleanFilename(BuildCsPath).LeftChop(FCString::Strlen(TEXT(".Build.cs")));
+			Node.Owner = Root.Owner;
+		}
+	}
+
+	// 每个模块独立：读取 Build.cs、统计源文件
+	ParallelFor(Nodes.Num(), [this](int32 Index)
+	{
+		FModuleNode& Node = Nodes[Index];
+
+		FString Text;
+		if (FFileHelper::LoadFileToString(Text, *Node.BuildCsPath))
+		{
+			ParseBuildCs(Text, Node.PublicDependencies, Node.PrivateDependencies);
+		}
+
+		TArray<FString> Sources;
+		ModuleBuilder::FindModuleFiles(Node.ModuleDir, TEXT(".cpp"), Sources);
+		Node.SourceFiles = Sources.Num();
+	});
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		NodeByName.Add(Nodes[Index].Name, Index);
+	}
+
+	Dependents.SetNum(Nodes.Num());
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		FModuleNode& Node = Nodes[Index];
+
+		for (const FString& Dep : Node.PublicDependencies)
+		{
+			if (const int32* DepIndex = NodeByName.Find(Dep))
+			{
+				Node.PublicEdges.Add(*DepIndex);
+				Node.AllEdges.AddUnique(*DepIndex);
+			}
+		}
+		for (const FString& Dep : Node.PrivateDependencies)
+		{
+			if (const int32* DepIndex = NodeByName.Find(Dep))
+			{
+				Node.AllEdges.AddUnique(*DepIndex);
+			}
+		}
+
+		for (int32 DepIndex : Node.AllEdges)
+		{
+			Dependents[DepIndex].Add(Index);
+		}
+	}
+}
+
+int32 FModuleDependencyGraph::FindNode(const FString& ModuleName) const
+{
+	const int32* Index = NodeByName.Find(ModuleName);
+	return Index ? *Index : INDEX_NONE;
+}
+
+// ===== 图外模块 =====
+
+TArray<FModuleSourceRoot> FExternalModuleIndex::GetEngineSourceRoots()
+{
+	check(IsInGameThread());
+
+	TArray<FModuleSourceRoot> Roots;
+	Roots.Add({ FPaths::ConvertRelativePathToFull(FPaths::EngineSourceDir()), TEXT("Engine") });
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+	{
+		if (Plugin->GetType() != EPluginType::Project)
+		{
+			Roots.Add({ FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Source")), Plugin->GetName() });
+		}
+	}
+
+	return Roots;
+}
+
+void FExternalModuleIndex::Build(const TArray<FModuleSourceRoot>& Roots)
+{
+	BuildCsByName.Reset();
+	PublicDependencyCache.Reset();
+
+	for (const FModuleSourceRoot& Root : Roots)
+	{
+		TArray<FString> BuildFiles;
+		IFileManager::Get().FindFilesRecursive(BuildFiles, *Root.Dir, TEXT("*.Build.cs"), true, false);
+
+		for (const FString& BuildCsPath : BuildFiles)
+		{
+			const FString Name = FPaths::GetCleanFilename(BuildCsPath).LeftChop(FCString::Strlen(TEXT(".Build.cs")));
+			BuildCsByName.FindOrAdd(Name, BuildCsPath);
+		}
+	}
+}
+
+FString FExternalModuleIndex::FindModuleDir(const FString& ModuleName) const
+{
+	const FString* BuildCsPath = BuildCsByName.Find(ModuleName);
+	return BuildCsPath ? FPaths::GetPath(*BuildCsPath) : FString();
+}
+
+FString FExternalModuleIndex::FindHeaderOwner(const FString& Include) const
+{
+	for (const TPair<FString, FString>& Pair : BuildCsByName)
+	{
+		const FString ModuleDir = FPaths::GetPath(Pair.Value);
+		for (const TCHAR* Folder : ModuleBuilder::GetPublicTopFolders())
+		{
+			if (FPaths::FileExists(ModuleDir / Folder / Include))
+			{
+				return Pair.Key;
+			}
+		}
+	}
+	return FString();
+}
+
+const TArray<FString>& FExternalModuleIndex::GetPublicDependencies(const FString& ModuleName)
+{
+	if (const TArray<FString>* Cached = PublicDependencyCache.Find(ModuleName))
+	{
+		return *Cached;
+	}
+
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+
+	FString Text;
+	const FString* BuildCsPath = BuildCsByName.Find(ModuleName);
+	if (BuildCsPath && FFileHelper::LoadFileToString(Text, **BuildCsPath))
+	{
+		FModuleDependencyGraph::ParseBuildCs(Text, PublicDependencies, PrivateDependencies);
+	}
+
+	return PublicDependencyCache.Add(ModuleName, MoveTemp(PublicDependencies));
+}
+
+// ===== 分析 =====
+
+TArray<TArray<int32>> FModuleDependencyGraph::FindCycles() const
+{
+	// Tarjan 强连通分量
+	TArray<int32> IndexOf;
+	TArray<int32> LowLink;
+	TArray<bool> OnStack;
+	IndexOf.Init(INDEX_NONE, Nodes.Num());
+	LowLink.Init(0, Nodes.Num());
+	OnStack.Init(false, Nodes.Num());
+
+	TArray<int32> Stack;
+	TArray<TArray<int32>> Cycles;
+	int32 NextIndex = 0;
+
+	TFunction<void(int32)> StrongConnect = [&](int32 V)
+	{
+		IndexOf[V] = LowLink[V] = NextIndex++;
+		Stack.Push(V);
+		OnStack[V] = true;
+
+		for (int32 W : Nodes[V].AllEdges)
+		{
+			if (IndexOf[W] == INDEX_NONE)
+			{
+				StrongConnect(W);
+				LowLink[V] = FMath::Min(LowLink[V], LowLink[W]);
+			}
+			else if (OnStack[W])
+			{
+				LowLink[V] = FMath::Min(LowLink[V], IndexOf[W]);
+			}
+		}
+
+		if (LowLink[V] == IndexOf[V])
+		{
+			TArray<int32> Component;
+			int32 W = INDEX_NONE;
+			do
+			{
+				W = Stack.Pop();
+				OnStack[W] = false;
+				Component.Add(W);
+			}
+			while (W != V);
+
+			if (Component.Num() > 1 || Nodes[V].AllEdges.Contains(V))
+			{
+				Cycles.Add(MoveTemp(Component));
+			}
+		}
+	};
+
+	for (int32 V = 0; V < Nodes.Num(); ++V)
+	{
+		if (IndexOf[V] == INDEX_NONE)
+		{
+			StrongConnect(V);
+		}
+	}
+
+	return Cycles;
+}
+
+TSet<FString> FModuleDependencyGraph::GetPublicClosure(int32 Node) const
+{
+	TSet<FString> Closure;
+	TArray<int32> Queue = { Node };
+	TSet<int32> Visited = { Node };
+
+	while (Queue.Num() > 0)
+	{
+		const FModuleNode& Current = Nodes[Queue.Pop(EAllowShrinking::No)];
+		for (const FString& Dep : Current.PublicDependencies)
+		{
+			Closure.Add(Dep);
+
+			const int32* DepIndex = NodeByName.Find(Dep);
+			if (DepIndex && !Visited.Contains(*DepIndex))
+			{
+				Visited.Add(*DepIndex);
+				Queue.Add(*DepIndex);
+			}
+		}
+	}
+
+	return Closure;
+}
+
+TSet<int32> FModuleDependencyGraph::GetRebuildExposure(int32 Node) const
+{
+	// 先找出把本模块公开转发出去的模块（沿反向 Public 边）
+	TSet<int32> Forwarders = { Node };
+	TArray<int32> Queue = { Node };
+
+	while (Queue.Num() > 0)
+	{
+		const int32 Current = Queue.Pop(EAllowShrinking::No);
+		for (int32 Dependent : Dependents[Current])
+		{
+			if (Nodes[Dependent].PublicEdges.Contains(Current) && !Forwarders.Contains(Dependent))
+			{
+				Forwarders.Add(Dependent);
+				Queue.Add(Dependent);
+			}
+		}
+	}
+
+	// 依赖任一转发者的模块都能看到本模块的公开头文件
+	TSet<int32> Exposure;
+	for (int32 Forwarder : Forwarders)
+	{
+		for (int32 Dependent : Dependents[Forwarder])
+		{
+			if (Dependent != Node)
+			{
+				Exposure.Add(Dependent);
+			}
+		}
+	}
+	return Exposure;
+}
+
+TArray<int32> FModuleDependencyGraph::ComputeCriticalPath(int32& OutCost) const
+{
+	// 0 = 未访问，1 = 访问中（遇到即视为环，跳过该边），2 = 完成
+	TArray<uint8> State;
+	TArray<int32> Longest;
+	TArray<int32> Next;
+	State.Init(0, Nodes.Num());
+	Longest.Init(0, Nodes.Num());
+	Next.Init(INDEX_NONE, Nodes.Num());
+
+	TFunction<int32(int32)> Visit = [&](int32 V) -> int32
+	{
+		if (State[V] == 2)
+		{
+			return Longest[V];
+		}
+		State[V] = 1;
+
+		int32 Best = 0;
+		for (int32 W : Nodes[V].AllEdges)
+		{
+			if (State[W] == 1)
+			{
+				continue;
+			}
+			const int32 Cost = Visit(W);
+			if (Cost > Best)
+			{
+				Best = Cost;
+				Next[V] = W;
+			}
+		}
+
+		Longest[V] = FMath::Max(1, Nodes[V].SourceFiles) + Best;
+		State[V] = 2;
+		return Longest[V];
+	};
+
+	int32 Start = INDEX_NONE;
+	OutCost = 0;
+	for (int32 V = 0; V < Nodes.Num(); ++V)
+	{
+		const int32 Cost = Visit(V);
+		if (Cost > OutCost)
+		{
+			OutCost = Cost;
+			Start = V;
+		}
+	}
+
+	// Start 是最上层模块，沿 Next 走到最底层依赖，再反转为编译顺序
+	TArray<int32> Path;
+	for (int32 V = Start; V != INDEX_NONE; V = Next[V])
+	{
+		Path.Add(V);
+	}
+	Algo::Reverse(Path);
+	return Path;
+}
+
+FString FModuleDependencyGraph::BuildReport() const
+{
+	FString Report;
+	Report += FString::Printf(TEXT("模块数：%d\n\n"), Nodes.Num());
+
+	if (Nodes.Num() == 0)
+	{
+		return Report;
+	}
+
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+
+	// 扇入 / 扇出
+	Report += TEXT("== 扇入 / 扇出（按扇入排序）==\n");
+	Order.Sort([this](int32 A, int32 B) { return Dependents[A].Num() > Dependents[B].Num(); });
+	for (int32 Index : Order)
+	{
+		const FModuleNode& Node = Nodes[Index];
+		Report += FString::Printf(TEXT("  %-40s 扇入 %3d  扇出 %3d（Public %d / Private %d）  源文件 %d  [%s]\n"),
+			*Node.Name, Dependents[Index].Num(),
+			Node.PublicDependencies.Num() + Node.PrivateDependencies.Num(),
+			Node.PublicDependencies.Num(), Node.PrivateDependencies.Num(),
+			Node.SourceFiles, *Node.Owner);
+	}
+
+	// 环
+	const TArray<TArray<int32>> Cycles = FindCycles();
+	Report += FString::Printf(TEXT("\n== 依赖环：%d 个 ==\n"), Cycles.Num());
+	for (const TArray<int32>& Cycle : Cycles)
+	{
+		TArray<FString> Names;
+		for (int32 Index : Cycle)
+		{
+			Names.Add(Nodes[Index].Name);
+		}
+		Report += TEXT("  ") + FString::Join(Names, TEXT(" <-> ")) + TEXT("\n");
+	}
+
+	// Public 传递闭包与级联重编
+	Report += TEXT("\n== Public 依赖传递闭包 / 公开头文件变化时的级联重编（按影响排序）==\n");
+	TArray<TPair<int32, int32>> Exposure;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Exposure.Add({ Index, GetRebuildExposure(Index).Num() });
+	}
+	Exposure.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Value > B.Value; });
+	for (const TPair<int32, int32>& Pair : Exposure)
+	{
+		Report += FString::Printf(TEXT("  %-40s 传递 Public 依赖 %3d  级联影响模块 %3d\n"),
+			*Nodes[Pair.Key].Name, GetPublicClosure(Pair.Key).Num(), Pair.Value);
+	}
+
+	// 关键路径
+	int32 CriticalCost = 0;
+	const TArray<int32> CriticalPath = ComputeCriticalPath(CriticalCost);
+	Report += FString::Printf(TEXT("\n== 编译关键路径（按源文件数加权，总计 %d）==\n"), CriticalCost);
+	for (int32 Index : CriticalPath)
+	{
+		Report += FString::Printf(TEXT("  %s（%d）\n"), *Nodes[Index].Name, Nodes[Index].SourceFiles);
+	}
+
+	return Report;
+}
@@ -0,0 +1,692 @@
+#include "ModuleGenerator.h"
+#include "DescriptorPatcher.h"
+#include "ModuleBuilderEditor.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleNameIndex.h"
+#include "ModuleStaging.h"
+#include "ModuleTemplate.h"
+#include "PluginDescriptorScanner.h"
+#include "UnityBuildAdvisor.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace ModuleBuilder
+{
+
+bool ResolveTargetFromParams(const FNewModuleParams& Params, FTargetResolveResult& Out, FString& OutError)
+{
+	MODULEBUILDER_SCOPE("ResolveTarget");
+
+	if (Params.TargetType == EModuleTargetType::Project)
+	{
+		Out.bIsProject = true;
+		Out.ContainerRoot = FPaths::ProjectDir();
+		Out.DescriptorPath = FPaths::GetProjectFilePath();
+		return true;
+	}
+
+	if (Params.TargetType == EModuleTargetType::ProjectPlugin)
+	{
+		TSharedPtr<IPlugin> Plugin;
+		{
+			MODULEBUILDER_SCOPE("ResolveTarget.FindPlugin");
+			Plugin = IPluginManager::Get().FindPlugin(Params.TargetPluginName);
+		}
+		if (Plugin.IsValid())
+		{
+			Out.bIsProject = false;
+			Out.ContainerRoot = Plugin->GetBaseDir();
+			Out.DescriptorPath = Plugin->GetDescriptorFileName();
+			return true;
+		}
+
+		// 未启用或未挂载的插件从磁盘扫描结果中查找
+		MODULEBUILDER_SCOPE("ResolveTarget.FindScannedPlugin");
+		if (const FScannedPlugin* Scanned = FPluginDescriptorScanner::Get().FindPlugin(Params.TargetPluginName))
+		{
+			Out.bIsProject = false;
+			Out.ContainerRoot = Scanned->GetBaseDir();
+			Out.DescriptorPath = Scanned->DescriptorPath;
+			return true;
+		}
+
+		OutError = TEXT("未找到目标插件：") + Params.TargetPluginName;
+		return false;
+	}
+
+	OutError = TEXT("未知的目标类型。");
+	return false;
+}
+
+// 默认 PCH 头文件所属模块；Shared PCH 的依赖方也会包含它们，所属模块须为 Public 依赖
+struct FPCHHeaderOwner
+{
+	const TCHAR* Header;
+	const TCHAR* Module;
+};
+
+static const FPCHHeaderOwner GPCHHeaderOwners[] =
+{
+	{ TEXT("CoreMinimal.h"),              TEXT("Core") },
+	{ TEXT("UObject/Object.h"),           TEXT("CoreUObject") },
+	{ TEXT("GameFramework/Actor.h"),      TEXT("Engine") },
+	{ TEXT("Editor.h"),                   TEXT("UnrealEd") },
+	{ TEXT("Widgets/SCompoundWidget.h"),  TEXT("SlateCore") },
+};
+
+static const TCHAR* FindPCHHeaderOwner(const FString& Header)
+{
+	for (const FPCHHeaderOwner& Owner : GPCHHeaderOwners)
+	{
+		if (Header.Equals(Owner.Header, ESearchCase::IgnoreCase))
+		{
+			return Owner.Module;
+		}
+	}
+	return nullptr;
+}
+
+// PCH 包含的头文件：模式为 None 时为空，未指定时取模板默认
+static TArray<FString> GetPCHHeaders(const FNewModuleParams& Params)
+{
+	if (Params.PCHMode == EModulePCHMode::None)
+	{
+		return TArray<FString>();
+	}
+	return Params.PCHHeaders.Num() > 0 ? Params.PCHHeaders : GetDefaultPCHHeaders(Params);
+}
+
+// 公开头文件只用到 Core，其余依赖默认私有，不向依赖方传递
+static void GetBuildCsDependencies(const FNewModuleParams& Params, const TArray<FString>& PCHHeaders, TArray<FString>& OutPublic, TArray<FString>& OutPrivate)
+{
+	OutPublic = { TEXT("Core") };
+	OutPrivate.Reset();
+
+	// Core-only：没有 CoreUObject，也就没有反射代码需要 UHT 处理
+	if (Params.Archetype != EModuleArchetype::CoreOnly)
+	{
+		OutPrivate = { TEXT("CoreUObject"), TEXT("Engine") };
+
+		if (Params.IsEditorModule())
+		{
+			OutPrivate.Append({ TEXT("UnrealEd"), TEXT("Slate"), TEXT("SlateCore"), TEXT("ToolMenus") });
+		}
+	}
+
+	// PCH 中头文件的所属模块必须是依赖；Shared PCH 会被依赖方包含，所属模块提升为 Public
+	for (const FString& Header : PCHHeaders)
+	{
+		const FString* Resolved = Params.PCHHeaderOwners.Find(Header);
+		const TCHAR* Owner = Resolved ? **Resolved : FindPCHHeaderOwner(Header);
+		if (!Owner || OutPublic.Contains(Owner))
+		{
+			continue;
+		}
+
+		if (Params.PCHMode == EModulePCHMode::Shared)
+		{
+			OutPrivate.Remove(Owner);
+			OutPublic.Add(Owner);
+		}
+		else
+		{
+			OutPrivate.AddUnique(Owner);
+		}
+	}
+
+	for (const FString& Module : Params.ExtraPublicDependencies)
+	{
+		OutPrivate.Remove(Module);
+		OutPublic.AddUnique(Module);
+	}
+	for (const FString& Module : Params.ExtraPrivateDependencies)
+	{
+		if (!OutPublic.Contains(Module))
+		{
+			OutPrivate.AddUnique(Module);
+		}
+	}
+}
+
+// 每行一项，缩进由模板中变量所在行决定
+static FString FormatDependencyList(const TArray<FString>& Modules)
+{
+	FString Text;
+	for (int32 Index = 0; Index < Modules.Num(); ++Index)
+	{
+		Text += TEXT("\"") + Modules[Index] + (Index + 1 < Modules.Num() ? TEXT("\",\n") : TEXT("\""));
+	}
+	return Text;
+}
+
+static void SetPCHVariables(FModuleTemplateVariables& Variables, const TArray<FString>& Headers, EModulePCHMode Mode)
+{
+	FString Includes;
+	for (const FString& Header : Headers)
+	{
+		Includes += (Includes.IsEmpty() ? TEXT("#include \"") : TEXT("\n#include \"")) + Header + TEXT("\"");
+	}
+	Variables.Set(TEXT("PCHIncludes"), MoveTemp(Includes));
+	Variables.SetFlag(TEXT("SharedPCH"), Mode == EModulePCHMode::Shared);
+}
+
+// 一个模块所有文件共用的模板变量
+static FModuleTemplateVariables MakeTemplateVariables(const FNewModuleParams& Params, const TArray<FString>& PCHHeaders)
+{
+	const FString& ModuleName = Params.ModuleName;
+	const FString UpperName = ModuleName.ToUpper();
+
+	FModuleTemplateVariables Variables;
+	Variables.Set(TEXT("ModuleName"), ModuleName);
+	Variables.Set(TEXT("ModuleNameUpper"), UpperName);
+	Variables.Set(TEXT("ModuleApi"), UpperName + TEXT("_API"));
+	Variables.Set(TEXT("ModuleType"), Params.ModuleType);
+	Variables.Set(TEXT("LoadingPhase"), Params.LoadingPhase);
+	Variables.SetFlag(TEXT("CoreOnly"), Params.Archetype == EModuleArchetype::CoreOnly);
+	Variables.SetFlag(TEXT("Editor"), Params.IsEditorModule());
+	Variables.SetFlag(TEXT("Instrumented"), Params.bInstrumented);
+
+	const FString PCHPath = GetPCHHeaderRelativePath(ModuleName, Params.PCHMode);
+	Variables.Set(TEXT("PrivatePCHHeaderFile"), Params.PCHMode == EModulePCHMode::Private ? PCHPath : FString());
+	Variables.Set(TEXT("SharedPCHHeaderFile"), Params.PCHMode == EModulePCHMode::Shared ? PCHPath : FString());
+	SetPCHVariables(Variables, PCHHeaders, Params.PCHMode);
+
+	// unity 与 PCH 只写阈值，模块长大后自动生效
+	FString UnitySettings = FormatUnitySettings(GetGeneratedModuleUnitySettings(Params.PCHMode != EModulePCHMode::None), TEXT(""));
+	UnitySettings.RemoveFromEnd(TEXT("\n"));
+	Variables.Set(TEXT("UnitySettings"), MoveTemp(UnitySettings));
+
+	TArray<FString> PublicModules;
+	TArray<FString> PrivateModules;
+	GetBuildCsDependencies(Params, PCHHeaders, PublicModules, PrivateModules);
+	Variables.Set(TEXT("PublicDependencies"), FormatDependencyList(PublicModules));
+	Variables.Set(TEXT("PrivateDependencies"), FormatDependencyList(PrivateModules));
+
+	return Variables;
+}
+
+bool LoadTextPreservingEncoding(const FString& Path, FString& OutText, bool& bOutHasBom)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		return false;
+	}
+
+	bOutHasBom = Bytes.Num() >= 3 && Bytes[0] == 0xEF && Bytes[1] == 0xBB && Bytes[2] == 0xBF;
+	FFileHelper::BufferToString(OutText, Bytes.GetData(), Bytes.Num());
+	return true;
+}
+
+bool SaveTextPreservingEncoding(const FString& Path, const FString& Text, bool bHasBom)
+{
+	return FFileHelper::SaveStringToFile(Text, *Path, bHasBom
+		? FFileHelper::EEncodingOptions::ForceUTF8
+		: FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString GetModuleDir(const FString& ContainerRoot, const FString& ModuleName)
+{
+	const FString SourceDir = FPaths::ConvertRelativePathToFull(ContainerRoot / TEXT("Source"));
+	return FPaths::ConvertRelativePathToFull(SourceDir / ModuleName);
+}
+
+TArray<FString> GetDefaultPCHHeaders(const FNewModuleParams& Params)
+{
+	TArray<FString> Headers = { TEXT("CoreMinimal.h") };
+
+	if (Params.Archetype == EModuleArchetype::CoreOnly)
+	{
+		return Headers;
+	}
+
+	Headers.Append({ TEXT("UObject/Object.h"), TEXT("GameFramework/Actor.h") });
+
+	if (Params.IsEditorModule())
+	{
+		Headers.Append({ TEXT("Editor.h"), TEXT("Widgets/SCompoundWidget.h") });
+	}
+
+	return Headers;
+}
+
+TArray<FString> GetUnknownPCHHeaders(const FNewModuleParams& Params)
+{
+	TArray<FString> Unknown;
+	for (const FString& Header : GetPCHHeaders(Params))
+	{
+		if (!FindPCHHeaderOwner(Header) && !Params.PCHHeaderOwners.Contains(Header))
+		{
+			Unknown.Add(Header);
+		}
+	}
+	return Unknown;
+}
+
+void ResolvePCHHeaderOwners(FNewModuleParams& Params, const FExternalModuleIndex& Index)
+{
+	MODULEBUILDER_SCOPE("ResolvePCHHeaderOwners");
+
+	for (const FString& Header : GetUnknownPCHHeaders(Params))
+	{
+		const FString Owner = Index.FindHeaderOwner(Header);
+		if (!Owner.IsEmpty())
+		{
+			Params.PCHHeaderOwners.Add(Header, Owner);
+		}
+	}
+}
+
+FString GetPCHHeaderRelativePath(const FString& ModuleName, EModulePCHMode Mode)
+{
+	switch (Mode)
+	{
+	case EModulePCHMode::Private: return TEXT("Private/") + ModuleName + TEXT("PCH.h");
+	case EModulePCHMode::Shared:  return TEXT("Public/") + ModuleName + TEXT("SharedPCH.h");
+	default:                      return FString();
+	}
+}
+
+FString MakePCHHeaderText(const FString& ModuleName, const TArray<FString>& Headers, EModulePCHMode Mode)
+{
+	FModuleTemplateVariables Variables;
+	Variables.Set(TEXT("ModuleName"), ModuleName);
+	SetPCHVariables(Variables, Headers, Mode);
+	return FModuleTemplateLibrary::Get().Render(FModuleTemplateLibrary::PCHHeader, Variables);
+}
+
+void RenderModuleFiles(const FString& ContainerRoot, const FNewModuleParams& Params, TArray<FGeneratedModuleFile>& OutFiles)
+{
+	MODULEBUILDER_SCOPE("RenderModuleFiles");
+
+	const FString& ModuleName = Params.ModuleName;
+	const FString ModuleDir = GetModuleDir(ContainerRoot, ModuleName);
+
+	const TArray<FString> PCHHeaders = GetPCHHeaders(Params);
+	for (const FString& Header : GetUnknownPCHHeaders(Params))
+	{
+		UE_LOG(LogModuleBuilder, Warning, TEXT("%s：找不到 PCH 头文件 %s 所属的模块，未加入 Build.cs 依赖，请手动添加"), *ModuleName, *Header);
+	}
+
+	// 所有文件共用一份变量，每个文件一次遍历渲染
+	const FModuleTemplateVariables Variables = MakeTemplateVariables(Params, PCHHeaders);
+	FModuleTemplateLibrary& Templates = FModuleTemplateLibrary::Get();
+
+	OutFiles.Reset(5);
+	OutFiles.Add({ ModuleDir / (ModuleName + TEXT(".Build.cs")),               Templates.Render(FModuleTemplateLibrary::BuildCs, Variables) });
+	OutFiles.Add({ ModuleDir / TEXT("Public") / (ModuleName + TEXT(".h")),    Templates.Render(FModuleTemplateLibrary::ModuleHeader, Variables) });
+	OutFiles.Add({ ModuleDir / TEXT("Private") / (ModuleName + TEXT(".cpp")), Templates.Render(FModuleTemplateLibrary::ModuleCpp, Variables) });
+
+	if (Params.bInstrumented)
+	{
+		OutFiles.Add({ ModuleDir / TEXT("Public") / (ModuleName + TEXT("Stats.h")), Templates.Render(FModuleTemplateLibrary::ModuleStatsHeader, Variables) });
+	}
+
+	if (Params.PCHMode != EModulePCHMode::None)
+	{
+		OutFiles.Add({ ModuleDir / GetPCHHeaderRelativePath(ModuleName, Params.PCHMode), Templates.Render(FModuleTemplateLibrary::PCHHeader, Variables) });
+	}
+}
+
+void GetModuleDependencies(const FNewModuleParams& Params, TArray<FString>& OutPublic, TArray<FString>& OutPrivate)
+{
+	GetBuildCsDependencies(Params, GetPCHHeaders(Params), OutPublic, OutPrivate);
+}
+
+bool StageModuleFiles(FModuleStagingArea& Staging, const TArray<FGeneratedModuleFile>& Files, FString& OutError)
+{
+	MODULEBUILDER_SCOPE("StageModuleFiles");
+
+	for (const FGeneratedModuleFile& File : Files)
+	{
+		if (Staging.Contains(File.Path) || FPaths::FileExists(File.Path))
+		{
+			OutError = TEXT("目标文件已存在，未进行覆盖：") + File.Path;
+			return false;
+		}
+	}
+
+	for (const FGeneratedModuleFile& File : Files)
+	{
+		if (!Staging.AddNewFile(File.Path, File.Text, OutError))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool StageModulesInDescriptor(FModuleStagingArea& Staging, const FString& DescriptorPath, const TArray<FNewModuleParams>& Modules, FString& OutError)
+{
+	MODULEBUILDER_SCOPE("StageDescriptor");
+
+	FString* Text = nullptr;
+	{
+		MODULEBUILDER_SCOPE("StageDescriptor.Read");
+		Text = Staging.EditFile(DescriptorPath, OutError);
+	}
+	if (!Text)
+	{
+		return false;
+	}
+
+	MODULEBUILDER_SCOPE("StageDescriptor.Patch");
+	FString Patched;
+	if (!PatchDescriptorText(*Text, Modules, Patched, OutError))
+	{
+		return false;
+	}
+	*Text = MoveTemp(Patched);
+	return true;
+}
+
+bool GenerateModuleFilesToTarget(const FString& ContainerRoot, const FNewModuleParams& Params, FString& OutError)
+{
+	MODULEBUILDER_SCOPE("GenerateModuleFiles");
+
+	FModuleTemplateLibrary::Get().Refresh();
+
+	TArray<FGeneratedModuleFile> Files;
+	RenderModuleFiles(ContainerRoot, Params, Files);
+
+	FModuleStagingArea Staging;
+	FStagingFlushResult Flush;
+	return StageModuleFiles(Staging, Files, OutError) && Staging.Flush(Flush, OutError);
+}
+
+bool AddModuleToDescriptor(
+	const FString& DescriptorPath,
+	const FString& ModuleName,
+	const FString& InModuleType,
+	const FString& InLoadingPhase,
+	FDescriptorPatchResult& OutPatch,
+	FString& OutError)
+{
+	FNewModuleParams Params;
+	Params.ModuleName   = ModuleName;
+	Params.ModuleType   = InModuleType;
+	Params.LoadingPhase = InLoadingPhase;
+
+	return AddModulesToDescriptor(DescriptorPath, { Params }, OutPatch, OutError);
+}
+
+bool AddModulesToDescriptor(const FString& DescriptorPath, const TArray<FNewModuleParams>& NewModules, FDescriptorPatchResult& OutPatch, FString& OutError)
+{
+	MODULEBUILDER_SCOPE("AddModuleToDescriptor");
+
+	// 只在原文中拼接新条目，保留格式与键顺序；内容不变时不写回
+	return PatchDescriptorFile(DescriptorPath, NewModules, OutPatch, OutError);
+}
+
+bool LoadModuleManifest(const FString& ManifestPath, TArray<FNewModuleParams>& OutModules, FString& OutError)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *ManifestPath))
+	{
+		OutError = TEXT("读取清单失败：") + ManifestPath;
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		OutError = TEXT("清单 JSON 解析失败：") + ManifestPath;
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root->TryGetArrayField(TEXT("Modules"), Entries) || !Entries)
+	{
+		OutError = TEXT("清单缺少 Modules 数组。");
+		return false;
+	}
+
+	OutModules.Reset(Entries->Num());
+
+	for (int32 Index = 0; Index < Entries->Num(); ++Index)
+	{
+		const TSharedPtr<FJsonObject>* ObjPtr = nullptr;
+		if (!(*Entries)[Index].IsValid() || !(*Entries)[Index]->TryGetObject(ObjPtr) || !ObjPtr || !ObjPtr->IsValid())
+		{
+			OutError = FString::Printf(TEXT("清单第 %d 项不是对象。"), Index);
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>& Obj = *ObjPtr;
+
+		FNewModuleParams Params;
+		if (!Obj->TryGetStringField(TEXT("Name"), Params.ModuleName) || Params.ModuleName.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("清单第 %d 项缺少 Name。"), Index);
+			return false;
+		}
+
+		Obj->TryGetStringField(TEXT("Type"), Params.ModuleType);
+		Obj->TryGetStringField(TEXT("LoadingPhase"), Params.LoadingPhase);
+
+		FString Archetype;
+		if (Obj->TryGetStringField(TEXT("Archetype"), Archetype) && Archetype.Equals(TEXT("CoreOnly"), ESearchCase::IgnoreCase))
+		{
+			Params.Archetype = EModuleArchetype::CoreOnly;
+		}
+
+		FString PCHMode;
+		if (Obj->TryGetStringField(TEXT("PCH"), PCHMode))
+		{
+			if (PCHMode.Equals(TEXT("Private"), ESearchCase::IgnoreCase))
+			{
+				Params.PCHMode = EModulePCHMode::Private;
+			}
+			else if (PCHMode.Equals(TEXT("Shared"), ESearchCase::IgnoreCase))
+			{
+				Params.PCHMode = EModulePCHMode::Shared;
+			}
+		}
+		Obj->TryGetStringArrayField(TEXT("PCHHeaders"), Params.PCHHeaders);
+		Obj->TryGetBoolField(TEXT("Instrumented"), Params.bInstrumented);
+
+		// 填了 Plugin 即视为工程插件目标
+		if (Obj->TryGetStringField(TEXT("Plugin"), Params.TargetPluginName) && !Params.TargetPluginName.IsEmpty())
+		{
+			Params.TargetType = EModuleTargetType::ProjectPlugin;
+		}
+
+		OutModules.Add(MoveTemp(Params));
+	}
+
+	return true;
+}
+
+void GenerateModuleBatch(const TArray<FNewModuleParams>& Modules, FModuleBatchResult& OutResult, bool bDryRun)
+{
+	// 整批作为一次操作计时，结束时输出分项摘要
+	TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> Timing = FModuleOperationTiming::Create(
+		FString::Printf(TEXT("GenerateModuleBatch %d%s"), Modules.Num(), bDryRun ? TEXT(" DryRun") : TEXT("")));
+	FModuleOperationTimingScope TimingScope(Timing);
+	ON_SCOPE_EXIT
+	{
+		Timing->Finish(OutResult.Errors.Num() == 0);
+	};
+
+	// 1）解析目标（需要 IPluginManager，放在调用线程上）
+	TArray<FTargetResolveResult> Targets;
+	TArray<bool> Valid;
+	Targets.SetNum(Modules.Num());
+	Valid.Init(false, Modules.Num());
+
+	TSet<FString> SeenModuleNames;
+
+	for (int32 Index = 0; Index < Modules.Num(); ++Index)
+	{
+		const FNewModuleParams& Params = Modules[Index];
+
+		FModuleNameIndex& NameIndex = FModuleNameIndex::Get();
+		FText NameError;
+		if (NameIndex.IsReady() && !NameIndex.ValidateNewModuleName(Params.ModuleName, NameError))
+		{
+			OutResult.Errors.Add(Params.ModuleName + TEXT("：") + NameError.ToString());
+			continue;
+		}
+
+		FString Error;
+		if (!ResolveTargetFromParams(Params, Targets[Index], Error))
+		{
+			OutResult.Errors.Add(Params.ModuleName + TEXT("：") + Error);
+			continue;
+		}
+
+		// 模块名全局唯一；同一批次内重名直接拒绝，也避免并行写同一文件
+		bool bAlreadyInSet = false;
+		SeenModuleNames.Add(Params.ModuleName, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			OutResult.Errors.Add(Params.ModuleName + TEXT("：清单中重复的模块。"));
+			continue;
+		}
+
+		Valid[Index] = true;
+	}
+
+	// 自定义 PCH 头文件的所属模块；Source 目录只在有未知头文件时收集一次
+	TArray<FNewModuleParams> RenderParams = Modules;
+	TOptional<FExternalModuleIndex> PCHOwnerIndex;
+	for (int32 Index = 0; Index < RenderParams.Num(); ++Index)
+	{
+		if (!Valid[Index] || GetUnknownPCHHeaders(RenderParams[Index]).Num() == 0)
+		{
+			continue;
+		}
+		if (!PCHOwnerIndex.IsSet())
+		{
+			TArray<FModuleSourceRoot> Roots = FModuleDependencyGraph::GetProjectSourceRoots();
+			Roots.Append(FExternalModuleIndex::GetEngineSourceRoots());
+			PCHOwnerIndex.Emplace();
+			PCHOwnerIndex->Build(Roots);
+		}
+		ResolvePCHHeaderOwners(RenderParams[Index], PCHOwnerIndex.GetValue());
+	}
+
+	// 2）并行渲染，不访问磁盘；模板在这里检查一次，渲染时只读缓存
+	FModuleTemplateLibrary::Get().Refresh();
+
+	TArray<TArray<FGeneratedModuleFile>> Rendered;
+	Rendered.SetNum(Modules.Num());
+
+	{
+		MODULEBUILDER_SCOPE("Batch.Render");
+		ParallelFor(Modules.Num(), [&](int32 Index)
+		{
+			if (Valid[Index])
+			{
+				RenderModuleFiles(Targets[Index].ContainerRoot, RenderParams[Index], Rendered[Index]);
+			}
+		});
+	}
+
+	// 3）按描述文件分组修补，成功的组再把模块文件加入暂存区；每个描述文件只读一次
+	TMap<FString, TArray<int32>> ByDescriptor;
+	for (int32 Index = 0; Index < Modules.Num(); ++Index)
+	{
+		if (Valid[Index])
+		{
+			ByDescriptor.FindOrAdd(Targets[Index].DescriptorPath).Add(Index);
+		}
+	}
+
+	FModuleStagingArea Staging;
+	TArray<FString> StagedDescriptors;
+	TArray<int32> Staged;
+
+	for (const TPair<FString, TArray<int32>>& Pair : ByDescriptor)
+	{
+		// 文件已存在的模块不进入描述文件
+		TArray<FNewModuleParams> Group;
+		TArray<int32> GroupIndices;
+		for (int32 Index : Pair.Value)
+		{
+			FString Error;
+			if (!StageModuleFiles(Staging, Rendered[Index], Error))
+			{
+				OutResult.Errors.Add(Modules[Index].ModuleName + TEXT("：") + Error);
+				continue;
+			}
+			Group.Add(Modules[Index]);
+			GroupIndices.Add(Index);
+		}
+
+		if (Group.Num() == 0)
+		{
+			continue;
+		}
+
+		FString Error;
+		if (!StageModulesInDescriptor(Staging, Pair.Key, Group, Error))
+		{
+			OutResult.Errors.Add(Pair.Key + TEXT("：") + Error);
+			OutResult.Errors.Add(TEXT("整批未写盘：描述文件修补失败时不能只生成部分模块。"));
+			return;
+		}
+
+		StagedDescriptors.Add(Pair.Key);
+		Staged.Append(GroupIndices);
+	}
+
+	if (Staged.Num() == 0)
+	{
+		return;
+	}
+
+	// 4）预览只输出 diff；否则一次性写盘，失败时磁盘保持原样
+	if (bDryRun)
+	{
+		OutResult.Diff = Staging.MakeDiff();
+		for (int32 Index : Staged)
+		{
+			OutResult.SucceededModules.Add(Modules[Index].ModuleName);
+		}
+		return;
+	}
+
+	FString FlushError;
+	FStagingFlushResult Flush;
+	if (!Staging.Flush(Flush, FlushError))
+	{
+		OutResult.Errors.Add(TEXT("写盘失败，已恢复原状：") + FlushError);
+		return;
+	}
+
+	OutResult.FilesWritten = Flush.WrittenFiles.Num();
+	OutResult.FlushSeconds = Flush.Seconds;
+
+	for (const FString& DescriptorPath : StagedDescriptors)
+	{
+		// 内容一致的描述文件不写回，时间戳不变，UBT makefile 继续有效
+		if (Flush.WrittenFiles.Contains(FPaths::ConvertRelativePathToFull(DescriptorPath)))
+		{
+			++OutResult.DescriptorsWritten;
+			MODULEBUILDER_COUNT(DescriptorsPatched, 1);
+			OutResult.MakefileInvalidations.Add(DescriptorPath);
+		}
+	}
+
+	for (int32 Index : Staged)
+	{
+		const FNewModuleParams& Params = Modules[Index];
+		OutResult.SucceededModules.Add(Params.ModuleName);
+		FModuleNameIndex::Get().AddModule(Params.ModuleName,
+			Params.TargetType == EModuleTargetType::Project ? EModuleNameOwner::Project : EModuleNameOwner::ProjectPlugin,
+			Params.TargetPluginName);
+	}
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,937 @@
+#include "ModuleMerger.h"
+#include "DependencyDemotion.h"
+#include "DescriptorPatcher.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "ModuleStaging.h"
+#include "SourceRewrite.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ModuleDescriptor.h"
+
+namespace ModuleBuilder
+{
+namespace ModuleMergerPrivate
+{
+
+// 实现模块的宏；PRIMARY_GAME 模块承载游戏主模块，不能并入其他模块
+static const TCHAR* const GImplementMacros[] = { TEXT("IMPLEMENT_PRIMARY_GAME_MODULE"), TEXT("IMPLEMENT_GAME_MODULE"), TEXT("IMPLEMENT_MODULE") };
+
+// 合并后无法自动带过去的 Build.cs 设置
+static const TCHAR* const GManualBuildCsSettings[] =
+{
+	TEXT("PublicDefinitions"), TEXT("PrivateDefinitions"),
+	TEXT("PublicIncludePaths"), TEXT("PrivateIncludePaths"),
+	TEXT("PublicAdditionalLibraries"), TEXT("PublicSystemLibraries"),
+	TEXT("PublicDelayLoadDLLs"), TEXT("RuntimeDependencies"),
+	TEXT("DynamicallyLoadedModuleNames"), TEXT("PrivateIncludePathModuleNames"),
+	TEXT("PrivatePCHHeaderFile"), TEXT("SharedPCHHeaderFile"),
+};
+
+// Build.cs 是否设置了 Setting：Key = ... 赋值或 Key.Add(...) 之类的成员调用；注释里的、名字只是前缀的都不算
+static bool HasBuildCsSetting(const FString& Code, const TArray<FBuildCsAssignment>& Assignments, const TCHAR* Setting)
+{
+	if (Assignments.ContainsByPredicate([Setting](const FBuildCsAssignment& Assignment) { return Assignment.Key.Equals(Setting, ESearchCase::CaseSensitive); }))
+	{
+		return true;
+	}
+
+	const auto IsNameChar = [](TCHAR C) { return FChar::IsAlnum(C) || C == TEXT('_'); };
+	const int32 SettingLen = FCString::Strlen(Setting);
+	for (int32 Pos = Code.Find(Setting, ESearchCase::CaseSensitive); Pos != INDEX_NONE; Pos = Code.Find(Setting, ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos + 1))
+	{
+		if (Pos > 0 && (IsNameChar(Code[Pos - 1]) || Code[Pos - 1] == TEXT('.')))
+		{
+			continue;
+		}
+		int32 End = Pos + SettingLen;
+		while (End < Code.Len() && FChar::IsWhitespace(Code[End]))
+		{
+			++End;
+		}
+		if (End < Code.Len() && Code[End] == TEXT('.'))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool IsSourceExtension(const FString& Extension)
+{
+	return Extension == TEXT("cpp") || Extension == TEXT("c") || Extension == TEXT("cc");
+}
+
+// 去掉注释、预处理行与全部空白，便于和模块样板比较
+static FString NormalizeCode(const FString& Text)
+{
+	TArray<FString> Lines;
+	StripCodeComments(Text).ParseIntoArrayLines(Lines, false);
+
+	FString Out;
+	for (const FString& Line : Lines)
+	{
+		if (Line.TrimStart().StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+		for (const TCHAR C : Line)
+		{
+			if (!FChar::IsWhitespace(C))
+			{
+				Out.AppendChar(C);
+			}
+		}
+	}
+	return Out;
+}
+
+/**
+ * 行首的 IMPLEMENT_*MODULE(...) 语句
+ */
+struct FImplementStatement
+{
+	FString Macro;
+	FString ClassName;
+
+	// 含行尾换行的整行范围
+	int32 Begin = INDEX_NONE;
+	int32 End = INDEX_NONE;
+};
+
+static bool FindImplementStatement(const FString& Text, FImplementStatement& Out)
+{
+	for (const TCHAR* Macro : GImplementMacros)
+	{
+		int32 Search = 0;
+		while (true)
+		{
+			const int32 Found = Text.Find(Macro, ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+			if (Found == INDEX_NONE)
+			{
+				break;
+			}
+			Search = Found + FCString::Strlen(Macro);
+
+			int32 LineBegin = Found;
+			while (LineBegin > 0 && (Text[LineBegin - 1] == TEXT(' ') || Text[LineBegin - 1] == TEXT('\t'))) --LineBegin;
+			if (LineBegin > 0 && Text[LineBegin - 1] != TEXT('\n'))
+			{
+				continue;
+			}
+
+			int32 Pos = Search;
+			while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos])) ++Pos;
+			if (Pos >= Text.Len() || Text[Pos] != TEXT('('))
+			{
+				continue;
+			}
+
+			const int32 Close = Text.Find(TEXT(")"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+			if (Close == INDEX_NONE)
+			{
+				continue;
+			}
+
+			FString Arguments = Text.Mid(Pos + 1, Close - Pos - 1);
+			FString ClassName;
+			Arguments.Split(TEXT(","), &ClassName, nullptr);
+
+			int32 LineEnd = Text.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Close);
+			LineEnd = LineEnd == INDEX_NONE ? Text.Len() : LineEnd + 1;
+
+			Out.Macro = Macro;
+			Out.ClassName = ClassName.TrimStartAndEnd();
+			Out.Begin = LineBegin;
+			Out.End = LineEnd;
+			return true;
+		}
+	}
+	return false;
+}
+
+// 只剩模块类样板（空的 StartupModule / ShutdownModule）或什么都没有
+static bool IsModuleBoilerplate(const FString& Text, const FString& ClassName)
+{
+	FString Rest = NormalizeCode(Text);
+
+	const FString Fragments[] =
+	{
+		TEXT("virtualvoidStartupModule()override{}"), TEXT("virtualvoidShutdownModule()override{}"),
+		TEXT("virtualvoidStartupModule()override;"), TEXT("virtualvoidShutdownModule()override;"),
+		TEXT("void") + ClassName + TEXT("::StartupModule(){}"), TEXT("void") + ClassName + TEXT("::ShutdownModule(){}"),
+	};
+	for (const FString& Fragment : Fragments)
+	{
+		Rest.ReplaceInline(*Fragment, TEXT(""), ESearchCase::CaseSensitive);
+	}
+
+	const FString ClassHead = TEXT("class") + ClassName + TEXT(":publicIModuleInterface{");
+	return Rest.IsEmpty() || Rest == ClassHead + TEXT("public:};") || Rest == ClassHead + TEXT("};");
+}
+
+// 工程 / 插件 Binaries 下该模块的编辑器二进制（取各配置中最大的一个）
+static int64 FindBinaryBytes(const FString& ContainerRoot, const FString& ModuleName)
+{
+	const FString Dir = ContainerRoot / TEXT("Binaries") / FPlatformProcess::GetBinariesSubdirectory();
+	const FString Extension = FPlatformProcess::GetModuleExtension();
+
+	int64 Bytes = 0;
+	for (const FString& Pattern : { TEXT("*-") + ModuleName + TEXT(".") + Extension, TEXT("*-") + ModuleName + TEXT("-*.") + Extension })
+	{
+		TArray<FString> Found;
+		IFileManager::Get().FindFiles(Found, *(Dir / Pattern), true, false);
+		for (const FString& File : Found)
+		{
+			Bytes = FMath::Max(Bytes, IFileManager::Get().FileSize(*(Dir / File)));
+		}
+	}
+	return Bytes;
+}
+
+// Target.cs 中的 "From" 改为 "To"；已列出 To 时连同逗号删掉
+static bool ReplaceTargetModuleName(FString& Text, const FString& From, const FString& To)
+{
+	const FString QuotedFrom = TEXT("\"") + From + TEXT("\"");
+	const int32 Found = Text.Find(QuotedFrom, ESearchCase::CaseSensitive);
+	if (Found == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (!Text.Contains(TEXT("\"") + To + TEXT("\""), ESearchCase::CaseSensitive))
+	{
+		Text = Text.Left(Found) + TEXT("\"") + To + TEXT("\"") + Text.Mid(Found + QuotedFrom.Len());
+		return true;
+	}
+
+	int32 Begin = Found;
+	int32 End = Found + QuotedFrom.Len();
+	int32 After = End;
+	while (After < Text.Len() && FChar::IsWhitespace(Text[After])) ++After;
+	if (After < Text.Len() && Text[After] == TEXT(','))
+	{
+		End = After + 1;
+		while (End < Text.Len() && (Text[End] == TEXT(' ') || Text[End] == TEXT('\t'))) ++End;
+	}
+	else
+	{
+		int32 Before = Begin;
+		while (Before > 0 && FChar::IsWhitespace(Text[Before - 1])) --Before;
+		if (Before > 0 && Text[Before - 1] == TEXT(','))
+		{
+			Begin = Before - 1;
+		}
+	}
+	Text = Text.Left(Begin) + Text.Mid(End);
+	return true;
+}
+
+// 是否有文件 #include 了名为 HeaderName 的头文件（按文件名比较）
+static bool IsHeaderIncluded(const TArray<FString>& Files, const FString& HeaderName, const FString& IgnoreFile)
+{
+	TArray<FString> Includes;
+	for (const FString& File : Files)
+	{
+		if (File == IgnoreFile)
+		{
+			continue;
+		}
+
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *File))
+		{
+			continue;
+		}
+
+		Includes.Reset();
+		FModuleDependencyGraph::ParseIncludes(Text, Includes);
+		for (const FString& Include : Includes)
+		{
+			if (FPaths::GetCleanFilename(Include) == HeaderName)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+static void CollectCodeFiles(const FString& ModuleDir, TArray<FString>& OutFiles)
+{
+	TArray<FString> Paths;
+	IFileManager::Get().FindFilesRecursive(Paths, *ModuleDir, TEXT("*.*"), true, false);
+	for (const FString& Path : Paths)
+	{
+		const FString Extension = FPaths::GetExtension(Path);
+		if (Extension == TEXT("h") || Extension == TEXT("hpp") || Extension == TEXT("inl") || IsSourceExtension(Extension))
+		{
+			OutFiles.Add(Path);
+		}
+	}
+}
+
+// 从 Start 出发沿 Next 可达的图内模块（不含 Start 本身，除非绕回）
+static TSet<int32> Reach(const TArray<int32>& Start, TFunctionRef<const TArray<int32>&(int32)> Next)
+{
+	TSet<int32> Visited;
+	TArray<int32> Queue;
+	for (int32 Node : Start)
+	{
+		Queue.Append(Next(Node));
+	}
+	while (Queue.Num() > 0)
+	{
+		const int32 Node = Queue.Pop(EAllowShrinking::No);
+		bool bAlreadyInSet = false;
+		Visited.Add(Node, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Queue.Append(Next(Node));
+		}
+	}
+	return Visited;
+}
+
+} // namespace ModuleMergerPrivate
+
+bool PlanModuleMerge(const FModuleDependencyGraph& Graph, const FString& TargetModule, const TArray<FString>& SourceModules,
+	const FModuleMergeOptions& Options, FModuleMergePlan& OutPlan, FString& OutError)
+{
+	using namespace ModuleMergerPrivate;
+
+	OutPlan = FModuleMergePlan();
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	const int32 TargetIndex = Graph.FindNode(TargetModule);
+	if (TargetIndex == INDEX_NONE)
+	{
+		OutError = TEXT("没有找到目标模块：") + TargetModule;
+		return false;
+	}
+
+	TArray<int32> SourceIndices;
+	for (const FString& Name : SourceModules)
+	{
+		const int32 Index = Graph.FindNode(Name);
+		if (Index == INDEX_NONE)
+		{
+			OutError = TEXT("没有找到模块：") + Name;
+			return false;
+		}
+		if (Index != TargetIndex)
+		{
+			SourceIndices.AddUnique(Index);
+		}
+	}
+	if (SourceIndices.Num() == 0)
+	{
+		OutError = TEXT("至少需要一个并入目标模块的模块");
+		return false;
+	}
+
+	TArray<int32> Group = SourceIndices;
+	Group.Add(TargetIndex);
+
+	TSet<FString> GroupNames;
+	for (int32 Index : Group)
+	{
+		GroupNames.Add(Nodes[Index].Name);
+	}
+
+	const FModuleNode& Target = Nodes[TargetIndex];
+	OutPlan.TargetModule = Target.Name;
+	OutPlan.TargetDir = Target.ModuleDir;
+	OutPlan.TargetBuildCsPath = Target.BuildCsPath;
+	OutPlan.TargetSourceFiles = Target.SourceFiles;
+
+	// 1）同一工程 / 插件、同一 Type
+	if (!FindModuleContainer(Target.ModuleDir, OutPlan.ContainerRoot, OutPlan.DescriptorPath))
+	{
+		OutError = TEXT("找不到模块所属的 .uproject / .uplugin：") + Target.ModuleDir;
+		return false;
+	}
+	ReadDescriptorModuleEntry(OutPlan.DescriptorPath, Target.Name, OutPlan.ModuleType, OutPlan.LoadingPhase);
+	OutPlan.TargetBinaryBytes = FindBinaryBytes(OutPlan.ContainerRoot, Target.Name);
+
+	ELoadingPhase::Type EarliestPhase = ParseLoadingPhase(OutPlan.LoadingPhase);
+	OutPlan.MergedLoadingPhase = OutPlan.LoadingPhase;
+
+	for (int32 Index : SourceIndices)
+	{
+		const FModuleNode& Node = Nodes[Index];
+
+		FString Root;
+		FString Descriptor;
+		if (!FindModuleContainer(Node.ModuleDir, Root, Descriptor) || Descriptor != OutPlan.DescriptorPath)
+		{
+			OutError = FString::Printf(TEXT("%s 与 %s 不在同一个工程 / 插件中"), *Node.Name, *Target.Name);
+			return false;
+		}
+
+		FString Type;
+		FString Phase;
+		ReadDescriptorModuleEntry(Descriptor, Node.Name, Type, Phase);
+		if (Type != OutPlan.ModuleType)
+		{
+			OutError = FString::Printf(TEXT("%s 的 Type 为 %s，与 %s 的 %s 不同，合并后会改变其可用范围"), *Node.Name, *Type, *Target.Name, *OutPlan.ModuleType);
+			return false;
+		}
+
+		const ELoadingPhase::Type SourcePhase = ParseLoadingPhase(Phase);
+		if (SourcePhase < EarliestPhase)
+		{
+			EarliestPhase = SourcePhase;
+			OutPlan.MergedLoadingPhase = Phase;
+		}
+	}
+
+	// 2）合并后不能成环：从合并组出发可达、又能回到合并组的外部模块
+	const TSet<int32> Downstream = Reach(Group, [&Nodes](int32 Node) -> const TArray<int32>& { return Nodes[Node].AllEdges; });
+	const TSet<int32> Upstream = Reach(Group, [&Graph](int32 Node) -> const TArray<int32>& { return Graph.GetDependents(Node); });
+	for (int32 Node : Downstream)
+	{
+		if (!Group.Contains(Node) && Upstream.Contains(Node))
+		{
+			OutError = FString::Printf(TEXT("合并后 %s 与 %s 形成循环依赖：%s 依赖合并组中的模块，又被合并组依赖"),
+				*Target.Name, *Nodes[Node].Name, *Nodes[Node].Name);
+			return false;
+		}
+	}
+
+	// 3）逐个整理被合并模块
+	TArray<FString> ScanFiles;
+	for (int32 Index : Group)
+	{
+		CollectCodeFiles(Nodes[Index].ModuleDir, ScanFiles);
+		for (int32 Dependent : Graph.GetDependents(Index))
+		{
+			if (!Group.Contains(Dependent))
+			{
+				CollectCodeFiles(Nodes[Dependent].ModuleDir, ScanFiles);
+			}
+		}
+	}
+
+	TMap<FString, FString> Destinations;
+	{
+		TArray<FString> TargetFiles;
+		IFileManager::Get().FindFilesRecursive(TargetFiles, *Target.ModuleDir, TEXT("*.*"), true, false);
+		for (const FString& File : TargetFiles)
+		{
+			Destinations.Add(File.RightChop(Target.ModuleDir.Len() + 1), Target.Name);
+		}
+	}
+
+	for (int32 Index : SourceIndices)
+	{
+		const FModuleNode& Node = Nodes[Index];
+
+		FModuleMergeSource& Source = OutPlan.Sources.AddDefaulted_GetRef();
+		Source.ModuleName = Node.Name;
+		Source.ModuleDir = Node.ModuleDir;
+		Source.BuildCsPath = Node.BuildCsPath;
+		Source.BinaryBytes = FindBinaryBytes(OutPlan.ContainerRoot, Node.Name);
+
+		TArray<FString> Files;
+		IFileManager::Get().FindFilesRecursive(Files, *Node.ModuleDir, TEXT("*.*"), true, false);
+		Files.Sort();
+
+		for (const FString& File : Files)
+		{
+			if (File == Node.BuildCsPath)
+			{
+				continue;
+			}
+
+			FString Text;
+			if (!FFileHelper::LoadFileToString(Text, *File))
+			{
+				Source.Files.Add(File);
+				continue;
+			}
+
+			FImplementStatement Statement;
+			if (Source.ModuleImplFile.IsEmpty() && FindImplementStatement(Text, Statement))
+			{
+				if (Statement.Macro == TEXT("IMPLEMENT_PRIMARY_GAME_MODULE"))
+				{
+					OutError = FString::Printf(TEXT("%s 是游戏主模块，只能作为合并目标"), *Node.Name);
+					return false;
+				}
+				if (HasModuleLifecycleCode(Text))
+				{
+					OutError = FString::Printf(TEXT("%s 的 StartupModule / ShutdownModule 中有代码（%s），请先手工移到 %s 的模块类中"),
+						*Node.Name, *File, *Target.Name);
+					return false;
+				}
+
+				Source.ModuleImplFile = File;
+				Source.bDeleteModuleImpl = IsModuleBoilerplate(Text.Left(Statement.Begin) + Text.Mid(Statement.End), Statement.ClassName);
+
+				// 生成器配套的 <Name>.h：只有样板且没有其他文件包含时删除
+				const FString HeaderName = Node.Name + TEXT(".h");
+				const FString* Header = Files.FindByPredicate([&HeaderName](const FString& Path) { return FPaths::GetCleanFilename(Path) == HeaderName; });
+				FString HeaderText;
+				if (Source.bDeleteModuleImpl && Header && FFileHelper::LoadFileToString(HeaderText, **Header)
+					&& IsModuleBoilerplate(HeaderText, Statement.ClassName) && !IsHeaderIncluded(ScanFiles, HeaderName, File))
+				{
+					Source.ModuleHeaderFile = *Header;
+				}
+
+				if (Source.bDeleteModuleImpl)
+				{
+					continue;
+				}
+			}
+
+			if (!Source.bHasReflectedTypes)
+			{
+				TArray<TPair<FString, FString>> Types;
+				FindReflectedTypes(Text, Types);
+				Source.bHasReflectedTypes = Types.Num() > 0;
+			}
+
+			Source.Files.Add(File);
+		}
+
+		Source.Files.Remove(Source.ModuleHeaderFile);
+		for (const FString& File : Source.Files)
+		{
+			if (IsSourceExtension(FPaths::GetExtension(File)))
+			{
+				++Source.SourceFiles;
+			}
+
+			const FString Relative = File.RightChop(Node.ModuleDir.Len() + 1);
+			if (const FString* Owner = Destinations.Find(Relative))
+			{
+				OutError = FString::Printf(TEXT("%s 中的 %s 与 %s 中的文件同名，请先改名"), *Node.Name, *Relative, **Owner);
+				return false;
+			}
+			Destinations.Add(Relative, Node.Name);
+		}
+
+		if (Source.ModuleImplFile.IsEmpty())
+		{
+			OutPlan.Warnings.Add(FString::Printf(TEXT("%s 中没有找到 IMPLEMENT_MODULE"), *Node.Name));
+		}
+
+		FString BuildCsText;
+		FFileHelper::LoadFileToString(BuildCsText, *Node.BuildCsPath);
+		TArray<FBuildCsAssignment> Assignments;
+		FModuleDependencyGraph::ParseBuildCsAssignments(BuildCsText, Assignments);
+		const FString BuildCsCode = StripCodeComments(BuildCsText);
+		for (const TCHAR* Setting : GManualBuildCsSettings)
+		{
+			if (HasBuildCsSetting(BuildCsCode, Assignments, Setting))
+			{
+				OutPlan.Warnings.Add(FString::Printf(TEXT("%s.Build.cs 中的 %s 需手工并入 %s.Build.cs"), *Node.Name, Setting, *Target.Name));
+			}
+		}
+
+		// 依赖并入目标模块
+		for (const FString& Dependency : Node.PublicDependencies)
+		{
+			if (!GroupNames.Contains(Dependency) && !Target.PublicDependencies.Contains(Dependency))
+			{
+				OutPlan.AddedPrivateDependencies.Remove(Dependency);
+				OutPlan.AddedPublicDependencies.AddUnique(Dependency);
+			}
+		}
+		for (const FString& Dependency : Node.PrivateDependencies)
+		{
+			if (!GroupNames.Contains(Dependency) && !Target.PublicDependencies.Contains(Dependency) && !Target.PrivateDependencies.Contains(Dependency)
+				&& !OutPlan.AddedPublicDependencies.Contains(Dependency))
+			{
+				OutPlan.AddedPrivateDependencies.AddUnique(Dependency);
+			}
+		}
+	}
+
+	if (OutPlan.MergedLoadingPhase != OutPlan.LoadingPhase)
+	{
+		OutPlan.Warnings.Add(FString::Printf(TEXT("%s 的 LoadingPhase 将从 %s 提前到 %s，以保证原模块的加载时机"),
+			*Target.Name, *OutPlan.LoadingPhase, *OutPlan.MergedLoadingPhase));
+	}
+
+	// 4）下游模块改为依赖目标模块
+	TArray<FString> SourceNames;
+	for (const FModuleMergeSource& Source : OutPlan.Sources)
+	{
+		SourceNames.Add(Source.ModuleName);
+	}
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FModuleNode& Node = Nodes[Index];
+		if (Group.Contains(Index))
+		{
+			continue;
+		}
+
+		FMergeDependentFix Fix;
+		for (const FString& Name : SourceNames)
+		{
+			const bool bPublic = Node.PublicDependencies.Contains(Name);
+			if (bPublic || Node.PrivateDependencies.Contains(Name))
+			{
+				Fix.RemovedDependencies.Add(Name);
+				Fix.bPublic |= bPublic;
+			}
+		}
+		if (Fix.RemovedDependencies.Num() == 0)
+		{
+			continue;
+		}
+
+		Fix.ModuleName = Node.Name;
+		Fix.BuildCsPath = Node.BuildCsPath;
+
+		const bool bLinksTarget = Node.PublicDependencies.Contains(Target.Name) || Node.PrivateDependencies.Contains(Target.Name);
+		OutPlan.DependentLinkInputsSaved += Fix.RemovedDependencies.Num() + (bLinksTarget ? 1 : 0) - 1;
+		OutPlan.DependentFixes.Add(MoveTemp(Fix));
+	}
+
+	// 5）工程 Target.cs 的 ExtraModuleNames
+	TArray<FString> TargetCsNames;
+	const FString ProjectSourceDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Source"));
+	IFileManager::Get().FindFiles(TargetCsNames, *(ProjectSourceDir / TEXT("*.Target.cs")), true, false);
+	for (const FString& Name : TargetCsNames)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *(ProjectSourceDir / Name)))
+		{
+			continue;
+		}
+		for (const FString& Source : SourceNames)
+		{
+			if (Text.Contains(TEXT("\"") + Source + TEXT("\""), ESearchCase::CaseSensitive))
+			{
+				OutPlan.TargetCsFiles.AddUnique(ProjectSourceDir / Name);
+			}
+		}
+	}
+
+	OutPlan.BinariesBefore = Group.Num();
+	OutPlan.BinariesAfter = 1;
+	OutPlan.EstimatedStartupSavingMs = (OutPlan.BinariesBefore - OutPlan.BinariesAfter) * Options.PerBinaryLoadMilliseconds;
+	return true;
+}
+
+FString FormatMergePlan(const FModuleMergePlan& Plan)
+{
+	FString Report = FString::Printf(TEXT("== 合并到 %s（%d 个 .cpp）==\n"), *Plan.TargetModule, Plan.TargetSourceFiles);
+	Report += FString::Printf(TEXT("  描述文件：%s（%s / %s）\n"), *Plan.DescriptorPath, *Plan.ModuleType, *Plan.MergedLoadingPhase);
+
+	int32 MergedSources = Plan.TargetSourceFiles;
+	int64 BinaryBytes = Plan.TargetBinaryBytes;
+
+	Report += TEXT("\n== 并入的模块 ==\n");
+	for (const FModuleMergeSource& Source : Plan.Sources)
+	{
+		MergedSources += Source.SourceFiles;
+		BinaryBytes += Source.BinaryBytes;
+
+		FString ModuleImpl;
+		if (!Source.ModuleImplFile.IsEmpty())
+		{
+			ModuleImpl = Source.bDeleteModuleImpl ? TEXT("  删除模块样板") : TEXT("  去掉 IMPLEMENT_MODULE");
+		}
+		Report += FString::Printf(TEXT("  %-40s 文件 %4d（.cpp %d）%s%s\n"), *Source.ModuleName, Source.Files.Num(), Source.SourceFiles,
+			*ModuleImpl, Source.bHasReflectedTypes ? TEXT("  [反射类型 → PackageRedirects]") : TEXT(""));
+	}
+
+	if (Plan.AddedPublicDependencies.Num() > 0)
+	{
+		Report += TEXT("\n  目标新增 Public 依赖：") + FString::Join(Plan.AddedPublicDependencies, TEXT(", ")) + TEXT("\n");
+	}
+	if (Plan.AddedPrivateDependencies.Num() > 0)
+	{
+		Report += TEXT("  目标新增 Private 依赖：") + FString::Join(Plan.AddedPrivateDependencies, TEXT(", ")) + TEXT("\n");
+	}
+
+	if (Plan.DependentFixes.Num() > 0)
+	{
+		Report += TEXT("\n== 下游模块改为依赖 ") + Plan.TargetModule + TEXT(" ==\n");
+		for (const FMergeDependentFix& Fix : Plan.DependentFixes)
+		{
+			Report += FString::Printf(TEXT("  %s（%s）：去掉 %s\n"), *Fix.ModuleName, Fix.bPublic ? TEXT("Public") : TEXT("Private"),
+				*FString::Join(Fix.RemovedDependencies, TEXT(", ")));
+		}
+	}
+	for (const FString& File : Plan.TargetCsFiles)
+	{
+		Report += TEXT("  ExtraModuleNames：") + File + TEXT("\n");
+	}
+
+	if (Plan.Warnings.Num() > 0)
+	{
+		Report += TEXT("\n== 注意 ==\n");
+		for (const FString& Warning : Plan.Warnings)
+		{
+			Report += TEXT("  ") + Warning + TEXT("\n");
+		}
+	}
+
+	Report += TEXT("\n== 链接与启动 ==\n");
+	Report += FString::Printf(TEXT("  编辑器（模块化构建）链接的二进制：%d → %d，合并后模块 .cpp %d 个\n"),
+		Plan.BinariesBefore, Plan.BinariesAfter, MergedSources);
+	Report += FString::Printf(TEXT("  下游模块的链接输入减少 %d 项\n"), Plan.DependentLinkInputsSaved);
+	if (BinaryBytes > 0)
+	{
+		Report += FString::Printf(TEXT("  现有二进制合计 %.1f MB\n"), BinaryBytes / (1024.0 * 1024.0));
+	}
+	Report += FString::Printf(TEXT("  编辑器启动时少加载 %d 个动态库，估计节省 %.0f ms（按每个 %.1f ms 计；单体打包构建不受影响）\n"),
+		Plan.BinariesBefore - Plan.BinariesAfter, Plan.EstimatedStartupSavingMs,
+		Plan.BinariesBefore > Plan.BinariesAfter ? Plan.EstimatedStartupSavingMs / (Plan.BinariesBefore - Plan.BinariesAfter) : 0.0);
+
+	return Report;
+}
+
+FString FormatMergeCandidates(const FModuleDependencyGraph& Graph, int32 MaxModules)
+{
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Order.Sort([&Nodes](int32 A, int32 B)
+	{
+		return Nodes[A].Owner != Nodes[B].Owner ? Nodes[A].Owner < Nodes[B].Owner : Nodes[A].SourceFiles < Nodes[B].SourceFiles;
+	});
+
+	FString Report = TEXT("输入“目标模块, 模块1, 模块2 ...”后回车，预览把后面的模块并入目标模块。\n");
+	Report += FString::Printf(TEXT("当前共 %d 个模块，模块化构建中各自链接为一个二进制。\n\n== 源文件最少的模块（按所属分组）==\n"), Nodes.Num());
+
+	FString Owner;
+	int32 Listed = 0;
+	for (int32 Index : Order)
+	{
+		const FModuleNode& Node = Nodes[Index];
+		if (Node.Owner != Owner)
+		{
+			Owner = Node.Owner;
+			Listed = 0;
+			Report += TEXT("[") + Owner + TEXT("]\n");
+		}
+		if (Listed++ >= MaxModules)
+		{
+			continue;
+		}
+		Report += FString::Printf(TEXT("  %-40s .cpp %4d  被 %d 个模块依赖\n"), *Node.Name, Node.SourceFiles, Graph.GetDependents(Index).Num());
+	}
+	return Report;
+}
+
+bool ApplyModuleMerge(const FModuleMergePlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors)
+{
+	using namespace ModuleMergerPrivate;
+
+	const FString TargetApi = Plan.TargetModule.ToUpper() + TEXT("_API");
+
+	TArray<FString> SourceNames;
+	for (const FModuleMergeSource& Source : Plan.Sources)
+	{
+		SourceNames.Add(Source.ModuleName);
+
+		for (const FString& File : Source.Files)
+		{
+			const FString Destination = Plan.TargetDir / File.RightChop(Source.ModuleDir.Len() + 1);
+			if (FPaths::FileExists(Destination))
+			{
+				OutErrors.Add(TEXT("目标文件已存在：") + Destination);
+			}
+		}
+	}
+	if (OutErrors.Num() > 0)
+	{
+		return false;
+	}
+
+	// 移动、删除与所有文本改动都先进暂存区，最后一次写盘；任一步失败时磁盘保持原样
+	FModuleStagingArea Staging;
+	FString Error;
+
+	// 文件所在目录直到模块目录逐级记录，移空后一并删除
+	TSet<FString> SourceDirs;
+	auto AddSourceDirs = [&SourceDirs](const FString& File, const FString& ModuleDir)
+	{
+		for (FString Dir = FPaths::GetPath(File); Dir.StartsWith(ModuleDir); Dir = FPaths::GetPath(Dir))
+		{
+			SourceDirs.Add(Dir);
+		}
+	};
+
+	// 1）先移动源文件并改 API 宏，保留的模块实现文件在移动后的文本上去掉 IMPLEMENT_MODULE
+	for (const FModuleMergeSource& Source : Plan.Sources)
+	{
+		const FString SourceApi = Source.ModuleName.ToUpper() + TEXT("_API");
+
+		for (const FString& File : Source.Files)
+		{
+			const FString Destination = Plan.TargetDir / File.RightChop(Source.ModuleDir.Len() + 1);
+			FString* Text = Staging.MoveFile(File, Destination, Error);
+			if (!Text)
+			{
+				OutErrors.Add(Error);
+				return false;
+			}
+			ReplaceIdentifier(*Text, SourceApi, TargetApi);
+
+			FImplementStatement Statement;
+			if (File == Source.ModuleImplFile && FindImplementStatement(*Text, Statement))
+			{
+				*Text = Text->Left(Statement.Begin) + Text->Mid(Statement.End);
+			}
+			AddSourceDirs(File, Source.ModuleDir);
+		}
+
+		// 2）再删除原模块的 Build.cs 与模块样板
+		for (const FString& File : { Source.bDeleteModuleImpl ? Source.ModuleImplFile : FString(), Source.ModuleHeaderFile, Source.BuildCsPath })
+		{
+			if (File.IsEmpty())
+			{
+				continue;
+			}
+			if (!Staging.DeleteFile(File, Error))
+			{
+				OutErrors.Add(Error);
+				return false;
+			}
+			AddSourceDirs(File, Source.ModuleDir);
+		}
+	}
+
+	// 3）Build.cs、描述文件、Target.cs 与配置
+	TArray<FPendingTextEdit> Edits;
+
+	if (FPendingTextEdit* Edit = FindOrLoadPendingEdit(Edits, Plan.TargetBuildCsPath, false, OutErrors))
+	{
+		FString Removed;
+		FString Added;
+		if (!RemoveDependenciesFromBuildCs(Edit->NewText, SourceNames, Removed, Error)
+			|| !AddDependenciesToBuildCs(Removed, Plan.AddedPublicDependencies, true, Added, Error)
+			|| !AddDependenciesToBuildCs(Added, Plan.AddedPrivateDependencies, false, Edit->NewText, Error))
+		{
+			OutErrors.Add(Plan.TargetBuildCsPath + TEXT("：") + Error);
+		}
+	}
+
+	for (const FMergeDependentFix& Fix : Plan.DependentFixes)
+	{
+		if (FPendingTextEdit* Edit = FindOrLoadPendingEdit(Edits, Fix.BuildCsPath, false, OutErrors))
+		{
+			FString Removed;
+			if (!RemoveDependenciesFromBuildCs(Edit->NewText, Fix.RemovedDependencies, Removed, Error)
+				|| !AddDependenciesToBuildCs(Removed, { Plan.TargetModule }, Fix.bPublic, Edit->NewText, Error))
+			{
+				OutErrors.Add(Fix.BuildCsPath + TEXT("：") + Error);
+			}
+		}
+	}
+
+	if (FPendingTextEdit* Edit = FindOrLoadPendingEdit(Edits, Plan.DescriptorPath, false, OutErrors))
+	{
+		FString Removed;
+		bool bOk = RemoveModulesFromDescriptorText(Edit->NewText, SourceNames, Removed, Error);
+		if (bOk && Plan.MergedLoadingPhase != Plan.LoadingPhase)
+		{
+			bOk = SetDescriptorModuleField(Removed, Plan.TargetModule, TEXT("LoadingPhase"), Plan.MergedLoadingPhase, Edit->NewText, Error);
+		}
+		else if (bOk)
+		{
+			Edit->NewText = Removed;
+		}
+
+		if (!bOk)
+		{
+			OutErrors.Add(Plan.DescriptorPath + TEXT("：") + Error);
+		}
+	}
+
+	for (const FString& TargetCs : Plan.TargetCsFiles)
+	{
+		if (FPendingTextEdit* Edit = FindOrLoadPendingEdit(Edits, TargetCs, false, OutErrors))
+		{
+			for (const FString& Name : SourceNames)
+			{
+				ReplaceTargetModuleName(Edit->NewText, Name, Plan.TargetModule);
+			}
+		}
+	}
+
+	TArray<FString> Redirects;
+	for (const FModuleMergeSource& Source : Plan.Sources)
+	{
+		if (Source.bHasReflectedTypes)
+		{
+			Redirects.Add(FString::Printf(TEXT("+PackageRedirects=(OldName=\"/Script/%s\",NewName=\"/Script/%s\")"), *Source.ModuleName, *Plan.TargetModule));
+		}
+	}
+	if (Redirects.Num() > 0)
+	{
+		const FString IniPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir() / TEXT("DefaultEngine.ini"));
+		if (FPendingTextEdit* Ini = FindOrLoadPendingEdit(Edits, IniPath, true, OutErrors))
+		{
+			Ini->NewText = AddCoreRedirects(Ini->NewText, Redirects);
+		}
+	}
+
+	if (OutErrors.Num() > 0)
+	{
+		return false;
+	}
+	if (!StagePendingEdits(Staging, Edits, Error))
+	{
+		OutErrors.Add(Error);
+		return false;
+	}
+
+	for (const FModuleMergeSource& Source : Plan.Sources)
+	{
+		OutLog += FString::Printf(TEXT("== %s：移动 %d 个文件到 %s，删除 %s ==\n"),
+			*Source.ModuleName, Source.Files.Num(), *Plan.TargetDir, *FPaths::GetCleanFilename(Source.BuildCsPath));
+		if (Source.bDeleteModuleImpl)
+		{
+			OutLog += TEXT("  删除模块样板：") + Source.ModuleImplFile + TEXT("\n");
+		}
+		if (!Source.ModuleHeaderFile.IsEmpty())
+		{
+			OutLog += TEXT("  删除模块样板：") + Source.ModuleHeaderFile + TEXT("\n");
+		}
+	}
+
+	if (bDryRun)
+	{
+		OutLog += Staging.MakeDiff();
+		return true;
+	}
+
+	// 4）一次写盘
+	FStagingFlushResult Flush;
+	if (!Staging.Flush(Flush, Error))
+	{
+		OutErrors.Add(TEXT("合并未写盘，磁盘保持原样：") + Error);
+		return false;
+	}
+	OutLog += FString::Printf(TEXT("已写入 %d 个文件，移走或删除 %d 个文件\n"), Flush.WrittenFiles.Num(), Flush.DeletedFiles.Num());
+
+	// 非空目录删除会失败，直接忽略
+	TArray<FString> Dirs = SourceDirs.Array();
+	Dirs.Sort([](const FString& A, const FString& B) { return A.Len() > B.Len(); });
+	for (const FString& Dir : Dirs)
+	{
+		IFileManager::Get().DeleteDirectory(*Dir, false, false);
+	}
+
+	return true;
+}
+
+} // namespace ModuleBuilder
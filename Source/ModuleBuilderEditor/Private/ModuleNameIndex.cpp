@@ -0,0 +1,255 @@
+#include "ModuleNameIndex.h"
+#include "PluginDescriptorScanner.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Interfaces/IProjectManager.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "ProjectDescriptor.h"
+#include "Tasks/Task.h"
+
+#define LOCTEXT_NAMESPACE "ModuleBuilderNameIndex"
+
+static void AddPluginModules(const IPlugin& Plugin, TMap<FString, FModuleNameEntry>& OutEntries)
+{
+	const EModuleNameOwner Owner = Plugin.GetType() == EPluginType::Project
+		? EModuleNameOwner::ProjectPlugin
+		: EModuleNameOwner::Engine;
+
+	for (const FModuleDescriptor& Module : Plugin.GetDescriptor().Modules)
+	{
+		OutEntries.Add(Module.Name.ToString(), FModuleNameEntry{ Owner, Plugin.GetName() });
+	}
+}
+
+FModuleNameIndex& FModuleNameIndex::Get()
+{
+	static FModuleNameIndex Instance;
+	return Instance;
+}
+
+void FModuleNameIndex::Initialize()
+{
+	MountedHandle = IPluginManager::Get().OnNewPluginMounted().AddRaw(this, &FModuleNameIndex::HandlePluginMounted);
+	ScanHandle = FPluginDescriptorScanner::Get().OnScanCompleted().AddRaw(this, &FModuleNameIndex::HandleScanCompleted);
+}
+
+void FModuleNameIndex::Shutdown()
+{
+	IPluginManager::Get().OnNewPluginMounted().Remove(MountedHandle);
+	FPluginDescriptorScanner::Get().OnScanCompleted().Remove(ScanHandle);
+
+	Entries.Reset();
+	bReady = false;
+}
+
+void FModuleNameIndex::CollectKnownModules(TMap<FString, FModuleNameEntry>& OutEntries, TArray<FString>& OutSourceRoots) const
+{
+	// 模块管理器知道的所有已编译模块（主要是引擎模块）
+	TArray<FName> KnownModules;
+	FModuleManager::Get().FindModules(TEXT("*"), KnownModules);
+	for (const FName& Name : KnownModules)
+	{
+		OutEntries.Add(Name.ToString(), FModuleNameEntry{ EModuleNameOwner::Engine, TEXT("Engine") });
+	}
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		AddPluginModules(*Plugin, OutEntries);
+		if (Plugin->GetType() == EPluginType::Project)
+		{
+			OutSourceRoots.Add(Plugin->GetBaseDir() / TEXT("Source"));
+		}
+	}
+
+	for (const FScannedPlugin& Scanned : FPluginDescriptorScanner::Get().GetPlugins())
+	{
+		for (const FString& ModuleName : Scanned.ModuleNames)
+		{
+			OutEntries.Add(ModuleName, FModuleNameEntry{ EModuleNameOwner::ProjectPlugin, Scanned.Name });
+		}
+		OutSourceRoots.AddUnique(Scanned.GetBaseDir() / TEXT("Source"));
+	}
+
+	if (const FProjectDescriptor* Project = IProjectManager::Get().GetCurrentProject())
+	{
+		for (const FModuleDescriptor& Module : Project->Modules)
+		{
+			OutEntries.Add(Module.Name.ToString(), FModuleNameEntry{ EModuleNameOwner::Project, FApp::GetProjectName() });
+		}
+	}
+	OutSourceRoots.Add(FPaths::ProjectDir() / TEXT("Source"));
+
+	for (FString& Root : OutSourceRoots)
+	{
+		Root = FPaths::ConvertRelativePathToFull(Root);
+	}
+}
+
+void FModuleNameIndex::CollectSourceFolders(const TArray<FString>& SourceRoots, TMap<FString, FModuleNameEntry>& OutEntries)
+{
+	for (const FString& Root : SourceRoots)
+	{
+		IFileManager::Get().IterateDirectory(*Root, [&OutEntries](const TCHAR* Path, bool bIsDirectory)
+		{
+			if (bIsDirectory)
+			{
+				OutEntries.Add(FPaths::GetCleanFilename(Path), FModuleNameEntry{ EModuleNameOwner::SourceFolder, Path });
+			}
+			return true;
+		});
+	}
+}
+
+void FModuleNameIndex::StartBuild()
+{
+	check(IsInGameThread());
+
+	if (bBuilding.exchange(true))
+	{
+		return;
+	}
+
+	TMap<FString, FModuleNameEntry> Known;
+	TArray<FString> SourceRoots;
+	CollectKnownModules(Known, SourceRoots);
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Known = MoveTemp(Known), SourceRoots = MoveTemp(SourceRoots)]() mutable
+	{
+		TMap<FString, FModuleNameEntry> Folders;
+		CollectSourceFolders(SourceRoots, Folders);
+
+		AsyncTask(ENamedThreads::GameThread, [Known = MoveTemp(Known), Folders = MoveTemp(Folders)]() mutable
+		{
+			FModuleNameIndex::Get().ApplyBuild(MoveTemp(Known), MoveTemp(Folders));
+		});
+	});
+}
+
+void FModuleNameIndex::BuildBlocking()
+{
+	bBuilding.store(true);
+
+	TMap<FString, FModuleNameEntry> Known;
+	TArray<FString> SourceRoots;
+	CollectKnownModules(Known, SourceRoots);
+
+	TMap<FString, FModuleNameEntry> Folders;
+	CollectSourceFolders(SourceRoots, Folders);
+
+	ApplyBuild(MoveTemp(Known), MoveTemp(Folders));
+}
+
+void FModuleNameIndex::ApplyBuild(TMap<FString, FModuleNameEntry>&& Known, TMap<FString, FModuleNameEntry>&& Folders)
+{
+	// 合并而不是替换：构建期间 AddModule / HandlePluginMounted 增量加入的条目比快照新，同名时保留
+	Entries.Reserve(Entries.Num() + Known.Num() + Folders.Num());
+
+	for (TPair<FString, FModuleNameEntry>& Pair : Known)
+	{
+		if (!Entries.Contains(Pair.Key))
+		{
+			Entries.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+		}
+	}
+
+	// 已注册的模块优先于单纯的目录
+	for (TPair<FString, FModuleNameEntry>& Pair : Folders)
+	{
+		if (!Entries.Contains(Pair.Key))
+		{
+			Entries.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+		}
+	}
+
+	bReady = true;
+	bBuilding.store(false);
+}
+
+void FModuleNameIndex::AddModule(const FString& ModuleName, EModuleNameOwner Owner, const FString& OwnerName)
+{
+	Entries.Add(ModuleName, FModuleNameEntry{ Owner, OwnerName });
+}
+
+void FModuleNameIndex::HandlePluginMounted(IPlugin& Plugin)
+{
+	AddPluginModules(Plugin, Entries);
+}
+
+void FModuleNameIndex::HandleScanCompleted()
+{
+	for (const FScannedPlugin& Scanned : FPluginDescriptorScanner::Get().GetPlugins())
+	{
+		for (const FString& ModuleName : Scanned.ModuleNames)
+		{
+			if (!Entries.Contains(ModuleName))
+			{
+				Entries.Add(ModuleName, FModuleNameEntry{ EModuleNameOwner::ProjectPlugin, Scanned.Name });
+			}
+		}
+	}
+}
+
+bool FModuleNameIndex::IsValidModuleIdentifier(const FString& ModuleName)
+{
+	// 只接受 ASCII：FChar::IsAlnum 对中文等字符也为真，但模块名要用作 C# 类名、C++ 宏与文件名
+	auto IsAsciiLetter = [](TCHAR C) { return (C >= TEXT('A') && C <= TEXT('Z')) || (C >= TEXT('a') && C <= TEXT('z')) || C == TEXT('_'); };
+	auto IsAsciiDigit = [](TCHAR C) { return C >= TEXT('0') && C <= TEXT('9'); };
+
+	if (ModuleName.IsEmpty() || !IsAsciiLetter(ModuleName[0]))
+	{
+		return false;
+	}
+
+	for (const TCHAR C : ModuleName)
+	{
+		if (!IsAsciiLetter(C) && !IsAsciiDigit(C))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FModuleNameIndex::ValidateNewModuleName(const FString& ModuleName, FText& OutReason) const
+{
+	if (ModuleName.IsEmpty())
+	{
+		OutReason = LOCTEXT("NameEmpty", "模块名称不能为空。");
+		return false;
+	}
+
+	if (!IsValidModuleIdentifier(ModuleName))
+	{
+		OutReason = LOCTEXT("NameInvalid", "模块名称只能包含英文字母、数字和下划线，且不能以数字开头。");
+		return false;
+	}
+
+	const FModuleNameEntry* Entry = Find(ModuleName);
+	if (!Entry)
+	{
+		return true;
+	}
+
+	switch (Entry->Owner)
+	{
+	case EModuleNameOwner::Engine:
+		OutReason = FText::Format(LOCTEXT("NameEngine", "与引擎模块重名（{0}）。"), FText::FromString(Entry->OwnerName));
+		break;
+	case EModuleNameOwner::Project:
+		OutReason = LOCTEXT("NameProject", "工程中已存在同名模块。");
+		break;
+	case EModuleNameOwner::ProjectPlugin:
+		OutReason = FText::Format(LOCTEXT("NamePlugin", "插件 {0} 中已存在同名模块。"), FText::FromString(Entry->OwnerName));
+		break;
+	case EModuleNameOwner::SourceFolder:
+		OutReason = FText::Format(LOCTEXT("NameFolder", "已存在同名目录：{0}"), FText::FromString(Entry->OwnerName));
+		break;
+	}
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
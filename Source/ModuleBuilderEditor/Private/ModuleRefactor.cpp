@@ -0,0 +1,720 @@
+#include "ModuleRefactor.h"
+#include "DependencyDemotion.h"
+#include "DescriptorPatcher.h"
+#include "IncludeResolver.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleNameIndex.h"
+#include "ModuleStaging.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+namespace ModuleRefactorPrivate
+{
+
+// 报告中最多列出的移动条目
+static constexpr int32 GMaxListedMoves = 30;
+
+static bool IsHeader(const FString& Path)
+{
+	const FString Extension = FPaths::GetExtension(Path);
+	return Extension == TEXT("h") || Extension == TEXT("hpp") || Extension == TEXT("inl");
+}
+
+// 路径所属的图内模块（最长的模块目录前缀）
+static int32 FindOwnerModule(const FModuleDependencyGraph& Graph, const FString& Path)
+{
+	int32 Best = INDEX_NONE;
+	int32 BestLen = 0;
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FString& Dir = Nodes[Index].ModuleDir;
+		if (Dir.Len() > BestLen && Path.StartsWith(Dir + TEXT("/")))
+		{
+			Best = Index;
+			BestLen = Dir.Len();
+		}
+	}
+	return Best;
+}
+
+static void CollectScanFiles(const TArray<FModuleSourceRoot>& Roots, TArray<FString>& OutFiles)
+{
+	TArray<FString> Dirs;
+	for (const FModuleSourceRoot& Root : Roots)
+	{
+		Dirs.Add(Root.Dir);
+	}
+	CollectRewritableFiles(Dirs, OutFiles);
+}
+
+// 从 Dir 逐级记录到 StopDir（不含）为止的目录
+static void AddEmptiedDirs(const FString& Dir, const FString& StopDir, TArray<FString>& OutDirs)
+{
+	for (FString Current = Dir; Current.Len() > StopDir.Len() && Current.StartsWith(StopDir); Current = FPaths::GetPath(Current))
+	{
+		OutDirs.AddUnique(Current);
+	}
+}
+
+// 配置中按 /Script/<Module> 引用的节与值，改名后需要手工处理
+static void FindConfigReferences(const FString& ContainerRoot, const FString& ModuleName, TArray<FString>& OutWarnings)
+{
+	TArray<FString> IniFiles;
+	IFileManager::Get().FindFilesRecursive(IniFiles, *(ContainerRoot / TEXT("Config")), TEXT("*.ini"), true, false);
+
+	const FString Needle = TEXT("/Script/") + ModuleName + TEXT(".");
+	for (const FString& Ini : IniFiles)
+	{
+		FString Text;
+		if (FFileHelper::LoadFileToString(Text, *Ini) && Text.Contains(Needle, ESearchCase::CaseSensitive))
+		{
+			OutWarnings.Add(FString::Printf(TEXT("%s 中有 %s 开头的配置，已写入包重定向，但配置节名需手工改为新模块"), *Ini, *Needle));
+		}
+	}
+}
+
+static bool ModuleHasReflectedTypes(const TArray<FString>& Files)
+{
+	for (const FString& File : Files)
+	{
+		FString Text;
+		TArray<TPair<FString, FString>> Types;
+		if (IsHeader(File) && FFileHelper::LoadFileToString(Text, *File))
+		{
+			FindReflectedTypes(Text, Types);
+			if (Types.Num() > 0)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+static void AddRedirects(TArray<FPendingTextEdit>& Edits, const TArray<FString>& Redirects, TArray<FString>& OutErrors)
+{
+	if (Redirects.Num() == 0)
+	{
+		return;
+	}
+
+	const FString IniPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir() / TEXT("DefaultEngine.ini"));
+	if (FPendingTextEdit* Ini = FindOrLoadPendingEdit(Edits, IniPath, true, OutErrors))
+	{
+		Ini->NewText = AddCoreRedirects(Ini->NewText, Redirects);
+	}
+}
+
+// 在 Augmented（图中已有边加上新增边）中 To 能否回到 From
+static bool Reaches(const TArray<TArray<int32>>& Augmented, int32 From, int32 To)
+{
+	TSet<int32> Visited;
+	TArray<int32> Queue = { To };
+	while (Queue.Num() > 0)
+	{
+		const int32 Node = Queue.Pop(EAllowShrinking::No);
+		if (Node == From)
+		{
+			return true;
+		}
+
+		bool bAlreadyInSet = false;
+		Visited.Add(Node, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Queue.Append(Augmented[Node]);
+		}
+	}
+	return false;
+}
+
+} // namespace ModuleRefactorPrivate
+
+bool PlanModuleRename(const FModuleDependencyGraph& Graph, const TArray<FModuleSourceRoot>& Roots,
+	const FString& OldName, const FString& NewName, FModuleRefactorPlan& OutPlan, FString& OutError)
+{
+	using namespace ModuleRefactorPrivate;
+
+	OutPlan = FModuleRefactorPlan();
+	OutPlan.Title = FString::Printf(TEXT("重命名模块 %s → %s"), *OldName, *NewName);
+
+	const int32 NodeIndex = Graph.FindNode(OldName);
+	if (NodeIndex == INDEX_NONE)
+	{
+		OutError = TEXT("没有找到模块：") + OldName;
+		return false;
+	}
+	if (!FModuleNameIndex::IsValidModuleIdentifier(NewName))
+	{
+		OutError = TEXT("新模块名不是合法的标识符：") + NewName;
+		return false;
+	}
+	if (Graph.FindNode(NewName) != INDEX_NONE)
+	{
+		OutError = TEXT("已存在同名模块：") + NewName;
+		return false;
+	}
+
+	const FModuleNode& Node = Graph.GetNodes()[NodeIndex];
+	const FString NewDir = FPaths::GetPath(Node.ModuleDir) / NewName;
+	if (IFileManager::Get().DirectoryExists(*NewDir))
+	{
+		OutError = TEXT("目标目录已存在：") + NewDir;
+		return false;
+	}
+
+	FString ContainerRoot;
+	if (!FindModuleContainer(Node.ModuleDir, ContainerRoot, OutPlan.DescriptorPath))
+	{
+		OutError = TEXT("找不到模块所属的 .uproject / .uplugin：") + Node.ModuleDir;
+		return false;
+	}
+	OutPlan.NewModuleName = NewName;
+
+	// 1）文件移动：Build.cs 与生成器的 <Name>.h / <Name>.cpp 随模块改名
+	TArray<FString> ModuleFiles;
+	IFileManager::Get().FindFilesRecursive(ModuleFiles, *Node.ModuleDir, TEXT("*.*"), true, false);
+	ModuleFiles.Sort();
+
+	TArray<FTextRewriteRule> Rules;
+
+	for (const FString& File : ModuleFiles)
+	{
+		FString Relative = File.RightChop(Node.ModuleDir.Len() + 1);
+		const FString FileName = FPaths::GetCleanFilename(File);
+
+		if (File == Node.BuildCsPath)
+		{
+			Relative = FPaths::GetPath(Relative) / NewName + TEXT(".Build.cs");
+		}
+		else if (FPaths::GetBaseFilename(File) == OldName && (FPaths::GetExtension(File) == TEXT("h") || FPaths::GetExtension(File) == TEXT("cpp")))
+		{
+			Relative = FPaths::GetPath(Relative) / NewName + TEXT(".") + FPaths::GetExtension(File);
+
+			if (IsHeader(File))
+			{
+				const FString OldKey = GetIncludeKey(Node.ModuleDir, File);
+				const FString NewKey = FPaths::GetPath(OldKey) / NewName + TEXT(".h");
+				Rules.Add({ ETextRewriteKind::IncludePath, OldKey, NewKey, ETextRewriteFiles::Code });
+				if (OldKey != FileName)
+				{
+					Rules.Add({ ETextRewriteKind::IncludePath, FileName, NewName + TEXT(".h"), ETextRewriteFiles::Code, Node.ModuleDir });
+				}
+			}
+		}
+
+		OutPlan.Moves.Add({ File, NewDir / Relative });
+		AddEmptiedDirs(FPaths::GetPath(File), FPaths::GetPath(Node.ModuleDir), OutPlan.EmptiedDirs);
+	}
+
+	// 2）全树改写规则
+	Rules.Add({ ETextRewriteKind::Identifier, OldName.ToUpper() + TEXT("_API"), NewName.ToUpper() + TEXT("_API"), ETextRewriteFiles::Code });
+	Rules.Add({ ETextRewriteKind::Identifier, TEXT("F") + OldName + TEXT("Module"), TEXT("F") + NewName + TEXT("Module"), ETextRewriteFiles::Code, Node.ModuleDir });
+	Rules.Add({ ETextRewriteKind::ImplementModuleName, OldName, NewName, ETextRewriteFiles::Code, Node.ModuleDir });
+	Rules.Add({ ETextRewriteKind::Identifier, OldName, NewName, ETextRewriteFiles::Scripts, Node.BuildCsPath });
+	Rules.Add({ ETextRewriteKind::QuotedString, OldName, NewName, ETextRewriteFiles::Scripts });
+
+	// 代码里只改模块加载调用的参数；其余同名字符串（可能是资源路径、配置键等）只记录命中，列出待人工确认
+	Rules.Add({ ETextRewriteKind::ModuleLoadArgument, OldName, NewName, ETextRewriteFiles::Code });
+	const int32 CodeStringRule = Rules.Add({ ETextRewriteKind::QuotedString, OldName, OldName, ETextRewriteFiles::Code });
+
+	TArray<FString> ScanFiles;
+	CollectScanFiles(Roots, ScanFiles);
+
+	TArray<FRewrittenFile> Rewritten;
+	RewriteFiles(ScanFiles, Rules, Rewritten, OutPlan.Stats);
+
+	for (FRewrittenFile& File : Rewritten)
+	{
+		if (File.Rules.Contains(CodeStringRule))
+		{
+			OutPlan.ReviewFiles.Add(File.Edit.Path);
+		}
+		if (File.Edit.IsChanged())
+		{
+			OutPlan.Edits.Add(MoveTemp(File.Edit));
+		}
+	}
+
+	// 3）描述文件条目、反射类型的包重定向
+	TArray<FString> Errors;
+	if (FPendingTextEdit* Descriptor = FindOrLoadPendingEdit(OutPlan.Edits, OutPlan.DescriptorPath, false, Errors))
+	{
+		FString Patched;
+		if (!SetDescriptorModuleField(Descriptor->NewText, OldName, TEXT("Name"), NewName, Patched, OutError))
+		{
+			return false;
+		}
+		Descriptor->NewText = Patched;
+	}
+
+	if (ModuleHasReflectedTypes(ModuleFiles))
+	{
+		AddRedirects(OutPlan.Edits, { FString::Printf(TEXT("+PackageRedirects=(OldName=\"/Script/%s\",NewName=\"/Script/%s\")"), *OldName, *NewName) }, Errors);
+		FindConfigReferences(FPaths::ProjectDir(), OldName, OutPlan.Warnings);
+	}
+
+	if (Errors.Num() > 0)
+	{
+		OutError = FString::Join(Errors, TEXT("\n"));
+		return false;
+	}
+
+	OutPlan.Warnings.Add(TEXT("Intermediate 与 Binaries 中旧模块的产物不会自动删除；编辑器需重启后才会加载新名字的模块"));
+	return true;
+}
+
+bool PlanModuleFileMove(const FModuleDependencyGraph& Graph, const TArray<FModuleSourceRoot>& Roots,
+	const FModuleFileMoveRequest& Request, FModuleRefactorPlan& OutPlan, FString& OutError)
+{
+	using namespace ModuleRefactorPrivate;
+
+	OutPlan = FModuleRefactorPlan();
+	OutPlan.Title = FString::Printf(TEXT("移动 %d 项：%s → %s"), Request.Files.Num(), *Request.FromModule, *Request.ToModule);
+
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+	const int32 FromIndex = Graph.FindNode(Request.FromModule);
+	const int32 ToIndex = Graph.FindNode(Request.ToModule);
+	if (FromIndex == INDEX_NONE || ToIndex == INDEX_NONE || FromIndex == ToIndex)
+	{
+		OutError = FString::Printf(TEXT("源模块与目标模块必须是两个已有模块：%s → %s"), *Request.FromModule, *Request.ToModule);
+		return false;
+	}
+
+	const FModuleNode& From = Nodes[FromIndex];
+	const FModuleNode& To = Nodes[ToIndex];
+
+	FString FromRoot;
+	FString ToRoot;
+	FString FromDescriptor;
+	FindModuleContainer(From.ModuleDir, FromRoot, FromDescriptor);
+	FindModuleContainer(To.ModuleDir, ToRoot, OutPlan.DescriptorPath);
+	if (FromDescriptor != OutPlan.DescriptorPath)
+	{
+		OutPlan.Warnings.Add(FString::Printf(TEXT("%s 与 %s 不在同一个工程 / 插件中，请确认依赖方能引用 %s 所在的插件"), *From.Name, *To.Name, *To.Name));
+	}
+
+	// 1）展开目录、计算目标路径
+	TArray<FString> Sources;
+	for (const FString& Entry : Request.Files)
+	{
+		const FString Path = FPaths::ConvertRelativePathToFull(From.ModuleDir / Entry);
+		if (IFileManager::Get().DirectoryExists(*Path))
+		{
+			TArray<FString> Found;
+			IFileManager::Get().FindFilesRecursive(Found, *Path, TEXT("*.*"), true, false);
+			Sources.Append(Found);
+		}
+		else if (FPaths::FileExists(Path))
+		{
+			Sources.Add(Path);
+		}
+		else
+		{
+			OutError = TEXT("文件不存在：") + Path;
+			return false;
+		}
+	}
+	Sources.Sort();
+
+	TSet<FString> Moved;
+	TMap<FString, FString> Destinations;
+	for (const FString& Source : Sources)
+	{
+		if (Source == From.BuildCsPath)
+		{
+			OutError = TEXT("Build.cs 不能移动：") + Source;
+			return false;
+		}
+
+		const FString Destination = Request.DestinationFolder.IsEmpty()
+			? To.ModuleDir / Source.RightChop(From.ModuleDir.Len() + 1)
+			: To.ModuleDir / Request.DestinationFolder / FPaths::GetCleanFilename(Source);
+		if (FPaths::FileExists(Destination) || Destinations.FindKey(Destination))
+		{
+			OutError = TEXT("目标文件已存在或重名：") + Destination;
+			return false;
+		}
+
+		Moved.Add(Source);
+		Destinations.Add(Source, Destination);
+		OutPlan.Moves.Add({ Source, Destination });
+		AddEmptiedDirs(FPaths::GetPath(Source), From.ModuleDir, OutPlan.EmptiedDirs);
+	}
+
+	// 2）移动后的包含路径与 API 宏；FROM 规则下标 → 被移动的头文件
+	TArray<FTextRewriteRule> Rules;
+	TMap<int32, FString> HeaderRules;
+	bool bAnyPublicDestination = false;
+
+	const FString FromApi = From.Name.ToUpper() + TEXT("_API");
+	const FString ToApi = To.Name.ToUpper() + TEXT("_API");
+
+	for (const FString& Source : Sources)
+	{
+		const FString& Destination = Destinations[Source];
+		bool bPublicDestination = false;
+		const FString NewKey = GetIncludeKey(To.ModuleDir, Destination, &bPublicDestination);
+		bAnyPublicDestination |= bPublicDestination;
+
+		Rules.Add({ ETextRewriteKind::Identifier, FromApi, ToApi, ETextRewriteFiles::Code, Source });
+
+		if (!IsHeader(Source))
+		{
+			continue;
+		}
+
+		const FString OldKey = GetIncludeKey(From.ModuleDir, Source);
+		HeaderRules.Add(Rules.Add({ ETextRewriteKind::IncludePath, OldKey, NewKey, ETextRewriteFiles::Code }), Source);
+
+		// 同目录文件按文件名包含
+		const FString FileName = FPaths::GetCleanFilename(Source);
+		if (OldKey != FileName)
+		{
+			HeaderRules.Add(Rules.Add({ ETextRewriteKind::IncludePath, FileName, NewKey, ETextRewriteFiles::Code, FPaths::GetPath(Source), false }), Source);
+		}
+	}
+
+	// 新增依赖：(模块, 依赖, 是否 Public)
+	TArray<TArray<int32>> Augmented;
+	Augmented.SetNum(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Augmented[Index] = Nodes[Index].AllEdges;
+	}
+
+	struct FNewDependency
+	{
+		int32 Module = INDEX_NONE;
+		int32 Dependency = INDEX_NONE;
+		bool bPublic = false;
+	};
+	TArray<FNewDependency> NewDependencies;
+
+	auto AddDependency = [&NewDependencies, &Augmented](int32 Module, int32 Dependency, bool bPublic)
+	{
+		FNewDependency* Existing = NewDependencies.FindByPredicate([Module, Dependency](const FNewDependency& Entry) { return Entry.Module == Module && Entry.Dependency == Dependency; });
+		if (Existing)
+		{
+			Existing->bPublic |= bPublic;
+			return;
+		}
+		NewDependencies.Add({ Module, Dependency, bPublic });
+		Augmented[Module].AddUnique(Dependency);
+	};
+
+	// 被移动的文件包含源模块中留下的文件；只在源模块内解析
+	TArray<FString> SourceDirs;
+	for (const TCHAR* Folder : GModuleTopFolders)
+	{
+		SourceDirs.Add(From.ModuleDir / Folder);
+	}
+	FIncludeResolver Resolver(MoveTemp(SourceDirs));
+
+	for (const FString& Source : Sources)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *Source))
+		{
+			continue;
+		}
+
+		bool bPublicDestination = false;
+		GetIncludeKey(To.ModuleDir, Destinations[Source], &bPublicDestination);
+
+		TArray<FString> Includes;
+		FModuleDependencyGraph::ParseIncludes(Text, Includes);
+		for (const FString& Include : Includes)
+		{
+			const FString Resolved = Resolver.Resolve(Include, FPaths::GetPath(Source));
+			const bool bSibling = Resolved == FPaths::ConvertRelativePathToFull(FPaths::GetPath(Source) / Include);
+			if (Resolved.IsEmpty() || Moved.Contains(Resolved) || !Resolved.StartsWith(From.ModuleDir + TEXT("/")))
+			{
+				continue;
+			}
+
+			bool bPublicHeader = false;
+			const FString Key = GetIncludeKey(From.ModuleDir, Resolved, &bPublicHeader);
+			if (!bPublicHeader)
+			{
+				OutPlan.Warnings.Add(FString::Printf(TEXT("%s 包含了 %s 的私有头文件 %s，移动后需把它移到 Public/ 或一并移动"),
+					*FPaths::GetCleanFilename(Source), *From.Name, *Include));
+				continue;
+			}
+
+			AddDependency(ToIndex, FromIndex, bPublicDestination);
+			if (bSibling && Include != Key)
+			{
+				Rules.Add({ ETextRewriteKind::IncludePath, Include, Key, ETextRewriteFiles::Code, Source });
+			}
+		}
+	}
+
+	// 3）全树扫描：包含了被移动头文件的模块需要依赖目标模块
+	TArray<FString> ScanFiles;
+	CollectScanFiles(Roots, ScanFiles);
+
+	TArray<FRewrittenFile> Rewritten;
+	RewriteFiles(ScanFiles, Rules, Rewritten, OutPlan.Stats);
+
+	for (FRewrittenFile& File : Rewritten)
+	{
+		const FString& Path = File.Edit.Path;
+		const int32 Owner = Moved.Contains(Path) ? ToIndex : FindOwnerModule(Graph, Path);
+
+		for (int32 Rule : File.Rules)
+		{
+			const FString* Header = HeaderRules.Find(Rule);
+			if (!Header || Owner == INDEX_NONE || Owner == ToIndex)
+			{
+				continue;
+			}
+
+			bool bPublicHeader = false;
+			GetIncludeKey(To.ModuleDir, Destinations[*Header], &bPublicHeader);
+			if (!bPublicHeader)
+			{
+				OutPlan.Warnings.Add(FString::Printf(TEXT("%s 包含的 %s 将位于 %s 的私有目录，移动后无法编译"),
+					*Path, *FPaths::GetCleanFilename(*Header), *To.Name));
+				continue;
+			}
+
+			bool bPublicIncluder = false;
+			GetIncludeKey(Nodes[Owner].ModuleDir, Path, &bPublicIncluder);
+			AddDependency(Owner, ToIndex, bPublicIncluder);
+		}
+
+		if (File.Edit.IsChanged())
+		{
+			OutPlan.Edits.Add(MoveTemp(File.Edit));
+		}
+	}
+
+	// 4）新增依赖不能成环
+	for (const FNewDependency& Dependency : NewDependencies)
+	{
+		if (Reaches(Augmented, Dependency.Module, Dependency.Dependency))
+		{
+			OutError = FString::Printf(TEXT("移动后 %s 与 %s 互相依赖，请调整要移动的文件"),
+				*Nodes[Dependency.Module].Name, *Nodes[Dependency.Dependency].Name);
+			return false;
+		}
+	}
+
+	// 5）Build.cs：目标模块沿用源模块的依赖，依赖方补上目标模块
+	TArray<FString> Errors;
+	auto AddToBuildCs = [&OutPlan, &Errors](const FString& BuildCsPath, const TArray<FString>& Dependencies, bool bPublic)
+	{
+		FPendingTextEdit* Edit = FindOrLoadPendingEdit(OutPlan.Edits, BuildCsPath, false, Errors);
+		FString Error;
+		FString Patched;
+		if (Edit && Dependencies.Num() > 0)
+		{
+			if (AddDependenciesToBuildCs(Edit->NewText, Dependencies, bPublic, Patched, Error))
+			{
+				Edit->NewText = Patched;
+			}
+			else
+			{
+				Errors.Add(BuildCsPath + TEXT("：") + Error);
+			}
+		}
+	};
+
+	TArray<FString> InheritedPublic = From.PublicDependencies;
+	TArray<FString> InheritedPrivate = From.PrivateDependencies;
+	InheritedPublic.Remove(To.Name);
+	InheritedPrivate.Remove(To.Name);
+	if (!bAnyPublicDestination)
+	{
+		InheritedPrivate.Append(InheritedPublic);
+		InheritedPublic.Reset();
+	}
+	AddToBuildCs(To.BuildCsPath, InheritedPublic, true);
+	AddToBuildCs(To.BuildCsPath, InheritedPrivate, false);
+
+	for (const FNewDependency& Dependency : NewDependencies)
+	{
+		AddToBuildCs(Nodes[Dependency.Module].BuildCsPath, { Nodes[Dependency.Dependency].Name }, Dependency.bPublic);
+	}
+
+	// 6）被移动的反射类型
+	TArray<FString> Redirects;
+	for (const FString& Source : Sources)
+	{
+		FString Text;
+		TArray<TPair<FString, FString>> Types;
+		if (IsHeader(Source) && FFileHelper::LoadFileToString(Text, *Source))
+		{
+			FindReflectedTypes(Text, Types);
+		}
+		for (const TPair<FString, FString>& Type : Types)
+		{
+			Redirects.Add(FString::Printf(TEXT("+%s=(OldName=\"/Script/%s.%s\",NewName=\"/Script/%s.%s\")"),
+				*Type.Key, *From.Name, *Type.Value, *To.Name, *Type.Value));
+		}
+	}
+	AddRedirects(OutPlan.Edits, Redirects, Errors);
+
+	if (Errors.Num() > 0)
+	{
+		OutError = FString::Join(Errors, TEXT("\n"));
+		return false;
+	}
+	return true;
+}
+
+FString FormatRefactorPlan(const FModuleRefactorPlan& Plan)
+{
+	using namespace ModuleRefactorPrivate;
+
+	FString Report = TEXT("== ") + Plan.Title + TEXT(" ==\n");
+	Report += FString::Printf(TEXT("  扫描 %d 个文件（%.1f MB，内存映射 %d 个），预筛命中 %d 个，内容变化 %d 个，用时 %.2f 秒\n"),
+		Plan.Stats.Files, Plan.Stats.Bytes / (1024.0 * 1024.0), Plan.Stats.MappedFiles, Plan.Stats.Candidates, Plan.Stats.Changed, Plan.Stats.Seconds);
+
+	int32 Changed = 0;
+	for (const FPendingTextEdit& Edit : Plan.Edits)
+	{
+		Changed += Edit.IsChanged() ? 1 : 0;
+	}
+	Report += FString::Printf(TEXT("  写回 %d 个文件（含 Build.cs / 描述文件 / 配置），移动 %d 个文件；其余文件不写，时间戳不变\n"), Changed, Plan.Moves.Num());
+
+	Report += TEXT("\n== 移动 ==\n");
+	for (int32 Index = 0; Index < Plan.Moves.Num(); ++Index)
+	{
+		if (Index == GMaxListedMoves)
+		{
+			Report += FString::Printf(TEXT("  ……另有 %d 个\n"), Plan.Moves.Num() - GMaxListedMoves);
+			break;
+		}
+		Report += FString::Printf(TEXT("  %s\n    → %s\n"), *Plan.Moves[Index].Key, *Plan.Moves[Index].Value);
+	}
+
+	if (Plan.ReviewFiles.Num() > 0)
+	{
+		Report += TEXT("\n== C++ 中还有未改写的旧模块名字符串，请人工确认 ==\n");
+		for (const FString& File : Plan.ReviewFiles)
+		{
+			Report += TEXT("  ") + File + TEXT("\n");
+		}
+	}
+
+	if (Plan.Warnings.Num() > 0)
+	{
+		Report += TEXT("\n== 注意 ==\n");
+		for (const FString& Warning : Plan.Warnings)
+		{
+			Report += TEXT("  ") + Warning + TEXT("\n");
+		}
+	}
+	return Report;
+}
+
+bool ApplyModuleRefactor(const FModuleRefactorPlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors, int32 MaxDiffFiles)
+{
+	using namespace ModuleRefactorPrivate;
+
+	for (const TPair<FString, FString>& Move : Plan.Moves)
+	{
+		if (FPaths::FileExists(Move.Value))
+		{
+			OutErrors.Add(TEXT("目标文件已存在：") + Move.Value);
+		}
+	}
+	if (OutErrors.Num() > 0)
+	{
+		return false;
+	}
+
+	// 移动与文本改动都先进暂存区，最后一次写盘；任一步失败时磁盘保持原样
+	FModuleStagingArea Staging;
+	FString Error;
+
+	// 被移动的文件在移动后的暂存文本上改写，其余改动按原路径暂存
+	TMap<FString, const FPendingTextEdit*> EditByPath;
+	for (const FPendingTextEdit& Edit : Plan.Edits)
+	{
+		EditByPath.Add(Edit.Path, &Edit);
+	}
+
+	TArray<FPendingTextEdit> InPlaceEdits;
+	TSet<FString> MovedSources;
+	for (const TPair<FString, FString>& Move : Plan.Moves)
+	{
+		FString* Text = Staging.MoveFile(Move.Key, Move.Value, Error);
+		if (!Text)
+		{
+			OutErrors.Add(Error);
+			return false;
+		}
+		MovedSources.Add(Move.Key);
+
+		const FPendingTextEdit* const* Edit = EditByPath.Find(Move.Key);
+		if (Edit && (*Edit)->IsChanged())
+		{
+			if (!Text->Equals((*Edit)->OldText, ESearchCase::CaseSensitive))
+			{
+				OutErrors.Add(TEXT("文件在读取后被修改过，请重新生成方案：") + Move.Key);
+				return false;
+			}
+			*Text = (*Edit)->NewText;
+		}
+	}
+	for (const FPendingTextEdit& Edit : Plan.Edits)
+	{
+		if (!MovedSources.Contains(Edit.Path))
+		{
+			InPlaceEdits.Add(Edit);
+		}
+	}
+
+	if (!StagePendingEdits(Staging, InPlaceEdits, Error))
+	{
+		OutErrors.Add(Error);
+		return false;
+	}
+
+	if (bDryRun)
+	{
+		OutLog += Staging.MakeDiff(MaxDiffFiles);
+		return true;
+	}
+
+	FStagingFlushResult Flush;
+	if (!Staging.Flush(Flush, Error))
+	{
+		OutErrors.Add(TEXT("改写未写盘，磁盘保持原样：") + Error);
+		return false;
+	}
+
+	// 非空目录删除会失败，直接忽略
+	TArray<FString> Dirs = Plan.EmptiedDirs;
+	Dirs.Sort([](const FString& A, const FString& B) { return A.Len() > B.Len(); });
+	for (const FString& Dir : Dirs)
+	{
+		IFileManager::Get().DeleteDirectory(*Dir, false, false);
+	}
+
+	OutLog += FString::Printf(TEXT("已写入 %d 个文件，移动 %d 个文件\n"), Flush.WrittenFiles.Num(), Plan.Moves.Num());
+
+	// 名称索引只在游戏线程访问
+	if (!Plan.NewModuleName.IsEmpty())
+	{
+		const bool bIsProject = Plan.DescriptorPath.EndsWith(TEXT(".uproject"));
+		const FString OwnerName = FPaths::GetBaseFilename(Plan.DescriptorPath);
+		AsyncTask(ENamedThreads::GameThread, [Name = Plan.NewModuleName, bIsProject, OwnerName]()
+		{
+			FModuleNameIndex::Get().AddModule(Name, bIsProject ? EModuleNameOwner::Project : EModuleNameOwner::ProjectPlugin, OwnerName);
+		});
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+} // namespace ModuleBuilder
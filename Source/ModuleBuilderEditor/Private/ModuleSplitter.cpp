@@ -0,0 +1,1372 @@
+#include "ModuleSplitter.h"
+#include "DependencyDemotion.h"
+#include "IncludeResolver.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "ModuleNameIndex.h"
+#include "ModuleStaging.h"
+#include "SourceRewrite.h"
+#include "UnityBuildAdvisor.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+namespace ModuleSplitterPrivate
+{
+
+// 少于这个数量的文件不值得拆分
+static constexpr int32 GMinSplitFiles = 8;
+
+// 标签传播的迭代上限（通常十轮内收敛）
+static constexpr int32 GMaxPropagationPasses = 32;
+
+// UBT 对工程模块的默认值：32 个 .cpp 起启用 unity，每块约 384 KB
+static constexpr int32 GDefaultMinUnityFiles = 32;
+static constexpr int32 GDefaultUnityBytes = 384 * 1024;
+
+struct FSplitFile
+{
+	FString Path;
+
+	// 相对模块目录的路径；去掉顶层 Public/Private/... 后的路径（依赖方 #include 的写法）
+	FString Relative;
+	FString IncludeKey;
+
+	bool bSource = false;
+	bool bPublic = false;
+	bool bImplementsModule = false;
+	int64 Bytes = 0;
+
+	// 模块内被本文件直接包含的文件
+	TArray<int32> Includes;
+	int32 Unit = INDEX_NONE;
+
+	// (Redirects 类别, 类型名)
+	TArray<TPair<FString, FString>> ReflectedTypes;
+};
+
+struct FWorkCluster
+{
+	TArray<int32> Units;
+	int32 FileCount = 0;
+
+	// 公共头及其传递包含
+	bool bCore = false;
+};
+
+// Build.cs 中 PrivatePCHHeaderFile / SharedPCHHeaderFile 指向的文件
+static FString FindPCHPath(const FString& BuildCsText, const FString& ModuleDir)
+{
+	TArray<FBuildCsAssignment> Assignments;
+	FModuleDependencyGraph::ParseBuildCsAssignments(BuildCsText, Assignments);
+
+	for (const FBuildCsAssignment& Assignment : Assignments)
+	{
+		if (Assignment.Key == TEXT("PrivatePCHHeaderFile") || Assignment.Key == TEXT("SharedPCHHeaderFile"))
+		{
+			return FPaths::ConvertRelativePathToFull(ModuleDir / Assignment.Value.TrimQuotes());
+		}
+	}
+	return FString();
+}
+
+static void CollectFiles(const FString& ModuleDir, TArray<FSplitFile>& OutFiles)
+{
+	TArray<FString> Paths;
+	IFileManager::Get().FindFilesRecursive(Paths, *ModuleDir, TEXT("*.*"), true, false);
+	Paths.Sort();
+
+	for (const FString& Path : Paths)
+	{
+		const FString Extension = FPaths::GetExtension(Path);
+		if (Extension != TEXT("h") && Extension != TEXT("hpp") && Extension != TEXT("inl") && Extension != TEXT("cpp"))
+		{
+			continue;
+		}
+
+		FSplitFile& File = OutFiles.AddDefaulted_GetRef();
+		File.Path = Path;
+		File.Relative = Path.RightChop(ModuleDir.Len() + 1);
+		File.IncludeKey = GetIncludeKey(ModuleDir, Path, &File.bPublic);
+		File.bSource = Extension == TEXT("cpp");
+		File.Bytes = FMath::Max<int64>(0, IFileManager::Get().FileSize(*Path));
+	}
+}
+
+// 解析模块内的包含关系，顺带识别模块实现文件与反射类型
+static int32 ResolveIncludes(const FString& ModuleDir, TArray<FSplitFile>& Files)
+{
+	TMap<FString, int32> ByPath;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		ByPath.Add(Files[Index].Path, Index);
+	}
+
+	// 只查本模块：顶层目录与模块目录，文件是否存在查已收集的文件
+	TArray<FString> SearchDirs;
+	for (const TCHAR* Folder : GModuleTopFolders)
+	{
+		SearchDirs.Add(ModuleDir / Folder);
+	}
+	SearchDirs.Add(ModuleDir);
+
+	ParallelFor(Files.Num(), [&Files, &ByPath, &SearchDirs](int32 Index)
+	{
+		FSplitFile& File = Files[Index];
+
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *File.Path))
+		{
+			return;
+		}
+
+		TArray<FString> Includes;
+		FModuleDependencyGraph::ParseIncludes(Text, Includes);
+
+		FIncludeResolver Resolver(SearchDirs, [&ByPath](const FString& Path) { return ByPath.Contains(Path); });
+		const FString FromDir = FPaths::GetPath(File.Path);
+		for (const FString& Include : Includes)
+		{
+			if (Include.EndsWith(TEXT(".generated.h")))
+			{
+				continue;
+			}
+
+			const FString Resolved = Resolver.Resolve(Include, FromDir);
+			const int32* Target = Resolved.IsEmpty() ? nullptr : ByPath.Find(Resolved);
+			if (Target && *Target != Index)
+			{
+				File.Includes.AddUnique(*Target);
+			}
+		}
+
+		if (File.bSource)
+		{
+			File.bImplementsModule = Text.Contains(TEXT("IMPLEMENT_MODULE")) || Text.Contains(TEXT("IMPLEMENT_GAME_MODULE"))
+				|| Text.Contains(TEXT("IMPLEMENT_PRIMARY_GAME_MODULE"));
+		}
+		else
+		{
+			FindReflectedTypes(Text, File.ReflectedTypes);
+		}
+	});
+
+	int32 Edges = 0;
+	for (const FSplitFile& File : Files)
+	{
+		Edges += File.Includes.Num();
+	}
+	return Edges;
+}
+
+// 同名 .h / .cpp / .inl 归为一个单元，一起移动
+static int32 BuildUnits(TArray<FSplitFile>& Files)
+{
+	TMap<FString, int32> UnitByKey;
+	for (FSplitFile& File : Files)
+	{
+		const FString Key = FPaths::GetBaseFilename(File.IncludeKey, false);
+		if (const int32* Existing = UnitByKey.Find(Key))
+		{
+			File.Unit = *Existing;
+		}
+		else
+		{
+			File.Unit = UnitByKey.Num();
+			UnitByKey.Add(Key, File.Unit);
+		}
+	}
+	return UnitByKey.Num();
+}
+
+static TSet<int32> GetIncludeClosure(const TArray<FSplitFile>& Files, const TArray<int32>& Roots)
+{
+	TSet<int32> Closure;
+	TArray<int32> Stack = Roots;
+	while (Stack.Num() > 0)
+	{
+		const int32 Current = Stack.Pop(EAllowShrinking::No);
+
+		bool bAlreadyInSet = false;
+		Closure.Add(Current, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Stack.Append(Files[Current].Includes);
+		}
+	}
+	return Closure;
+}
+
+// 加权标签传播；Fixed 中的单元不参与也不传播
+static TArray<int32> PropagateLabels(const TArray<TMap<int32, int32>>& UnitEdges, const TArray<bool>& Fixed)
+{
+	TArray<int32> Label;
+	Label.SetNum(UnitEdges.Num());
+	for (int32 Unit = 0; Unit < Label.Num(); ++Unit)
+	{
+		Label[Unit] = Unit;
+	}
+
+	for (int32 Pass = 0; Pass < GMaxPropagationPasses; ++Pass)
+	{
+		bool bChanged = false;
+
+		for (int32 Unit = 0; Unit < Label.Num(); ++Unit)
+		{
+			if (Fixed[Unit])
+			{
+				continue;
+			}
+
+			TMap<int32, int32> Scores;
+			for (const TPair<int32, int32>& Edge : UnitEdges[Unit])
+			{
+				if (!Fixed[Edge.Key])
+				{
+					Scores.FindOrAdd(Label[Edge.Key]) += Edge.Value;
+				}
+			}
+
+			// 平分时保留当前标签，其次取较小的标签，保证结果稳定
+			const int32 Current = Label[Unit];
+			int32 Best = Current;
+			int32 BestScore = Scores.FindRef(Current);
+			for (const TPair<int32, int32>& Score : Scores)
+			{
+				if (Score.Value > BestScore || (Score.Value == BestScore && Best != Current && Score.Key < Best))
+				{
+					Best = Score.Key;
+					BestScore = Score.Value;
+				}
+			}
+
+			if (Best != Label[Unit])
+			{
+				Label[Unit] = Best;
+				bChanged = true;
+			}
+		}
+
+		if (!bChanged)
+		{
+			break;
+		}
+	}
+
+	return Label;
+}
+
+class FClusterSet
+{
+public:
+	FClusterSet(const TArray<FSplitFile>& InFiles, int32 NumUnits)
+		: Files(InFiles)
+	{
+		UnitFiles.SetNum(NumUnits);
+		for (int32 Index = 0; Index < Files.Num(); ++Index)
+		{
+			UnitFiles[Files[Index].Unit].Add(Index);
+		}
+		ClusterOfUnit.Init(INDEX_NONE, NumUnits);
+	}
+
+	int32 Add(const TArray<int32>& Units, bool bCore)
+	{
+		const int32 Cluster = Clusters.AddDefaulted();
+		Clusters[Cluster].bCore = bCore;
+		for (int32 Unit : Units)
+		{
+			AddUnit(Cluster, Unit);
+		}
+		return Cluster;
+	}
+
+	void AddUnit(int32 Cluster, int32 Unit)
+	{
+		ClusterOfUnit[Unit] = Cluster;
+		Clusters[Cluster].Units.Add(Unit);
+		Clusters[Cluster].FileCount += UnitFiles[Unit].Num();
+	}
+
+	void Merge(int32 From, int32 To)
+	{
+		for (int32 Unit : Clusters[From].Units)
+		{
+			AddUnit(To, Unit);
+		}
+		Clusters[To].bCore = Clusters[To].bCore && Clusters[From].bCore;
+		Clusters[From] = FWorkCluster();
+	}
+
+	bool IsAlive(int32 Cluster) const { return Clusters[Cluster].Units.Num() > 0; }
+
+	int32 NumAlive() const
+	{
+		int32 Count = 0;
+		for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+		{
+			Count += IsAlive(Cluster) ? 1 : 0;
+		}
+		return Count;
+	}
+
+	int32 ClusterOfFile(int32 File) const { return ClusterOfUnit[Files[File].Unit]; }
+
+	// 与其他簇之间的包含边数（双向）
+	TMap<int32, int32> GetLinks(int32 Cluster) const
+	{
+		TMap<int32, int32> Links;
+		for (int32 Unit : Clusters[Cluster].Units)
+		{
+			for (int32 File : UnitFiles[Unit])
+			{
+				for (int32 Included : Files[File].Includes)
+				{
+					const int32 Other = ClusterOfFile(Included);
+					if (Other != Cluster && Other != INDEX_NONE)
+					{
+						Links.FindOrAdd(Other)++;
+					}
+				}
+			}
+		}
+		for (int32 File = 0; File < Files.Num(); ++File)
+		{
+			const int32 Other = ClusterOfFile(File);
+			if (Other == Cluster || Other == INDEX_NONE)
+			{
+				continue;
+			}
+			for (int32 Included : Files[File].Includes)
+			{
+				if (ClusterOfFile(Included) == Cluster)
+				{
+					Links.FindOrAdd(Other)++;
+				}
+			}
+		}
+		return Links;
+	}
+
+	// 联系最紧的非公共簇；没有联系时取 Fallback（INDEX_NONE 表示最大的簇）
+	int32 FindMergeTarget(int32 Cluster, int32 Fallback) const
+	{
+		int32 Best = INDEX_NONE;
+		int32 BestWeight = 0;
+		for (const TPair<int32, int32>& Link : GetLinks(Cluster))
+		{
+			if (!Clusters[Link.Key].bCore && (Link.Value > BestWeight || (Link.Value == BestWeight && Link.Key < Best)))
+			{
+				Best = Link.Key;
+				BestWeight = Link.Value;
+			}
+		}
+		if (Best != INDEX_NONE)
+		{
+			return Best;
+		}
+
+		if (Fallback != INDEX_NONE && Fallback != Cluster && IsAlive(Fallback) && !Clusters[Fallback].bCore)
+		{
+			return Fallback;
+		}
+
+		for (int32 Other = 0; Other < Clusters.Num(); ++Other)
+		{
+			if (Other != Cluster && IsAlive(Other) && !Clusters[Other].bCore
+				&& (Best == INDEX_NONE || Clusters[Other].FileCount > Clusters[Best].FileCount))
+			{
+				Best = Other;
+			}
+		}
+		return Best;
+	}
+
+	// 最小的非公共簇；只剩一个非公共簇时返回 INDEX_NONE
+	int32 FindSmallest() const
+	{
+		int32 Smallest = INDEX_NONE;
+		int32 Candidates = 0;
+		for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+		{
+			if (!IsAlive(Cluster) || Clusters[Cluster].bCore)
+			{
+				continue;
+			}
+			++Candidates;
+			if (Smallest == INDEX_NONE || Clusters[Cluster].FileCount < Clusters[Smallest].FileCount)
+			{
+				Smallest = Cluster;
+			}
+		}
+		return Candidates > 1 ? Smallest : INDEX_NONE;
+	}
+
+	// 簇之间的包含成环时合并，保证新模块依赖无环
+	void MergeCycles()
+	{
+		TArray<TSet<int32>> Edges;
+		Edges.SetNum(Clusters.Num());
+		for (int32 File = 0; File < Files.Num(); ++File)
+		{
+			const int32 From = ClusterOfFile(File);
+			for (int32 Included : Files[File].Includes)
+			{
+				const int32 To = ClusterOfFile(Included);
+				if (From != INDEX_NONE && To != INDEX_NONE && From != To)
+				{
+					Edges[From].Add(To);
+				}
+			}
+		}
+
+		// Tarjan 强连通分量
+		TArray<int32> IndexOf;
+		TArray<int32> LowLink;
+		TArray<bool> OnStack;
+		IndexOf.Init(INDEX_NONE, Clusters.Num());
+		LowLink.Init(0, Clusters.Num());
+		OnStack.Init(false, Clusters.Num());
+
+		TArray<int32> Stack;
+		TArray<TArray<int32>> Components;
+		int32 NextIndex = 0;
+
+		TFunction<void(int32)> StrongConnect = [&](int32 V)
+		{
+			IndexOf[V] = LowLink[V] = NextIndex++;
+			Stack.Push(V);
+			OnStack[V] = true;
+
+			for (int32 W : Edges[V])
+			{
+				if (IndexOf[W] == INDEX_NONE)
+				{
+					StrongConnect(W);
+					LowLink[V] = FMath::Min(LowLink[V], LowLink[W]);
+				}
+				else if (OnStack[W])
+				{
+					LowLink[V] = FMath::Min(LowLink[V], IndexOf[W]);
+				}
+			}
+
+			if (LowLink[V] == IndexOf[V])
+			{
+				TArray<int32> Component;
+				int32 W = INDEX_NONE;
+				do
+				{
+					W = Stack.Pop();
+					OnStack[W] = false;
+					Component.Add(W);
+				}
+				while (W != V);
+
+				if (Component.Num() > 1)
+				{
+					Components.Add(MoveTemp(Component));
+				}
+			}
+		};
+
+		for (int32 V = 0; V < Clusters.Num(); ++V)
+		{
+			if (IsAlive(V) && IndexOf[V] == INDEX_NONE)
+			{
+				StrongConnect(V);
+			}
+		}
+
+		for (const TArray<int32>& Component : Components)
+		{
+			int32 Largest = Component[0];
+			for (int32 Cluster : Component)
+			{
+				Largest = Clusters[Cluster].FileCount > Clusters[Largest].FileCount ? Cluster : Largest;
+			}
+			for (int32 Cluster : Component)
+			{
+				if (Cluster != Largest)
+				{
+					Merge(Cluster, Largest);
+				}
+			}
+		}
+	}
+
+	TArray<FWorkCluster> Clusters;
+	TArray<int32> ClusterOfUnit;
+	TArray<TArray<int32>> UnitFiles;
+
+private:
+	const TArray<FSplitFile>& Files;
+};
+
+static FString SanitizeToken(const FString& In)
+{
+	FString Out;
+	for (TCHAR C : In)
+	{
+		if (FChar::IsAlnum(C))
+		{
+			Out.AppendChar(Out.IsEmpty() ? FChar::ToUpper(C) : C);
+		}
+	}
+	return Out;
+}
+
+// 多数文件所在的子目录名；没有时取被包含最多的文件名
+static FString ChooseClusterToken(const TArray<FSplitFile>& Files, const TArray<int32>& ClusterFiles, const TArray<int32>& InDegree)
+{
+	TMap<FString, int32> Dirs;
+	for (int32 File : ClusterFiles)
+	{
+		int32 Slash = INDEX_NONE;
+		if (Files[File].IncludeKey.FindChar(TEXT('/'), Slash))
+		{
+			Dirs.FindOrAdd(Files[File].IncludeKey.Left(Slash))++;
+		}
+	}
+
+	FString BestDir;
+	int32 BestCount = 0;
+	for (const TPair<FString, int32>& Dir : Dirs)
+	{
+		if (Dir.Value > BestCount)
+		{
+			BestDir = Dir.Key;
+			BestCount = Dir.Value;
+		}
+	}
+	if (BestCount * 2 >= ClusterFiles.Num() && !SanitizeToken(BestDir).IsEmpty())
+	{
+		return SanitizeToken(BestDir);
+	}
+
+	int32 Hub = ClusterFiles[0];
+	for (int32 File : ClusterFiles)
+	{
+		Hub = InDegree[File] > InDegree[Hub] ? File : Hub;
+	}
+	return SanitizeToken(FPaths::GetBaseFilename(Files[Hub].IncludeKey));
+}
+
+struct FUnityModel
+{
+	TArray<int32> Sources;
+	FUnityBuildSettings Settings;
+
+	// 显式 PCH 的传递包含：其中任一文件变化整个模块重编
+	TSet<int32> PCHClosure;
+};
+
+static FRebuildEstimate EstimateRebuild(const TArray<FSplitFile>& Files, const TArray<TArray<int32>>& IncludedBy, const TArray<FUnityModel>& Modules)
+{
+	// 与 UBT 相同：按路径排序后按字节数切块，文件数不到阈值时不合并
+	TArray<int32> BlobOf;
+	TArray<int32> BlobSize;
+	TArray<TArray<int32>> ModuleBlobs;
+	BlobOf.Init(INDEX_NONE, Files.Num());
+	ModuleBlobs.SetNum(Modules.Num());
+
+	for (int32 Module = 0; Module < Modules.Num(); ++Module)
+	{
+		const FUnityBuildSettings& Settings = Modules[Module].Settings;
+		const int32 MinFiles = Settings.MinSourceFilesForUnityBuildOverride.Get(0) > 0 ? Settings.MinSourceFilesForUnityBuildOverride.GetValue() : GDefaultMinUnityFiles;
+		const int64 Budget = Settings.NumIncludedBytesPerUnityCPPOverride.Get(0) > 0 ? Settings.NumIncludedBytesPerUnityCPPOverride.GetValue() : GDefaultUnityBytes;
+		const bool bUnity = Settings.bUseUnity.Get(true) && Modules[Module].Sources.Num() >= MinFiles;
+
+		TArray<int32> Sources = Modules[Module].Sources;
+		Sources.Sort();
+
+		int32 Current = INDEX_NONE;
+		int64 CurrentBytes = 0;
+		for (int32 Source : Sources)
+		{
+			if (!bUnity || Current == INDEX_NONE || CurrentBytes + Files[Source].Bytes > Budget)
+			{
+				Current = BlobSize.Add(0);
+				ModuleBlobs[Module].Add(Current);
+				CurrentBytes = 0;
+			}
+			BlobOf[Source] = Current;
+			++BlobSize[Current];
+			CurrentBytes += Files[Source].Bytes;
+		}
+	}
+
+	FRebuildEstimate Estimate;
+
+	TArray<int32> HeaderCosts;
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		if (Files[File].bSource)
+		{
+			continue;
+		}
+
+		TSet<int32> Blobs;
+		for (int32 Source : IncludedBy[File])
+		{
+			Blobs.Add(BlobOf[Source]);
+		}
+		for (int32 Module = 0; Module < Modules.Num(); ++Module)
+		{
+			if (Modules[Module].PCHClosure.Contains(File))
+			{
+				Blobs.Append(ModuleBlobs[Module]);
+			}
+		}
+
+		int32 Cost = 0;
+		for (int32 Blob : Blobs)
+		{
+			Cost += BlobSize[Blob];
+		}
+		HeaderCosts.Add(Cost);
+	}
+
+	if (HeaderCosts.Num() > 0)
+	{
+		HeaderCosts.Sort();
+		int64 Total = 0;
+		for (int32 Cost : HeaderCosts)
+		{
+			Total += Cost;
+		}
+		Estimate.MeanHeaderEdit = double(Total) / HeaderCosts.Num();
+		Estimate.P90HeaderEdit = HeaderCosts[FMath::Max(0, FMath::CeilToInt(HeaderCosts.Num() * 0.9f) - 1)];
+		Estimate.MaxHeaderEdit = HeaderCosts.Last();
+	}
+
+	int32 Sources = 0;
+	int64 Companions = 0;
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		if (Files[File].bSource && BlobOf[File] != INDEX_NONE)
+		{
+			++Sources;
+			Companions += BlobSize[BlobOf[File]] - 1;
+		}
+	}
+	Estimate.MeanSourceEdit = Sources > 0 ? double(Companions) / Sources : 0.0;
+
+	return Estimate;
+}
+
+static FNewModuleParams MakeSplitModuleParams(const FModuleSplitPlan& Plan, const FModuleSplitCluster& Cluster)
+{
+	FNewModuleParams Params;
+	Params.ModuleName = Cluster.ModuleName;
+	Params.ModuleType = Plan.ModuleType;
+	Params.LoadingPhase = Plan.LoadingPhase;
+
+	const bool bUsesUObject = Cluster.ReflectedTypes.Num() > 0
+		|| Plan.PublicDependencies.Contains(TEXT("CoreUObject")) || Plan.PrivateDependencies.Contains(TEXT("CoreUObject"));
+	Params.Archetype = bUsesUObject ? EModuleArchetype::Standard : EModuleArchetype::CoreOnly;
+
+	// 沿用原模块的全部依赖，多余的 Public 依赖可再用依赖降级收紧
+	Params.ExtraPublicDependencies = Plan.PublicDependencies;
+	Params.ExtraPublicDependencies.Append(Cluster.PublicDependencies);
+	Params.ExtraPrivateDependencies = Plan.PrivateDependencies;
+	Params.ExtraPrivateDependencies.Append(Cluster.PrivateDependencies);
+
+	if (Plan.DescriptorPath.EndsWith(TEXT(".uplugin")))
+	{
+		Params.TargetType = EModuleTargetType::ProjectPlugin;
+		Params.TargetPluginName = FPaths::GetBaseFilename(Plan.DescriptorPath);
+	}
+	return Params;
+}
+
+static bool AddPendingDependencies(const FString& BuildCsPath, const TArray<FString>& Public, const TArray<FString>& Private,
+	TArray<FPendingTextEdit>& Edits, TArray<FString>& OutErrors)
+{
+	FPendingTextEdit* Edit = FindOrLoadPendingEdit(Edits, BuildCsPath, false, OutErrors);
+	if (!Edit)
+	{
+		return false;
+	}
+
+	FString Error;
+	FString Text;
+	if (!AddDependenciesToBuildCs(Edit->NewText, Public, true, Text, Error)
+		|| !AddDependenciesToBuildCs(Text, Private, false, Edit->NewText, Error))
+	{
+		OutErrors.Add(BuildCsPath + TEXT("：") + Error);
+		return false;
+	}
+	return true;
+}
+
+} // namespace ModuleSplitterPrivate
+
+bool PlanModuleSplit(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, const FString& ModuleName,
+	const FModuleSplitOptions& Options, FModuleSplitPlan& OutPlan, FString& OutError)
+{
+	using namespace ModuleSplitterPrivate;
+
+	OutPlan = FModuleSplitPlan();
+
+	const int32 NodeIndex = Graph.FindNode(ModuleName);
+	if (NodeIndex == INDEX_NONE)
+	{
+		OutError = TEXT("没有找到模块：") + ModuleName;
+		return false;
+	}
+
+	const FModuleNode& Node = Graph.GetNodes()[NodeIndex];
+	OutPlan.ModuleName = Node.Name;
+	OutPlan.ModuleDir = Node.ModuleDir;
+	OutPlan.BuildCsPath = Node.BuildCsPath;
+	OutPlan.PublicDependencies = Node.PublicDependencies;
+	OutPlan.PrivateDependencies = Node.PrivateDependencies;
+
+	if (!FindModuleContainer(Node.ModuleDir, OutPlan.ContainerRoot, OutPlan.DescriptorPath))
+	{
+		OutError = TEXT("找不到模块所属的 .uproject / .uplugin：") + Node.ModuleDir;
+		return false;
+	}
+	ReadDescriptorModuleEntry(OutPlan.DescriptorPath, Node.Name, OutPlan.ModuleType, OutPlan.LoadingPhase);
+
+	FString BuildCsText;
+	FFileHelper::LoadFileToString(BuildCsText, *Node.BuildCsPath);
+	FUnityBuildSettings UnitySettings;
+	bool bHasExplicitPCH = false;
+	ReadUnitySettings(BuildCsText, UnitySettings, bHasExplicitPCH);
+	const FString PCHPath = bHasExplicitPCH ? FindPCHPath(BuildCsText, Node.ModuleDir) : FString();
+
+	// 1）模块内包含图
+	TArray<FSplitFile> Files;
+	CollectFiles(Node.ModuleDir, Files);
+	if (Files.Num() < GMinSplitFiles)
+	{
+		OutError = FString::Printf(TEXT("%s 只有 %d 个源文件，不需要拆分"), *Node.Name, Files.Num());
+		return false;
+	}
+
+	OutPlan.TotalFiles = Files.Num();
+	OutPlan.IncludeEdges = ResolveIncludes(Node.ModuleDir, Files);
+	const int32 NumUnits = BuildUnits(Files);
+
+	TArray<int32> InDegree;
+	InDegree.Init(0, Files.Num());
+	for (const FSplitFile& File : Files)
+	{
+		for (int32 Included : File.Includes)
+		{
+			++InDegree[Included];
+		}
+	}
+
+	TArray<TMap<int32, int32>> UnitEdges;
+	UnitEdges.SetNum(NumUnits);
+	for (const FSplitFile& File : Files)
+	{
+		for (int32 Included : File.Includes)
+		{
+			const int32 Other = Files[Included].Unit;
+			if (Other != File.Unit)
+			{
+				UnitEdges[File.Unit].FindOrAdd(Other)++;
+				UnitEdges[Other].FindOrAdd(File.Unit)++;
+			}
+		}
+	}
+
+	// 2）公共头：被大多数文件直接包含的头文件及其传递包含
+	const int32 HubThreshold = FMath::Max(2, FMath::CeilToInt(Files.Num() * Options.HubShare));
+	TArray<int32> HubFiles;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (!Files[Index].bSource && InDegree[Index] >= HubThreshold)
+		{
+			HubFiles.Add(Index);
+			OutPlan.HubHeaders.Add(Files[Index].Relative);
+		}
+	}
+
+	TArray<bool> Fixed;
+	Fixed.Init(false, NumUnits);
+	TArray<int32> CoreUnits;
+	for (int32 File : GetIncludeClosure(Files, HubFiles))
+	{
+		if (!Fixed[Files[File].Unit])
+		{
+			Fixed[Files[File].Unit] = true;
+			CoreUnits.Add(Files[File].Unit);
+		}
+	}
+
+	if (CoreUnits.Num() >= NumUnits)
+	{
+		OutError = TEXT("公共头的传递包含覆盖了整个模块，无法拆分；可调高公共头比例再试");
+		return false;
+	}
+
+	// PCH 头文件不参与聚类，始终留在原模块
+	int32 PCHUnit = INDEX_NONE;
+	int32 PCHFile = INDEX_NONE;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (!PCHPath.IsEmpty() && Files[Index].Path == PCHPath)
+		{
+			PCHFile = Index;
+			PCHUnit = Files[Index].Unit;
+		}
+	}
+	const bool bPCHInCore = PCHUnit != INDEX_NONE && Fixed[PCHUnit];
+	if (PCHUnit != INDEX_NONE)
+	{
+		Fixed[PCHUnit] = true;
+	}
+
+	// 3）标签传播聚类
+	const TArray<int32> Labels = PropagateLabels(UnitEdges, Fixed);
+
+	FClusterSet Set(Files, NumUnits);
+	if (CoreUnits.Num() > 0)
+	{
+		Set.Add(CoreUnits, true);
+	}
+
+	TMap<int32, TArray<int32>> UnitsByLabel;
+	for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+	{
+		if (!Fixed[Unit])
+		{
+			UnitsByLabel.FindOrAdd(Labels[Unit]).Add(Unit);
+		}
+	}
+	for (const TPair<int32, TArray<int32>>& Pair : UnitsByLabel)
+	{
+		Set.Add(Pair.Value, false);
+	}
+
+	int32 ImplementationUnit = INDEX_NONE;
+	for (const FSplitFile& File : Files)
+	{
+		if (File.bImplementsModule && ImplementationUnit == INDEX_NONE)
+		{
+			ImplementationUnit = File.Unit;
+		}
+	}
+	auto KeptCluster = [&Set, ImplementationUnit]()
+	{
+		return ImplementationUnit != INDEX_NONE ? Set.ClusterOfUnit[ImplementationUnit] : INDEX_NONE;
+	};
+
+	// 4）过小的簇并入联系最紧的簇，再压到 MaxClusters 个以内
+	const int32 MinFiles = Options.MinClusterFiles > 0
+		? Options.MinClusterFiles
+		: FMath::Max(4, Files.Num() / (FMath::Max(1, Options.MaxClusters) * 3));
+
+	while (true)
+	{
+		const int32 Smallest = Set.FindSmallest();
+		const bool bTooMany = Set.NumAlive() > FMath::Max(2, Options.MaxClusters);
+		if (Smallest == INDEX_NONE || (!bTooMany && Set.Clusters[Smallest].FileCount >= MinFiles))
+		{
+			break;
+		}
+
+		const int32 Target = Set.FindMergeTarget(Smallest, KeptCluster());
+		if (Target == INDEX_NONE)
+		{
+			break;
+		}
+		Set.Merge(Smallest, Target);
+	}
+
+	Set.MergeCycles();
+
+	if (Set.NumAlive() < 2)
+	{
+		OutError = TEXT("包含关系过于紧密，所有文件都落在同一个簇里，拆分没有收益");
+		return false;
+	}
+
+	// 5）保留原名的簇：模块实现文件所在簇，没有时取最大的
+	int32 Kept = KeptCluster();
+	if (Kept == INDEX_NONE)
+	{
+		for (int32 Cluster = 0; Cluster < Set.Clusters.Num(); ++Cluster)
+		{
+			if (Set.IsAlive(Cluster) && (Kept == INDEX_NONE || Set.Clusters[Cluster].FileCount > Set.Clusters[Kept].FileCount))
+			{
+				Kept = Cluster;
+			}
+		}
+	}
+	if (PCHUnit != INDEX_NONE && !bPCHInCore)
+	{
+		Set.AddUnit(Kept, PCHUnit);
+	}
+	else if (PCHUnit != INDEX_NONE && Set.ClusterOfUnit[PCHUnit] != Kept)
+	{
+		// PCH 在公共头的闭包里：从公共簇移出，留在原模块
+		FWorkCluster& Owner = Set.Clusters[Set.ClusterOfUnit[PCHUnit]];
+		Owner.Units.Remove(PCHUnit);
+		Owner.FileCount -= Set.UnitFiles[PCHUnit].Num();
+		Set.AddUnit(Kept, PCHUnit);
+	}
+	if (PCHUnit != INDEX_NONE)
+	{
+		// 固定 PCH 会带来新的包含边，可能重新成环；再合并一次，原模块随 PCH 所在的簇
+		Set.MergeCycles();
+		Kept = Set.ClusterOfUnit[PCHUnit];
+		if (Set.NumAlive() < 2)
+		{
+			OutError = TEXT("固定 PCH 后包含关系成环，所有文件都并回了同一个簇，拆分没有收益");
+			return false;
+		}
+	}
+
+	// 6）命名并输出：原模块在前，其余按文件数
+	TArray<int32> Order;
+	for (int32 Cluster = 0; Cluster < Set.Clusters.Num(); ++Cluster)
+	{
+		if (Set.IsAlive(Cluster))
+		{
+			Order.Add(Cluster);
+		}
+	}
+	Order.Sort([&Set, Kept](int32 A, int32 B)
+	{
+		if ((A == Kept) != (B == Kept))
+		{
+			return A == Kept;
+		}
+		return Set.Clusters[A].FileCount > Set.Clusters[B].FileCount;
+	});
+
+	TArray<int32> PlanIndexOfCluster;
+	PlanIndexOfCluster.Init(INDEX_NONE, Set.Clusters.Num());
+	TSet<FString> UsedNames = { Node.Name };
+
+	for (int32 Cluster : Order)
+	{
+		TArray<int32> ClusterFiles;
+		for (int32 Unit : Set.Clusters[Cluster].Units)
+		{
+			ClusterFiles.Append(Set.UnitFiles[Unit]);
+		}
+		ClusterFiles.Sort();
+
+		PlanIndexOfCluster[Cluster] = OutPlan.Clusters.Num();
+		FModuleSplitCluster& Out = OutPlan.Clusters.AddDefaulted_GetRef();
+		Out.bKeepsOriginal = Cluster == Kept;
+
+		if (Out.bKeepsOriginal)
+		{
+			Out.ModuleName = Node.Name;
+		}
+		else
+		{
+			FString Token = Set.Clusters[Cluster].bCore ? FString(TEXT("Core")) : ChooseClusterToken(Files, ClusterFiles, InDegree);
+			if (Token.IsEmpty() || !FChar::IsAlpha(Token[0]))
+			{
+				Token = TEXT("Part") + Token;
+			}
+
+			FString Candidate = Node.Name + Token;
+			for (int32 Suffix = 2; UsedNames.Contains(Candidate) || Graph.FindNode(Candidate) != INDEX_NONE || !External.FindModuleDir(Candidate).IsEmpty(); ++Suffix)
+			{
+				Candidate = Node.Name + Token + FString::FromInt(Suffix);
+			}
+			UsedNames.Add(Candidate);
+			Out.ModuleName = Candidate;
+		}
+
+		for (int32 File : ClusterFiles)
+		{
+			Out.Files.Add(Files[File].Path);
+			Out.SourceFiles += Files[File].bSource ? 1 : 0;
+			if (!Out.bKeepsOriginal)
+			{
+				for (const TPair<FString, FString>& Type : Files[File].ReflectedTypes)
+				{
+					Out.ReflectedTypes.AddUnique(Type);
+				}
+			}
+		}
+	}
+
+	// 7）新模块之间的依赖：公开头文件包含到的为 Public
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		FModuleSplitCluster& From = OutPlan.Clusters[PlanIndexOfCluster[Set.ClusterOfFile(File)]];
+		for (int32 Included : Files[File].Includes)
+		{
+			const FModuleSplitCluster& To = OutPlan.Clusters[PlanIndexOfCluster[Set.ClusterOfFile(Included)]];
+			if (&From == &To)
+			{
+				continue;
+			}
+
+			(Files[File].bPublic ? From.PublicDependencies : From.PrivateDependencies).AddUnique(To.ModuleName);
+
+			if (!Files[Included].bPublic)
+			{
+				OutPlan.Warnings.Add(FString::Printf(TEXT("%s 包含了 %s 的非公开头文件 %s"),
+					*Files[File].Relative, *To.ModuleName, *Files[Included].Relative));
+			}
+		}
+	}
+	for (FModuleSplitCluster& Cluster : OutPlan.Clusters)
+	{
+		Cluster.PrivateDependencies.RemoveAll([&Cluster](const FString& Name) { return Cluster.PublicDependencies.Contains(Name); });
+	}
+
+	// 8）下游模块：直接包含了被移出头文件的补上依赖
+	TMap<FString, FString> MovedHeaderOwner;
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		const FModuleSplitCluster& Cluster = OutPlan.Clusters[PlanIndexOfCluster[Set.ClusterOfFile(File)]];
+		if (!Cluster.bKeepsOriginal && Files[File].bPublic && !Files[File].bSource)
+		{
+			MovedHeaderOwner.Add(Files[File].IncludeKey, Cluster.ModuleName);
+		}
+	}
+
+	const TArray<int32>& Dependents = Graph.GetDependents(NodeIndex);
+	TArray<FSplitDependentFix> Fixes;
+	Fixes.SetNum(Dependents.Num());
+
+	ParallelFor(Dependents.Num(), [&Graph, &Dependents, &MovedHeaderOwner, &Fixes, &Node](int32 Index)
+	{
+		const FModuleNode& Dependent = Graph.GetNodes()[Dependents[Index]];
+		FSplitDependentFix& Fix = Fixes[Index];
+		Fix.ModuleName = Dependent.Name;
+		Fix.BuildCsPath = Dependent.BuildCsPath;
+		Fix.bPublic = Dependent.PublicDependencies.Contains(Node.Name);
+
+		TArray<FString> Paths;
+		IFileManager::Get().FindFilesRecursive(Paths, *Dependent.ModuleDir, TEXT("*.*"), true, false);
+
+		TArray<FString> Includes;
+		for (const FString& Path : Paths)
+		{
+			const FString Extension = FPaths::GetExtension(Path);
+			if (Extension != TEXT("h") && Extension != TEXT("hpp") && Extension != TEXT("inl") && Extension != TEXT("cpp"))
+			{
+				continue;
+			}
+
+			FString Text;
+			if (!FFileHelper::LoadFileToString(Text, *Path))
+			{
+				continue;
+			}
+
+			Includes.Reset();
+			FModuleDependencyGraph::ParseIncludes(Text, Includes);
+			for (const FString& Include : Includes)
+			{
+				if (const FString* Owner = MovedHeaderOwner.Find(Include))
+				{
+					Fix.Dependencies.AddUnique(*Owner);
+				}
+			}
+		}
+		Fix.Dependencies.Sort();
+	});
+
+	for (FSplitDependentFix& Fix : Fixes)
+	{
+		if (Fix.Dependencies.Num() > 0)
+		{
+			OutPlan.DependentFixes.Add(MoveTemp(Fix));
+		}
+	}
+
+	// 9）重编估算：包含关系不变，变化的是 unity 分块与 PCH 的范围
+	TArray<TArray<int32>> IncludedBy;
+	IncludedBy.SetNum(Files.Num());
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		if (!Files[File].bSource)
+		{
+			continue;
+		}
+		for (int32 Reached : GetIncludeClosure(Files, Files[File].Includes))
+		{
+			IncludedBy[Reached].Add(File);
+		}
+	}
+
+	const TSet<int32> PCHClosure = PCHFile != INDEX_NONE ? GetIncludeClosure(Files, { PCHFile }) : TSet<int32>();
+
+	TArray<FUnityModel> Before;
+	FUnityModel& Whole = Before.AddDefaulted_GetRef();
+	Whole.Settings = UnitySettings;
+	Whole.PCHClosure = PCHClosure;
+
+	TArray<FUnityModel> After;
+	After.SetNum(OutPlan.Clusters.Num());
+	for (int32 Cluster = 0; Cluster < OutPlan.Clusters.Num(); ++Cluster)
+	{
+		const bool bKept = OutPlan.Clusters[Cluster].bKeepsOriginal;
+		After[Cluster].Settings = bKept ? UnitySettings : GetGeneratedModuleUnitySettings(false);
+		if (bKept)
+		{
+			After[Cluster].PCHClosure = PCHClosure;
+		}
+	}
+
+	for (int32 File = 0; File < Files.Num(); ++File)
+	{
+		if (Files[File].bSource)
+		{
+			Whole.Sources.Add(File);
+			After[PlanIndexOfCluster[Set.ClusterOfFile(File)]].Sources.Add(File);
+		}
+	}
+
+	OutPlan.Before = EstimateRebuild(Files, IncludedBy, Before);
+	OutPlan.After = EstimateRebuild(Files, IncludedBy, After);
+
+	return true;
+}
+
+FString FormatSplitPlan(const FModuleSplitPlan& Plan)
+{
+	FString Report = FString::Printf(TEXT("== 拆分 %s（%d 个文件，模块内 %d 条包含关系）==\n"), *Plan.ModuleName, Plan.TotalFiles, Plan.IncludeEdges);
+	Report += FString::Printf(TEXT("  描述文件：%s（%s / %s）\n"), *Plan.DescriptorPath, *Plan.ModuleType, *Plan.LoadingPhase);
+
+	if (Plan.HubHeaders.Num() > 0)
+	{
+		Report += TEXT("  公共头：") + FString::Join(Plan.HubHeaders, TEXT(", ")) + TEXT("\n");
+	}
+
+	Report += TEXT("\n== 模块 ==\n");
+	for (const FModuleSplitCluster& Cluster : Plan.Clusters)
+	{
+		Report += FString::Printf(TEXT("  %-40s 文件 %4d（.cpp %d）%s\n"),
+			*Cluster.ModuleName, Cluster.Files.Num(), Cluster.SourceFiles, Cluster.bKeepsOriginal ? TEXT("  [保留原模块]") : TEXT(""));
+		if (Cluster.PublicDependencies.Num() > 0)
+		{
+			Report += TEXT("      Public 依赖：") + FString::Join(Cluster.PublicDependencies, TEXT(", ")) + TEXT("\n");
+		}
+		if (Cluster.PrivateDependencies.Num() > 0)
+		{
+			Report += TEXT("      Private 依赖：") + FString::Join(Cluster.PrivateDependencies, TEXT(", ")) + TEXT("\n");
+		}
+		if (Cluster.ReflectedTypes.Num() > 0)
+		{
+			Report += FString::Printf(TEXT("      反射类型 %d 个，将写入 CoreRedirects\n"), Cluster.ReflectedTypes.Num());
+		}
+	}
+
+	if (Plan.DependentFixes.Num() > 0)
+	{
+		Report += TEXT("\n== 下游模块需补的依赖 ==\n");
+		for (const FSplitDependentFix& Fix : Plan.DependentFixes)
+		{
+			Report += FString::Printf(TEXT("  %s（%s）：%s\n"), *Fix.ModuleName, Fix.bPublic ? TEXT("Public") : TEXT("Private"),
+				*FString::Join(Fix.Dependencies, TEXT(", ")));
+		}
+	}
+
+	if (Plan.Warnings.Num() > 0)
+	{
+		Report += FString::Printf(TEXT("\n== 需手工处理：%d 处跨模块包含非公开头文件（移到 Public/ 后才能编译）==\n"), Plan.Warnings.Num());
+		for (const FString& Warning : Plan.Warnings)
+		{
+			Report += TEXT("  ") + Warning + TEXT("\n");
+		}
+	}
+
+	Report += TEXT("\n== 重编估算（只计本模块的 .cpp，unity 按 Build.cs 设置分块）==\n");
+	Report += FString::Printf(TEXT("  改一个头文件：平均 %.1f → %.1f 个 .cpp，P90 %d → %d，最多 %d → %d\n"),
+		Plan.Before.MeanHeaderEdit, Plan.After.MeanHeaderEdit,
+		Plan.Before.P90HeaderEdit, Plan.After.P90HeaderEdit,
+		Plan.Before.MaxHeaderEdit, Plan.After.MaxHeaderEdit);
+	Report += FString::Printf(TEXT("  改一个 .cpp：同一 unity 文件里连带重编平均 %.1f → %.1f 个\n"),
+		Plan.Before.MeanSourceEdit, Plan.After.MeanSourceEdit);
+
+	if (Plan.Before.MeanHeaderEdit > 0.0)
+	{
+		Report += FString::Printf(TEXT("  头文件改动的平均重编量减少 %.0f%%\n"),
+			100.0 * (1.0 - Plan.After.MeanHeaderEdit / Plan.Before.MeanHeaderEdit));
+	}
+
+	return Report;
+}
+
+FString FormatSplitCandidates(const FModuleDependencyGraph& Graph, int32 MaxModules)
+{
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Order.Sort([&Nodes](int32 A, int32 B) { return Nodes[A].SourceFiles > Nodes[B].SourceFiles; });
+
+	FString Report = TEXT("输入要拆分的模块名后回车，查看拆分方案与重编估算。\n\n== 源文件最多的模块 ==\n");
+	for (int32 Rank = 0; Rank < FMath::Min(MaxModules, Order.Num()); ++Rank)
+	{
+		const FModuleNode& Node = Nodes[Order[Rank]];
+		Report += FString::Printf(TEXT("  %-40s .cpp %4d  被 %d 个模块依赖  [%s]\n"),
+			*Node.Name, Node.SourceFiles, Graph.GetDependents(Order[Rank]).Num(), *Node.Owner);
+	}
+	return Report;
+}
+
+bool ApplyModuleSplit(const FModuleSplitPlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors)
+{
+	using namespace ModuleSplitterPrivate;
+
+	const FString OldApi = Plan.ModuleName.ToUpper() + TEXT("_API");
+
+	// 新模块、文件移动与所有文本改动都先进暂存区，最后一次写盘；任一步失败时磁盘保持原样
+	FModuleStagingArea Staging;
+	TArray<FNewModuleParams> NewModules;
+	TArray<const FModuleSplitCluster*> NewClusters;
+	TSet<FString> SourceDirs;
+
+	// 1）生成新模块，移动文件并改 API 宏
+	for (const FModuleSplitCluster& Cluster : Plan.Clusters)
+	{
+		if (Cluster.bKeepsOriginal)
+		{
+			continue;
+		}
+
+		FNewModuleParams Params = MakeSplitModuleParams(Plan, Cluster);
+		const FString NewModuleDir = GetModuleDir(Plan.ContainerRoot, Params.ModuleName);
+
+		if (IFileManager::Get().DirectoryExists(*NewModuleDir))
+		{
+			OutErrors.Add(TEXT("目标目录已存在：") + NewModuleDir);
+			return false;
+		}
+
+		TArray<FGeneratedModuleFile> Generated;
+		RenderModuleFiles(Plan.ContainerRoot, Params, Generated);
+
+		FString Error;
+		if (!StageModuleFiles(Staging, Generated, Error))
+		{
+			OutErrors.Add(Params.ModuleName + TEXT("：") + Error);
+			return false;
+		}
+
+		// 与生成的模块文件重名时 MoveFile 失败
+		const FString NewApi = Params.ModuleName.ToUpper() + TEXT("_API");
+		for (const FString& File : Cluster.Files)
+		{
+			const FString Destination = NewModuleDir / File.RightChop(Plan.ModuleDir.Len() + 1);
+			FString* Text = Staging.MoveFile(File, Destination, Error);
+			if (!Text)
+			{
+				OutErrors.Add(Error);
+				return false;
+			}
+			ReplaceIdentifier(*Text, OldApi, NewApi);
+			SourceDirs.Add(FPaths::GetPath(File));
+		}
+
+		OutLog += FString::Printf(TEXT("== 新模块 %s：生成模块文件，移动 %d 个文件到 %s ==\n"), *Params.ModuleName, Cluster.Files.Num(), *NewModuleDir);
+
+		NewModules.Add(MoveTemp(Params));
+		NewClusters.Add(&Cluster);
+	}
+
+	// 2）原模块与下游模块的 Build.cs、描述文件、CoreRedirects
+	TArray<FPendingTextEdit> Edits;
+
+	for (const FModuleSplitCluster& Cluster : Plan.Clusters)
+	{
+		if (Cluster.bKeepsOriginal)
+		{
+			AddPendingDependencies(Plan.BuildCsPath, Cluster.PublicDependencies, Cluster.PrivateDependencies, Edits, OutErrors);
+		}
+	}
+	for (const FSplitDependentFix& Fix : Plan.DependentFixes)
+	{
+		AddPendingDependencies(Fix.BuildCsPath, Fix.bPublic ? Fix.Dependencies : TArray<FString>(), Fix.bPublic ? TArray<FString>() : Fix.Dependencies, Edits, OutErrors);
+	}
+
+	TArray<FString> Redirects;
+	for (const FModuleSplitCluster* Cluster : NewClusters)
+	{
+		for (const TPair<FString, FString>& Type : Cluster->ReflectedTypes)
+		{
+			Redirects.Add(FString::Printf(TEXT("+%s=(OldName=\"/Script/%s.%s\",NewName=\"/Script/%s.%s\")"),
+				*Type.Key, *Plan.ModuleName, *Type.Value, *Cluster->ModuleName, *Type.Value));
+		}
+	}
+	if (Redirects.Num() > 0)
+	{
+		const FString IniPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir() / TEXT("DefaultEngine.ini"));
+		if (FPendingTextEdit* Ini = FindOrLoadPendingEdit(Edits, IniPath, true, OutErrors))
+		{
+			Ini->NewText = AddCoreRedirects(Ini->NewText, Redirects);
+		}
+	}
+
+	if (OutErrors.Num() > 0)
+	{
+		return false;
+	}
+
+	// 新模块只有在文件写入的同一次写盘中才加入描述文件
+	FString Error;
+	if (!StagePendingEdits(Staging, Edits, Error) || !StageModulesInDescriptor(Staging, Plan.DescriptorPath, NewModules, Error))
+	{
+		OutErrors.Add(Error);
+		return false;
+	}
+
+	if (bDryRun)
+	{
+		OutLog += Staging.MakeDiff();
+		return true;
+	}
+
+	// 3）一次写盘
+	FStagingFlushResult Flush;
+	if (!Staging.Flush(Flush, Error))
+	{
+		OutErrors.Add(TEXT("拆分未写盘，磁盘保持原样：") + Error);
+		return false;
+	}
+	OutLog += FString::Printf(TEXT("已写入 %d 个文件，移走 %d 个文件\n"), Flush.WrittenFiles.Num(), Flush.DeletedFiles.Num());
+
+	// 移空的目录一并删除（非空目录删除会失败，直接忽略）
+	TArray<FString> Dirs = SourceDirs.Array();
+	Dirs.Sort([](const FString& A, const FString& B) { return A.Len() > B.Len(); });
+	for (const FString& Dir : Dirs)
+	{
+		IFileManager::Get().DeleteDirectory(*Dir, false, false);
+	}
+
+	// 名称索引只在游戏线程访问
+	const bool bIsProject = Plan.DescriptorPath.EndsWith(TEXT(".uproject"));
+	const FString OwnerName = FPaths::GetBaseFilename(Plan.DescriptorPath);
+	TArray<FString> ModuleNames;
+	for (const FNewModuleParams& Params : NewModules)
+	{
+		ModuleNames.Add(Params.ModuleName);
+	}
+	AsyncTask(ENamedThreads::GameThread, [ModuleNames = MoveTemp(ModuleNames), bIsProject, OwnerName]()
+	{
+		for (const FString& Name : ModuleNames)
+		{
+			FModuleNameIndex::Get().AddModule(Name, bIsProject ? EModuleNameOwner::Project : EModuleNameOwner::ProjectPlugin, OwnerName);
+		}
+	});
+
+	return true;
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,388 @@
+#include "ModuleStaging.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleGenerator.h"
+#include "TextDiff.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <atomic>
+
+namespace ModuleStagingPrivate
+{
+
+// 临时文件与备份文件与目标同目录，改名不跨卷
+static const TCHAR* const GTempSuffix = TEXT(".mbstage");
+static const TCHAR* const GBackupSuffix = TEXT(".mbbackup");
+
+static bool MoveStagedFile(const FString& Dest, const FString& Source)
+{
+	return IFileManager::Get().Move(*Dest, *Source, false, false, false, true);
+}
+
+static void DeleteStagedFile(const FString& Path)
+{
+	IFileManager::Get().Delete(*Path, false, true, true);
+}
+
+} // namespace ModuleStagingPrivate
+
+bool FModuleStagingArea::AddNewFile(const FString& Path, const FString& Text, FString& OutError)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+	if (FileByPath.Contains(FullPath) || FPaths::FileExists(FullPath))
+	{
+		OutError = TEXT("目标文件已存在，未进行覆盖：") + FullPath;
+		return false;
+	}
+
+	FStagedFile& File = Files.AddDefaulted_GetRef();
+	File.Path = FullPath;
+	File.Text = Text;
+	FileByPath.Add(FullPath, Files.Num() - 1);
+	return true;
+}
+
+FString* FModuleStagingArea::EditFile(const FString& Path, FString& OutError)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+	if (const int32* Existing = FileByPath.Find(FullPath))
+	{
+		if (Files[*Existing].bDelete)
+		{
+			OutError = TEXT("文件已被移走或删除：") + FullPath;
+			return nullptr;
+		}
+		return &Files[*Existing].Text;
+	}
+
+	FStagedFile File;
+	File.Path = FullPath;
+	File.bExisting = true;
+	File.Timestamp = IFileManager::Get().GetTimeStamp(*FullPath);
+	if (!ModuleBuilder::LoadTextPreservingEncoding(FullPath, File.OriginalText, File.bHasBom))
+	{
+		OutError = TEXT("读取文件失败：") + FullPath;
+		return nullptr;
+	}
+	File.Text = File.OriginalText;
+
+	FileByPath.Add(FullPath, Files.Num());
+	return &Files.Add_GetRef(MoveTemp(File)).Text;
+}
+
+FString* FModuleStagingArea::MoveFile(const FString& From, const FString& To, FString& OutError)
+{
+	const FString FullFrom = FPaths::ConvertRelativePathToFull(From);
+	const FString FullTo = FPaths::ConvertRelativePathToFull(To);
+	if (FileByPath.Contains(FullFrom))
+	{
+		OutError = TEXT("文件已在暂存区中，不能移动：") + FullFrom;
+		return nullptr;
+	}
+	if (FileByPath.Contains(FullTo) || FPaths::FileExists(FullTo))
+	{
+		OutError = TEXT("移动的目标文件已存在：") + FullTo;
+		return nullptr;
+	}
+
+	FStagedFile Source;
+	Source.Path = FullFrom;
+	Source.bExisting = true;
+	Source.bDelete = true;
+	Source.Timestamp = IFileManager::Get().GetTimeStamp(*FullFrom);
+	if (!ModuleBuilder::LoadTextPreservingEncoding(FullFrom, Source.OriginalText, Source.bHasBom))
+	{
+		OutError = TEXT("读取文件失败：") + FullFrom;
+		return nullptr;
+	}
+	Source.Text = Source.OriginalText;
+
+	FStagedFile Moved;
+	Moved.Path = FullTo;
+	Moved.Text = Source.OriginalText;
+	Moved.OriginalText = Source.OriginalText;
+	Moved.bHasBom = Source.bHasBom;
+	Moved.MovedFrom = FullFrom;
+
+	FileByPath.Add(FullFrom, Files.Num());
+	Files.Add(MoveTemp(Source));
+	FileByPath.Add(FullTo, Files.Num());
+	return &Files.Add_GetRef(MoveTemp(Moved)).Text;
+}
+
+bool FModuleStagingArea::DeleteFile(const FString& Path, FString& OutError)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+	if (FileByPath.Contains(FullPath))
+	{
+		OutError = TEXT("文件已在暂存区中，不能删除：") + FullPath;
+		return false;
+	}
+	if (!FPaths::FileExists(FullPath))
+	{
+		OutError = TEXT("要删除的文件不存在：") + FullPath;
+		return false;
+	}
+
+	FStagedFile& File = Files.AddDefaulted_GetRef();
+	File.Path = FullPath;
+	File.bExisting = true;
+	File.bDelete = true;
+	File.Timestamp = IFileManager::Get().GetTimeStamp(*FullPath);
+	FileByPath.Add(FullPath, Files.Num() - 1);
+	return true;
+}
+
+bool FModuleStagingArea::Contains(const FString& Path) const
+{
+	return FileByPath.Contains(FPaths::ConvertRelativePathToFull(Path));
+}
+
+int32 FModuleStagingArea::NumChanged() const
+{
+	int32 Changed = 0;
+	for (const FStagedFile& File : Files)
+	{
+		Changed += File.IsChanged() ? 1 : 0;
+	}
+	return Changed;
+}
+
+FString FModuleStagingArea::MakeDiff(int32 MaxFiles) const
+{
+	FString Diff;
+	int32 Listed = 0;
+	for (const FStagedFile& File : Files)
+	{
+		if (!File.IsChanged())
+		{
+			continue;
+		}
+		if (Listed++ == MaxFiles)
+		{
+			Diff += FString::Printf(TEXT("……另有 %d 个文件的 diff 省略\n"), NumChanged() - MaxFiles);
+			break;
+		}
+		if (File.bDelete)
+		{
+			Diff += FString::Printf(TEXT("删除 %s\n"), *File.Path);
+			continue;
+		}
+		if (!File.MovedFrom.IsEmpty())
+		{
+			Diff += FString::Printf(TEXT("移动 %s → %s\n"), *File.MovedFrom, *File.Path);
+		}
+		Diff += ModuleBuilder::MakeUnifiedDiff(File.Path, File.OriginalText, File.Text);
+	}
+	return Diff;
+}
+
+bool FModuleStagingArea::Flush(FStagingFlushResult& OutResult, FString& OutError)
+{
+	using namespace ModuleStagingPrivate;
+
+	MODULEBUILDER_SCOPE("Flush");
+
+	const double StartTime = FPlatformTime::Seconds();
+	OutResult = FStagingFlushResult();
+
+	TArray<int32> Changed;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (Files[Index].IsChanged())
+		{
+			Changed.Add(Index);
+		}
+		else
+		{
+			++OutResult.UnchangedFiles;
+		}
+	}
+
+	// 1）暂存之后磁盘不能被改动：新文件仍不存在，已有文件时间戳不变
+	{
+		MODULEBUILDER_SCOPE("Flush.CheckConflicts");
+		for (int32 Index : Changed)
+		{
+			const FStagedFile& File = Files[Index];
+			if (!File.bExisting && FPaths::FileExists(File.Path))
+			{
+				OutError = TEXT("目标文件已存在，未进行覆盖：") + File.Path;
+				return false;
+			}
+			if (File.bExisting && IFileManager::Get().GetTimeStamp(*File.Path) != File.Timestamp)
+			{
+				OutError = TEXT("文件在预览后被修改过，请重新生成：") + File.Path;
+				return false;
+			}
+		}
+	}
+
+	// 2）创建目录，记下本次新建的目录用于回滚
+	TArray<FString> CreatedDirs;
+	{
+		MODULEBUILDER_SCOPE("Flush.CreateDirs");
+		for (int32 Index : Changed)
+		{
+			if (Files[Index].bDelete)
+			{
+				continue;
+			}
+
+			TArray<FString> Missing;
+			for (FString Dir = FPaths::GetPath(Files[Index].Path); !Dir.IsEmpty() && !IFileManager::Get().DirectoryExists(*Dir); Dir = FPaths::GetPath(Dir))
+			{
+				Missing.Add(Dir);
+			}
+			CreatedDirs.Append(Missing);
+
+			if (Missing.Num() > 0 && !IFileManager::Get().MakeDirectory(*Missing[0], true))
+			{
+				OutError = TEXT("创建目录失败：") + Missing[0];
+				break;
+			}
+		}
+	}
+
+	auto DeleteCreatedDirs = [&CreatedDirs]()
+	{
+		CreatedDirs.Sort([](const FString& A, const FString& B) { return A.Len() > B.Len(); });
+		for (const FString& Dir : CreatedDirs)
+		{
+			IFileManager::Get().DeleteDirectory(*Dir, false, false);
+		}
+	};
+
+	if (!OutError.IsEmpty())
+	{
+		DeleteCreatedDirs();
+		return false;
+	}
+
+	// 3）并行写临时文件；新文件与原生成器一致按内容自动选编码，已有文件保留 BOM 有无
+	TArray<bool> Written;
+	Written.Init(false, Changed.Num());
+	std::atomic<int64> Bytes { 0 };
+
+	{
+		MODULEBUILDER_SCOPE("Flush.WriteTemp");
+		ParallelFor(Changed.Num(), [this, &Changed, &Written, &Bytes](int32 Index)
+		{
+			const FStagedFile& File = Files[Changed[Index]];
+			if (File.bDelete)
+			{
+				Written[Index] = true;
+				return;
+			}
+
+			const FString TempPath = File.Path + GTempSuffix;
+			const FFileHelper::EEncodingOptions Encoding = !File.bExisting && File.MovedFrom.IsEmpty()
+				? FFileHelper::EEncodingOptions::AutoDetect
+				: File.bHasBom ? FFileHelper::EEncodingOptions::ForceUTF8 : FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM;
+
+			Written[Index] = FFileHelper::SaveStringToFile(File.Text, *TempPath, Encoding);
+			if (Written[Index])
+			{
+				Bytes += FMath::Max<int64>(0, IFileManager::Get().FileSize(*TempPath));
+			}
+		});
+	}
+
+	auto DeleteTempFiles = [this, &Changed]()
+	{
+		for (int32 Index : Changed)
+		{
+			DeleteStagedFile(Files[Index].Path + GTempSuffix);
+		}
+	};
+
+	const int32 Failed = Written.Find(false);
+	if (Failed != INDEX_NONE)
+	{
+		OutError = TEXT("写入文件失败：") + Files[Changed[Failed]].Path;
+		DeleteTempFiles();
+		DeleteCreatedDirs();
+		return false;
+	}
+
+	// 4）改名到位：已有文件先改名为备份，要删除的文件只改名为备份；失败时按相反顺序恢复
+	TArray<int32> Committed;
+	{
+		MODULEBUILDER_SCOPE("Flush.Rename");
+		for (int32 Index : Changed)
+		{
+			const FStagedFile& File = Files[Index];
+			const FString BackupPath = File.Path + GBackupSuffix;
+
+			if (File.bExisting && !MoveStagedFile(BackupPath, File.Path))
+			{
+				OutError = TEXT("替换文件失败（可能被占用）：") + File.Path;
+				break;
+			}
+			if (File.bDelete)
+			{
+				Committed.Add(Index);
+				continue;
+			}
+			if (!MoveStagedFile(File.Path, File.Path + GTempSuffix))
+			{
+				if (File.bExisting)
+				{
+					MoveStagedFile(File.Path, BackupPath);
+				}
+				OutError = TEXT("替换文件失败（可能被占用）：") + File.Path;
+				break;
+			}
+			Committed.Add(Index);
+		}
+	}
+
+	if (!OutError.IsEmpty())
+	{
+		for (int32 Position = Committed.Num() - 1; Position >= 0; --Position)
+		{
+			const FStagedFile& File = Files[Committed[Position]];
+			DeleteStagedFile(File.Path);
+			if (File.bExisting)
+			{
+				MoveStagedFile(File.Path, File.Path + GBackupSuffix);
+			}
+		}
+		DeleteTempFiles();
+		DeleteCreatedDirs();
+		return false;
+	}
+
+	// 5）全部到位后才删除备份
+	{
+		MODULEBUILDER_SCOPE("Flush.DeleteBackups");
+		for (int32 Index : Changed)
+		{
+			const FStagedFile& File = Files[Index];
+			if (File.bExisting)
+			{
+				DeleteStagedFile(File.Path + GBackupSuffix);
+			}
+			(File.bDelete ? OutResult.DeletedFiles : OutResult.WrittenFiles).Add(File.Path);
+		}
+	}
+
+	OutResult.CreatedDirs = CreatedDirs.Num();
+	OutResult.BytesWritten = Bytes.load();
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	MODULEBUILDER_COUNT(FilesWritten, OutResult.WrittenFiles.Num());
+	MODULEBUILDER_COUNT(BytesWritten, OutResult.BytesWritten);
+	MODULEBUILDER_COUNT(DirsCreated, OutResult.CreatedDirs);
+	return true;
+}
+
+void FModuleStagingArea::Reset()
+{
+	Files.Reset();
+	FileByPath.Reset();
+}
@@ -0,0 +1,620 @@
+#include "ModuleTemplate.h"
+#include "ModuleBuilderEditor.h"
+#include "ModuleBuilderTrace.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace ModuleTemplatePrivate
+{
+
+static const TCHAR* GBuildCsTemplate = TEXT(
+R"(using UnrealBuildTool;
+
+public class {{ModuleName}} : ModuleRules
+{
+	public {{ModuleName}}(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		{{#if PrivatePCHHeaderFile}}
+		PrivatePCHHeaderFile = "{{PrivatePCHHeaderFile}}";
+		{{/if}}
+		{{#if SharedPCHHeaderFile}}
+		SharedPCHHeaderFile = "{{SharedPCHHeaderFile}}";
+		{{/if}}
+		IWYUSupport = IWYUSupport.Full;
+		{{UnitySettings}}
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			{{PublicDependencies}}
+		});
+		{{#if PrivateDependencies}}
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			{{PrivateDependencies}}
+		});
+		{{/if}}
+	}
+}
+)");
+
+static const TCHAR* GModuleHeaderTemplate = TEXT(
+R"(#pragma once
+
+#include "CoreTypes.h"
+
+/**
+ * {{ModuleName}} 模块公共头文件
+ * 模块类定义在 Private/{{ModuleName}}.cpp，这里只放对外 API，依赖方不会间接包含 ModuleManager.h
+{{#if CoreOnly}}
+ * 本模块只依赖 Core，不要声明 UCLASS / USTRUCT / UENUM（否则需要 CoreUObject 与 UHT）
+{{/if}}
+{{#if Instrumented}}
+ * 性能统计（stat 分组、LLM 标签、CSV 分类、Trace 通道）声明在 {{ModuleName}}Stats.h
+{{/if}}
+ */
+)");
+
+static const TCHAR* GModuleCppTemplate = TEXT(
+R"(#include "{{ModuleName}}.h"
+{{#if Instrumented}}
+#include "{{ModuleName}}Stats.h"
+{{/if}}
+
+#include "Modules/ModuleInterface.h"
+#include "Modules/ModuleManager.h"
+{{#if Instrumented}}
+
+LLM_DEFINE_TAG({{ModuleName}});
+CSV_DEFINE_CATEGORY_MODULE({{ModuleApi}}, {{ModuleName}}, true);
+UE_TRACE_CHANNEL_DEFINE({{ModuleName}}Channel)
+{{/if}}
+
+class F{{ModuleName}}Module : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override
+    {
+        {{#if Instrumented}}
+        {{ModuleNameUpper}}_SCOPE(StartupModule);
+
+        {{/if}}
+        // 模块启动时调用
+    }
+
+    virtual void ShutdownModule() override
+    {
+        {{#if Instrumented}}
+        {{ModuleNameUpper}}_SCOPE(ShutdownModule);
+
+        {{/if}}
+        // 模块关闭时调用
+    }
+};
+
+IMPLEMENT_MODULE(F{{ModuleName}}Module, {{ModuleName}})
+)");
+
+// 单独成文件，不用埋点的依赖方不必包含 Stats.h 等头文件
+static const TCHAR* GModuleStatsHeaderTemplate = TEXT(
+R"(#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * {{ModuleName}} 模块的性能统计，定义在 Private/{{ModuleName}}.cpp
+ *
+ *   stat {{ModuleName}}               CPU 耗时（STATGROUP_{{ModuleName}}）
+ *   -llm，stat llmfull / memreport    内存（LLM 标签 {{ModuleName}}）
+ *   csvprofile start                  CSV 分类 {{ModuleName}}
+ *   -trace=cpu,memory,{{ModuleName}}  Insights 中的 {{ModuleName}}Channel 通道
+ */
+DECLARE_STATS_GROUP(TEXT("{{ModuleName}}"), STATGROUP_{{ModuleName}}, STATCAT_Advanced);
+
+LLM_DECLARE_TAG_API({{ModuleName}}, {{ModuleApi}});
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN({{ModuleApi}}, {{ModuleName}});
+
+UE_TRACE_CHANNEL_EXTERN({{ModuleName}}Channel, {{ModuleApi}})
+
+// 同时计入上面四项，每个作用域用一次：{{ModuleNameUpper}}_SCOPE(Tick);
+#define {{ModuleNameUpper}}_SCOPE(Name) \
+	LLM_SCOPE_BYTAG({{ModuleName}}); \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_{{ModuleName}}_##Name, STATGROUP_{{ModuleName}}); \
+	CSV_SCOPED_TIMING_STAT({{ModuleName}}, Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Name, {{ModuleName}}Channel)
+)");
+
+static const TCHAR* GPCHHeaderTemplate = TEXT(
+R"(#pragma once
+
+// {{ModuleName}} 的预编译头：只放稳定、被大多数 .cpp 使用的头文件
+// 这里任何一个头文件变化都会让整个模块重新编译
+{{#if SharedPCH}}
+// 共享 PCH：依赖本模块的模块也会复用，头文件所属模块须是本模块的 Public 依赖
+{{/if}}
+
+{{PCHIncludes}}
+)");
+
+struct FBuiltInTemplate
+{
+	const TCHAR* Name;
+	const TCHAR* Text;
+};
+
+static const FBuiltInTemplate GBuiltInTemplates[] =
+{
+	{ TEXT("Build.cs"),      GBuildCsTemplate },
+	{ TEXT("Module.h"),      GModuleHeaderTemplate },
+	{ TEXT("Module.cpp"),    GModuleCppTemplate },
+	{ TEXT("ModuleStats.h"), GModuleStatsHeaderTemplate },
+	{ TEXT("PCH.h"),         GPCHHeaderTemplate },
+};
+
+static const TCHAR* FindBuiltInTemplate(const FString& Name)
+{
+	for (const FBuiltInTemplate& BuiltIn : GBuiltInTemplates)
+	{
+		if (Name.Equals(BuiltIn.Name, ESearchCase::IgnoreCase))
+		{
+			return BuiltIn.Text;
+		}
+	}
+	return nullptr;
+}
+
+static bool IsIdentifier(const FString& Text)
+{
+	if (Text.IsEmpty() || !(FChar::IsAlpha(Text[0]) || Text[0] == TEXT('_')))
+	{
+		return false;
+	}
+	for (const TCHAR Char : Text)
+	{
+		if (!FChar::IsAlnum(Char) && Char != TEXT('_'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool IsBlank(TCHAR Char)
+{
+	return Char == TEXT(' ') || Char == TEXT('\t');
+}
+
+static int32 GetLineNumber(const FString& Source, int32 Position)
+{
+	int32 Line = 1;
+	for (int32 Index = 0; Index < Position && Index < Source.Len(); ++Index)
+	{
+		Line += Source[Index] == TEXT('\n') ? 1 : 0;
+	}
+	return Line;
+}
+
+} // namespace ModuleTemplatePrivate
+
+TSharedPtr<const FModuleTemplate, ESPMode::ThreadSafe> FModuleTemplate::Compile(const FString& InSource, FString& OutError)
+{
+	using namespace ModuleTemplatePrivate;
+
+	TSharedRef<FModuleTemplate, ESPMode::ThreadSafe> Template = MakeShared<FModuleTemplate, ESPMode::ThreadSafe>();
+	Template->Source = InSource;
+
+	const FString& Source = Template->Source;
+	const TCHAR* Chars = *Source;
+	const int32 Len = Source.Len();
+
+	TMap<FName, int32> NameIndices;
+	auto FindOrAddName = [&Template, &NameIndices](const FString& Name)
+	{
+		const FName Key(*Name);
+		if (const int32* Existing = NameIndices.Find(Key))
+		{
+			return *Existing;
+		}
+		const int32 Index = Template->Names.Add(Key);
+		Template->NameUses.Add(0);
+		NameIndices.Add(Key, Index);
+		return Index;
+	};
+
+	auto AddText = [&Template](int32 Begin, int32 End)
+	{
+		if (End > Begin)
+		{
+			FToken& Token = Template->Tokens.AddDefaulted_GetRef();
+			Token.Op = EOp::Text;
+			Token.Start = Begin;
+			Token.Len = End - Begin;
+			Template->LiteralLen += Token.Len;
+		}
+	};
+
+	// 未闭合的 {{#if}}：If 与 Else 的指令下标
+	struct FOpenBlock
+	{
+		int32 If = INDEX_NONE;
+		int32 Else = INDEX_NONE;
+		int32 Position = 0;
+	};
+	TArray<FOpenBlock> OpenBlocks;
+
+	int32 TextStart = 0;
+	int32 Position = 0;
+
+	while (Position < Len)
+	{
+		const int32 Open = Source.Find(TEXT("{{"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Position);
+		if (Open == INDEX_NONE)
+		{
+			break;
+		}
+		const int32 Close = Source.Find(TEXT("}}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open + 2);
+		if (Close == INDEX_NONE)
+		{
+			break;
+		}
+
+		const FString Tag = Source.Mid(Open + 2, Close - Open - 2).TrimStartAndEnd();
+		const int32 TagEnd = Close + 2;
+
+		EOp Op = EOp::Variable;
+		FString Name = Tag;
+		bool bNegate = false;
+
+		if (Tag.StartsWith(TEXT("#if")) && Tag.Len() > 3 && IsBlank(Tag[3]))
+		{
+			Op = EOp::If;
+			Name = Tag.RightChop(3).TrimStart();
+			bNegate = Name.RemoveFromStart(TEXT("!"));
+			Name.TrimStartInline();
+		}
+		else if (Tag == TEXT("else"))
+		{
+			Op = EOp::Else;
+		}
+		else if (Tag == TEXT("/if"))
+		{
+			Op = EOp::EndIf;
+		}
+
+		// 不是标签的 {{ }} 原样保留
+		if ((Op == EOp::Variable || Op == EOp::If) && !IsIdentifier(Name))
+		{
+			if (Op == EOp::If)
+			{
+				OutError = FString::Printf(TEXT("第 %d 行：{{#if}} 后不是变量名：%s"), GetLineNumber(Source, Open), *Tag);
+				return nullptr;
+			}
+			Position = Open + 2;
+			continue;
+		}
+
+		// 标签前到行首只有空白，且不属于前一个标签所在的行
+		int32 LineStart = Open;
+		while (LineStart > 0 && IsBlank(Chars[LineStart - 1]))
+		{
+			--LineStart;
+		}
+		const bool bStartsLine = (LineStart == 0 || Chars[LineStart - 1] == TEXT('\n')) && LineStart >= TextStart;
+
+		const int32 TokenIndex = Template->Tokens.Num();
+
+		if (Op == EOp::Variable)
+		{
+			AddText(TextStart, Open);
+
+			FToken& Token = Template->Tokens.AddDefaulted_GetRef();
+			Token.Op = EOp::Variable;
+			Token.Name = FindOrAddName(Name);
+			Token.Start = LineStart;
+			Token.Len = bStartsLine ? Open - LineStart : 0;
+			++Template->NameUses[Token.Name];
+
+			TextStart = TagEnd;
+			Position = TagEnd;
+			continue;
+		}
+
+		// 独占一行的条件标签连同整行去掉
+		int32 LineEnd = TagEnd;
+		while (LineEnd < Len && (IsBlank(Chars[LineEnd]) || Chars[LineEnd] == TEXT('\r')))
+		{
+			++LineEnd;
+		}
+		const bool bEndsLine = LineEnd == Len || Chars[LineEnd] == TEXT('\n');
+
+		if (bStartsLine && bEndsLine)
+		{
+			AddText(TextStart, LineStart);
+			TextStart = FMath::Min(LineEnd + 1, Len);
+		}
+		else
+		{
+			AddText(TextStart, Open);
+			TextStart = TagEnd;
+		}
+		Position = FMath::Max(TagEnd, TextStart);
+
+		FToken& Token = Template->Tokens.AddDefaulted_GetRef();
+		Token.Op = Op;
+
+		if (Op == EOp::If)
+		{
+			Token.Name = FindOrAddName(Name);
+			Token.bNegate = bNegate;
+			OpenBlocks.Add({ TokenIndex, INDEX_NONE, Open });
+		}
+		else if (Op == EOp::Else)
+		{
+			if (OpenBlocks.Num() == 0 || OpenBlocks.Last().Else != INDEX_NONE)
+			{
+				OutError = FString::Printf(TEXT("第 %d 行：多余的 {{else}}"), GetLineNumber(Source, Open));
+				return nullptr;
+			}
+			OpenBlocks.Last().Else = TokenIndex;
+			Template->Tokens[OpenBlocks.Last().If].Jump = TokenIndex + 1;
+		}
+		else
+		{
+			if (OpenBlocks.Num() == 0)
+			{
+				OutError = FString::Printf(TEXT("第 %d 行：多余的 {{/if}}"), GetLineNumber(Source, Open));
+				return nullptr;
+			}
+			const FOpenBlock Block = OpenBlocks.Pop(EAllowShrinking::No);
+			Template->Tokens[Block.Else != INDEX_NONE ? Block.Else : Block.If].Jump = TokenIndex;
+		}
+	}
+
+	if (OpenBlocks.Num() > 0)
+	{
+		OutError = FString::Printf(TEXT("第 %d 行：{{#if}} 没有对应的 {{/if}}"), GetLineNumber(Source, OpenBlocks.Last().Position));
+		return nullptr;
+	}
+
+	AddText(TextStart, Len);
+	Template->Tokens.Shrink();
+	return Template;
+}
+
+void FModuleTemplate::Render(const FModuleTemplateVariables& Variables, FString& OutText) const
+{
+	// 变量只查一次，按输出次数预估总长度
+	TArray<const FString*, TInlineAllocator<32>> Values;
+	Values.SetNumUninitialized(Names.Num());
+
+	int32 Estimate = LiteralLen;
+	for (int32 Index = 0; Index < Names.Num(); ++Index)
+	{
+		Values[Index] = Variables.Find(Names[Index]);
+		Estimate += Values[Index] ? Values[Index]->Len() * NameUses[Index] : 0;
+	}
+
+	OutText.Reset(Estimate + Estimate / 8);
+
+	const TCHAR* Chars = *Source;
+	for (int32 Index = 0; Index < Tokens.Num();)
+	{
+		const FToken& Token = Tokens[Index];
+		switch (Token.Op)
+		{
+		case EOp::Text:
+			OutText.AppendChars(Chars + Token.Start, Token.Len);
+			++Index;
+			break;
+
+		case EOp::Variable:
+			if (const FString* Value = Values[Token.Name])
+			{
+				if (Token.Len == 0)
+				{
+					OutText.Append(*Value);
+				}
+				else
+				{
+					// 多行的值逐行补上变量所在行的缩进
+					const TCHAR* Begin = **Value;
+					const TCHAR* End = Begin + Value->Len();
+					for (const TCHAR* Cursor = Begin; Cursor < End; ++Cursor)
+					{
+						if (*Cursor == TEXT('\n') && Cursor + 1 < End)
+						{
+							OutText.AppendChars(Begin, UE_PTRDIFF_TO_INT32(Cursor + 1 - Begin));
+							OutText.AppendChars(Chars + Token.Start, Token.Len);
+							Begin = Cursor + 1;
+						}
+					}
+					OutText.AppendChars(Begin, UE_PTRDIFF_TO_INT32(End - Begin));
+				}
+			}
+			++Index;
+			break;
+
+		case EOp::If:
+		{
+			const FString* Value = Values[Token.Name];
+			const bool bTrue = Value && !Value->IsEmpty();
+			Index = bTrue != Token.bNegate ? Index + 1 : Token.Jump;
+			break;
+		}
+
+		case EOp::Else:
+			Index = Token.Jump;
+			break;
+
+		default:
+			++Index;
+			break;
+		}
+	}
+}
+
+FString FModuleTemplate::Render(const FModuleTemplateVariables& Variables) const
+{
+	FString Text;
+	Render(Variables, Text);
+	return Text;
+}
+
+const TCHAR* FModuleTemplateLibrary::BuildCs = TEXT("Build.cs");
+const TCHAR* FModuleTemplateLibrary::ModuleHeader = TEXT("Module.h");
+const TCHAR* FModuleTemplateLibrary::ModuleCpp = TEXT("Module.cpp");
+const TCHAR* FModuleTemplateLibrary::ModuleStatsHeader = TEXT("ModuleStats.h");
+const TCHAR* FModuleTemplateLibrary::PCHHeader = TEXT("PCH.h");
+
+FModuleTemplateLibrary& FModuleTemplateLibrary::Get()
+{
+	static FModuleTemplateLibrary Instance;
+	return Instance;
+}
+
+FString FModuleTemplateLibrary::GetTemplateDir()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir() / TEXT("ModuleBuilder") / TEXT("Templates"));
+}
+
+FString FModuleTemplateLibrary::GetTemplatePath(const FString& Name)
+{
+	return GetTemplateDir() / (Name + TEXT(".template"));
+}
+
+TArray<FString> FModuleTemplateLibrary::GetBuiltInNames()
+{
+	TArray<FString> Names;
+	for (const ModuleTemplatePrivate::FBuiltInTemplate& BuiltIn : ModuleTemplatePrivate::GBuiltInTemplates)
+	{
+		Names.Add(BuiltIn.Name);
+	}
+	return Names;
+}
+
+FModuleTemplateLibrary::FEntry FModuleTemplateLibrary::Load(const FString& Name) const
+{
+	MODULEBUILDER_SCOPE("Template.Load");
+
+	FEntry Entry;
+	Entry.Timestamp = FDateTime::MinValue();
+
+	const FString Path = GetTemplatePath(Name);
+	const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*Path);
+	if (Timestamp != FDateTime::MinValue())
+	{
+		Entry.Timestamp = Timestamp;
+
+		FString Text;
+		FString Error;
+		if (!FFileHelper::LoadFileToString(Text, *Path))
+		{
+			UE_LOG(LogModuleBuilder, Warning, TEXT("读取模板失败，改用内置模板：%s"), *Path);
+		}
+		else if (TSharedPtr<const FModuleTemplate, ESPMode::ThreadSafe> Compiled = FModuleTemplate::Compile(Text, Error))
+		{
+			UE_LOG(LogModuleBuilder, Log, TEXT("使用工程模板：%s"), *Path);
+			Entry.Template = Compiled;
+			return Entry;
+		}
+		else
+		{
+			UE_LOG(LogModuleBuilder, Warning, TEXT("模板 %s %s，改用内置模板"), *Path, *Error);
+		}
+	}
+
+	const TCHAR* BuiltIn = ModuleTemplatePrivate::FindBuiltInTemplate(Name);
+	if (!BuiltIn)
+	{
+		UE_LOG(LogModuleBuilder, Error, TEXT("没有名为 %s 的模板"), *Name);
+		BuiltIn = TEXT("");
+	}
+
+	FString Error;
+	Entry.Template = FModuleTemplate::Compile(BuiltIn, Error);
+	checkf(Entry.Template.IsValid(), TEXT("内置模板 %s 编译失败：%s"), *Name, *Error);
+	return Entry;
+}
+
+void FModuleTemplateLibrary::Refresh()
+{
+	TArray<FString> Names;
+	{
+		FScopeLock ScopeLock(&Lock);
+		Entries.GetKeys(Names);
+	}
+
+	for (const FString& Name : Names)
+	{
+		const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*GetTemplatePath(Name));
+		{
+			FScopeLock ScopeLock(&Lock);
+			const FEntry* Entry = Entries.Find(Name);
+			if (Entry && Entry->Timestamp == Timestamp)
+			{
+				continue;
+			}
+		}
+
+		FEntry Loaded = Load(Name);
+
+		FScopeLock ScopeLock(&Lock);
+		Entries.Add(Name, MoveTemp(Loaded));
+	}
+}
+
+TSharedRef<const FModuleTemplate, ESPMode::ThreadSafe> FModuleTemplateLibrary::Find(const FString& Name)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FEntry* Entry = Entries.Find(Name))
+		{
+			return Entry->Template.ToSharedRef();
+		}
+	}
+
+	// 在锁外编译；并行渲染时可能有多个线程同时加载同一个模板，先加入的生效
+	FEntry Loaded = Load(Name);
+
+	FScopeLock ScopeLock(&Lock);
+	if (const FEntry* Entry = Entries.Find(Name))
+	{
+		return Entry->Template.ToSharedRef();
+	}
+	return Entries.Add(Name, MoveTemp(Loaded)).Template.ToSharedRef();
+}
+
+FString FModuleTemplateLibrary::Render(const FString& Name, const FModuleTemplateVariables& Variables)
+{
+	return Find(Name)->Render(Variables);
+}
+
+bool FModuleTemplateLibrary::ExportBuiltInTemplates(TArray<FString>& OutWritten, FString& OutError)
+{
+	for (const ModuleTemplatePrivate::FBuiltInTemplate& BuiltIn : ModuleTemplatePrivate::GBuiltInTemplates)
+	{
+		const FString Path = GetTemplatePath(BuiltIn.Name);
+		if (IFileManager::Get().FileExists(*Path))
+		{
+			continue;
+		}
+
+		if (!FFileHelper::SaveStringToFile(FString(BuiltIn.Text), *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			OutError = TEXT("写入模板失败：") + Path;
+			return false;
+		}
+		OutWritten.Add(Path);
+	}
+	return true;
+}
@@ -0,0 +1,235 @@
+#include "PCHAdvisor.h"
+#include "IncludeResolver.h"
+#include "ModuleBuilderCache.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModuleBuilder
+{
+namespace PCHAdvisorPrivate
+{
+
+static FString FindExistingPCH(const FString& BuildCsPath)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *BuildCsPath))
+	{
+		return FString();
+	}
+
+	for (const TCHAR* Key : { TEXT("PrivatePCHHeaderFile"), TEXT("SharedPCHHeaderFile") })
+	{
+		const int32 Found = Text.Find(Key, ESearchCase::CaseSensitive);
+		if (Found == INDEX_NONE)
+		{
+			continue;
+		}
+		const int32 QuoteBegin = Text.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Found);
+		const int32 QuoteEnd = QuoteBegin != INDEX_NONE ? Text.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, QuoteBegin + 1) : INDEX_NONE;
+		if (QuoteEnd != INDEX_NONE)
+		{
+			return FString(Key) + TEXT(" = ") + Text.Mid(QuoteBegin, QuoteEnd - QuoteBegin + 1);
+		}
+	}
+	return FString();
+}
+
+} // namespace PCHAdvisorPrivate
+
+void SuggestPCHContents(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, int32 ModuleNode,
+	float MinShare, int32 MaxHeaders, FPCHSuggestion& OutSuggestion)
+{
+	using namespace PCHAdvisorPrivate;
+
+	const FModuleNode& Node = Graph.GetNodes()[ModuleNode];
+
+	OutSuggestion = FPCHSuggestion();
+	OutSuggestion.ModuleName = Node.Name;
+	OutSuggestion.ExistingPCH = FindExistingPCH(Node.BuildCsPath);
+
+	TArray<FString> Sources;
+	FindModuleFiles(Node.ModuleDir, TEXT(".cpp"), Sources);
+	OutSuggestion.SourceFiles = Sources.Num();
+	if (Sources.Num() == 0)
+	{
+		return;
+	}
+
+	FIncludeResolver Resolver(FIncludeResolver::GetSearchDirs(Graph, &External, Node));
+
+	// 每个 .cpp 直接包含的、位于模块外的头文件
+	const FString ModulePrefix = Node.ModuleDir + TEXT("/");
+	TMap<FString, FString> ResolvedByInclude;
+	TMap<FString, int32> IncludeCounts;
+	TArray<TArray<FString>> SourceIncludes;
+	SourceIncludes.SetNum(Sources.Num());
+
+	for (int32 Index = 0; Index < Sources.Num(); ++Index)
+	{
+		const FString FromDir = FPaths::GetPath(Sources[Index]);
+		TSet<FString> Seen;
+		for (const FString& Include : Resolver.GetFileIncludes(Sources[Index]))
+		{
+			if (Include.EndsWith(TEXT(".generated.h")) || Seen.Contains(Include))
+			{
+				continue;
+			}
+			Seen.Add(Include);
+
+			// 模块自己的头文件经常改动，放进 PCH 反而扩大重编范围
+			const FString Resolved = Resolver.Resolve(Include, FromDir);
+			if (Resolved.IsEmpty() || Resolved.StartsWith(ModulePrefix))
+			{
+				continue;
+			}
+
+			ResolvedByInclude.Add(Include, Resolved);
+			IncludeCounts.FindOrAdd(Include)++;
+			SourceIncludes[Index].Add(Include);
+		}
+	}
+
+	const int32 MinSources = FMath::Max(2, FMath::CeilToInt(Sources.Num() * MinShare));
+
+	for (const TPair<FString, int32>& Pair : IncludeCounts)
+	{
+		if (Pair.Value < MinSources)
+		{
+			continue;
+		}
+
+		const TSet<FString>& Closure = Resolver.GetClosure(ResolvedByInclude[Pair.Key]);
+
+		FPCHHeaderCandidate& Candidate = OutSuggestion.Candidates.AddDefaulted_GetRef();
+		Candidate.Include = Pair.Key;
+		Candidate.IncludingSources = Pair.Value;
+		Candidate.ClosureFiles = Closure.Num();
+		Candidate.ClosureBytes = Resolver.GetBytes(Closure);
+	}
+
+	OutSuggestion.Candidates.Sort([](const FPCHHeaderCandidate& A, const FPCHHeaderCandidate& B)
+	{
+		return A.IncludingSources * A.ClosureBytes > B.IncludingSources * B.ClosureBytes;
+	});
+
+	TSet<FString> SuggestedSet;
+	TSet<FString> PCHFiles;
+	for (const FPCHHeaderCandidate& Candidate : OutSuggestion.Candidates)
+	{
+		if (OutSuggestion.Suggested.Num() >= MaxHeaders)
+		{
+			break;
+		}
+
+		// 已被前面的头文件传递包含的不再单列
+		const FString& Resolved = ResolvedByInclude[Candidate.Include];
+		if (PCHFiles.Contains(Resolved))
+		{
+			continue;
+		}
+
+		OutSuggestion.Suggested.Add(Candidate.Include);
+		SuggestedSet.Add(Candidate.Include);
+		PCHFiles.Append(Resolver.GetClosure(Resolved));
+	}
+
+	OutSuggestion.PCHBytes = Resolver.GetBytes(PCHFiles);
+
+	// 每个 .cpp 要为建议集合解析的内容（多个头文件的闭包取并集）
+	for (const TArray<FString>& Includes : SourceIncludes)
+	{
+		TSet<FString> Parsed;
+		for (const FString& Include : Includes)
+		{
+			if (SuggestedSet.Contains(Include) || PCHFiles.Contains(ResolvedByInclude[Include]))
+			{
+				Parsed.Append(Resolver.GetClosure(ResolvedByInclude[Include]));
+			}
+		}
+		OutSuggestion.ParsedBytesWithoutPCH += Resolver.GetBytes(Parsed);
+	}
+}
+
+FString FormatPCHSuggestion(const FPCHSuggestion& Suggestion)
+{
+	using namespace PCHAdvisorPrivate;
+
+	FString Report = FString::Printf(TEXT("== %s（%d 个 .cpp）==\n"), *Suggestion.ModuleName, Suggestion.SourceFiles);
+
+	if (!Suggestion.ExistingPCH.IsEmpty())
+	{
+		Report += TEXT("  已有：") + Suggestion.ExistingPCH + TEXT("\n");
+	}
+
+	if (Suggestion.Suggested.Num() == 0)
+	{
+		Report += TEXT("  没有被多数 .cpp 共同包含的模块外头文件，不建议单独 PCH。\n");
+		return Report;
+	}
+
+	Report += TEXT("  候选头文件（直接包含的 .cpp 数 / 传递头文件数 / 传递大小）：\n");
+	for (const FPCHHeaderCandidate& Candidate : Suggestion.Candidates)
+	{
+		Report += FString::Printf(TEXT("    %s %-50s %3d / %4d / %s\n"),
+			Suggestion.Suggested.Contains(Candidate.Include) ? TEXT("*") : TEXT(" "),
+			*Candidate.Include, Candidate.IncludingSources, Candidate.ClosureFiles, *FormatBytes(Candidate.ClosureBytes));
+	}
+
+	// 用 PCH 后：PCH 本身编译一次，各 .cpp 直接加载
+	const int64 Saved = Suggestion.ParsedBytesWithoutPCH - Suggestion.PCHBytes;
+	Report += FString::Printf(TEXT("  估算：不用 PCH 时各 .cpp 为这些头文件共解析 %s；PCH 一次解析 %s；每次全量编译少解析约 %s。\n"),
+		*FormatBytes(Suggestion.ParsedBytesWithoutPCH), *FormatBytes(Suggestion.PCHBytes), *FormatBytes(FMath::Max<int64>(0, Saved)));
+
+	if (Suggestion.SourceFiles < 4)
+	{
+		Report += TEXT("  .cpp 很少，单独 PCH 的收益有限，可能不如共享 PCH。\n");
+	}
+
+	Report += FString::Printf(TEXT("  建议（Build.cs：PrivatePCHHeaderFile = \"%s\";）：\n"),
+		*GetPCHHeaderRelativePath(Suggestion.ModuleName, EModulePCHMode::Private));
+
+	TArray<FString> Lines;
+	MakePCHHeaderText(Suggestion.ModuleName, Suggestion.Suggested, EModulePCHMode::Private).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		Report += TEXT("    | ") + Line + TEXT("\n");
+	}
+
+	return Report;
+}
+
+FString BuildPCHReport(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, const FString& OnlyModule)
+{
+	TArray<FPCHSuggestion> Suggestions;
+
+	for (int32 Index = 0; Index < Graph.GetNodes().Num(); ++Index)
+	{
+		if (!OnlyModule.IsEmpty() && Graph.GetNodes()[Index].Name != OnlyModule)
+		{
+			continue;
+		}
+		SuggestPCHContents(Graph, External, Index, 0.3f, 12, Suggestions.AddDefaulted_GetRef());
+	}
+
+	if (Suggestions.Num() == 0)
+	{
+		return OnlyModule.IsEmpty() ? TEXT("没有找到模块。\n") : TEXT("没有找到模块：") + OnlyModule + TEXT("\n");
+	}
+
+	Suggestions.Sort([](const FPCHSuggestion& A, const FPCHSuggestion& B)
+	{
+		return A.ParsedBytesWithoutPCH - A.PCHBytes > B.ParsedBytesWithoutPCH - B.PCHBytes;
+	});
+
+	FString Report = TEXT("按源码实际包含频率估算；大小为传递包含的头文件字节数，不是实测编译时间。\n\n");
+	for (const FPCHSuggestion& Suggestion : Suggestions)
+	{
+		Report += FormatPCHSuggestion(Suggestion) + TEXT("\n");
+	}
+	return Report;
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,257 @@
+#include "PluginDescriptorScanner.h"
+#include "ModuleBuilderCache.h"
+#include "ModuleBuilderEditor.h"
+#include "ModuleBuilderTrace.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PluginDescriptor.h"
+#include "Tasks/Task.h"
+
+// 缓存文件格式，结构变化时递增
+static constexpr uint32 GPluginCacheMagic = 0x4D425043; // 'MBPC'
+static constexpr int32 GPluginCacheVersion = 2;
+
+FArchive& operator<<(FArchive& Ar, FScannedPlugin& Plugin)
+{
+	Ar << Plugin.Name;
+	Ar << Plugin.DescriptorPath;
+	Ar << Plugin.FriendlyName;
+	Ar << Plugin.ModuleNames;
+	Ar << Plugin.bEnabledByDefault;
+	Ar << Plugin.TimestampTicks;
+	Ar << Plugin.FileSize;
+	Ar << Plugin.ContentHash;
+	return Ar;
+}
+
+FString FScannedPlugin::GetBaseDir() const
+{
+	return FPaths::GetPath(DescriptorPath);
+}
+
+// 条目直接保存完整字段，不使用字符串表
+static void LoadPluginCache(const FString& CachePath, TMap<FString, FScannedPlugin>& OutCache)
+{
+	TArray<FString> Strings;
+	TArray<FScannedPlugin> Entries;
+	if (!ModuleBuilder::LoadIndexCache(CachePath, GPluginCacheMagic, GPluginCacheVersion, Strings, Entries))
+	{
+		return;
+	}
+
+	OutCache.Reserve(Entries.Num());
+	for (FScannedPlugin& Entry : Entries)
+	{
+		OutCache.Add(Entry.DescriptorPath, MoveTemp(Entry));
+	}
+}
+
+static void SavePluginCache(const FString& CachePath, TArray<FScannedPlugin>& Entries)
+{
+	ModuleBuilder::FCacheStringTable Strings;
+	ModuleBuilder::SaveIndexCache(CachePath, GPluginCacheMagic, GPluginCacheVersion, Strings, Entries, TEXT("插件"));
+}
+
+static bool ParsePluginDescriptor(const TArray<uint8>& Bytes, FScannedPlugin& InOutPlugin)
+{
+	FString Text;
+	FFileHelper::BufferToString(Text, Bytes.GetData(), Bytes.Num());
+
+	FPluginDescriptor Descriptor;
+	FText FailReason;
+	if (!Descriptor.Read(Text, FailReason))
+	{
+		UE_LOG(LogModuleBuilder, Warning, TEXT("解析插件描述文件失败：%s（%s）"), *InOutPlugin.DescriptorPath, *FailReason.ToString());
+		return false;
+	}
+
+	InOutPlugin.FriendlyName = Descriptor.FriendlyName;
+	InOutPlugin.bEnabledByDefault = Descriptor.EnabledByDefault == EPluginEnabledByDefault::Enabled;
+
+	InOutPlugin.ModuleNames.Reset(Descriptor.Modules.Num());
+	for (const FModuleDescriptor& Module : Descriptor.Modules)
+	{
+		InOutPlugin.ModuleNames.Add(Module.Name.ToString());
+	}
+	return true;
+}
+
+FPluginDescriptorScanner& FPluginDescriptorScanner::Get()
+{
+	static FPluginDescriptorScanner Instance;
+	return Instance;
+}
+
+FString FPluginDescriptorScanner::GetCachePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("PluginDescriptorCache.bin"));
+}
+
+const FScannedPlugin* FPluginDescriptorScanner::FindPlugin(const FString& Name) const
+{
+	const int32* Index = PluginsByName.Find(Name);
+	return Index ? &Plugins[*Index] : nullptr;
+}
+
+void FPluginDescriptorScanner::StartScan()
+{
+	check(IsInGameThread());
+
+	if (bScanning.exchange(true))
+	{
+		return;
+	}
+
+	const FString PluginsDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir());
+	const FString CachePath = GetCachePath();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [PluginsDir, CachePath]()
+	{
+		TArray<FScannedPlugin> Result;
+		FPluginScanStats Stats;
+		Scan(PluginsDir, CachePath, Result, Stats);
+
+		AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result), Stats]() mutable
+		{
+			FPluginDescriptorScanner::Get().ApplyResult(MoveTemp(Result), Stats);
+		});
+	});
+}
+
+void FPluginDescriptorScanner::ScanBlocking()
+{
+	bScanning.store(true);
+
+	TArray<FScannedPlugin> Result;
+	FPluginScanStats Stats;
+	Scan(FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir()), GetCachePath(), Result, Stats);
+
+	ApplyResult(MoveTemp(Result), Stats);
+}
+
+void FPluginDescriptorScanner::ApplyResult(TArray<FScannedPlugin>&& InPlugins, const FPluginScanStats& InStats)
+{
+	Plugins = MoveTemp(InPlugins);
+	LastStats = InStats;
+
+	PluginsByName.Reset();
+	PluginsByName.Reserve(Plugins.Num());
+	for (int32 Index = 0; Index < Plugins.Num(); ++Index)
+	{
+		PluginsByName.Add(Plugins[Index].Name, Index);
+	}
+
+	bScanning.store(false);
+
+	UE_LOG(LogModuleBuilder, Log, TEXT("插件扫描完成：%d 个描述文件，重新解析 %d，内容未变 %d，耗时 %.3f 秒"),
+		LastStats.DescriptorsFound, LastStats.DescriptorsParsed, LastStats.DescriptorsRehashed, LastStats.Seconds);
+
+	ScanCompletedEvent.Broadcast();
+}
+
+void FPluginDescriptorScanner::Scan(const FString& PluginsDir, const FString& CachePath, TArray<FScannedPlugin>& OutPlugins, FPluginScanStats& OutStats)
+{
+	MODULEBUILDER_SCOPE("PluginScan");
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TMap<FString, FScannedPlugin> Cache;
+	{
+		MODULEBUILDER_SCOPE("PluginScan.LoadCache");
+		LoadPluginCache(CachePath, Cache);
+	}
+
+	// 1）只做目录遍历和 stat，不读文件内容
+	OutPlugins.Reset();
+	{
+		MODULEBUILDER_SCOPE("PluginScan.Enumerate");
+		IFileManager::Get().IterateDirectoryStatRecursively(*PluginsDir, [&OutPlugins](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory && FPaths::GetExtension(Path) == TEXT("uplugin"))
+			{
+				FScannedPlugin& Plugin = OutPlugins.AddDefaulted_GetRef();
+				Plugin.DescriptorPath = FPaths::ConvertRelativePathToFull(Path);
+				Plugin.Name = FPaths::GetBaseFilename(Path);
+				Plugin.TimestampTicks = StatData.ModificationTime.GetTicks();
+				Plugin.FileSize = StatData.FileSize;
+			}
+			return true;
+		});
+	}
+
+	OutStats.DescriptorsFound = OutPlugins.Num();
+
+	// 2）时间戳和大小都没变的直接复用缓存，其余并行读取 + 哈希 + 解析
+	std::atomic<int32> Parsed { 0 };
+	std::atomic<int32> Rehashed { 0 };
+	TArray<bool> Keep;
+	Keep.Init(true, OutPlugins.Num());
+
+	{
+		MODULEBUILDER_SCOPE("PluginScan.Parse");
+		ParallelFor(OutPlugins.Num(), [&](int32 Index)
+		{
+			FScannedPlugin& Plugin = OutPlugins[Index];
+			const FScannedPlugin* Cached = Cache.Find(Plugin.DescriptorPath);
+
+			if (Cached && Cached->TimestampTicks == Plugin.TimestampTicks && Cached->FileSize == Plugin.FileSize)
+			{
+				Plugin = *Cached;
+				return;
+			}
+
+			TArray<uint8> Bytes;
+			if (!FFileHelper::LoadFileToArray(Bytes, *Plugin.DescriptorPath))
+			{
+				Keep[Index] = false;
+				return;
+			}
+
+			Plugin.ContentHash = FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+
+			// 时间戳变了但内容相同（例如重新检出），沿用解析结果
+			if (Cached && Cached->ContentHash == Plugin.ContentHash)
+			{
+				const int64 TimestampTicks = Plugin.TimestampTicks;
+				const int64 FileSize = Plugin.FileSize;
+				Plugin = *Cached;
+				Plugin.TimestampTicks = TimestampTicks;
+				Plugin.FileSize = FileSize;
+				++Rehashed;
+				return;
+			}
+
+			Keep[Index] = ParsePluginDescriptor(Bytes, Plugin);
+			++Parsed;
+		});
+	}
+
+	for (int32 Index = OutPlugins.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Keep[Index])
+		{
+			OutPlugins.RemoveAtSwap(Index);
+		}
+	}
+
+	OutPlugins.Sort([](const FScannedPlugin& A, const FScannedPlugin& B) { return A.Name < B.Name; });
+
+	OutStats.DescriptorsParsed = Parsed.load();
+	OutStats.DescriptorsRehashed = Rehashed.load();
+
+	// 有新解析、内容未变但时间戳更新、或描述文件被删除时才重写缓存
+	if (OutStats.DescriptorsParsed > 0 || OutStats.DescriptorsRehashed > 0 || Cache.Num() != OutPlugins.Num())
+	{
+		MODULEBUILDER_SCOPE("PluginScan.SaveCache");
+		SavePluginCache(CachePath, OutPlugins);
+	}
+
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	MODULEBUILDER_COUNT(PluginsScanned, OutStats.DescriptorsParsed);
+}
@@ -0,0 +1,124 @@
+#include "ProjectPluginIndex.h"
+#include "ModuleBuilderTrace.h"
+#include "PluginDescriptorScanner.h"
+
+#include "Algo/BinarySearch.h"
+#include "Interfaces/IPluginManager.h"
+
+static bool PluginNameLess(const TSharedPtr<FString>& A, const TSharedPtr<FString>& B)
+{
+	return A->Compare(*B, ESearchCase::IgnoreCase) < 0;
+}
+
+FProjectPluginIndex& FProjectPluginIndex::Get()
+{
+	static FProjectPluginIndex Instance;
+	return Instance;
+}
+
+void FProjectPluginIndex::Initialize()
+{
+	IPluginManager& PluginManager = IPluginManager::Get();
+	MountedHandle   = PluginManager.OnNewPluginMounted().AddRaw(this, &FProjectPluginIndex::HandlePluginMounted);
+	CreatedHandle   = PluginManager.OnNewPluginCreated().AddRaw(this, &FProjectPluginIndex::HandlePluginMounted);
+	UnmountedHandle = PluginManager.OnPluginUnmounted().AddRaw(this, &FProjectPluginIndex::HandlePluginUnmounted);
+
+	// 磁盘扫描结果到达后合并未启用 / 未挂载的插件
+	ScanHandle = FPluginDescriptorScanner::Get().OnScanCompleted().AddRaw(this, &FProjectPluginIndex::HandleScanCompleted);
+
+	bDirty = true;
+}
+
+void FProjectPluginIndex::Shutdown()
+{
+	IPluginManager& PluginManager = IPluginManager::Get();
+	PluginManager.OnNewPluginMounted().Remove(MountedHandle);
+	PluginManager.OnNewPluginCreated().Remove(CreatedHandle);
+	PluginManager.OnPluginUnmounted().Remove(UnmountedHandle);
+	FPluginDescriptorScanner::Get().OnScanCompleted().Remove(ScanHandle);
+
+	Plugins.Reset();
+	bDirty = true;
+}
+
+const TArray<TSharedPtr<FString>>& FProjectPluginIndex::GetProjectPlugins()
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+	return Plugins;
+}
+
+void FProjectPluginIndex::Rebuild()
+{
+	MODULEBUILDER_SCOPE("PluginIndex.Rebuild");
+
+	Plugins.Reset();
+
+	TSet<FString> Seen;
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+	{
+		if (Plugin->GetType() == EPluginType::Project)
+		{
+			Seen.Add(Plugin->GetName());
+			Plugins.Add(MakeShared<FString>(Plugin->GetName()));
+		}
+	}
+
+	for (const FScannedPlugin& Scanned : FPluginDescriptorScanner::Get().GetPlugins())
+	{
+		bool bAlreadyInSet = false;
+		Seen.Add(Scanned.Name, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Plugins.Add(MakeShared<FString>(Scanned.Name));
+		}
+	}
+
+	Plugins.Sort([](const TSharedPtr<FString>& A, const TSharedPtr<FString>& B) { return PluginNameLess(A, B); });
+
+	bDirty = false;
+	++Revision;
+}
+
+void FProjectPluginIndex::HandlePluginMounted(IPlugin& Plugin)
+{
+	if (bDirty || Plugin.GetType() != EPluginType::Project)
+	{
+		return;
+	}
+
+	TSharedPtr<FString> Name = MakeShared<FString>(Plugin.GetName());
+	const int32 Index = Algo::LowerBound(Plugins, Name, [](const TSharedPtr<FString>& A, const TSharedPtr<FString>& B) { return PluginNameLess(A, B); });
+
+	if (Plugins.IsValidIndex(Index) && Plugins[Index]->Equals(*Name, ESearchCase::IgnoreCase))
+	{
+		return;
+	}
+
+	Plugins.Insert(Name, Index);
+	++Revision;
+}
+
+void FProjectPluginIndex::HandleScanCompleted()
+{
+	bDirty = true;
+}
+
+void FProjectPluginIndex::HandlePluginUnmounted(IPlugin& Plugin)
+{
+	// 插件目录仍在磁盘上时保留（可作为未挂载插件继续选择）
+	if (bDirty || Plugin.GetType() != EPluginType::Project || FPluginDescriptorScanner::Get().FindPlugin(Plugin.GetName()))
+	{
+		return;
+	}
+
+	const FString Name = Plugin.GetName();
+	const int32 Removed = Plugins.RemoveAll([&Name](const TSharedPtr<FString>& Item) { return Item->Equals(Name, ESearchCase::IgnoreCase); });
+	if (Removed > 0)
+	{
+		++Revision;
+	}
+}
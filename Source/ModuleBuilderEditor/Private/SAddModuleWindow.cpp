@@ -1,17 +1,37 @@
 ﻿#include "SAddModuleWindow.h"
+#include "LoadingPhaseAdvisor.h"
+#include "ModuleBuildOperation.h"
+#include "ModuleGenerator.h"
+#include "ModuleNameIndex.h"
+#include "ProjectPluginIndex.h"
 
-#include "Interfaces/IPluginManager.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Misc/MessageDialog.h"
+#include "Misc/Paths.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SComboButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SUniformGridPanel.h"
 #include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
 #include "Widgets/SWindow.h"
 
 #define LOCTEXT_NAMESPACE "ModuleBuilderWindow"
 
+// 类型下拉中的 Core-only 模板（生成 Runtime 模块）
+static const TCHAR* CoreOnlyTypeOption = TEXT("Runtime (Core only)");
+
+// 最后一次按键后等待多久再校验
+static constexpr double GNameValidationDelay = 0.25;
+
 static TSharedRef<SWidget> MakeComboItemWidget(TSharedPtr<FString> Item)
 {
 	return SNew(STextBlock)
@@ -50,10 +70,24 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 				SNew(STextBlock)
 				.Text(LOCTEXT("ModuleNameLabel", "模块名称"))
 			]
-			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 12)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 4)
 			[
 				SAssignNew(ModuleNameText, SEditableTextBox)
 				.HintText(LOCTEXT("ModuleNameHint", "例如：MyGameplay 或 MyPluginEditor"))
+				.OnTextChanged(this, &SAddModuleWindow::HandleModuleNameChanged)
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 12)
+			[
+				SNew(STextBlock)
+				.Text_Lambda([this](){ return NameValidationMessage; })
+				.ColorAndOpacity_Lambda([this]()
+				{
+					return bNameValid ? FSlateColor::UseSubduedForeground() : FSlateColor(FLinearColor::Red);
+				})
+				.Visibility_Lambda([this]()
+				{
+					return NameValidationMessage.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+				})
 			]
 
 			// 目标类型
@@ -104,15 +138,14 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 			.AutoHeight()
 			.Padding(0, 0, 0, 12)
 			[
-				SNew(SComboBox<TSharedPtr<FString>>)
+				SAssignNew(PluginPickerButton, SComboButton)
 				.Visibility_Lambda([this](){ return GetPluginPickerVisibility(); })
-				.OptionsSource(&ProjectPluginOptions)
-				.InitiallySelectedItem(SelectedProjectPlugin)
-				.OnSelectionChanged_Lambda([this](TSharedPtr<FString> NewItem, ESelectInfo::Type)
+				.OnGetMenuContent(this, &SAddModuleWindow::GetPluginPickerMenu)
+				.OnComboBoxOpened_Lambda([this]()
 				{
-					SelectedProjectPlugin = NewItem;
+					RefreshProjectPlugins();
 				})
-				.OnGenerateWidget_Lambda([](TSharedPtr<FString> Item){ return MakeComboItemWidget(Item); })
+				.ButtonContent()
 				[
 					SNew(STextBlock).Text_Lambda([this]()
 					{
@@ -137,6 +170,7 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 				.OnSelectionChanged_Lambda([this](TSharedPtr<FString> NewItem, ESelectInfo::Type)
 				{
 					SelectedModuleType = NewItem;
+					RefreshPCHDefaults(false);
 				})
 				.OnGenerateWidget_Lambda([](TSharedPtr<FString> Item){ return MakeComboItemWidget(Item); })
 				[
@@ -148,6 +182,17 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 					})
 				]
 			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 12)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				.Text(CoreOnlySavingsText)
+				.Visibility_Lambda([this]()
+				{
+					return IsCoreOnlySelected() ? EVisibility::Visible : EVisibility::Collapsed;
+				})
+			]
 
 			// 加载阶段
 			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 6)
@@ -155,7 +200,7 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 				SNew(STextBlock)
 				.Text(LOCTEXT("LoadingPhaseLabel", "加载阶段"))
 			]
-			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 16)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 6)
 			[
 				SNew(SComboBox<TSharedPtr<FString>>)
 				.OptionsSource(&LoadingPhaseOptions)
@@ -174,6 +219,112 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 					})
 				]
 			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 16)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				.Text_Lambda([this]()
+				{
+					const FString ModuleType = IsCoreOnlySelected() || !SelectedModuleType.IsValid() ? TEXT("Runtime") : *SelectedModuleType;
+					return ModuleBuilder::GetLoadingPhaseGuidance(SelectedLoadingPhase.IsValid() ? *SelectedLoadingPhase : TEXT("Default"), ModuleType);
+				})
+			]
+
+			// 预编译头
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 6)
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("PCHLabel", "预编译头"))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 6)
+			[
+				SNew(SComboBox<TSharedPtr<FString>>)
+				.OptionsSource(&PCHModeOptions)
+				.InitiallySelectedItem(SelectedPCHMode)
+				.OnSelectionChanged_Lambda([this](TSharedPtr<FString> NewItem, ESelectInfo::Type)
+				{
+					SelectedPCHMode = NewItem;
+					RefreshPCHDefaults(false);
+				})
+				.OnGenerateWidget_Lambda([](TSharedPtr<FString> Item){ return MakeComboItemWidget(Item); })
+				[
+					SNew(STextBlock).Text_Lambda([this]()
+					{
+						return SelectedPCHMode.IsValid()
+							? FText::FromString(*SelectedPCHMode)
+							: LOCTEXT("PCHSelectHint", "请选择");
+					})
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 16)
+			[
+				SNew(SVerticalBox)
+				.Visibility_Lambda([this]()
+				{
+					return GetSelectedPCHMode() == EModulePCHMode::None ? EVisibility::Collapsed : EVisibility::Visible;
+				})
+
+				+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 4)
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+					.Text(LOCTEXT("PCHHeadersHint", "每行一个头文件。只放稳定且被大多数 .cpp 使用的头文件；生成后可用“预编译头建议”按实际包含频率调整。"))
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					SNew(SBox)
+					.MinDesiredHeight(72.f)
+					[
+						SAssignNew(PCHHeadersText, SMultiLineEditableTextBox)
+					]
+				]
+			]
+
+			// 性能埋点
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 6)
+			[
+				SNew(SCheckBox)
+				.IsChecked_Lambda([this]() { return bInstrumented ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { bInstrumented = State == ECheckBoxState::Checked; })
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("InstrumentedLabel", "性能埋点（stat / LLM / CSV / Trace）"))
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 16)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				.Text(LOCTEXT("InstrumentedHint", "额外生成 Public/<模块名>Stats.h：stat 分组、LLM 内存标签、CSV 分类与 Trace 通道，StartupModule / ShutdownModule 已埋点；模块代码中用 <模块名大写>_SCOPE(名称) 一次计入全部四项。"))
+				.Visibility_Lambda([this]() { return bInstrumented ? EVisibility::Visible : EVisibility::Collapsed; })
+			]
+
+			// 生成进度
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 0, 0, 6)
+			[
+				SNew(STextBlock)
+				.Visibility_Lambda([this](){ return GetProgressVisibility(); })
+				.Text_Lambda([this]()
+				{
+					return ActiveOperation.IsValid() ? ActiveOperation->GetStatusText() : FText::GetEmpty();
+				})
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 0, 0, 12)
+			[
+				SNew(SProgressBar)
+				.Visibility_Lambda([this](){ return GetProgressVisibility(); })
+				.Percent_Lambda([this]()
+				{
+					return ActiveOperation.IsValid() ? TOptional<float>(ActiveOperation->GetProgress()) : TOptional<float>();
+				})
+			]
 
 			// 按钮
 			+ SVerticalBox::Slot()
@@ -186,7 +337,16 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 				+ SUniformGridPanel::Slot(0, 0)
 				[
 					SNew(SButton)
-					.Text(LOCTEXT("CancelButton", "取消"))
+					.Text_Lambda([this]()
+					{
+						return IsBuilding()
+							? LOCTEXT("CancelBuildButton", "取消生成")
+							: LOCTEXT("CancelButton", "取消");
+					})
+					.IsEnabled_Lambda([this]()
+					{
+						return !IsBuilding() || !ActiveOperation->IsCancelRequested();
+					})
 					.OnClicked(this, &SAddModuleWindow::HandleCancel)
 				]
 
@@ -194,11 +354,14 @@ void SAddModuleWindow::Construct(const FArguments& InArgs)
 				[
 					SNew(SButton)
 					.Text(LOCTEXT("ConfirmButton", "确定"))
+					.IsEnabled_Lambda([this](){ return !IsBuilding(); })
 					.OnClicked(this, &SAddModuleWindow::HandleConfirm)
 				]
 			]
 		]
 	];
+
+	RefreshPCHDefaults(true);
 }
 
 void SAddModuleWindow::InitOptions()
@@ -209,17 +372,46 @@ void SAddModuleWindow::InitOptions()
 		MakeShared<FString>(TEXT("Developer")),
 		MakeShared<FString>(TEXT("RuntimeNoCommandlet")),
 		MakeShared<FString>(TEXT("EditorNoCommandlet")),
+		MakeShared<FString>(CoreOnlyTypeOption),
 	};
 	SelectedModuleType = ModuleTypeOptions[0];
 
+	// 两种模板写入 Build.cs 的依赖数量
+	FNewModuleParams Preview;
+	Preview.ModuleName = TEXT("Preview");
+
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+	ModuleBuilder::GetModuleDependencies(Preview, PublicDependencies, PrivateDependencies);
+	const int32 StandardDependencies = PublicDependencies.Num() + PrivateDependencies.Num();
+
+	Preview.Archetype = EModuleArchetype::CoreOnly;
+	ModuleBuilder::GetModuleDependencies(Preview, PublicDependencies, PrivateDependencies);
+	const int32 CoreOnlyDependencies = PublicDependencies.Num() + PrivateDependencies.Num();
+
+	CoreOnlySavingsText = FText::Format(
+		LOCTEXT("CoreOnlySavings",
+			"仅依赖 Core：依赖模块 {0} 个（标准模板 {1} 个），编译前无需等待 CoreUObject / Engine；"
+			"不含反射代码，UHT 不处理该模块，也没有 .generated.h；加载时没有 UObject 注册开销。"),
+		FText::AsNumber(CoreOnlyDependencies),
+		FText::AsNumber(StandardDependencies));
+
 	LoadingPhaseOptions = {
 		MakeShared<FString>(TEXT("Default")),
 		MakeShared<FString>(TEXT("PostEngineInit")),
 		MakeShared<FString>(TEXT("PreDefault")),
 		MakeShared<FString>(TEXT("PostDefault")),
+		MakeShared<FString>(TEXT("None")),
 	};
 	SelectedLoadingPhase = LoadingPhaseOptions[0];
 
+	PCHModeOptions = {
+		MakeShared<FString>(TEXT("None")),
+		MakeShared<FString>(TEXT("Private")),
+		MakeShared<FString>(TEXT("Shared")),
+	};
+	SelectedPCHMode = PCHModeOptions[0];
+
 	TargetTypeOptions = {
 		MakeShared<FString>(TEXT("Project")),
 		MakeShared<FString>(TEXT("ProjectPlugin")),
@@ -229,21 +421,138 @@ void SAddModuleWindow::InitOptions()
 
 void SAddModuleWindow::RefreshProjectPlugins()
 {
-	ProjectPluginOptions.Reset();
-	SelectedProjectPlugin.Reset();
+	FProjectPluginIndex& Index = FProjectPluginIndex::Get();
+	const TArray<TSharedPtr<FString>>& Plugins = Index.GetProjectPlugins();
+
+	// 索引未变化时什么都不做，打开选择器的开销与插件数量无关
+	if (Index.GetRevision() == PluginIndexRevision)
+	{
+		return;
+	}
+
+	PluginIndexRevision = Index.GetRevision();
+	ProjectPluginOptions = Plugins;
 
-	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+	// 保留仍然存在的选择
+	if (SelectedProjectPlugin.IsValid())
 	{
-		if (Plugin->GetType() == EPluginType::Project)
+		const FString Previous = *SelectedProjectPlugin;
+		const TSharedPtr<FString>* Found = ProjectPluginOptions.FindByPredicate([&Previous](const TSharedPtr<FString>& Item)
 		{
-			ProjectPluginOptions.Add(MakeShared<FString>(Plugin->GetName()));
-		}
+			return *Item == Previous;
+		});
+		SelectedProjectPlugin = Found ? *Found : nullptr;
 	}
 
-	if (ProjectPluginOptions.Num() > 0)
+	if (!SelectedProjectPlugin.IsValid() && ProjectPluginOptions.Num() > 0)
 	{
 		SelectedProjectPlugin = ProjectPluginOptions[0];
 	}
+
+	ApplyPluginFilter(PluginFilter, true);
+}
+
+void SAddModuleWindow::ApplyPluginFilter(const FString& NewFilter, bool bFromScratch)
+{
+	// 新关键字是旧关键字的延伸时，只需在当前结果里继续筛
+	const bool bNarrowing = !bFromScratch
+		&& !PluginFilter.IsEmpty()
+		&& NewFilter.StartsWith(PluginFilter, ESearchCase::IgnoreCase);
+
+	if (!bNarrowing)
+	{
+		FilteredPluginOptions = ProjectPluginOptions;
+	}
+
+	if (!NewFilter.IsEmpty())
+	{
+		FilteredPluginOptions.RemoveAll([&NewFilter](const TSharedPtr<FString>& Item)
+		{
+			return !Item->Contains(NewFilter, ESearchCase::IgnoreCase);
+		});
+	}
+
+	PluginFilter = NewFilter;
+
+	if (PluginListView.IsValid())
+	{
+		PluginListView->RequestListRefresh();
+	}
+}
+
+TSharedRef<SWidget> SAddModuleWindow::GetPluginPickerMenu()
+{
+	// 菜单只构建一次，之后每次打开直接复用
+	if (!PluginPickerMenu.IsValid())
+	{
+		PluginPickerMenu =
+			SNew(SVerticalBox)
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4)
+			[
+				SAssignNew(PluginSearchBox, SSearchBox)
+				.HintText(LOCTEXT("PluginSearchHint", "搜索插件"))
+				.OnTextChanged_Lambda([this](const FText& Text)
+				{
+					ApplyPluginFilter(Text.ToString(), false);
+				})
+				.OnTextCommitted_Lambda([this](const FText&, ETextCommit::Type CommitType)
+				{
+					if (CommitType == ETextCommit::OnEnter && FilteredPluginOptions.Num() > 0)
+					{
+						HandlePluginSelected(FilteredPluginOptions[0], ESelectInfo::OnKeyPress);
+					}
+				})
+			]
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SBox)
+				.MaxDesiredHeight(320.f)
+				[
+					SAssignNew(PluginListView, SListView<TSharedPtr<FString>>)
+					.ListItemsSource(&FilteredPluginOptions)
+					.SelectionMode(ESelectionMode::Single)
+					.OnGenerateRow(this, &SAddModuleWindow::MakePluginRow)
+					.OnSelectionChanged(this, &SAddModuleWindow::HandlePluginSelected)
+				]
+			];
+
+		if (PluginPickerButton.IsValid())
+		{
+			PluginPickerButton->SetMenuContentWidgetToFocus(PluginSearchBox);
+		}
+	}
+
+	return PluginPickerMenu.ToSharedRef();
+}
+
+TSharedRef<ITableRow> SAddModuleWindow::MakePluginRow(TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<FString>>, OwnerTable)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(*Item))
+			.HighlightText_Lambda([this]() { return FText::FromString(PluginFilter); })
+		];
+}
+
+void SAddModuleWindow::HandlePluginSelected(TSharedPtr<FString> Item, ESelectInfo::Type SelectInfo)
+{
+	if (!Item.IsValid() || SelectInfo == ESelectInfo::Direct)
+	{
+		return;
+	}
+
+	SelectedProjectPlugin = Item;
+
+	if (PluginPickerButton.IsValid())
+	{
+		PluginPickerButton->SetIsOpen(false);
+	}
 }
 
 EVisibility SAddModuleWindow::GetPluginPickerVisibility() const
@@ -255,6 +564,144 @@ EVisibility SAddModuleWindow::GetPluginPickerVisibility() const
 	return EVisibility::Collapsed;
 }
 
+void SAddModuleWindow::HandleModuleNameChanged(const FText& NewText)
+{
+	LastNameEditTime = FSlateApplication::Get().GetCurrentTime();
+	bNameValidationPending = true;
+
+	if (!NameValidationTimer.IsValid())
+	{
+		NameValidationTimer = RegisterActiveTimer(0.05f,
+			FWidgetActiveTimerDelegate::CreateSP(this, &SAddModuleWindow::HandleNameValidationTimer));
+	}
+}
+
+EActiveTimerReturnType SAddModuleWindow::HandleNameValidationTimer(double InCurrentTime, float InDeltaTime)
+{
+	if (!bNameValidationPending)
+	{
+		return EActiveTimerReturnType::Stop;
+	}
+
+	if (InCurrentTime - LastNameEditTime < GNameValidationDelay)
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	ValidateModuleName();
+
+	// 索引还在后台构建时继续等待
+	return bNameValidationPending ? EActiveTimerReturnType::Continue : EActiveTimerReturnType::Stop;
+}
+
+void SAddModuleWindow::ValidateModuleName()
+{
+	const FString Name = ModuleNameText.IsValid()
+		? ModuleNameText->GetText().ToString().TrimStartAndEnd()
+		: FString();
+
+	if (Name.IsEmpty())
+	{
+		bNameValidationPending = false;
+		bNameValid = true;
+		NameValidationMessage = FText::GetEmpty();
+		ModuleNameText->SetError(FText::GetEmpty());
+		return;
+	}
+
+	const FModuleNameIndex& Index = FModuleNameIndex::Get();
+	if (!Index.IsReady())
+	{
+		bNameValid = true;
+		NameValidationMessage = LOCTEXT("NameIndexBuilding", "正在建立模块索引…");
+		return;
+	}
+
+	bNameValidationPending = false;
+
+	FText Reason;
+	bNameValid = Index.ValidateNewModuleName(Name, Reason);
+	NameValidationMessage = bNameValid ? LOCTEXT("NameAvailable", "名称可用") : Reason;
+	ModuleNameText->SetError(bNameValid ? FText::GetEmpty() : Reason);
+}
+
+bool SAddModuleWindow::IsCoreOnlySelected() const
+{
+	return SelectedModuleType.IsValid() && *SelectedModuleType == CoreOnlyTypeOption;
+}
+
+EModulePCHMode SAddModuleWindow::GetSelectedPCHMode() const
+{
+	const int32 Index = PCHModeOptions.IndexOfByKey(SelectedPCHMode);
+	return Index == INDEX_NONE ? EModulePCHMode::None : static_cast<EModulePCHMode>(Index);
+}
+
+void SAddModuleWindow::RefreshPCHDefaults(bool bForce)
+{
+	if (!PCHHeadersText.IsValid())
+	{
+		return;
+	}
+
+	// 用户改过列表就不再覆盖
+	const FString Current = PCHHeadersText->GetText().ToString();
+	if (!bForce && !Current.IsEmpty() && Current != PCHDefaultsText)
+	{
+		return;
+	}
+
+	FNewModuleParams Preview;
+	Preview.ModuleType = IsCoreOnlySelected() ? TEXT("Runtime") : (SelectedModuleType.IsValid() ? *SelectedModuleType : TEXT("Runtime"));
+	Preview.Archetype  = IsCoreOnlySelected() ? EModuleArchetype::CoreOnly : EModuleArchetype::Standard;
+
+	PCHDefaultsText = FString::Join(ModuleBuilder::GetDefaultPCHHeaders(Preview), TEXT("\n"));
+	PCHHeadersText->SetText(FText::FromString(PCHDefaultsText));
+}
+
+TArray<FString> SAddModuleWindow::GetPCHHeaders() const
+{
+	TArray<FString> Headers;
+	if (PCHHeadersText.IsValid())
+	{
+		PCHHeadersText->GetText().ToString().ParseIntoArrayLines(Headers);
+	}
+
+	for (FString& Header : Headers)
+	{
+		Header.TrimStartAndEndInline();
+		Header.RemoveFromStart(TEXT("#include"));
+		Header.TrimStartAndEndInline();
+		Header.TrimCharInline(TEXT('"'), nullptr);
+	}
+	Headers.RemoveAll([](const FString& Header) { return Header.IsEmpty(); });
+	return Headers;
+}
+
+bool SAddModuleWindow::IsBuilding() const
+{
+	return ActiveOperation.IsValid() && ActiveOperation->IsRunning();
+}
+
+EVisibility SAddModuleWindow::GetProgressVisibility() const
+{
+	return IsBuilding() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+void SAddModuleWindow::HandleBuildCompleted(bool bSuccess, const FString& Message)
+{
+	ActiveOperation.Reset();
+
+	if (!bSuccess)
+	{
+		return;
+	}
+
+	if (TSharedPtr<SWindow> W = ParentWindow.Pin())
+	{
+		W->RequestDestroyWindow();
+	}
+}
+
 FReply SAddModuleWindow::HandleConfirm()
 {
 	FNewModuleParams Params;
@@ -264,8 +711,22 @@ FReply SAddModuleWindow::HandleConfirm()
 		: TEXT("");
 
 	Params.ModuleType   = SelectedModuleType.IsValid()   ? *SelectedModuleType   : TEXT("Runtime");
+
+	// Core-only 是 Runtime 模块的一种模板
+	if (IsCoreOnlySelected())
+	{
+		Params.ModuleType = TEXT("Runtime");
+		Params.Archetype  = EModuleArchetype::CoreOnly;
+	}
 	Params.LoadingPhase = SelectedLoadingPhase.IsValid() ? *SelectedLoadingPhase : TEXT("Default");
 
+	Params.PCHMode = GetSelectedPCHMode();
+	if (Params.PCHMode != EModulePCHMode::None)
+	{
+		Params.PCHHeaders = GetPCHHeaders();
+	}
+	Params.bInstrumented = bInstrumented;
+
 	if (SelectedTargetType.IsValid() && *SelectedTargetType == TEXT("ProjectPlugin"))
 	{
 		Params.TargetType = EModuleTargetType::ProjectPlugin;
@@ -297,16 +758,17 @@ FReply SAddModuleWindow::HandleConfirm()
 		return FReply::Handled();
 	}
 
-	const bool bOk = OnConfirm.Execute(Params);
-
-	if (!bOk)
+	if (IsBuilding())
 	{
 		return FReply::Handled();
 	}
 
-	if (TSharedPtr<SWindow> W = ParentWindow.Pin())
+	ActiveOperation = OnConfirm.Execute(Params);
+
+	// 完成回调在游戏线程的后续帧广播，这里绑定不会错过
+	if (ActiveOperation.IsValid())
 	{
-		W->RequestDestroyWindow();
+		ActiveOperation->OnCompleted().AddSP(this, &SAddModuleWindow::HandleBuildCompleted);
 	}
 
 	return FReply::Handled();
@@ -314,6 +776,13 @@ FReply SAddModuleWindow::HandleConfirm()
 
 FReply SAddModuleWindow::HandleCancel()
 {
+	if (IsBuilding())
+	{
+		// 只请求取消，窗口等完成回调后再恢复可编辑
+		ActiveOperation->Cancel();
+		return FReply::Handled();
+	}
+
 	if (OnCancel.IsBound())
 	{
 		OnCancel.Execute();
@@ -0,0 +1,200 @@
+#include "SModuleReportWindow.h"
+
+#include "Async/Async.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Tasks/Task.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "ModuleBuilderReport"
+
+void SModuleReportWindow::Construct(const FArguments& InArgs)
+{
+	OnPrepareReport = InArgs._OnPrepareReport;
+	OnPrepareAction = InArgs._OnPrepareAction;
+	ActionText      = InArgs._ActionText;
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.Padding(12)
+		[
+			SNew(SVerticalBox)
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 0, 0, 8)
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(0, 0, 8, 0)
+				[
+					SNew(SBox)
+					.WidthOverride(240.f)
+					.Visibility(InArgs._InputHint.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible)
+					[
+						SNew(SEditableTextBox)
+						.HintText(InArgs._InputHint)
+						.OnTextChanged(InArgs._OnInputChanged)
+						.OnTextCommitted(this, &SModuleReportWindow::HandleInputCommitted)
+						.IsEnabled_Lambda([this]() { return !bGenerating; })
+					]
+				]
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]()
+					{
+						return bGenerating ? LOCTEXT("Generating", "分析中…") : FText::GetEmpty();
+					})
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(ActionText)
+					.Visibility(ActionText.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible)
+					.IsEnabled_Lambda([this]() { return !bGenerating; })
+					.OnClicked(this, &SModuleReportWindow::HandleActionClicked)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("Refresh", "刷新"))
+					.IsEnabled_Lambda([this]() { return !bGenerating; })
+					.OnClicked(this, &SModuleReportWindow::HandleRefreshClicked)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("Copy", "复制"))
+					.IsEnabled_Lambda([this]() { return !Report.IsEmpty(); })
+					.OnClicked(this, &SModuleReportWindow::HandleCopyClicked)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.FillHeight(1.f)
+			[
+				SAssignNew(ReportText, SMultiLineEditableTextBox)
+				.IsReadOnly(true)
+				.AlwaysShowScrollbars(true)
+				.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+			]
+		]
+	];
+
+	StartTask(OnPrepareReport);
+}
+
+void SModuleReportWindow::Open(const FText& Title, FOnPrepareReport OnPrepareReport, const FText& ActionText, FOnPrepareReport OnPrepareAction,
+	const FText& InputHint, FOnTextChanged OnInputChanged)
+{
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(Title)
+		.ClientSize(FVector2D(900.f, 640.f))
+		.SupportsMinimize(false);
+
+	Window->SetContent(
+		SNew(SModuleReportWindow)
+		.OnPrepareReport(OnPrepareReport)
+		.ActionText(ActionText)
+		.OnPrepareAction(OnPrepareAction)
+		.InputHint(InputHint)
+		.OnInputChanged(OnInputChanged)
+	);
+
+	FSlateApplication::Get().AddWindow(Window);
+}
+
+void SModuleReportWindow::StartTask(const FOnPrepareReport& Prepare)
+{
+	if (!Prepare.IsBound())
+	{
+		return;
+	}
+
+	// 返回空表示放弃（例如用户在确认框中取消）
+	TFunction<FString()> Generate = Prepare.Execute();
+	if (!Generate)
+	{
+		return;
+	}
+
+	bGenerating = true;
+	const uint32 RequestId = ++LatestRequestId;
+	TWeakPtr<SModuleReportWindow> WeakThis = StaticCastSharedRef<SModuleReportWindow>(AsShared());
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Generate = MoveTemp(Generate), WeakThis, RequestId]()
+	{
+		FString Result = Generate();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, Result = MoveTemp(Result)]() mutable
+		{
+			if (TSharedPtr<SModuleReportWindow> This = WeakThis.Pin())
+			{
+				This->HandleReportReady(RequestId, MoveTemp(Result));
+			}
+		});
+	});
+}
+
+void SModuleReportWindow::HandleReportReady(uint32 RequestId, FString InReport)
+{
+	if (RequestId != LatestRequestId)
+	{
+		return;
+	}
+
+	bGenerating = false;
+	Report = MoveTemp(InReport);
+	ReportText->SetText(FText::FromString(Report));
+}
+
+FReply SModuleReportWindow::HandleRefreshClicked()
+{
+	StartTask(OnPrepareReport);
+	return FReply::Handled();
+}
+
+FReply SModuleReportWindow::HandleActionClicked()
+{
+	StartTask(OnPrepareAction);
+	return FReply::Handled();
+}
+
+void SModuleReportWindow::HandleInputCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+	if (CommitType == ETextCommit::OnEnter && !bGenerating)
+	{
+		StartTask(OnPrepareReport);
+	}
+}
+
+FReply SModuleReportWindow::HandleCopyClicked()
+{
+	FPlatformApplicationMisc::ClipboardCopy(*Report);
+	return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,826 @@
+#include "SourceRewrite.h"
+#include "ModuleGenerator.h"
+#include "ModuleStaging.h"
+#include "TextDiff.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace ModuleBuilder
+{
+namespace SourceRewritePrivate
+{
+
+static bool IsIdentifierChar(TCHAR C)
+{
+	return FChar::IsAlnum(C) || C == TEXT('_');
+}
+
+static bool IsCodeFile(const FString& Path)
+{
+	const FString Extension = FPaths::GetExtension(Path);
+	return Extension == TEXT("h") || Extension == TEXT("hpp") || Extension == TEXT("inl")
+		|| Extension == TEXT("cpp") || Extension == TEXT("c") || Extension == TEXT("cc");
+}
+
+static bool IsScriptFile(const FString& Path)
+{
+	return Path.EndsWith(TEXT(".Build.cs")) || Path.EndsWith(TEXT(".Target.cs"));
+}
+
+static bool IsRuleInScope(const FString& Path, const FTextRewriteRule& Rule)
+{
+	if ((Rule.Files == ETextRewriteFiles::Code && !IsCodeFile(Path))
+		|| (Rule.Files == ETextRewriteFiles::Scripts && !IsScriptFile(Path)))
+	{
+		return false;
+	}
+
+	if (Rule.Scope.IsEmpty() || Path == Rule.Scope)
+	{
+		return true;
+	}
+	return Rule.bScopeRecursive ? Path.StartsWith(Rule.Scope + TEXT("/")) : FPaths::GetPath(Path) == Rule.Scope;
+}
+
+static bool IsWordAt(const FString& Text, int32 Begin, int32 End)
+{
+	return (Begin == 0 || !IsIdentifierChar(Text[Begin - 1])) && (End >= Text.Len() || !IsIdentifierChar(Text[End]));
+}
+
+// 从 Pos 向前跳过空白，返回前一个非空白字符的下标
+static int32 SkipWhitespaceBack(const FString& Text, int32 Pos)
+{
+	while (Pos > 0 && FChar::IsWhitespace(Text[Pos - 1])) --Pos;
+	return Pos - 1;
+}
+
+// "From" / <From> 且所在行以 #include 开头
+static bool IsIncludePathAt(const FString& Text, int32 Found, int32 End)
+{
+	if (Found == 0 || End >= Text.Len()
+		|| !((Text[Found - 1] == TEXT('"') && Text[End] == TEXT('"')) || (Text[Found - 1] == TEXT('<') && Text[End] == TEXT('>'))))
+	{
+		return false;
+	}
+
+	int32 LineBegin = Found - 1;
+	while (LineBegin > 0 && Text[LineBegin - 1] != TEXT('\n')) --LineBegin;
+	const FString Directive = Text.Mid(LineBegin, Found - 1 - LineBegin).Replace(TEXT(" "), TEXT("")).Replace(TEXT("\t"), TEXT(""));
+	return Directive == TEXT("#include");
+}
+
+// IMPLEMENT_MODULE / IMPLEMENT_GAME_MODULE / IMPLEMENT_PRIMARY_GAME_MODULE 的模块名参数；找到时返回名字的起点
+static int32 FindImplementModuleName(const FString& Text, const FString& From, int32 Search)
+{
+	while (true)
+	{
+		const int32 Found = Text.Find(TEXT("IMPLEMENT_"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+		if (Found == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+		Search = Found + 10;
+
+		const int32 Open = Text.Find(TEXT("("), ESearchCase::CaseSensitive, ESearchDir::FromStart, Found);
+		const int32 Close = Open == INDEX_NONE ? INDEX_NONE : Text.Find(TEXT(")"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open);
+		if (Close == INDEX_NONE || !Text.Mid(Found, Open - Found).TrimEnd().EndsWith(TEXT("MODULE")))
+		{
+			continue;
+		}
+
+		const int32 Comma = Text.Find(TEXT(","), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open);
+		if (Comma == INDEX_NONE || Comma > Close)
+		{
+			continue;
+		}
+
+		int32 NameBegin = Comma + 1;
+		while (NameBegin < Close && FChar::IsWhitespace(Text[NameBegin])) ++NameBegin;
+		int32 NameEnd = Close;
+		while (NameEnd > NameBegin && FChar::IsWhitespace(Text[NameEnd - 1])) --NameEnd;
+
+		if (Text.Mid(NameBegin, NameEnd - NameBegin) == From)
+		{
+			return NameBegin;
+		}
+	}
+}
+
+// 模块加载类调用：LoadModule* / GetModule* / IsModuleLoaded，或 FModuleManager 的任意静态 / Get() 成员函数
+static bool IsModuleLoadCall(const FString& Text, int32 NameBegin, int32 NameEnd)
+{
+	const FString Name = Text.Mid(NameBegin, NameEnd - NameBegin);
+	if (Name.StartsWith(TEXT("LoadModule")) || Name.StartsWith(TEXT("GetModule")) || Name == TEXT("IsModuleLoaded"))
+	{
+		return true;
+	}
+
+	const FString Before = Text.Mid(FMath::Max(0, NameBegin - 48), FMath::Min(NameBegin, 48)).Replace(TEXT(" "), TEXT("")).Replace(TEXT("\t"), TEXT(""));
+	return Before.EndsWith(TEXT("FModuleManager::")) || Before.EndsWith(TEXT("FModuleManager::Get().")) || Before.EndsWith(TEXT("FModuleManager::Get()->"));
+}
+
+// Quote 为引号的下标：作为模块加载类调用第一个参数的 "From" / TEXT("From")
+static bool IsModuleLoadArgumentAt(const FString& Text, int32 Quote)
+{
+	// TEXT( 包裹
+	int32 Pos = SkipWhitespaceBack(Text, Quote);
+	if (Pos >= 4 && Text[Pos] == TEXT('(') && Text.Mid(Pos - 4, 4) == TEXT("TEXT") && (Pos == 4 || !IsIdentifierChar(Text[Pos - 5])))
+	{
+		Pos = SkipWhitespaceBack(Text, Pos - 4);
+	}
+	if (Pos < 0 || Text[Pos] != TEXT('('))
+	{
+		return false;
+	}
+
+	// 模板参数 <IFooModule>
+	Pos = SkipWhitespaceBack(Text, Pos);
+	if (Pos >= 0 && Text[Pos] == TEXT('>'))
+	{
+		int32 Depth = 0;
+		for (; Pos >= 0; --Pos)
+		{
+			Depth += Text[Pos] == TEXT('>') ? 1 : Text[Pos] == TEXT('<') ? -1 : 0;
+			if (Depth == 0)
+			{
+				break;
+			}
+		}
+		Pos = SkipWhitespaceBack(Text, Pos);
+	}
+
+	const int32 NameEnd = Pos + 1;
+	int32 NameBegin = NameEnd;
+	while (NameBegin > 0 && IsIdentifierChar(Text[NameBegin - 1])) --NameBegin;
+	return NameBegin < NameEnd && IsModuleLoadCall(Text, NameBegin, NameEnd);
+}
+
+// 从 Search 起规则的下一处命中；返回 From 在 Text 中的起点，改写时替换的正是这 From.Len() 个字符
+static int32 FindRuleMatch(const FString& Text, ETextRewriteKind Kind, const FString& From, int32 Search)
+{
+	if (From.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+	if (Kind == ETextRewriteKind::ImplementModuleName)
+	{
+		return FindImplementModuleName(Text, From, Search);
+	}
+
+	while (true)
+	{
+		const int32 Found = Text.Find(From, ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+		if (Found == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+		Search = Found + From.Len();
+
+		const int32 End = Found + From.Len();
+		const bool bQuoted = Found > 0 && End < Text.Len() && Text[Found - 1] == TEXT('"') && Text[End] == TEXT('"');
+
+		bool bMatch = false;
+		switch (Kind)
+		{
+		case ETextRewriteKind::Identifier:          bMatch = IsWordAt(Text, Found, End); break;
+		case ETextRewriteKind::QuotedString:        bMatch = bQuoted; break;
+		case ETextRewriteKind::IncludePath:         bMatch = IsIncludePathAt(Text, Found, End); break;
+		case ETextRewriteKind::ModuleLoadArgument:  bMatch = bQuoted && IsModuleLoadArgumentAt(Text, Found - 1); break;
+		default: break;
+		}
+		if (bMatch)
+		{
+			return Found;
+		}
+	}
+}
+
+static bool ReplaceRuleMatches(FString& Text, ETextRewriteKind Kind, const FString& From, const FString& To)
+{
+	bool bReplaced = false;
+	int32 Search = 0;
+	while (true)
+	{
+		const int32 Found = FindRuleMatch(Text, Kind, From, Search);
+		if (Found == INDEX_NONE)
+		{
+			return bReplaced;
+		}
+		Text = Text.Left(Found) + To + Text.Mid(Found + From.Len());
+		Search = Found + To.Len();
+		bReplaced = true;
+	}
+}
+
+static bool ContainsBytes(const uint8* Data, int64 Size, const TArray<uint8>& Needle)
+{
+	if (Needle.Num() == 0)
+	{
+		return false;
+	}
+
+	const uint8 First = Needle[0];
+	for (int64 Pos = 0; Pos + Needle.Num() <= Size; ++Pos)
+	{
+		if (Data[Pos] == First && FMemory::Memcmp(Data + Pos, Needle.GetData(), Needle.Num()) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace SourceRewritePrivate
+
+bool FindModuleContainer(const FString& ModuleDir, FString& OutRoot, FString& OutDescriptor)
+{
+	FString Dir = FPaths::GetPath(ModuleDir);
+	while (!Dir.IsEmpty())
+	{
+		for (const TCHAR* Pattern : { TEXT("*.uplugin"), TEXT("*.uproject") })
+		{
+			TArray<FString> Found;
+			IFileManager::Get().FindFiles(Found, *(Dir / Pattern), true, false);
+			if (Found.Num() > 0)
+			{
+				OutRoot = Dir;
+				OutDescriptor = Dir / Found[0];
+				return true;
+			}
+		}
+
+		const FString Parent = FPaths::GetPath(Dir);
+		if (Parent == Dir)
+		{
+			break;
+		}
+		Dir = Parent;
+	}
+	return false;
+}
+
+void ReadDescriptorModuleEntry(const FString& DescriptorPath, const FString& ModuleName, FString& OutType, FString& OutLoadingPhase)
+{
+	OutType = TEXT("Runtime");
+	OutLoadingPhase = TEXT("Default");
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *DescriptorPath))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	const TArray<TSharedPtr<FJsonValue>>* Modules = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("Modules"), Modules) || !Modules)
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Modules)
+	{
+		const TSharedPtr<FJsonObject>* Obj = nullptr;
+		FString Name;
+		if (Value.IsValid() && Value->TryGetObject(Obj) && Obj && (*Obj)->TryGetStringField(TEXT("Name"), Name) && Name == ModuleName)
+		{
+			(*Obj)->TryGetStringField(TEXT("Type"), OutType);
+			(*Obj)->TryGetStringField(TEXT("LoadingPhase"), OutLoadingPhase);
+			return;
+		}
+	}
+}
+
+FString StripCodeComments(const FString& Text)
+{
+	FString Out;
+	Out.Reserve(Text.Len());
+
+	for (int32 Pos = 0; Pos < Text.Len(); ++Pos)
+	{
+		const TCHAR C = Text[Pos];
+		const TCHAR Next = Pos + 1 < Text.Len() ? Text[Pos + 1] : TEXT('\0');
+
+		if (C == TEXT('/') && Next == TEXT('/'))
+		{
+			while (Pos < Text.Len() && Text[Pos] != TEXT('\n')) ++Pos;
+			Out.AppendChar(TEXT('\n'));
+		}
+		else if (C == TEXT('/') && Next == TEXT('*'))
+		{
+			const int32 End = Text.Find(TEXT("*/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos + 2);
+			Pos = End == INDEX_NONE ? Text.Len() : End + 1;
+			Out.AppendChar(TEXT(' '));
+		}
+		else if (C == TEXT('"'))
+		{
+			Out.AppendChar(C);
+			for (++Pos; Pos < Text.Len() && Text[Pos] != TEXT('"'); ++Pos)
+			{
+				if (Text[Pos] == TEXT('\\') && Pos + 1 < Text.Len())
+				{
+					Out.AppendChar(Text[Pos++]);
+				}
+				Out.AppendChar(Text[Pos]);
+			}
+			if (Pos < Text.Len())
+			{
+				Out.AppendChar(Text[Pos]);
+			}
+		}
+		else
+		{
+			Out.AppendChar(C);
+		}
+	}
+	return Out;
+}
+
+FString FindModuleFunctionBody(const FString& Text, const TCHAR* Function)
+{
+	const FString Code = StripCodeComments(Text);
+
+	FString Body;
+	int32 Search = 0;
+	while (true)
+	{
+		const int32 Found = Code.Find(Function, ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+		if (Found == INDEX_NONE)
+		{
+			break;
+		}
+		Search = Found + FCString::Strlen(Function);
+
+		const int32 Close = Code.Find(TEXT(")"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+		if (Close == INDEX_NONE)
+		{
+			break;
+		}
+
+		// 跳过 override / const，只看紧跟的函数体
+		int32 Pos = Close + 1;
+		while (Pos < Code.Len() && (FChar::IsWhitespace(Code[Pos]) || FChar::IsAlpha(Code[Pos]))) ++Pos;
+		if (Pos >= Code.Len() || Code[Pos] != TEXT('{'))
+		{
+			continue;
+		}
+
+		int32 Depth = 0;
+		const int32 BodyBegin = Pos + 1;
+		for (; Pos < Code.Len(); ++Pos)
+		{
+			Depth += Code[Pos] == TEXT('{') ? 1 : (Code[Pos] == TEXT('}') ? -1 : 0);
+			if (Depth == 0)
+			{
+				break;
+			}
+		}
+
+		const FString Part = Code.Mid(BodyBegin, Pos - BodyBegin).TrimStartAndEnd();
+		if (!Part.IsEmpty())
+		{
+			Body += Body.IsEmpty() ? Part : TEXT("\n") + Part;
+		}
+	}
+	return Body;
+}
+
+bool HasModuleLifecycleCode(const FString& Text)
+{
+	return !FindModuleFunctionBody(Text, TEXT("StartupModule")).IsEmpty() || !FindModuleFunctionBody(Text, TEXT("ShutdownModule")).IsEmpty();
+}
+
+ELoadingPhase::Type ParseLoadingPhase(const FString& Phase)
+{
+	const ELoadingPhase::Type Parsed = ELoadingPhase::FromString(*Phase);
+	return Parsed == ELoadingPhase::Max ? ELoadingPhase::Default : Parsed;
+}
+
+void FindReflectedTypes(const FString& Text, TArray<TPair<FString, FString>>& OutTypes)
+{
+	static const TPair<const TCHAR*, const TCHAR*> Macros[] =
+	{
+		{ TEXT("UCLASS"),     TEXT("ClassRedirects") },
+		{ TEXT("UINTERFACE"), TEXT("ClassRedirects") },
+		{ TEXT("USTRUCT"),    TEXT("StructRedirects") },
+		{ TEXT("UENUM"),      TEXT("EnumRedirects") },
+	};
+
+	for (const TPair<const TCHAR*, const TCHAR*>& Macro : Macros)
+	{
+		const int32 MacroLen = FCString::Strlen(Macro.Key);
+
+		int32 Search = 0;
+		while (true)
+		{
+			const int32 Found = Text.Find(Macro.Key, ESearchCase::CaseSensitive, ESearchDir::FromStart, Search);
+			if (Found == INDEX_NONE)
+			{
+				break;
+			}
+			Search = Found + MacroLen;
+
+			// 只认行首的宏，注释和字符串里的不算
+			int32 Before = Found;
+			while (Before > 0 && (Text[Before - 1] == TEXT(' ') || Text[Before - 1] == TEXT('\t')))
+			{
+				--Before;
+			}
+			if (Before > 0 && Text[Before - 1] != TEXT('\n'))
+			{
+				continue;
+			}
+
+			int32 Pos = Search;
+			while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos])) ++Pos;
+			if (Pos >= Text.Len() || Text[Pos] != TEXT('('))
+			{
+				continue;
+			}
+
+			int32 Depth = 0;
+			for (; Pos < Text.Len(); ++Pos)
+			{
+				Depth += Text[Pos] == TEXT('(') ? 1 : (Text[Pos] == TEXT(')') ? -1 : 0);
+				if (Depth == 0)
+				{
+					break;
+				}
+			}
+
+			// 最后一个标识符即类型名：跳过 class / struct / enum 与 XXX_API
+			FString Name;
+			for (++Pos; Pos < Text.Len(); )
+			{
+				const TCHAR C = Text[Pos];
+				if (C == TEXT(':') || C == TEXT('{') || C == TEXT(';'))
+				{
+					break;
+				}
+				if (!SourceRewritePrivate::IsIdentifierChar(C))
+				{
+					++Pos;
+					continue;
+				}
+
+				const int32 Begin = Pos;
+				while (Pos < Text.Len() && SourceRewritePrivate::IsIdentifierChar(Text[Pos])) ++Pos;
+				const FString Token = Text.Mid(Begin, Pos - Begin);
+				if (Token != TEXT("class") && Token != TEXT("struct") && Token != TEXT("enum") && !Token.EndsWith(TEXT("_API")))
+				{
+					Name = Token;
+				}
+			}
+
+			if (Name.Len() < 2)
+			{
+				continue;
+			}
+
+			// 反射名不含 U / A / F 前缀，枚举保留原名
+			if (FCString::Strcmp(Macro.Value, TEXT("EnumRedirects")) != 0
+				&& (Name[0] == TEXT('U') || Name[0] == TEXT('A') || Name[0] == TEXT('F')) && FChar::IsUpper(Name[1]))
+			{
+				Name.RightChopInline(1);
+			}
+			OutTypes.AddUnique({ Macro.Value, Name });
+		}
+	}
+}
+
+bool ReplaceIdentifier(FString& Text, const FString& From, const FString& To)
+{
+	return SourceRewritePrivate::ReplaceRuleMatches(Text, ETextRewriteKind::Identifier, From, To);
+}
+
+FString AddCoreRedirects(const FString& IniText, const TArray<FString>& Lines)
+{
+	const FString Eol = IniText.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+
+	FString Insert;
+	for (const FString& Line : Lines)
+	{
+		if (!IniText.Contains(Line))
+		{
+			Insert += Line + Eol;
+		}
+	}
+	if (Insert.IsEmpty())
+	{
+		return IniText;
+	}
+
+	const int32 Section = IniText.Find(TEXT("[CoreRedirects]"), ESearchCase::IgnoreCase);
+	if (Section == INDEX_NONE)
+	{
+		FString Text = IniText;
+		if (!Text.IsEmpty())
+		{
+			Text += Text.EndsWith(TEXT("\n")) ? Eol : Eol + Eol;
+		}
+		return Text + TEXT("[CoreRedirects]") + Eol + Insert;
+	}
+
+	int32 LineEnd = IniText.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Section);
+	if (LineEnd == INDEX_NONE)
+	{
+		return IniText + Eol + Insert;
+	}
+	return IniText.Left(LineEnd + 1) + Insert + IniText.Mid(LineEnd + 1);
+}
+
+FPendingTextEdit* FindOrLoadPendingEdit(TArray<FPendingTextEdit>& Edits, const FString& Path, bool bAllowMissing, TArray<FString>& OutErrors)
+{
+	if (FPendingTextEdit* Existing = Edits.FindByPredicate([&Path](const FPendingTextEdit& Edit) { return Edit.Path == Path; }))
+	{
+		return Existing;
+	}
+
+	FPendingTextEdit Added;
+	Added.Path = Path;
+	const bool bMissing = bAllowMissing && !FPaths::FileExists(Path);
+	if (!bMissing && !LoadTextPreservingEncoding(Path, Added.OldText, Added.bHasBom))
+	{
+		OutErrors.Add(TEXT("读取失败：") + Path);
+		return nullptr;
+	}
+	Added.NewText = Added.OldText;
+	return &Edits.Add_GetRef(MoveTemp(Added));
+}
+
+FString MakePendingDiff(const TArray<FPendingTextEdit>& Edits)
+{
+	FString Diff;
+	for (const FPendingTextEdit& Edit : Edits)
+	{
+		Diff += MakeUnifiedDiff(Edit.Path, Edit.OldText, Edit.NewText);
+	}
+	return Diff;
+}
+
+void SavePendingEdits(const TArray<FPendingTextEdit>& Edits, TArray<FString>& OutErrors)
+{
+	for (const FPendingTextEdit& Edit : Edits)
+	{
+		if (Edit.IsChanged() && !SaveTextPreservingEncoding(Edit.Path, Edit.NewText, Edit.bHasBom))
+		{
+			OutErrors.Add(TEXT("写入失败：") + Edit.Path);
+		}
+	}
+}
+
+bool StagePendingEdits(FModuleStagingArea& Staging, const TArray<FPendingTextEdit>& Edits, FString& OutError)
+{
+	for (const FPendingTextEdit& Edit : Edits)
+	{
+		if (!Edit.IsChanged())
+		{
+			continue;
+		}
+
+		// FindOrLoadPendingEdit 允许缺失的文件按新文件处理
+		if (!FPaths::FileExists(Edit.Path))
+		{
+			if (!Edit.OldText.IsEmpty())
+			{
+				OutError = TEXT("文件在读取后被删除：") + Edit.Path;
+				return false;
+			}
+			if (!Staging.AddNewFile(Edit.Path, Edit.NewText, OutError))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		FString* Staged = Staging.EditFile(Edit.Path, OutError);
+		if (!Staged)
+		{
+			return false;
+		}
+		if (!Staged->Equals(Edit.OldText, ESearchCase::CaseSensitive))
+		{
+			OutError = TEXT("文件在读取后被修改过，请重新生成方案：") + Edit.Path;
+			return false;
+		}
+		*Staged = Edit.NewText;
+	}
+	return true;
+}
+
+bool ApplyRewriteRules(const FString& Path, const FString& InText, const TArray<FTextRewriteRule>& Rules, FString& OutText, TArray<int32>& OutHits)
+{
+	using namespace SourceRewritePrivate;
+
+	OutText = InText;
+	OutHits.Reset();
+
+	for (int32 Index = 0; Index < Rules.Num(); ++Index)
+	{
+		const FTextRewriteRule& Rule = Rules[Index];
+		if (!IsRuleInScope(Path, Rule))
+		{
+			continue;
+		}
+
+		if (ReplaceRuleMatches(OutText, Rule.Kind, Rule.From, Rule.To))
+		{
+			OutHits.Add(Index);
+		}
+	}
+
+	return !OutText.Equals(InText, ESearchCase::CaseSensitive);
+}
+
+void MatchRewriteRules(const FString& Path, const FString& Text, const TArray<FTextRewriteRule>& Rules, TArray<int32>& OutHits)
+{
+	using namespace SourceRewritePrivate;
+
+	OutHits.Reset();
+	for (int32 Index = 0; Index < Rules.Num(); ++Index)
+	{
+		const FTextRewriteRule& Rule = Rules[Index];
+		if (IsRuleInScope(Path, Rule) && FindRuleMatch(Text, Rule.Kind, Rule.From, 0) != INDEX_NONE)
+		{
+			OutHits.Add(Index);
+		}
+	}
+}
+
+void CollectRewritableFiles(const TArray<FString>& Dirs, TArray<FString>& OutFiles)
+{
+	using namespace SourceRewritePrivate;
+
+	for (const FString& Dir : Dirs)
+	{
+		TArray<FString> Paths;
+		IFileManager::Get().FindFilesRecursive(Paths, *Dir, TEXT("*.*"), true, false);
+		for (FString& Path : Paths)
+		{
+			if (IsCodeFile(Path) || IsScriptFile(Path) || Path.EndsWith(TEXT(".uplugin")) || Path.EndsWith(TEXT(".uproject")))
+			{
+				OutFiles.Add(MoveTemp(Path));
+			}
+		}
+	}
+}
+
+namespace SourceRewritePrivate
+{
+
+// bRewrite 为 false 时只记录命中的规则，不生成改写后的文本，也不保留文件内容
+static void ScanFiles(const TArray<FString>& Files, const TArray<FTextRewriteRule>& Rules, bool bRewrite, TArray<FRewrittenFile>& OutFiles, FRewriteScanStats& OutStats)
+{
+
+	const double StartTime = FPlatformTime::Seconds();
+	OutStats = FRewriteScanStats();
+	OutStats.Files = Files.Num();
+
+	// 规则原文的 UTF-8 字节；文件里没有任何一条就不必解码
+	TArray<TArray<uint8>> Needles;
+	for (const FTextRewriteRule& Rule : Rules)
+	{
+		const FTCHARToUTF8 Converter(*Rule.From);
+		Needles.Emplace(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	struct FFileResult
+	{
+		int64 Bytes = 0;
+		bool bMapped = false;
+		bool bCandidate = false;
+		bool bChanged = false;
+		FRewrittenFile File;
+	};
+
+	TArray<FFileResult> Results;
+	Results.SetNum(Files.Num());
+
+	ParallelFor(Files.Num(), [&Files, &Rules, &Needles, &Results, bRewrite](int32 Index)
+	{
+		const FString& Path = Files[Index];
+		FFileResult& Result = Results[Index];
+
+		TArray<int32> InScope;
+		for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+		{
+			if (IsRuleInScope(Path, Rules[RuleIndex]))
+			{
+				InScope.Add(RuleIndex);
+			}
+		}
+		if (InScope.Num() == 0)
+		{
+			return;
+		}
+
+		// 映射整个文件，只读不复制；不支持映射时回退为普通读取
+		TArray<uint8> Buffer;
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+
+		FOpenMappedResult Mapped = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+		if (Mapped.HasValue())
+		{
+			Handle = Mapped.StealValue();
+			Size = Handle->GetFileSize();
+			if (Size > 0)
+			{
+				Region.Reset(Handle->MapRegion(0, Size));
+			}
+		}
+
+		if (Region)
+		{
+			Data = Region->GetMappedPtr();
+			Result.bMapped = true;
+		}
+		else
+		{
+			if (!FFileHelper::LoadFileToArray(Buffer, *Path) || Buffer.Num() == 0)
+			{
+				return;
+			}
+			Data = Buffer.GetData();
+			Size = Buffer.Num();
+		}
+		Result.Bytes = Size;
+
+		// UTF-16 文件字节里没有连续的 ASCII 原文，总是解码
+		bool bCandidate = Size >= 2 && ((Data[0] == 0xFF && Data[1] == 0xFE) || (Data[0] == 0xFE && Data[1] == 0xFF));
+		for (int32 RuleIndex : InScope)
+		{
+			if (bCandidate)
+			{
+				break;
+			}
+			bCandidate = ContainsBytes(Data, Size, Needles[RuleIndex]);
+		}
+		if (!bCandidate)
+		{
+			return;
+		}
+		Result.bCandidate = true;
+
+		FPendingTextEdit& Edit = Result.File.Edit;
+		Edit.Path = Path;
+		Edit.bHasBom = Size >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF;
+		FFileHelper::BufferToString(Edit.OldText, Data, static_cast<int32>(Size));
+		if (bRewrite)
+		{
+			Result.bChanged = ApplyRewriteRules(Path, Edit.OldText, Rules, Edit.NewText, Result.File.Rules);
+		}
+		else
+		{
+			MatchRewriteRules(Path, Edit.OldText, Rules, Result.File.Rules);
+			Edit.OldText.Empty();
+		}
+	});
+
+	for (FFileResult& Result : Results)
+	{
+		OutStats.Bytes += Result.Bytes;
+		OutStats.MappedFiles += Result.bMapped ? 1 : 0;
+		OutStats.Candidates += Result.bCandidate ? 1 : 0;
+		OutStats.Changed += Result.bChanged ? 1 : 0;
+
+		if (Result.File.Rules.Num() > 0)
+		{
+			OutFiles.Add(MoveTemp(Result.File));
+		}
+	}
+
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+} // namespace SourceRewritePrivate
+
+void RewriteFiles(const TArray<FString>& Files, const TArray<FTextRewriteRule>& Rules, TArray<FRewrittenFile>& OutFiles, FRewriteScanStats& OutStats)
+{
+	SourceRewritePrivate::ScanFiles(Files, Rules, true, OutFiles, OutStats);
+}
+
+void MatchFiles(const TArray<FString>& Files, const TArray<FTextRewriteRule>& Rules, TArray<FRuleMatchedFile>& OutFiles, FRewriteScanStats& OutStats)
+{
+	TArray<FRewrittenFile> Scanned;
+	SourceRewritePrivate::ScanFiles(Files, Rules, false, Scanned, OutStats);
+
+	OutFiles.Reserve(OutFiles.Num() + Scanned.Num());
+	for (FRewrittenFile& File : Scanned)
+	{
+		OutFiles.Add({ MoveTemp(File.Edit.Path), MoveTemp(File.Rules) });
+	}
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,279 @@
+#include "StartupProfiler.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "Interfaces/IProjectManager.h"
+#include "Misc/App.h"
+#include "ProjectDescriptor.h"
+
+namespace StartupProfilerPrivate
+{
+
+// 回归：比之前的中位数至少多这么多，且超过一定比例
+static constexpr double GRegressionMinMs = 5.0;
+static constexpr double GRegressionRatio = 1.25;
+
+// 阶段窗口的变化超过该比例时标出
+static constexpr double GPhaseChangeRatio = 0.1;
+
+static double Median(TArray<double> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return -1.0;
+	}
+	Values.Sort();
+	const int32 Middle = Values.Num() / 2;
+	return Values.Num() % 2 == 1 ? Values[Middle] : (Values[Middle - 1] + Values[Middle]) * 0.5;
+}
+
+static FString FormatMs(double Milliseconds, bool bUpperBound = false)
+{
+	return FString::Printf(TEXT("%s%.1f ms"), bUpperBound ? TEXT("≤") : TEXT(""), Milliseconds);
+}
+
+static FString FormatChange(double Current, double Baseline)
+{
+	if (Baseline <= 0.0)
+	{
+		return FString();
+	}
+	return FString::Printf(TEXT("（%+.0f%%）"), (Current / Baseline - 1.0) * 100.0);
+}
+
+static FString FormatSample(const FModuleLoadSample& Sample)
+{
+	if (Sample.MapMilliseconds < 0.0)
+	{
+		return FormatMs(Sample.Milliseconds, Sample.bUpperBound);
+	}
+	return FString::Printf(TEXT("%s = 映射 %s + StartupModule %s"),
+		*FormatMs(Sample.Milliseconds, Sample.bUpperBound), *FormatMs(Sample.MapMilliseconds, Sample.bUpperBound), *FormatMs(Sample.StartupMilliseconds));
+}
+
+} // namespace StartupProfilerPrivate
+
+double FStartupModuleProfile::GetIncreaseMs() const
+{
+	if (BaselineStartupMs >= 0.0 && Sample.StartupMilliseconds >= 0.0)
+	{
+		return Sample.StartupMilliseconds - BaselineStartupMs;
+	}
+	return BaselineMs >= 0.0 ? Sample.Milliseconds - BaselineMs : 0.0;
+}
+
+bool FStartupModuleProfile::IsRegression() const
+{
+	using namespace StartupProfilerPrivate;
+
+	const bool bByStartup = BaselineStartupMs >= 0.0 && Sample.StartupMilliseconds >= 0.0;
+	const double Baseline = bByStartup ? BaselineStartupMs : BaselineMs;
+	const double Current = bByStartup ? Sample.StartupMilliseconds : Sample.Milliseconds;
+
+	// 含阶段切换的样本只是上限，不用来判断回归
+	return Baseline >= 0.0 && !Sample.bUpperBound
+		&& Current - Baseline >= GRegressionMinMs && Current >= Baseline * GRegressionRatio;
+}
+
+namespace ModuleBuilder
+{
+
+TMap<FString, FString> GetProjectAndPluginModules()
+{
+	check(IsInGameThread());
+
+	TMap<FString, FString> Owners;
+
+	if (const FProjectDescriptor* Project = IProjectManager::Get().GetCurrentProject())
+	{
+		for (const FModuleDescriptor& Module : Project->Modules)
+		{
+			Owners.Add(Module.Name.ToString(), FApp::GetProjectName());
+		}
+	}
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+	{
+		for (const FModuleDescriptor& Module : Plugin->GetDescriptor().Modules)
+		{
+			Owners.FindOrAdd(Module.Name.ToString(), Plugin->GetName());
+		}
+	}
+	return Owners;
+}
+
+void AnalyzeStartupProfile(const FString& HistoryPath, const TMap<FString, FString>& ModuleOwners, FStartupProfile& OutProfile)
+{
+	using namespace StartupProfilerPrivate;
+
+	OutProfile = FStartupProfile();
+	if (!FModuleLoadRecorder::LoadHistory(HistoryPath, OutProfile.History) || OutProfile.History.Num() == 0)
+	{
+		return;
+	}
+
+	const FModuleLoadSession& Latest = OutProfile.History.Last();
+	const int32 PreviousSessions = OutProfile.History.Num() - 1;
+
+	for (const FModuleLoadSample& Sample : Latest.Samples)
+	{
+		const FString* Owner = ModuleOwners.Find(Sample.ModuleName);
+		if (!Owner)
+		{
+			continue;
+		}
+
+		FStartupModuleProfile& Profile = OutProfile.Modules.AddDefaulted_GetRef();
+		Profile.ModuleName = Sample.ModuleName;
+		Profile.Owner = *Owner;
+		Profile.Sample = Sample;
+
+		// 之前各次启动中本模块的耗时；上限样本不进入基线
+		TArray<double> Totals;
+		TArray<double> Startups;
+		for (int32 Index = 0; Index < PreviousSessions; ++Index)
+		{
+			const FModuleLoadSample* Previous = OutProfile.History[Index].FindSample(Sample.ModuleName);
+			if (!Previous || Previous->bUpperBound)
+			{
+				continue;
+			}
+			Totals.Add(Previous->Milliseconds);
+			if (Previous->StartupMilliseconds >= 0.0)
+			{
+				Startups.Add(Previous->StartupMilliseconds);
+			}
+		}
+
+		Profile.BaselineSessions = Totals.Num();
+		Profile.BaselineMs = Median(Totals);
+		Profile.BaselineStartupMs = Median(Startups);
+	}
+
+	OutProfile.Modules.Sort([](const FStartupModuleProfile& A, const FStartupModuleProfile& B)
+	{
+		return A.Sample.Milliseconds > B.Sample.Milliseconds;
+	});
+}
+
+FString FormatStartupProfileReport(const FStartupProfile& Profile, const FString& OnlyModule)
+{
+	using namespace StartupProfilerPrivate;
+
+	const FModuleLoadSession* Latest = Profile.GetLatest();
+	if (!Latest)
+	{
+		return TEXT("还没有启动记录。重新启动编辑器后，每次启动的模块加载耗时会自动记录到 Intermediate/ModuleBuilder。\n");
+	}
+
+	const int32 PreviousSessions = Profile.History.Num() - 1;
+
+	// 单个模块：列出历次启动
+	if (!OnlyModule.IsEmpty())
+	{
+		FString Report = FString::Printf(TEXT("== %s 的历次启动耗时 ==\n"), *OnlyModule);
+		bool bFound = false;
+		for (const FModuleLoadSession& Session : Profile.History)
+		{
+			const FModuleLoadSample* Sample = Session.FindSample(OnlyModule);
+			if (Sample)
+			{
+				bFound = true;
+				Report += FString::Printf(TEXT("  %s（%s）：%s\n"), *Session.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M")), *Sample->Phase, *FormatSample(*Sample));
+			}
+			else
+			{
+				Report += FString::Printf(TEXT("  %s：未加载或在记录开始前加载\n"), *Session.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M")));
+			}
+		}
+		return bFound ? Report : TEXT("启动记录中没有模块：") + OnlyModule + TEXT("\n");
+	}
+
+	FString Report = TEXT("== 编辑器启动耗时 ==\n");
+	Report += FString::Printf(TEXT("  最近一次启动 %s：%.2f 秒，记录 %d 个模块（工程 / 插件模块 %d 个），记录开始前已加载 %d 个\n"),
+		*Latest->Timestamp.ToString(TEXT("%Y-%m-%d %H:%M")), Latest->BootSeconds, Latest->Samples.Num(), Profile.Modules.Num(), Latest->PreloadedModules.Num());
+	Report += FString::Printf(TEXT("  与之前 %d 次启动的中位数对比\n"), PreviousSessions);
+	Report += TEXT("  映射 = 映射动态库与静态初始化；StartupModule 不含其中嵌套加载的模块；≤ 表示前面隔着阶段切换，只能作为上限\n");
+
+	// 加载阶段窗口
+	Report += TEXT("\n== 加载阶段 ==\n");
+	for (const FModuleLoadPhaseTime& Phase : Latest->Phases)
+	{
+		TArray<double> Previous;
+		for (int32 Index = 0; Index < PreviousSessions; ++Index)
+		{
+			if (const FModuleLoadPhaseTime* Found = Profile.History[Index].FindPhase(Phase.Phase))
+			{
+				Previous.Add(Found->Seconds);
+			}
+		}
+		const double Baseline = Median(Previous);
+
+		double OwnedMs = 0.0;
+		int32 Owned = 0;
+		for (const FStartupModuleProfile& Module : Profile.Modules)
+		{
+			if (Module.Sample.Phase == Phase.Phase)
+			{
+				OwnedMs += Module.Sample.Milliseconds;
+				++Owned;
+			}
+		}
+
+		const bool bChanged = Baseline > 0.0 && FMath::Abs(Phase.Seconds / Baseline - 1.0) >= GPhaseChangeRatio;
+		Report += FString::Printf(TEXT("  %s：%.2f 秒%s，%d 个模块，其中工程 / 插件模块 %d 个共 %s%s\n"),
+			*Phase.Phase, Phase.Seconds, Baseline >= 0.0 ? *FString::Printf(TEXT("（之前 %.2f 秒）"), Baseline) : TEXT(""),
+			Phase.Modules, Owned, *FormatMs(OwnedMs), bChanged ? *FormatChange(Phase.Seconds, Baseline) : TEXT(""));
+	}
+
+	// 回归
+	TArray<const FStartupModuleProfile*> Regressions;
+	for (const FStartupModuleProfile& Module : Profile.Modules)
+	{
+		if (Module.IsRegression())
+		{
+			Regressions.Add(&Module);
+		}
+	}
+	Regressions.Sort([](const FStartupModuleProfile& A, const FStartupModuleProfile& B) { return A.GetIncreaseMs() > B.GetIncreaseMs(); });
+
+	Report += FString::Printf(TEXT("\n== 变慢的模块（比之前中位数多 %.0f%% 且至少 %.0f ms）==\n"), (GRegressionRatio - 1.0) * 100.0, GRegressionMinMs);
+	if (Regressions.Num() == 0)
+	{
+		Report += PreviousSessions > 0 ? TEXT("  无\n") : TEXT("  只有一次启动记录，下次启动后可以对比\n");
+	}
+	for (const FStartupModuleProfile* Module : Regressions)
+	{
+		Report += FString::Printf(TEXT("  %s（%s，%s）：%s，之前 %s，多 %s\n"),
+			*Module->ModuleName, *Module->Owner, *Module->Sample.Phase, *FormatSample(Module->Sample),
+			*FormatMs(Module->BaselineStartupMs >= 0.0 && Module->Sample.StartupMilliseconds >= 0.0 ? Module->BaselineStartupMs : Module->BaselineMs),
+			*FormatMs(Module->GetIncreaseMs()));
+	}
+
+	// 全部工程 / 插件模块
+	Report += TEXT("\n== 工程 / 插件模块（按本次耗时）==\n");
+	for (const FStartupModuleProfile& Module : Profile.Modules)
+	{
+		Report += FString::Printf(TEXT("  %s（%s，%s）：%s"), *Module.ModuleName, *Module.Owner, *Module.Sample.Phase, *FormatSample(Module.Sample));
+		if (Module.BaselineMs >= 0.0)
+		{
+			Report += FString::Printf(TEXT("；之前 %s%s"), *FormatMs(Module.BaselineMs), *FormatChange(Module.Sample.Milliseconds, Module.BaselineMs));
+		}
+		Report += TEXT("\n");
+	}
+
+	// 历次启动
+	Report += TEXT("\n== 历次启动 ==\n");
+	for (const FModuleLoadSession& Session : Profile.History)
+	{
+		TArray<FString> Phases;
+		for (const FModuleLoadPhaseTime& Phase : Session.Phases)
+		{
+			Phases.Add(FString::Printf(TEXT("%s %.2f"), *Phase.Phase, Phase.Seconds));
+		}
+		Report += FString::Printf(TEXT("  %s：%.2f 秒；%s\n"),
+			*Session.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M")), Session.BootSeconds, *FString::Join(Phases, TEXT("，")));
+	}
+	return Report;
+}
+
+} // namespace ModuleBuilder
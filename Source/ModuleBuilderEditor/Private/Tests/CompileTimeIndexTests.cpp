@@ -0,0 +1,106 @@
+#include "CompileTimeIndex.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompileTimeTraceTest, "ModuleBuilder.CompileTime.ParseTimeTrace",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCompileTimeTraceTest::RunTest(const FString& Parameters)
+{
+	const FString Trace = TEXT(R"({"traceEvents":[
+		{"ph":"X","name":"Source","dur":3000,"args":{"detail":"/Proj/Source/Mod/Public/A.h"}},
+		{"ph":"X","name":"Source","dur":2000,"args":{"detail":"/Proj/Source/Mod/Private/../Public/A.h"}},
+		{"ph":"X","name":"Source","dur":200,"args":{"detail":"/Eng/Source/Runtime/Small.h"}},
+		{"ph":"X","name":"Source","dur":3000,"args":{"detail":"/Eng/Source/Runtime/Large.h"}},
+		{"ph":"i","name":"Source","dur":9000,"args":{"detail":"/Proj/Source/Mod/Public/Instant.h"}},
+		{"ph":"X","name":"ExecuteCompiler","dur":11000},
+		{"ph":"X","name":"Total Frontend","dur":8000},
+		{"ph":"X","name":"Total Backend","dur":2000},
+		{"ph":"X","name":"Total ExecuteCompiler","dur":10500}
+	],"beginningOfTime":0})");
+
+	FCompileTimeUnit Unit;
+	if (!TestTrue(TEXT("解析追踪"), FCompileTimeIndex::ParseTimeTrace(Trace, TEXT("/Proj/"), Unit)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("前端"), Unit.FrontendMicros, int64(8000));
+	TestEqual(TEXT("后端"), Unit.BackendMicros, int64(2000));
+	TestEqual(TEXT("总耗时取 Total ExecuteCompiler"), Unit.TotalMicros, int64(10500));
+
+	// 同一头文件的多次解析合并；工程外耗时小的丢弃；按耗时降序
+	if (TestEqual(TEXT("保留的头文件"), Unit.Includes.Num(), 2))
+	{
+		TestEqual(TEXT("工程内头文件"), Unit.Includes[0].Path, FString(TEXT("/Proj/Source/Mod/Public/A.h")));
+		TestEqual(TEXT("合并耗时"), Unit.Includes[0].Micros, int64(5000));
+		TestEqual(TEXT("工程外耗时大的头文件"), Unit.Includes[1].Path, FString(TEXT("/Eng/Source/Runtime/Large.h")));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompileTimeTraceFallbackTest, "ModuleBuilder.CompileTime.ParseTimeTraceFallback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCompileTimeTraceFallbackTest::RunTest(const FString& Parameters)
+{
+	// 没有 Total ExecuteCompiler 时取最长的 ExecuteCompiler
+	FCompileTimeUnit Unit;
+	TestTrue(TEXT("解析追踪"), FCompileTimeIndex::ParseTimeTrace(TEXT(R"({"traceEvents":[
+		{"ph":"X","name":"ExecuteCompiler","dur":4000},
+		{"ph":"X","name":"ExecuteCompiler","dur":7000},
+		{"ph":"X","name":"Total Frontend","dur":5000}
+	]})"), TEXT("/Proj/"), Unit));
+	TestEqual(TEXT("总耗时"), Unit.TotalMicros, int64(7000));
+
+	// 两者都没有时为前端 + 后端
+	FCompileTimeUnit Sum;
+	TestTrue(TEXT("解析追踪"), FCompileTimeIndex::ParseTimeTrace(TEXT(R"({"traceEvents":[
+		{"ph":"X","name":"Total Frontend","dur":5000},
+		{"ph":"X","name":"Total Backend","dur":1000}
+	]})"), TEXT("/Proj/"), Sum));
+	TestEqual(TEXT("总耗时"), Sum.TotalMicros, int64(6000));
+
+	// 其他 JSON 不是追踪
+	FCompileTimeUnit Other;
+	TestFalse(TEXT("非追踪 JSON"), FCompileTimeIndex::ParseTimeTrace(TEXT(R"({"Version":"1.2","Data":{}})"), TEXT("/Proj/"), Other));
+	TestFalse(TEXT("损坏的追踪"), FCompileTimeIndex::ParseTimeTrace(TEXT(R"({"traceEvents":[)"), TEXT("/Proj/"), Other));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompileTimeDependencyListTest, "ModuleBuilder.CompileTime.ParseDependencyList",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCompileTimeDependencyListTest::RunTest(const FString& Parameters)
+{
+	// clang .d：续行、转义的空格，-MP 生成的空规则不读取
+	TArray<FString> Make;
+	TestTrue(TEXT("解析 .d"), FCompileTimeIndex::ParseDependencyList(
+		TEXT("Mod.cpp.o: /Proj/A.cpp \\\n  /Proj/My\\ Dir/B.h \\\r\n  C:/Eng/C.h\n\n/Proj/A.cpp:\n"), true, Make));
+	TestEqual(TEXT(".d 依赖"), Make, TArray<FString>({ TEXT("/Proj/A.cpp"), TEXT("/Proj/My Dir/B.h"), TEXT("C:/Eng/C.h") }));
+
+	// 目标带盘符时跳过盘符后的冒号
+	TArray<FString> Drive;
+	TestTrue(TEXT("解析带盘符的 .d"), FCompileTimeIndex::ParseDependencyList(TEXT("C:/Build/Mod.cpp.obj: C:/Src/A.cpp D:/X.h"), true, Drive));
+	TestEqual(TEXT("带盘符的 .d 依赖"), Drive, TArray<FString>({ TEXT("C:/Src/A.cpp"), TEXT("D:/X.h") }));
+
+	TArray<FString> NotMake;
+	TestFalse(TEXT("没有规则"), FCompileTimeIndex::ParseDependencyList(TEXT("C:/Src/A.cpp"), true, NotMake));
+
+	// MSVC .dep.json
+	TArray<FString> Json;
+	TestTrue(TEXT("解析 .dep.json"), FCompileTimeIndex::ParseDependencyList(
+		TEXT(R"({"Version":"1.2","Data":{"Source":"c:\\proj\\a.cpp","Includes":["c:\\proj\\a.h","c:\\eng\\b.h"]}})"), false, Json));
+	TestEqual(TEXT(".dep.json 依赖"), Json, TArray<FString>({ TEXT("c:\\proj\\a.h"), TEXT("c:\\eng\\b.h") }));
+
+	TArray<FString> NoIncludes;
+	TestFalse(TEXT("没有 Includes"), FCompileTimeIndex::ParseDependencyList(TEXT(R"({"Version":"1.2","Data":{}})"), false, NoIncludes));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,179 @@
+#include "DescriptorPatcher.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DescriptorPatcherTestsPrivate
+{
+
+static const TCHAR* GProjectDescriptor = TEXT(
+	"{\n"
+	"\t\"FileVersion\": 3,\n"
+	"\t\"Modules\": [\n"
+	"\t\t{\n"
+	"\t\t\t\"Name\": \"Game\",\n"
+	"\t\t\t\"Type\": \"Runtime\",\n"
+	"\t\t\t\"LoadingPhase\": \"Default\"\n"
+	"\t\t}\n"
+	"\t]\n"
+	"}\n");
+
+static FNewModuleParams MakeParams(const TCHAR* Name, const TCHAR* Type, const TCHAR* LoadingPhase)
+{
+	FNewModuleParams Params;
+	Params.ModuleName = Name;
+	Params.ModuleType = Type;
+	Params.LoadingPhase = LoadingPhase;
+	return Params;
+}
+
+// 修补后的文本必须仍是合法 JSON；返回 Modules 中的条目
+static bool ParseModules(FAutomationTestBase& Test, const FString& Text, TArray<TSharedPtr<FJsonObject>>& OutModules)
+{
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+	const TArray<TSharedPtr<FJsonValue>>* Modules = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("Modules"), Modules))
+	{
+		Test.AddError(TEXT("修补后的描述文件不是合法 JSON：") + Text);
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Modules)
+	{
+		OutModules.Add(Value->AsObject());
+	}
+	return true;
+}
+
+} // namespace DescriptorPatcherTestsPrivate
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDescriptorPatchTest, "ModuleBuilder.Descriptor.Patch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDescriptorPatchTest::RunTest(const FString& Parameters)
+{
+	using namespace DescriptorPatcherTestsPrivate;
+
+	const FString InText = GProjectDescriptor;
+	FString OutText;
+	FString Error;
+	if (!TestTrue(TEXT("追加模块"), ModuleBuilder::PatchDescriptorText(InText, { MakeParams(TEXT("NewMod"), TEXT("Editor"), TEXT("PostEngineInit")) }, OutText, Error)))
+	{
+		AddError(Error);
+		return false;
+	}
+
+	// 新条目沿用已有条目的缩进，其余字节不变
+	const FString Expected = TEXT(
+		"{\n"
+		"\t\"FileVersion\": 3,\n"
+		"\t\"Modules\": [\n"
+		"\t\t{\n"
+		"\t\t\t\"Name\": \"Game\",\n"
+		"\t\t\t\"Type\": \"Runtime\",\n"
+		"\t\t\t\"LoadingPhase\": \"Default\"\n"
+		"\t\t},\n"
+		"\t\t{\n"
+		"\t\t\t\"Name\": \"NewMod\",\n"
+		"\t\t\t\"Type\": \"Editor\",\n"
+		"\t\t\t\"LoadingPhase\": \"PostEngineInit\"\n"
+		"\t\t}\n"
+		"\t]\n"
+		"}\n");
+	TestEqual(TEXT("修补后的文本"), OutText, Expected);
+
+	TArray<TSharedPtr<FJsonObject>> Modules;
+	if (ParseModules(*this, OutText, Modules) && TestEqual(TEXT("模块数"), Modules.Num(), 2))
+	{
+		TestEqual(TEXT("新模块名"), Modules[1]->GetStringField(TEXT("Name")), FString(TEXT("NewMod")));
+	}
+
+	// 同名模块
+	TestFalse(TEXT("同名模块"), ModuleBuilder::PatchDescriptorText(InText, { MakeParams(TEXT("Game"), TEXT("Runtime"), TEXT("Default")) }, OutText, Error));
+	TestTrue(TEXT("错误中带模块名"), Error.Contains(TEXT("Game")));
+	TestFalse(TEXT("一批中重复的模块"), ModuleBuilder::PatchDescriptorText(InText,
+		{ MakeParams(TEXT("A"), TEXT("Runtime"), TEXT("Default")), MakeParams(TEXT("A"), TEXT("Editor"), TEXT("Default")) }, OutText, Error));
+
+	// 没有 Modules 键时新建
+	const FString NoModules = TEXT("{\n\t\"FileVersion\": 3,\n\t\"EngineAssociation\": \"5.6\"\n}\n");
+	if (TestTrue(TEXT("新建 Modules"), ModuleBuilder::PatchDescriptorText(NoModules, { MakeParams(TEXT("NewMod"), TEXT(""), TEXT("")) }, OutText, Error)))
+	{
+		Modules.Reset();
+		if (ParseModules(*this, OutText, Modules) && TestEqual(TEXT("模块数"), Modules.Num(), 1))
+		{
+			TestEqual(TEXT("默认类型"), Modules[0]->GetStringField(TEXT("Type")), FString(TEXT("Runtime")));
+			TestEqual(TEXT("默认加载阶段"), Modules[0]->GetStringField(TEXT("LoadingPhase")), FString(TEXT("Default")));
+		}
+	}
+
+	// Modules 不是数组时不追加第二个 Modules 键
+	TestFalse(TEXT("Modules 为 null"), ModuleBuilder::PatchDescriptorText(TEXT("{ \"Modules\": null }"), { MakeParams(TEXT("NewMod"), TEXT(""), TEXT("")) }, OutText, Error));
+	TestFalse(TEXT("Modules 为对象"), ModuleBuilder::PatchDescriptorText(TEXT("{ \"Modules\": {} }"), { MakeParams(TEXT("NewMod"), TEXT(""), TEXT("")) }, OutText, Error));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDescriptorFieldTest, "ModuleBuilder.Descriptor.SetField",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDescriptorFieldTest::RunTest(const FString& Parameters)
+{
+	using namespace DescriptorPatcherTestsPrivate;
+
+	// 引号、反斜杠与控制字符都要转义，写回后仍能解析出原值
+	const FString Value = TEXT("Say \"Hi\"\\\n\tDone\x01");
+
+	FString Replaced;
+	FString Appended;
+	FString Error;
+	TestTrue(TEXT("改写已有字段"), ModuleBuilder::SetDescriptorModuleField(GProjectDescriptor, TEXT("Game"), TEXT("LoadingPhase"), Value, Replaced, Error));
+	TestTrue(TEXT("追加字段"), ModuleBuilder::SetDescriptorModuleField(Replaced, TEXT("Game"), TEXT("Note"), Value, Appended, Error));
+
+	TArray<TSharedPtr<FJsonObject>> Modules;
+	if (ParseModules(*this, Appended, Modules) && TestEqual(TEXT("模块数"), Modules.Num(), 1))
+	{
+		TestEqual(TEXT("改写的字段"), Modules[0]->GetStringField(TEXT("LoadingPhase")), Value);
+		TestEqual(TEXT("追加的字段"), Modules[0]->GetStringField(TEXT("Note")), Value);
+		TestEqual(TEXT("其他字段不变"), Modules[0]->GetStringField(TEXT("Type")), FString(TEXT("Runtime")));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDescriptorRemoveTest, "ModuleBuilder.Descriptor.Remove",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDescriptorRemoveTest::RunTest(const FString& Parameters)
+{
+	using namespace DescriptorPatcherTestsPrivate;
+
+	FString TwoModules;
+	FString Error;
+	if (!TestTrue(TEXT("追加模块"), ModuleBuilder::PatchDescriptorText(GProjectDescriptor, { MakeParams(TEXT("NewMod"), TEXT("Editor"), TEXT("Default")) }, TwoModules, Error)))
+	{
+		return false;
+	}
+
+	// 删除第一项时连同其后的分隔符
+	FString OutText;
+	TestTrue(TEXT("删除模块"), ModuleBuilder::RemoveModulesFromDescriptorText(TwoModules, { TEXT("Game"), TEXT("Missing") }, OutText, Error));
+
+	TArray<TSharedPtr<FJsonObject>> Modules;
+	if (ParseModules(*this, OutText, Modules) && TestEqual(TEXT("模块数"), Modules.Num(), 1))
+	{
+		TestEqual(TEXT("剩下的模块"), Modules[0]->GetStringField(TEXT("Name")), FString(TEXT("NewMod")));
+	}
+
+	// 删除最后一项时连同其前的分隔符，回到原文
+	TestTrue(TEXT("删除新模块"), ModuleBuilder::RemoveModulesFromDescriptorText(TwoModules, { TEXT("NewMod") }, OutText, Error));
+	TestEqual(TEXT("回到原文"), OutText, FString(GProjectDescriptor));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
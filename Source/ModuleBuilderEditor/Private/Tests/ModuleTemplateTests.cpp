@@ -0,0 +1,120 @@
+#include "ModuleTemplate.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ModuleTemplateTestsPrivate
+{
+
+// 编译失败时记录错误并返回空
+static FString CompileAndRender(FAutomationTestBase& Test, const FString& Source, const FModuleTemplateVariables& Variables)
+{
+	FString Error;
+	TSharedPtr<const FModuleTemplate, ESPMode::ThreadSafe> Template = FModuleTemplate::Compile(Source, Error);
+	if (!Template.IsValid())
+	{
+		Test.AddError(FString::Printf(TEXT("编译失败：%s"), *Error));
+		return FString();
+	}
+	return Template->Render(Variables);
+}
+
+} // namespace ModuleTemplateTestsPrivate
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModuleTemplateVariableTest, "ModuleBuilder.Template.Variables",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FModuleTemplateVariableTest::RunTest(const FString& Parameters)
+{
+	using namespace ModuleTemplateTestsPrivate;
+
+	FModuleTemplateVariables Variables;
+	Variables.Set(TEXT("Name"), TEXT("World"));
+	Variables.Set(TEXT("List"), TEXT("\"Core\",\n\"Engine\""));
+
+	TestEqual(TEXT("变量"), CompileAndRender(*this, TEXT("Hello {{Name}}!"), Variables), TEXT("Hello World!"));
+	TestEqual(TEXT("标签内空白"), CompileAndRender(*this, TEXT("{{ Name }}"), Variables), TEXT("World"));
+	TestEqual(TEXT("未设置的变量为空"), CompileAndRender(*this, TEXT("[{{Missing}}]"), Variables), TEXT("[]"));
+	TestEqual(TEXT("多行值逐行缩进"), CompileAndRender(*this, TEXT("{\n\t\t{{List}}\n}"), Variables), TEXT("{\n\t\t\"Core\",\n\t\t\"Engine\"\n}"));
+	TestEqual(TEXT("行内变量不补缩进"), CompileAndRender(*this, TEXT("x {{List}}"), Variables), TEXT("x \"Core\",\n\"Engine\""));
+	TestEqual(TEXT("非标签原样输出"), CompileAndRender(*this, TEXT("{{ 1 + 1 }} {{}}"), Variables), TEXT("{{ 1 + 1 }} {{}}"));
+
+	// FName 为键：不区分大小写
+	FModuleTemplateVariables Lower;
+	Lower.Set(TEXT("modulename"), TEXT("Foo"));
+	TestEqual(TEXT("变量名不区分大小写"), CompileAndRender(*this, TEXT("{{ModuleName}}"), Lower), TEXT("Foo"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModuleTemplateConditionTest, "ModuleBuilder.Template.Conditions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FModuleTemplateConditionTest::RunTest(const FString& Parameters)
+{
+	using namespace ModuleTemplateTestsPrivate;
+
+	const FString Source = TEXT("A\n{{#if Flag}}\nB\n{{else}}\nC\n{{/if}}\nD\n");
+
+	FModuleTemplateVariables On;
+	On.SetFlag(TEXT("Flag"), true);
+	FModuleTemplateVariables Off;
+	Off.SetFlag(TEXT("Flag"), false);
+
+	// 独占一行的条件标签连同所在行一起去掉
+	TestEqual(TEXT("条件为真"), CompileAndRender(*this, Source, On), TEXT("A\nB\nD\n"));
+	TestEqual(TEXT("条件为假"), CompileAndRender(*this, Source, Off), TEXT("A\nC\nD\n"));
+	TestEqual(TEXT("未设置按假处理"), CompileAndRender(*this, Source, FModuleTemplateVariables()), TEXT("A\nC\nD\n"));
+
+	TestEqual(TEXT("取反"), CompileAndRender(*this, TEXT("{{#if !Flag}}no{{/if}}"), Off), TEXT("no"));
+	TestEqual(TEXT("行内条件保留其余文本"), CompileAndRender(*this, TEXT("x{{#if Flag}}y{{/if}}z"), Off), TEXT("xz"));
+	TestEqual(TEXT("CRLF"), CompileAndRender(*this, TEXT("A\r\n{{#if Flag}}\r\nB\r\n{{/if}}\r\nC"), On), TEXT("A\r\nB\r\nC"));
+
+	FModuleTemplateVariables Nested;
+	Nested.SetFlag(TEXT("Outer"), true);
+	Nested.SetFlag(TEXT("Inner"), false);
+	TestEqual(TEXT("嵌套"), CompileAndRender(*this, TEXT("{{#if Outer}}1{{#if Inner}}2{{else}}3{{/if}}4{{/if}}"), Nested), TEXT("134"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModuleTemplateErrorTest, "ModuleBuilder.Template.Errors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FModuleTemplateErrorTest::RunTest(const FString& Parameters)
+{
+	FString Error;
+
+	TestFalse(TEXT("未闭合的 if"), FModuleTemplate::Compile(TEXT("a\n{{#if Flag}}\nb"), Error).IsValid());
+	TestTrue(TEXT("错误带行号"), Error.Contains(TEXT("第 2 行")));
+
+	TestFalse(TEXT("多余的 /if"), FModuleTemplate::Compile(TEXT("{{/if}}"), Error).IsValid());
+	TestFalse(TEXT("多余的 else"), FModuleTemplate::Compile(TEXT("{{#if A}}{{else}}{{else}}{{/if}}"), Error).IsValid());
+	TestFalse(TEXT("if 后不是变量名"), FModuleTemplate::Compile(TEXT("{{#if 1}}{{/if}}"), Error).IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModuleTemplateBuiltInTest, "ModuleBuilder.Template.BuiltIn",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FModuleTemplateBuiltInTest::RunTest(const FString& Parameters)
+{
+	FModuleTemplateVariables Variables;
+	Variables.Set(TEXT("ModuleName"), TEXT("TestModule"));
+	Variables.Set(TEXT("ModuleNameUpper"), TEXT("TESTMODULE"));
+	Variables.Set(TEXT("ModuleApi"), TEXT("TESTMODULE_API"));
+
+	// 工程模板可能覆盖内置模板，这里只检查都能渲染出模块名
+	for (const FString& Name : FModuleTemplateLibrary::GetBuiltInNames())
+	{
+		const FString Text = FModuleTemplateLibrary::Get().Render(Name, Variables);
+		TestFalse(*FString::Printf(TEXT("%s 不为空"), *Name), Text.IsEmpty());
+		TestFalse(*FString::Printf(TEXT("%s 没有未处理的条件标签"), *Name), Text.Contains(TEXT("{{#if")) || Text.Contains(TEXT("{{/if}}")));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
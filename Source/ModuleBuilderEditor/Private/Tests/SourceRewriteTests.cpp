@@ -0,0 +1,173 @@
+#include "SourceRewrite.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SourceRewriteTestsPrivate
+{
+
+static FTextRewriteRule MakeRule(ETextRewriteKind Kind, const TCHAR* From, const TCHAR* To, ETextRewriteFiles Files = ETextRewriteFiles::All)
+{
+	FTextRewriteRule Rule;
+	Rule.Kind = Kind;
+	Rule.From = From;
+	Rule.To = To;
+	Rule.Files = Files;
+	return Rule;
+}
+
+// 对一段文本应用单条规则，返回改写后的文本
+static FString ApplyRule(const FTextRewriteRule& Rule, const FString& Path, const FString& Text)
+{
+	FString Result;
+	TArray<int32> Hits;
+	ModuleBuilder::ApplyRewriteRules(Path, Text, { Rule }, Result, Hits);
+	return Result;
+}
+
+} // namespace SourceRewriteTestsPrivate
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSourceRewriteModuleLoadTest, "ModuleBuilder.Rewrite.ModuleLoadArgument",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSourceRewriteModuleLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace SourceRewriteTestsPrivate;
+
+	const TArray<FTextRewriteRule> Rules = { MakeRule(ETextRewriteKind::ModuleLoadArgument, TEXT("Old"), TEXT("New"), ETextRewriteFiles::Code) };
+	const FString Path = TEXT("/Proj/Source/Game/Private/Game.cpp");
+
+	const FString Text = TEXT(
+		"IOldModule& A = FModuleManager::LoadModuleChecked<IOldModule>(\"Old\");\n"
+		"FModuleManager::Get().LoadModule(TEXT(\"Old\"));\n"
+		"FModuleManager::Get().UnloadModule( TEXT( \"Old\" ) );\n"
+		"if (FModuleManager::Get().IsModuleLoaded(\"Old\")) {}\n"
+		"const TCHAR* Label = TEXT(\"Old\");\n"
+		"UE_LOG(LogTemp, Log, TEXT(\"Old\"));\n");
+	const FString Expected = TEXT(
+		"IOldModule& A = FModuleManager::LoadModuleChecked<IOldModule>(\"New\");\n"
+		"FModuleManager::Get().LoadModule(TEXT(\"New\"));\n"
+		"FModuleManager::Get().UnloadModule( TEXT( \"New\" ) );\n"
+		"if (FModuleManager::Get().IsModuleLoaded(\"New\")) {}\n"
+		"const TCHAR* Label = TEXT(\"Old\");\n"
+		"UE_LOG(LogTemp, Log, TEXT(\"Old\"));\n");
+
+	FString Result;
+	TArray<int32> Hits;
+	TestTrue(TEXT("有改写"), ModuleBuilder::ApplyRewriteRules(Path, Text, Rules, Result, Hits));
+	TestEqual(TEXT("只改写加载调用的参数"), Result, Expected);
+	TestEqual(TEXT("命中的规则"), Hits, TArray<int32>({ 0 }));
+
+	// Files 为 Code 时不作用于 Build.cs
+	TestFalse(TEXT("Build.cs 不在作用范围"), ModuleBuilder::ApplyRewriteRules(TEXT("/Proj/Source/Game/Game.Build.cs"), Text, Rules, Result, Hits));
+	TestEqual(TEXT("Build.cs 没有命中"), Hits.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSourceRewriteKindsTest, "ModuleBuilder.Rewrite.Kinds",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSourceRewriteKindsTest::RunTest(const FString& Parameters)
+{
+	using namespace SourceRewriteTestsPrivate;
+
+	const FString Header = TEXT("/Proj/Source/Old/Public/Old.h");
+
+	TestEqual(TEXT("整词标识符"),
+		ApplyRule(MakeRule(ETextRewriteKind::Identifier, TEXT("OLD_API"), TEXT("NEW_API")), Header, TEXT("class OLD_API A; class MYOLD_API B;")),
+		FString(TEXT("class NEW_API A; class MYOLD_API B;")));
+
+	TestEqual(TEXT("带引号的字符串"),
+		ApplyRule(MakeRule(ETextRewriteKind::QuotedString, TEXT("Old"), TEXT("New")), TEXT("/Proj/Source/Game/Game.Build.cs"), TEXT("\"Old\", \"OldEditor\", Old")),
+		FString(TEXT("\"New\", \"OldEditor\", Old")));
+
+	TestEqual(TEXT("包含路径"),
+		ApplyRule(MakeRule(ETextRewriteKind::IncludePath, TEXT("Old/Foo.h"), TEXT("New/Foo.h")), Header,
+			TEXT("#include \"Old/Foo.h\"\n# include <Old/Foo.h>\nconst char* P = \"Old/Foo.h\";\n")),
+		FString(TEXT("#include \"New/Foo.h\"\n# include <New/Foo.h>\nconst char* P = \"Old/Foo.h\";\n")));
+
+	TestEqual(TEXT("IMPLEMENT_MODULE 的模块名"),
+		ApplyRule(MakeRule(ETextRewriteKind::ImplementModuleName, TEXT("Old"), TEXT("New")), TEXT("/Proj/Source/Old/Private/Old.cpp"),
+			TEXT("IMPLEMENT_MODULE(FOldModule, Old)\nIMPLEMENT_GAME_MODULE(FDefaultGameModuleImpl,  Old );\nOld();\n")),
+		FString(TEXT("IMPLEMENT_MODULE(FOldModule, New)\nIMPLEMENT_GAME_MODULE(FDefaultGameModuleImpl,  New );\nOld();\n")));
+
+	// 作用域：不递归时只作用于该目录下的文件
+	FTextRewriteRule Scoped = MakeRule(ETextRewriteKind::Identifier, TEXT("Old"), TEXT("New"));
+	Scoped.Scope = TEXT("/Proj/Source/Old/Public");
+	Scoped.bScopeRecursive = false;
+	TestEqual(TEXT("作用域内"), ApplyRule(Scoped, Header, TEXT("Old")), FString(TEXT("New")));
+	TestEqual(TEXT("作用域的子目录"), ApplyRule(Scoped, TEXT("/Proj/Source/Old/Public/Sub/A.h"), TEXT("Old")), FString(TEXT("Old")));
+	TestEqual(TEXT("作用域外"), ApplyRule(Scoped, TEXT("/Proj/Source/Old/Public2/A.h"), TEXT("Old")), FString(TEXT("Old")));
+
+	// 只读匹配：每条规则按原文单独匹配；From 与 To 相同的规则也记录命中
+	const TArray<FTextRewriteRule> Rules = {
+		MakeRule(ETextRewriteKind::Identifier, TEXT("A"), TEXT("B")),
+		MakeRule(ETextRewriteKind::Identifier, TEXT("B"), TEXT("C")),
+		MakeRule(ETextRewriteKind::Identifier, TEXT("A"), TEXT("A")),
+	};
+	TArray<int32> Hits;
+	ModuleBuilder::MatchRewriteRules(Header, TEXT("A"), Rules, Hits);
+	TestEqual(TEXT("只读匹配"), Hits, TArray<int32>({ 0, 2 }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSourceRewriteFilesTest, "ModuleBuilder.Rewrite.RewriteFiles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSourceRewriteFilesTest::RunTest(const FString& Parameters)
+{
+	using namespace SourceRewriteTestsPrivate;
+
+	const FString Dir = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("ModuleBuilder") / TEXT("Rewrite"));
+	const FString Matching = Dir / TEXT("Old.h");
+	const FString Other = Dir / TEXT("Other.h");
+	const FString OldText = TEXT("#pragma once\nclass OLD_API FOld {};\n");
+
+	if (!TestTrue(TEXT("写入测试文件"), FFileHelper::SaveStringToFile(OldText, *Matching)
+		&& FFileHelper::SaveStringToFile(TEXT("#pragma once\nclass OTHER_API FOther {};\n"), *Other)))
+	{
+		IFileManager::Get().DeleteDirectory(*Dir, false, true);
+		return false;
+	}
+
+	const TArray<FTextRewriteRule> Rules = { MakeRule(ETextRewriteKind::Identifier, TEXT("OLD_API"), TEXT("NEW_API")) };
+
+	TArray<FRewrittenFile> Files;
+	FRewriteScanStats Stats;
+	ModuleBuilder::RewriteFiles({ Matching, Other }, Rules, Files, Stats);
+
+	TestEqual(TEXT("扫描的文件"), Stats.Files, 2);
+	TestEqual(TEXT("预筛命中的文件"), Stats.Candidates, 1);
+	TestEqual(TEXT("有变化的文件"), Stats.Changed, 1);
+	if (TestEqual(TEXT("改写的文件"), Files.Num(), 1))
+	{
+		TestEqual(TEXT("路径"), Files[0].Edit.Path, Matching);
+		TestEqual(TEXT("原内容"), Files[0].Edit.OldText, OldText);
+		TestEqual(TEXT("新内容"), Files[0].Edit.NewText, FString(TEXT("#pragma once\nclass NEW_API FOld {};\n")));
+		TestEqual(TEXT("命中的规则"), Files[0].Rules, TArray<int32>({ 0 }));
+	}
+
+	// 只生成改写，不写回磁盘
+	FString OnDisk;
+	FFileHelper::LoadFileToString(OnDisk, *Matching);
+	TestEqual(TEXT("磁盘上的文件未改动"), OnDisk, OldText);
+
+	TArray<FRuleMatchedFile> Matched;
+	ModuleBuilder::MatchFiles({ Matching, Other }, Rules, Matched, Stats);
+	if (TestEqual(TEXT("只读匹配的文件"), Matched.Num(), 1))
+	{
+		TestEqual(TEXT("只读匹配的路径"), Matched[0].Path, Matching);
+	}
+	TestEqual(TEXT("只读匹配没有变化"), Stats.Changed, 0);
+
+	IFileManager::Get().DeleteDirectory(*Dir, false, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,123 @@
+#include "UnityBuildAdvisor.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnityBuildAdvisorTestsPrivate
+{
+
+static FModuleSourceStats MakeStats(int32 Files, int64 Lines, int64 Bytes)
+{
+	FModuleSourceStats Stats;
+	Stats.SourceFiles = Files;
+	Stats.SourceLines = Lines;
+	Stats.SourceBytes = Bytes;
+	return Stats;
+}
+
+static const TCHAR* GBuildCs = TEXT(
+	"using UnrealBuildTool;\n"
+	"\n"
+	"public class Game : ModuleRules\n"
+	"{\n"
+	"\tpublic Game(ReadOnlyTargetRules Target) : base(Target)\n"
+	"\t{\n"
+	"\t\tPCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;\n"
+	"\t\tbUseUnity = true;\n"
+	"\t}\n"
+	"}\n");
+
+} // namespace UnityBuildAdvisorTestsPrivate
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnityRecommendTest, "ModuleBuilder.Unity.Recommend",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnityRecommendTest::RunTest(const FString& Parameters)
+{
+	using namespace UnityBuildAdvisorTestsPrivate;
+
+	// 小模块只设阈值，不写死 bUseUnity
+	TArray<FString> Reasons;
+	const FUnityBuildSettings Small = ModuleBuilder::RecommendUnitySettings(MakeStats(5, 1000, 40 * 1024), false, &Reasons);
+	TestFalse(TEXT("小模块不设 bUseUnity"), Small.bUseUnity.IsSet());
+	TestEqual(TEXT("小模块的 unity 阈值"), Small.MinSourceFilesForUnityBuildOverride.Get(0), 12);
+	TestEqual(TEXT("共享 PCH 总是使用"), Small.MinFilesUsingPrecompiledHeaderOverride.Get(0), 1);
+	TestTrue(TEXT("给出原因"), Reasons.Num() > 0);
+
+	// 显式 PCH 的小模块不用 PCH
+	const FUnityBuildSettings SmallExplicit = ModuleBuilder::RecommendUnitySettings(MakeStats(2, 200, 8 * 1024), true);
+	TestEqual(TEXT("显式 PCH 阈值高于文件数"), SmallExplicit.MinFilesUsingPrecompiledHeaderOverride.Get(0), 4);
+
+	// 平均行数过大时关闭 unity
+	const FUnityBuildSettings Large = ModuleBuilder::RecommendUnitySettings(MakeStats(20, 20 * 3000, 4 * 1024 * 1024), false);
+	TestEqual(TEXT("大文件关闭 unity"), Large.bUseUnity.Get(true), false);
+
+	// 普通模块启用 unity；源码多时缩小 unity 块
+	const FUnityBuildSettings Medium = ModuleBuilder::RecommendUnitySettings(MakeStats(40, 40 * 200, 3 * 1024 * 1024), false);
+	TestEqual(TEXT("启用 unity"), Medium.bUseUnity.Get(false), true);
+	TestEqual(TEXT("unity 阈值"), Medium.MinSourceFilesForUnityBuildOverride.Get(0), 12);
+	TestEqual(TEXT("unity 块大小"), Medium.NumIncludedBytesPerUnityCPPOverride.Get(0), 256 * 1024);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnityApplyBuildCsTest, "ModuleBuilder.Unity.ApplyBuildCs",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnityApplyBuildCsTest::RunTest(const FString& Parameters)
+{
+	using namespace UnityBuildAdvisorTestsPrivate;
+
+	FUnityBuildSettings Settings;
+	Settings.bUseUnity = false;
+	Settings.MinSourceFilesForUnityBuildOverride = 12;
+
+	// 已有赋值改值，缺少的插入到 PCHUsage 之后；读回应与写入一致
+	FString OutText;
+	FString Error;
+	if (!TestTrue(TEXT("写入设置"), ModuleBuilder::ApplyUnitySettingsToBuildCs(GBuildCs, Settings, OutText, Error)))
+	{
+		AddError(Error);
+		return false;
+	}
+	TestTrue(TEXT("插入到 PCHUsage 之后"), OutText.Contains(TEXT("PCHUsageMode.UseExplicitOrSharedPCHs;\n\t\tMinSourceFilesForUnityBuildOverride = 12;\n")));
+
+	FUnityBuildSettings ReadBack;
+	bool bHasExplicitPCH = true;
+	ModuleBuilder::ReadUnitySettings(OutText, ReadBack, bHasExplicitPCH);
+	TestEqual(TEXT("bUseUnity"), ReadBack.bUseUnity.Get(true), false);
+	TestEqual(TEXT("MinSourceFilesForUnityBuildOverride"), ReadBack.MinSourceFilesForUnityBuildOverride.Get(0), 12);
+	TestFalse(TEXT("没有显式 PCH"), bHasExplicitPCH);
+
+	// 再次写入同样的设置不再变化
+	FString Again;
+	TestTrue(TEXT("再次写入"), ModuleBuilder::ApplyUnitySettingsToBuildCs(OutText, Settings, Again, Error));
+	TestEqual(TEXT("再次写入不变"), Again, OutText);
+
+	// 缺少的多项按 FormatUnitySettings 的顺序插入
+	FUnityBuildSettings Several;
+	Several.bUseUnity = true;
+	Several.MinSourceFilesForUnityBuildOverride = 12;
+	Several.MinFilesUsingPrecompiledHeaderOverride = 1;
+	const FString NoUnity = FString(GBuildCs).Replace(TEXT("\t\tbUseUnity = true;\n"), TEXT(""));
+	TestTrue(TEXT("写入多项设置"), ModuleBuilder::ApplyUnitySettingsToBuildCs(NoUnity, Several, OutText, Error));
+	TestTrue(TEXT("插入顺序与生成的模块一致"), OutText.Contains(TEXT("PCHUsageMode.UseExplicitOrSharedPCHs;\n") + ModuleBuilder::FormatUnitySettings(Several, TEXT("\t\t"))));
+
+	// 同一设置有多处赋值时不修改
+	const FString Branched = FString(GBuildCs).Replace(TEXT("\t\tbUseUnity = true;\n"), TEXT(
+		"\t\tif (Target.Configuration == UnrealTargetConfiguration.Shipping)\n"
+		"\t\t{\n"
+		"\t\t\tbUseUnity = true;\n"
+		"\t\t}\n"
+		"\t\telse\n"
+		"\t\t{\n"
+		"\t\t\tbUseUnity = false;\n"
+		"\t\t}\n"));
+	TestFalse(TEXT("多处赋值"), ModuleBuilder::ApplyUnitySettingsToBuildCs(Branched, Settings, OutText, Error));
+	TestTrue(TEXT("错误中带设置名"), Error.Contains(TEXT("bUseUnity")));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
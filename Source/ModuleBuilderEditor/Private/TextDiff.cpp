@@ -0,0 +1,144 @@
+#include "TextDiff.h"
+
+namespace ModuleBuilder
+{
+
+FString MakeUnifiedDiff(const FString& Path, const FString& OldText, const FString& NewText, int32 ContextLines)
+{
+	if (OldText.Equals(NewText, ESearchCase::CaseSensitive))
+	{
+		return FString();
+	}
+
+	TArray<FString> OldLines;
+	TArray<FString> NewLines;
+	OldText.ParseIntoArrayLines(OldLines, false);
+	NewText.ParseIntoArrayLines(NewLines, false);
+
+	// 去掉相同的首尾行，LCS 只在中间的变化区域上做
+	int32 Prefix = 0;
+	while (Prefix < OldLines.Num() && Prefix < NewLines.Num() && OldLines[Prefix] == NewLines[Prefix])
+	{
+		++Prefix;
+	}
+	int32 Suffix = 0;
+	while (Suffix < OldLines.Num() - Prefix && Suffix < NewLines.Num() - Prefix
+		&& OldLines[OldLines.Num() - 1 - Suffix] == NewLines[NewLines.Num() - 1 - Suffix])
+	{
+		++Suffix;
+	}
+
+	const int32 OldCount = OldLines.Num() - Prefix - Suffix;
+	const int32 NewCount = NewLines.Num() - Prefix - Suffix;
+
+	// Lcs[i][j]：旧[i..] 与新[j..] 的最长公共子序列长度
+	TArray<int32> Lcs;
+	Lcs.SetNumZeroed((OldCount + 1) * (NewCount + 1));
+	auto At = [&Lcs, NewCount](int32 I, int32 J) -> int32& { return Lcs[I * (NewCount + 1) + J]; };
+
+	for (int32 I = OldCount - 1; I >= 0; --I)
+	{
+		for (int32 J = NewCount - 1; J >= 0; --J)
+		{
+			At(I, J) = OldLines[Prefix + I] == NewLines[Prefix + J]
+				? At(I + 1, J + 1) + 1
+				: FMath::Max(At(I + 1, J), At(I, J + 1));
+		}
+	}
+
+	// 逐行标记：' ' 相同，'-' 删除，'+' 新增
+	struct FDiffLine
+	{
+		TCHAR Op;
+		const FString* Text;
+		int32 OldLine;
+		int32 NewLine;
+	};
+
+	TArray<FDiffLine> Lines;
+	for (int32 Index = 0; Index < Prefix; ++Index)
+	{
+		Lines.Add({ TEXT(' '), &OldLines[Index], Index, Index });
+	}
+
+	int32 I = 0;
+	int32 J = 0;
+	while (I < OldCount || J < NewCount)
+	{
+		if (I < OldCount && J < NewCount && OldLines[Prefix + I] == NewLines[Prefix + J])
+		{
+			Lines.Add({ TEXT(' '), &OldLines[Prefix + I], Prefix + I, Prefix + J });
+			++I;
+			++J;
+		}
+		else if (J < NewCount && (I >= OldCount || At(I, J + 1) >= At(I + 1, J)))
+		{
+			Lines.Add({ TEXT('+'), &NewLines[Prefix + J], Prefix + I, Prefix + J });
+			++J;
+		}
+		else
+		{
+			Lines.Add({ TEXT('-'), &OldLines[Prefix + I], Prefix + I, Prefix + J });
+			++I;
+		}
+	}
+
+	for (int32 Index = 0; Index < Suffix; ++Index)
+	{
+		Lines.Add({ TEXT(' '), &OldLines[OldLines.Num() - Suffix + Index], OldLines.Num() - Suffix + Index, NewLines.Num() - Suffix + Index });
+	}
+
+	FString Out = FString::Printf(TEXT("--- %s\n+++ %s\n"), *Path, *Path);
+
+	int32 Index = 0;
+	while (Index < Lines.Num())
+	{
+		if (Lines[Index].Op == TEXT(' '))
+		{
+			++Index;
+			continue;
+		}
+
+		// 向后合并相距不超过 2 * ContextLines 的改动
+		const int32 HunkBegin = FMath::Max(0, Index - ContextLines);
+		int32 HunkEnd = Index;
+		int32 Quiet = 0;
+		for (int32 Scan = Index; Scan < Lines.Num(); ++Scan)
+		{
+			if (Lines[Scan].Op != TEXT(' '))
+			{
+				HunkEnd = Scan;
+				Quiet = 0;
+			}
+			else if (++Quiet > ContextLines * 2)
+			{
+				break;
+			}
+		}
+		HunkEnd = FMath::Min(Lines.Num() - 1, HunkEnd + ContextLines);
+
+		int32 OldLen = 0;
+		int32 NewLen = 0;
+		for (int32 Scan = HunkBegin; Scan <= HunkEnd; ++Scan)
+		{
+			OldLen += Lines[Scan].Op != TEXT('+') ? 1 : 0;
+			NewLen += Lines[Scan].Op != TEXT('-') ? 1 : 0;
+		}
+
+		Out += FString::Printf(TEXT("@@ -%d,%d +%d,%d @@\n"),
+			Lines[HunkBegin].OldLine + 1, OldLen, Lines[HunkBegin].NewLine + 1, NewLen);
+
+		for (int32 Scan = HunkBegin; Scan <= HunkEnd; ++Scan)
+		{
+			Out.AppendChar(Lines[Scan].Op);
+			Out += *Lines[Scan].Text;
+			Out += TEXT("\n");
+		}
+
+		Index = HunkEnd + 1;
+	}
+
+	return Out;
+}
+
+} // namespace ModuleBuilder
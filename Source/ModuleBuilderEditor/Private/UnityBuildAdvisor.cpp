@@ -0,0 +1,435 @@
+#include "UnityBuildAdvisor.h"
+#include "IncludeResolver.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "TextDiff.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+namespace ModuleBuilder
+{
+namespace UnityBuildAdvisorPrivate
+{
+
+// 少于这个数量的 .cpp 不做 unity：合并收益小，改一个文件却要重编整块
+static constexpr int32 GUnityMinSourceFiles = 12;
+
+// 显式 PCH 本身要编译一次，.cpp 少于这个数量时不划算
+static constexpr int32 GExplicitPCHMinSourceFiles = 4;
+
+// 平均每个 .cpp 超过这么多行时，unity 块过大，增量编译代价高
+static constexpr int64 GUnityMaxAverageLines = 1500;
+
+// 源码总量超过该值时缩小每个 unity 块（UBT 默认 384 KB）
+static constexpr int64 GLargeModuleBytes = 2 * 1024 * 1024;
+static constexpr int32 GLargeModuleUnityBytes = 256 * 1024;
+
+static const TCHAR* const GUseUnityKey = TEXT("bUseUnity");
+static const TCHAR* const GMinUnityFilesKey = TEXT("MinSourceFilesForUnityBuildOverride");
+static const TCHAR* const GMinPCHFilesKey = TEXT("MinFilesUsingPrecompiledHeaderOverride");
+static const TCHAR* const GUnityBytesKey = TEXT("NumIncludedBytesPerUnityCPPOverride");
+
+// 设置项按固定顺序输出：Key 与 Build.cs 中的值文本
+static TArray<TPair<const TCHAR*, FString>> ToAssignments(const FUnityBuildSettings& Settings)
+{
+	TArray<TPair<const TCHAR*, FString>> Out;
+	if (Settings.bUseUnity.IsSet())
+	{
+		Out.Add({ GUseUnityKey, Settings.bUseUnity.GetValue() ? TEXT("true") : TEXT("false") });
+	}
+	if (Settings.MinSourceFilesForUnityBuildOverride.IsSet())
+	{
+		Out.Add({ GMinUnityFilesKey, FString::FromInt(Settings.MinSourceFilesForUnityBuildOverride.GetValue()) });
+	}
+	if (Settings.MinFilesUsingPrecompiledHeaderOverride.IsSet())
+	{
+		Out.Add({ GMinPCHFilesKey, FString::FromInt(Settings.MinFilesUsingPrecompiledHeaderOverride.GetValue()) });
+	}
+	if (Settings.NumIncludedBytesPerUnityCPPOverride.IsSet())
+	{
+		Out.Add({ GUnityBytesKey, FString::FromInt(Settings.NumIncludedBytesPerUnityCPPOverride.GetValue()) });
+	}
+	return Out;
+}
+
+template <typename T>
+static bool Differs(const TOptional<T>& Recommended, const TOptional<T>& Current)
+{
+	return Recommended.IsSet() && (!Current.IsSet() || Current.GetValue() != Recommended.GetValue());
+}
+
+static FString Describe(const TOptional<int32>& Value)
+{
+	return Value.IsSet() ? FString::FromInt(Value.GetValue()) : TEXT("默认");
+}
+
+static FString Describe(const TOptional<bool>& Value)
+{
+	return Value.IsSet() ? (Value.GetValue() ? TEXT("true") : TEXT("false")) : TEXT("默认");
+}
+
+static int32 LineStart(const FString& Text, int32 Pos)
+{
+	while (Pos > 0 && Text[Pos - 1] != TEXT('\n'))
+	{
+		--Pos;
+	}
+	return Pos;
+}
+
+} // namespace UnityBuildAdvisorPrivate
+
+bool FUnityRecommendation::NeedsChange() const
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	return Differs(Recommended.bUseUnity, Current.bUseUnity)
+		|| Differs(Recommended.MinSourceFilesForUnityBuildOverride, Current.MinSourceFilesForUnityBuildOverride)
+		|| Differs(Recommended.MinFilesUsingPrecompiledHeaderOverride, Current.MinFilesUsingPrecompiledHeaderOverride)
+		|| Differs(Recommended.NumIncludedBytesPerUnityCPPOverride, Current.NumIncludedBytesPerUnityCPPOverride);
+}
+
+FUnityBuildSettings GetGeneratedModuleUnitySettings(bool bHasExplicitPCH)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	FUnityBuildSettings Settings;
+	Settings.MinSourceFilesForUnityBuildOverride = GUnityMinSourceFiles;
+	Settings.MinFilesUsingPrecompiledHeaderOverride = bHasExplicitPCH ? GExplicitPCHMinSourceFiles : 1;
+	return Settings;
+}
+
+FString FormatUnitySettings(const FUnityBuildSettings& Settings, const FString& Indent)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	FString Text;
+	for (const TPair<const TCHAR*, FString>& Assignment : ToAssignments(Settings))
+	{
+		Text += FString::Printf(TEXT("%s%s = %s;\n"), *Indent, Assignment.Key, *Assignment.Value);
+	}
+	return Text;
+}
+
+FModuleSourceStats CountModuleSources(const FString& ModuleDir)
+{
+	FModuleSourceStats Stats;
+
+	TArray<FString> Sources;
+	FindModuleFiles(ModuleDir, TEXT(".cpp"), Sources);
+	Stats.SourceFiles = Sources.Num();
+
+	for (const FString& Source : Sources)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Source))
+		{
+			continue;
+		}
+
+		Stats.SourceBytes += Bytes.Num();
+		for (uint8 Byte : Bytes)
+		{
+			Stats.SourceLines += Byte == '\n' ? 1 : 0;
+		}
+	}
+
+	return Stats;
+}
+
+FUnityBuildSettings RecommendUnitySettings(const FModuleSourceStats& Stats, bool bHasExplicitPCH, TArray<FString>* OutReasons)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	FUnityBuildSettings Settings;
+	auto Reason = [OutReasons](const FString& Text)
+	{
+		if (OutReasons)
+		{
+			OutReasons->Add(Text);
+		}
+	};
+
+	const int64 AverageLines = Stats.SourceFiles > 0 ? Stats.SourceLines / Stats.SourceFiles : 0;
+
+	if (Stats.SourceFiles < GUnityMinSourceFiles)
+	{
+		// 只设阈值不写死 bUseUnity：文件数增长到阈值后自动启用
+		Settings.MinSourceFilesForUnityBuildOverride = GUnityMinSourceFiles;
+		Reason(FString::Printf(TEXT("%d 个 .cpp，少于 %d：unity 合并收益小，阈值设为 %d，未达到时改一个文件只重编一个"),
+			Stats.SourceFiles, GUnityMinSourceFiles, GUnityMinSourceFiles));
+	}
+	else if (AverageLines > GUnityMaxAverageLines)
+	{
+		Settings.bUseUnity = false;
+		Reason(FString::Printf(TEXT("平均每个 .cpp %lld 行：文件本身已经很大，合并后的 unity 块过大，增量编译代价高"), AverageLines));
+	}
+	else
+	{
+		// 工程模块默认要到 32 个文件才启用 unity，这里提前到阈值
+		Settings.bUseUnity = true;
+		Settings.MinSourceFilesForUnityBuildOverride = GUnityMinSourceFiles;
+		Reason(FString::Printf(TEXT("%d 个 .cpp、平均 %lld 行：启用 unity，阈值 %d"), Stats.SourceFiles, AverageLines, GUnityMinSourceFiles));
+
+		if (Stats.SourceBytes > GLargeModuleBytes)
+		{
+			Settings.NumIncludedBytesPerUnityCPPOverride = GLargeModuleUnityBytes;
+			Reason(FString::Printf(TEXT("源码 %.1f MB：unity 块缩小到 %d KB，改动时重编的范围更小"),
+				Stats.SourceBytes / (1024.0 * 1024.0), GLargeModuleUnityBytes / 1024));
+		}
+	}
+
+	if (bHasExplicitPCH)
+	{
+		if (Stats.SourceFiles < GExplicitPCHMinSourceFiles)
+		{
+			// 阈值高于文件数即不使用 PCH
+			Settings.MinFilesUsingPrecompiledHeaderOverride = GExplicitPCHMinSourceFiles;
+			Reason(FString::Printf(TEXT("显式 PCH 但只有 %d 个 .cpp：编译 PCH 本身的开销大于收益"), Stats.SourceFiles));
+		}
+	}
+	else
+	{
+		// 共享 PCH 已由引擎编好，文件再少也值得使用（目标默认少于 6 个文件不用）
+		Settings.MinFilesUsingPrecompiledHeaderOverride = 1;
+		Reason(TEXT("没有显式 PCH：共享 PCH 无需额外编译，任何数量的 .cpp 都使用"));
+	}
+
+	return Settings;
+}
+
+void ReadUnitySettings(const FString& BuildCsText, FUnityBuildSettings& OutSettings, bool& bOutHasExplicitPCH)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	OutSettings = FUnityBuildSettings();
+	bOutHasExplicitPCH = false;
+
+	TArray<FBuildCsAssignment> Assignments;
+	FModuleDependencyGraph::ParseBuildCsAssignments(BuildCsText, Assignments);
+
+	for (const FBuildCsAssignment& Assignment : Assignments)
+	{
+		const bool bIsNumber = Assignment.Value.IsNumeric();
+
+		if (Assignment.Key == GUseUnityKey && (Assignment.Value == TEXT("true") || Assignment.Value == TEXT("false")))
+		{
+			OutSettings.bUseUnity = Assignment.Value == TEXT("true");
+		}
+		else if (Assignment.Key == GMinUnityFilesKey && bIsNumber)
+		{
+			OutSettings.MinSourceFilesForUnityBuildOverride = FCString::Atoi(*Assignment.Value);
+		}
+		else if (Assignment.Key == GMinPCHFilesKey && bIsNumber)
+		{
+			OutSettings.MinFilesUsingPrecompiledHeaderOverride = FCString::Atoi(*Assignment.Value);
+		}
+		else if (Assignment.Key == GUnityBytesKey && bIsNumber)
+		{
+			OutSettings.NumIncludedBytesPerUnityCPPOverride = FCString::Atoi(*Assignment.Value);
+		}
+		else if (Assignment.Key == TEXT("PrivatePCHHeaderFile") || Assignment.Key == TEXT("SharedPCHHeaderFile"))
+		{
+			bOutHasExplicitPCH = true;
+		}
+	}
+}
+
+bool ApplyUnitySettingsToBuildCs(const FString& InText, const FUnityBuildSettings& Settings, FString& OutText, FString& OutError)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	OutText = InText;
+	const FString Eol = InText.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+
+	// 已有赋值原地改值，缺少的最后一起插入
+	TArray<TPair<const TCHAR*, FString>> Missing;
+	for (const TPair<const TCHAR*, FString>& Setting : ToAssignments(Settings))
+	{
+		TArray<FBuildCsAssignment> Assignments;
+		FModuleDependencyGraph::ParseBuildCsAssignments(OutText, Assignments);
+
+		const FBuildCsAssignment* Existing = nullptr;
+		int32 Occurrences = 0;
+		for (const FBuildCsAssignment& Assignment : Assignments)
+		{
+			if (Assignment.Key == Setting.Key)
+			{
+				Existing = &Assignment;
+				++Occurrences;
+			}
+		}
+
+		// 多处赋值通常在按平台 / 配置的分支中，改哪一处都可能不是本意
+		if (Occurrences > 1)
+		{
+			OutError = FString::Printf(TEXT("%s 有 %d 处赋值，请手动修改"), Setting.Key, Occurrences);
+			return false;
+		}
+
+		if (Existing)
+		{
+			OutText = OutText.Left(Existing->ValueBegin) + Setting.Value + OutText.Mid(Existing->ValueEnd);
+		}
+		else
+		{
+			Missing.Add(Setting);
+		}
+	}
+
+	if (Missing.Num() == 0)
+	{
+		return true;
+	}
+
+	// 缺少的设置按 FormatUnitySettings 的顺序一次插入：接在 PCHUsage 之后；没有时接在构造函数的 { 之后
+	TArray<FBuildCsAssignment> Assignments;
+	FModuleDependencyGraph::ParseBuildCsAssignments(OutText, Assignments);
+
+	int32 InsertAt = INDEX_NONE;
+	FString Indent;
+
+	const FBuildCsAssignment* Anchor = Assignments.FindByPredicate([](const FBuildCsAssignment& Assignment)
+	{
+		return Assignment.Key == TEXT("PCHUsage");
+	});
+
+	if (Anchor)
+	{
+		const int32 AnchorLine = LineStart(OutText, Anchor->StatementBegin);
+		Indent = OutText.Mid(AnchorLine, Anchor->StatementBegin - AnchorLine);
+		InsertAt = Anchor->StatementEnd;
+	}
+	else
+	{
+		const int32 BaseCall = OutText.Find(TEXT(": base(Target)"));
+		const int32 Brace = BaseCall != INDEX_NONE ? OutText.Find(TEXT("{"), ESearchCase::CaseSensitive, ESearchDir::FromStart, BaseCall) : INDEX_NONE;
+		if (Brace == INDEX_NONE)
+		{
+			OutError = TEXT("找不到 ModuleRules 构造函数");
+			return false;
+		}
+
+		const int32 BraceLine = LineStart(OutText, Brace);
+		Indent = OutText.Mid(BraceLine, Brace - BraceLine) + TEXT("\t");
+		InsertAt = Brace + 1;
+	}
+
+	FString Block;
+	for (const TPair<const TCHAR*, FString>& Setting : Missing)
+	{
+		Block += Eol + Indent + Setting.Key + TEXT(" = ") + Setting.Value + TEXT(";");
+	}
+	OutText = OutText.Left(InsertAt) + Block + OutText.Mid(InsertAt);
+
+	return true;
+}
+
+void AnalyzeUnitySettings(const FModuleDependencyGraph& Graph, TArray<FUnityRecommendation>& OutRecommendations)
+{
+	const TArray<FModuleNode>& Nodes = Graph.GetNodes();
+
+	OutRecommendations.Reset();
+	OutRecommendations.SetNum(Nodes.Num());
+
+	ParallelFor(Nodes.Num(), [&Nodes, &OutRecommendations](int32 Index)
+	{
+		const FModuleNode& Node = Nodes[Index];
+		FUnityRecommendation& Recommendation = OutRecommendations[Index];
+
+		Recommendation.ModuleName = Node.Name;
+		Recommendation.BuildCsPath = Node.BuildCsPath;
+		Recommendation.Stats = CountModuleSources(Node.ModuleDir);
+
+		FString Text;
+		if (FFileHelper::LoadFileToString(Text, *Node.BuildCsPath))
+		{
+			ReadUnitySettings(Text, Recommendation.Current, Recommendation.bHasExplicitPCH);
+		}
+
+		Recommendation.Recommended = RecommendUnitySettings(Recommendation.Stats, Recommendation.bHasExplicitPCH, &Recommendation.Reasons);
+	});
+
+	OutRecommendations.Sort([](const FUnityRecommendation& A, const FUnityRecommendation& B)
+	{
+		return A.Stats.SourceFiles > B.Stats.SourceFiles;
+	});
+}
+
+bool ApplyUnityRecommendations(const TArray<FUnityRecommendation>& Recommendations, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors)
+{
+	for (const FUnityRecommendation& Recommendation : Recommendations)
+	{
+		if (!Recommendation.NeedsChange())
+		{
+			continue;
+		}
+
+		FString Text;
+		bool bHasBom = false;
+		if (!LoadTextPreservingEncoding(Recommendation.BuildCsPath, Text, bHasBom))
+		{
+			OutErrors.Add(TEXT("读取失败：") + Recommendation.BuildCsPath);
+			continue;
+		}
+
+		FString NewText;
+		FString Error;
+		if (!ApplyUnitySettingsToBuildCs(Text, Recommendation.Recommended, NewText, Error))
+		{
+			OutErrors.Add(Recommendation.BuildCsPath + TEXT("：") + Error);
+			continue;
+		}
+
+		OutDiff += MakeUnifiedDiff(Recommendation.BuildCsPath, Text, NewText);
+
+		if (!bDryRun && !NewText.Equals(Text, ESearchCase::CaseSensitive)
+			&& !SaveTextPreservingEncoding(Recommendation.BuildCsPath, NewText, bHasBom))
+		{
+			OutErrors.Add(TEXT("写入失败：") + Recommendation.BuildCsPath);
+		}
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+FString FormatUnityReport(const TArray<FUnityRecommendation>& Recommendations)
+{
+	using namespace UnityBuildAdvisorPrivate;
+
+	int32 ChangeCount = 0;
+	for (const FUnityRecommendation& Recommendation : Recommendations)
+	{
+		ChangeCount += Recommendation.NeedsChange() ? 1 : 0;
+	}
+
+	FString Report = FString::Printf(TEXT("模块 %d 个，需要调整 %d 个\n\n"), Recommendations.Num(), ChangeCount);
+
+	for (const FUnityRecommendation& Recommendation : Recommendations)
+	{
+		const FUnityBuildSettings& Current = Recommendation.Current;
+		const FUnityBuildSettings& Recommended = Recommendation.Recommended;
+
+		Report += FString::Printf(TEXT("%s %s（%d 个 .cpp，%lld 行，%.1f KB）%s\n"),
+			Recommendation.NeedsChange() ? TEXT("*") : TEXT(" "),
+			*Recommendation.ModuleName, Recommendation.Stats.SourceFiles, Recommendation.Stats.SourceLines,
+			Recommendation.Stats.SourceBytes / 1024.0,
+			Recommendation.bHasExplicitPCH ? TEXT(" 显式 PCH") : TEXT(""));
+
+		Report += FString::Printf(TEXT("    bUseUnity %s -> %s，MinSourceFilesForUnityBuildOverride %s -> %s，MinFilesUsingPrecompiledHeaderOverride %s -> %s，NumIncludedBytesPerUnityCPPOverride %s -> %s\n"),
+			*Describe(Current.bUseUnity), *Describe(Recommended.bUseUnity.IsSet() ? Recommended.bUseUnity : Current.bUseUnity),
+			*Describe(Current.MinSourceFilesForUnityBuildOverride), *Describe(Recommended.MinSourceFilesForUnityBuildOverride.IsSet() ? Recommended.MinSourceFilesForUnityBuildOverride : Current.MinSourceFilesForUnityBuildOverride),
+			*Describe(Current.MinFilesUsingPrecompiledHeaderOverride), *Describe(Recommended.MinFilesUsingPrecompiledHeaderOverride.IsSet() ? Recommended.MinFilesUsingPrecompiledHeaderOverride : Current.MinFilesUsingPrecompiledHeaderOverride),
+			*Describe(Current.NumIncludedBytesPerUnityCPPOverride), *Describe(Recommended.NumIncludedBytesPerUnityCPPOverride.IsSet() ? Recommended.NumIncludedBytesPerUnityCPPOverride : Current.NumIncludedBytesPerUnityCPPOverride));
+
+		for (const FString& Reason : Recommendation.Reasons)
+		{
+			Report += TEXT("    - ") + Reason + TEXT("\n");
+		}
+	}
+
+	return Report;
+}
+
+} // namespace ModuleBuilder
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+
+/**
+ * 编译单元中一次 #include 的解析耗时（含其嵌套包含）
+ */
+struct FCompileTimeInclude
+{
+	FString Path;
+	int64 Micros = 0;
+};
+
+/**
+ * 一个编译单元的 -ftime-trace 记录
+ */
+struct FCompileTimeUnit
+{
+	FString TracePath;
+
+	// .json 对应的源文件名（如 Module.Foo.cpp、Foo.gen.cpp）
+	FString SourceName;
+
+	// 所属的图内模块
+	int32 Module = INDEX_NONE;
+
+	// 缓存键
+	int64 TimestampTicks = 0;
+	int64 FileSize = 0;
+
+	int64 FrontendMicros = 0;
+	int64 BackendMicros = 0;
+	int64 TotalMicros = 0;
+
+	// 追踪中的头文件解析耗时：工程内的全部保留，工程外只保留耗时较大的。
+	// clang 只记录超过 -ftime-trace-granularity 的事件，不能用来判断包含了哪些文件
+	TArray<FCompileTimeInclude> Includes;
+
+	// UBT 写在目标文件旁的依赖列表（.d / .dep.json）中工程内的文件，用于重编范围
+	TArray<FString> Dependencies;
+	bool bHasDependencies = false;
+};
+
+/**
+ * 一次索引更新的统计
+ */
+struct FCompileTimeStats
+{
+	int32 TraceFiles = 0;
+	int32 Parsed = 0;     // 缓存未命中，重新解析
+	int32 Skipped = 0;    // 不是 -ftime-trace 输出，或无法解析
+	int32 Duplicates = 0; // 其他 Target / 配置下同一源文件的较旧记录
+	int32 Unowned = 0;    // 无法归到图内模块
+	int32 NoDependencies = 0; // 旁边没有 .d / .dep.json，不计入重编范围
+	FDateTime Newest = FDateTime::MinValue();
+	int64 CacheBytes = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * 一个模块的编译耗时
+ */
+struct FModuleCompileCost
+{
+	int32 Module = INDEX_NONE;
+	int32 Units = 0;
+
+	int64 FrontendMicros = 0;
+	int64 BackendMicros = 0;
+	int64 TotalMicros = 0;
+
+	// 最慢的编译单元
+	int32 SlowestUnit = INDEX_NONE;
+
+	// 本模块任一头文件变化时需要重编的编译单元（按 UBT 依赖列表中的实际包含）及其耗时
+	int32 RebuildUnits = 0;
+	int32 RebuildModules = 0;
+	int64 RebuildMicros = 0;
+
+	// 只改一个 .cpp 时的平均重编耗时
+	int64 AverageUnitMicros() const { return Units > 0 ? TotalMicros / Units : 0; }
+};
+
+/**
+ * 一个头文件在所有编译单元中的解析耗时
+ */
+struct FHeaderCompileCost
+{
+	FString Path;
+
+	// 所属的图内模块，引擎与第三方头文件为 INDEX_NONE
+	int32 Module = INDEX_NONE;
+
+	int32 Units = 0;
+	int64 TotalMicros = 0;
+};
+
+/**
+ * clang -ftime-trace 输出的编译耗时索引
+ *
+ * 在工程与各插件的 Intermediate/Build 下查找编译单元的 .json，按所在目录归到模块，
+ * 汇总前端 / 后端耗时与头文件解析耗时；包含关系取自 UBT 在同一目录写出的依赖列表，追踪只用于计时。
+ * 以修改时间 + 文件大小为键缓存解析结果，
+ * 存放在 Intermediate/ModuleBuilder 下；同一源文件在多个 Target / 配置下都有记录时只取最新的。
+ */
+class FCompileTimeIndex
+{
+public:
+	static FString GetCachePath();
+
+	// 解析一个 -ftime-trace 的 .json，不是追踪时返回 false；ProjectDir 下的头文件全部保留，其余只保留耗时较大的
+	static bool ParseTimeTrace(const FString& Text, const FString& ProjectDir, FCompileTimeUnit& OutUnit);
+
+	// 解析 UBT 的依赖列表：bMakeFormat 为 clang 的 .d，否则为 MSVC 的 .dep.json；路径原样输出
+	static bool ParseDependencyList(const FString& Text, bool bMakeFormat, TArray<FString>& OutPaths);
+
+	// 任意线程；CachePath 为空时不读写缓存
+	void Build(const FModuleDependencyGraph& Graph, const FString& CachePath, FCompileTimeStats& OutStats);
+
+	const TArray<FCompileTimeUnit>& GetUnits() const { return Units; }
+
+	// 每个图内模块一项，下标与图节点一致
+	TArray<FModuleCompileCost> ComputeModuleCosts(const FModuleDependencyGraph& Graph) const;
+
+	// OnlyModule 非空时只统计该模块的编译单元；按 TotalMicros 降序
+	TArray<FHeaderCompileCost> ComputeHeaderCosts(const FModuleDependencyGraph& Graph, int32 OnlyModule = INDEX_NONE) const;
+
+	// OnlyModule 非空时只报告该模块
+	FString BuildReport(const FModuleDependencyGraph& Graph, const FCompileTimeStats& Stats, const FString& OnlyModule = FString(), int32 MaxHeaders = 30) const;
+
+private:
+	TArray<FCompileTimeUnit> Units;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+class FExternalModuleIndex;
+
+/**
+ * 一条可以从 Public 降为 Private 的依赖
+ */
+struct FDependencyDemotion
+{
+	FString ModuleName;
+	FString BuildCsPath;
+	FString Dependency;
+
+	// Private 源文件中包含了该依赖的头文件；否则整个模块都没有包含它
+	bool bUsedPrivately = false;
+
+	// 依赖的头文件变化时，降级后不再需要重编的下游模块与 .cpp 数
+	TArray<FString> DownstreamModules;
+	int32 DownstreamTranslationUnits = 0;
+};
+
+/**
+ * 依赖降级分析结果
+ */
+struct FDemotionAnalysis
+{
+	TArray<FDependencyDemotion> Demotions;
+
+	// 找不到源码目录、无法判断的 Public 依赖（"模块: 依赖"）
+	TArray<FString> Unresolved;
+
+	// 没有 Public/Classes 目录、公开内容无法判断而跳过的模块
+	TArray<FString> SkippedModules;
+};
+
+/**
+ * 依据实际 #include 把只在 Private 中使用的 Public 依赖降为 Private
+ */
+namespace ModuleBuilder
+{
+	// 扫描图中每个模块的公开头文件与私有源文件
+	void AnalyzeDependencyDemotions(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, FDemotionAnalysis& OutAnalysis);
+
+	// 纯文本：把 Dependencies 从 Public 列表移到 Private 列表
+	bool DemoteDependenciesInBuildCs(const FString& InText, const TArray<FString>& Dependencies, FString& OutText, FString& OutError);
+
+	// 纯文本：加入依赖；已在 Private 中而要求 Public 时移到 Public 列表
+	bool AddDependenciesToBuildCs(const FString& InText, const TArray<FString>& Dependencies, bool bPublic, FString& OutText, FString& OutError);
+
+	// 纯文本：从 Public 与 Private 列表中删除依赖；单独的 Add("X") 语句整句删除
+	bool RemoveDependenciesFromBuildCs(const FString& InText, const TArray<FString>& Dependencies, FString& OutText, FString& OutError);
+
+	// bDryRun 时只生成 diff；否则写回内容有变化的 Build.cs
+	bool ApplyDependencyDemotions(const TArray<FDependencyDemotion>& Demotions, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors);
+
+	FString FormatDemotionReport(const FDemotionAnalysis& Analysis);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NewModuleParams.h"
+
+/**
+ * 描述文件中一个模块条目的位置
+ */
+struct FDescriptorModuleSpan
+{
+	// 模块名（Name 字段）
+	FString Name;
+
+	// 条目对象在文本中的范围 [Begin, End)
+	int32 Begin = INDEX_NONE;
+	int32 End = INDEX_NONE;
+};
+
+/**
+ * 描述文件（.uproject / .uplugin）的文本布局
+ * 只记录位置，不构建 JSON DOM
+ */
+struct FDescriptorLayout
+{
+	// 根对象的 { 与 }
+	int32 RootOpen = INDEX_NONE;
+	int32 RootClose = INDEX_NONE;
+
+	// 根对象最后一个成员值的结束位置（用于在末尾追加成员）
+	int32 LastMemberEnd = INDEX_NONE;
+
+	// "Modules" 键的起始位置与数组的 [ 和 ]，不存在时为 INDEX_NONE；值不是数组时只记录键
+	int32 ModulesKey = INDEX_NONE;
+	int32 ArrayOpen = INDEX_NONE;
+	int32 ArrayClose = INDEX_NONE;
+
+	TArray<FDescriptorModuleSpan> Modules;
+};
+
+/**
+ * 一次描述文件修补的结果
+ */
+struct FDescriptorPatchResult
+{
+	// 修补后内容与原内容不同
+	bool bChanged = false;
+
+	// 实际写回了磁盘；描述文件时间戳变化会让 UBT 丢弃缓存的 makefile 并重新生成
+	bool bWritten = false;
+};
+
+/**
+ * 保留格式的描述文件修补
+ * 只定位 Modules 数组并拼接新条目，其余字节保持原样
+ */
+namespace ModuleBuilder
+{
+	bool ScanDescriptorLayout(const FString& Text, FDescriptorLayout& OutLayout, FString& OutError);
+
+	// 纯文本操作，不访问磁盘
+	bool PatchDescriptorText(const FString& InText, const TArray<FNewModuleParams>& NewModules, FString& OutText, FString& OutError);
+
+	// 读取 → 修补 → 内容不变时跳过写回
+	bool PatchDescriptorFile(const FString& DescriptorPath, const TArray<FNewModuleParams>& NewModules, FDescriptorPatchResult& OutResult, FString& OutError);
+
+	// 纯文本：删除指定名字的条目及其分隔符；不存在的名字忽略
+	bool RemoveModulesFromDescriptorText(const FString& InText, const TArray<FString>& ModuleNames, FString& OutText, FString& OutError);
+
+	// 纯文本：改写条目中的字符串字段（如 LoadingPhase），字段不存在时追加到条目末尾
+	bool SetDescriptorModuleField(const FString& InText, const FString& ModuleName, const FString& Key, const FString& Value, FString& OutText, FString& OutError);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+
+/**
+ * 索引中的一个源文件或头文件
+ */
+struct FIncludeGraphFile
+{
+	FString Path;
+
+	// 所属的图内模块
+	int32 Module = INDEX_NONE;
+
+	// 缓存键：修改时间 + 文件大小 + 内容哈希
+	int64 TimestampTicks = 0;
+	int64 FileSize = 0;
+	uint32 ContentHash = 0;
+
+	bool bSource = false;
+
+	// #include 原文
+	TArray<FString> Includes;
+
+	// 解析到索引内文件的包含；其余（引擎头文件、.generated.h）只按原文计入 External
+	TArray<int32> Resolved;
+	TArray<FString> External;
+};
+
+/**
+ * 一次索引更新的统计
+ */
+struct FIncludeIndexStats
+{
+	int32 Files = 0;
+	int32 Parsed = 0;   // 缓存未命中，重新解析
+	int32 Rehashed = 0; // 时间戳变了但内容未变
+	int32 Removed = 0;  // 缓存中已删除的文件
+	int32 Edges = 0;
+	int32 UnresolvedEdges = 0;
+	int64 CacheBytes = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * 一个头文件的传递包含开销
+ */
+struct FHeaderIncludeCost
+{
+	int32 File = INDEX_NONE;
+
+	// 自身及传递包含的索引内文件
+	int32 ClosureFiles = 0;
+	int64 ClosureBytes = 0;
+
+	// 闭包中不同的外部包含
+	int32 ExternalIncludes = 0;
+
+	// 直接或间接包含它的 .cpp 数，即它变化时需要重编的编译单元
+	int32 IncludingSources = 0;
+
+	// 所有编译单元为它解析的字节数
+	int64 TotalParsedBytes() const { return ClosureBytes * IncludingSources; }
+};
+
+/**
+ * 一个模块的传递包含开销
+ */
+struct FModuleIncludeCost
+{
+	int32 Module = INDEX_NONE;
+	int32 SourceFiles = 0;
+	int32 Headers = 0;
+
+	// 各 .cpp 传递包含的索引内字节数之和（不含 .cpp 自身）
+	int64 ParsedBytes = 0;
+
+	// 其中来自其他模块的部分
+	int64 CrossModuleBytes = 0;
+
+	// 闭包中不同的外部包含
+	int32 ExternalIncludes = 0;
+};
+
+/**
+ * 工程与插件全部 Source 的头文件包含图索引
+ *
+ * 并行扫描各模块目录，以修改时间 + 大小 + 内容哈希为键缓存每个文件的 #include，
+ * 存放在 Intermediate/ModuleBuilder 下，下次只重新解析变化过的文件。
+ * 包含按 UBT 的可见性解析（与 PCH 建议共用 FIncludeResolver）：相对当前文件、本模块目录、可见模块的 Public / Classes / Internal。
+ */
+class FIncludeGraphIndex
+{
+public:
+	static FString GetCachePath();
+
+	// 任意线程；CachePath 为空时不读写缓存
+	void Build(const FModuleDependencyGraph& Graph, const FString& CachePath, FIncludeIndexStats& OutStats);
+
+	const TArray<FIncludeGraphFile>& GetFiles() const { return Files; }
+	int32 FindFile(const FString& Path) const;
+
+	// 直接包含本文件的文件
+	const TArray<int32>& GetIncluders(int32 File) const { return Includers[File]; }
+
+	// File 及其传递包含的索引内文件（升序）
+	TArray<int32> GetClosure(int32 File) const;
+
+	FHeaderIncludeCost GetHeaderCost(int32 File) const;
+	FModuleIncludeCost GetModuleCost(int32 Module) const;
+
+	// 所有头文件的开销，并行计算，按 TotalParsedBytes 降序
+	TArray<FHeaderIncludeCost> ComputeHeaderCosts() const;
+
+	// OnlyModule 非空时只报告该模块
+	FString BuildReport(const FModuleDependencyGraph& Graph, const FIncludeIndexStats& Stats, const FString& OnlyModule = FString(), int32 MaxHeaders = 30) const;
+
+private:
+	void Resolve(const FModuleDependencyGraph& Graph);
+
+	TArray<FIncludeGraphFile> Files;
+	TMap<FString, int32> FileByPath;
+
+	// 反向边：直接包含本文件的文件
+	TArray<TArray<int32>> Includers;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+class FExternalModuleIndex;
+struct FModuleNode;
+
+/**
+ * 模块目录结构与 #include 解析，PCH 建议、包含图索引与拆分 / 重命名共用
+ */
+namespace ModuleBuilder
+{
+	// 模块内的顶层目录；前三个对依赖方可见
+	extern const TCHAR* const GModuleTopFolders[4];
+
+	// 依赖方能通过 #include 看到的顶层目录：Public / Classes / Internal
+	inline TArrayView<const TCHAR* const> GetPublicTopFolders() { return MakeArrayView(GModuleTopFolders, 3); }
+
+	// 相对模块目录的路径去掉顶层 Public/Private/... 之后的部分，即依赖方 #include 的写法；
+	// bOutPublic 为是否位于对依赖方可见的顶层目录
+	FString GetIncludeKey(const FString& ModuleDir, const FString& Path, bool* bOutPublic = nullptr);
+
+	// 模块目录下扩展名为 Extension（如 ".cpp"）的文件；含 *.Build.cs 的子目录是另一个模块，不再深入
+	void FindModuleFiles(const FString& ModuleDir, const TCHAR* Extension, TArray<FString>& OutFiles);
+}
+
+/**
+ * 按 UBT 的可见性解析 #include：当前文件目录、本模块目录，再到可见模块的 Public / Classes / Internal
+ *
+ * 结果按包含原文缓存，一个解析器只用于同一模块中的文件。非线程安全，并行时每个线程各建一个。
+ */
+class FIncludeResolver
+{
+public:
+	// 判断文件是否存在；为空时访问磁盘
+	using FFileExists = TFunction<bool(const FString& Path)>;
+
+	explicit FIncludeResolver(TArray<FString> InSearchDirs, FFileExists InFileExists = FFileExists());
+
+	// 本模块的顶层目录与模块目录，之后是直接依赖与沿 Public 依赖传递可见的模块的公开目录与上级目录
+	// （UBT 允许写成 <模块名>/Public/X.h）。External 为空时只查图内模块
+	static TArray<FString> GetSearchDirs(const FModuleDependencyGraph& Graph, FExternalModuleIndex* External, const FModuleNode& Node);
+
+	// 解析不到时返回空
+	FString Resolve(const FString& Include, const FString& FromDir);
+
+	// Path 及其传递包含的文件集合（已缓存）
+	const TSet<FString>& GetClosure(const FString& Path);
+
+	int64 GetFileSize(const FString& Path);
+	int64 GetBytes(const TSet<FString>& Files);
+
+	// 读取并解析文件中的 #include（已缓存）
+	const TArray<FString>& GetFileIncludes(const FString& Path);
+
+private:
+	bool FileExists(const FString& Path) const;
+
+	TArray<FString> SearchDirs;
+	FFileExists FileExistsFunc;
+	TMap<FString, FString> ResolveCache;
+	TMap<FString, TArray<FString>> IncludeCache;
+	TMap<FString, TSet<FString>> ClosureCache;
+	TMap<FString, int64> SizeCache;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleLoadRecorder.h"
+
+class FModuleDependencyGraph;
+
+/**
+ * 单个模块的加载阶段建议
+ */
+struct FLoadingPhaseRecommendation
+{
+	FString ModuleName;
+	FString DescriptorPath;
+	FString ModuleType;
+	FString CurrentPhase;
+
+	// 与 CurrentPhase 相同表示保持不变；"None" 表示不在启动时加载，首次使用时再加载
+	FString SuggestedPhase;
+
+	// 上次启动记录的加载耗时，没有记录时小于 0
+	double MeasuredMs = -1.0;
+	bool bUpperBound = false;
+
+	// Build.cs 依赖本模块、且在启动时加载的模块
+	TArray<FString> BootDependents;
+
+	// 以字符串引用模块名（LoadModule / GetModuleChecked 等）的其他模块
+	TArray<FString> NameReferences;
+
+	TArray<FString> Reasons;
+
+	bool NeedsChange() const { return SuggestedPhase != CurrentPhase; }
+};
+
+/**
+ * 一次分析的结果与启动耗时汇总
+ */
+struct FLoadingPhaseAnalysis
+{
+	TArray<FLoadingPhaseRecommendation> Recommendations;
+
+	// 上次启动的记录；没有记录时 bHasSession 为 false，只按源码给出建议
+	FModuleLoadSession Session;
+	bool bHasSession = false;
+
+	// 上次应用建议之前的记录，用于前后对比
+	FModuleLoadSession Baseline;
+	bool bHasBaseline = false;
+};
+
+/**
+ * 按实测加载耗时与启动期引用关系调整工程 / 插件模块的 LoadingPhase
+ *
+ * 启动时没有任何模块依赖、StartupModule 为空且没有反射类型的模块改为 None（按需加载）；
+ * 有启动代码的编辑器模块推迟到 PostEngineInit。其余模块保持不变并说明原因。
+ */
+namespace ModuleBuilder
+{
+	FString GetLoadingPhaseBaselinePath();
+
+	// 任意线程；Session 为空路径时不读取启动记录
+	void AnalyzeLoadingPhases(const FModuleDependencyGraph& Graph, const FString& SessionPath, FLoadingPhaseAnalysis& OutAnalysis);
+
+	// bDryRun 时只生成 diff；否则改写描述文件，并把当前启动记录保存为对比基线
+	bool ApplyLoadingPhases(const FLoadingPhaseAnalysis& Analysis, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors);
+
+	FString FormatLoadingPhaseReport(const FLoadingPhaseAnalysis& Analysis);
+
+	// 新建模块窗口中各 LoadingPhase 选项的说明
+	FText GetLoadingPhaseGuidance(const FString& Phase, const FString& ModuleType);
+}
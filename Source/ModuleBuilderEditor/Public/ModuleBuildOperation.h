@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleDependencyGraph.h"
+#include "ModuleGenerator.h"
+#include "NewModuleParams.h"
+
+#include <atomic>
+
+// bSuccess, Message（失败时为错误信息）
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModuleBuildCompleted, bool, const FString&);
+
+/**
+ * 一次异步的模块生成
+ *
+ * 渲染、暂存与一次性写盘在 UE::Tasks 工作线程上执行，
+ * 进度与状态可在任意线程读取，完成回调总在游戏线程广播。
+ * 调用方应在 Launch 所在的同一帧内绑定 OnCompleted（完成回调至少晚一帧到达）。
+ */
+class FModuleBuildOperation : public TSharedFromThis<FModuleBuildOperation, ESPMode::ThreadSafe>
+{
+public:
+	// 目标需在游戏线程上先解析好（依赖 IPluginManager）；Timing 为调用方已开始计时的操作，为空时新建
+	static TSharedRef<FModuleBuildOperation, ESPMode::ThreadSafe> Launch(const FNewModuleParams& Params, const FTargetResolveResult& Target,
+		const TSharedPtr<FModuleOperationTiming, ESPMode::ThreadSafe>& Timing = nullptr);
+
+	FModuleBuildOperation(const FNewModuleParams& InParams, const FTargetResolveResult& InTarget, const TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe>& InTiming);
+
+	float GetProgress() const { return Progress.load(); }
+	FText GetStatusText() const;
+
+	bool IsRunning() const { return bRunning.load(); }
+
+	// 写盘之前都可以取消；写盘本身要么全部成功，要么不留下任何文件
+	void Cancel() { bCancelRequested.store(true); }
+	bool IsCancelRequested() const { return bCancelRequested.load(); }
+
+	const FNewModuleParams& GetParams() const { return Params; }
+	const FTargetResolveResult& GetTarget() const { return Target; }
+
+	// 描述文件是否因本次写入导致 UBT makefile 失效
+	bool InvalidatedMakefile() const { return bInvalidatedMakefile.load(); }
+
+	FOnModuleBuildCompleted& OnCompleted() { return CompletedEvent; }
+
+private:
+	void Run();
+	void SetStage(float InProgress, const FString& InStatus);
+	void Finish(bool bSuccess, const FString& Message);
+
+	// PCHHeaderOwners 在工作线程开始时填入，完成前其他线程不读取
+	FNewModuleParams Params;
+	const FTargetResolveResult Target;
+	const TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> Timing;
+
+	std::atomic<float> Progress { 0.f };
+	std::atomic<bool> bRunning { false };
+	std::atomic<bool> bCancelRequested { false };
+
+	mutable FCriticalSection StatusLock;
+	FString Status;
+
+	// 有未知 PCH 头文件时在 Launch（游戏线程）收集的工程与引擎 Source，用于查找所属模块
+	TArray<FModuleSourceRoot> PCHSearchRoots;
+
+	// 工作线程写盘后写入；游戏线程在完成回调中及之后通过 InvalidatedMakefile() 读取
+	std::atomic<bool> bInvalidatedMakefile { false };
+
+	FOnModuleBuildCompleted CompletedEvent;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ModuleBuilderCommandlet.generated.h"
+
+struct FModuleFileMoveRequest;
+struct FModuleRefactorPlan;
+
+/**
+ * 无界面批量生成模块
+ *
+ * 用法：
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Manifest=<清单.json> [-DryRun]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Graph [-Out=<报告.txt>]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Demote [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -SuggestPCH [-Module=<模块名>]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Includes [-Module=<模块名>]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Unity [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Split -Module=<模块名> [-Clusters=<N>] [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Merge -Into=<目标模块> -Modules=<模块1,模块2> [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -Rename -Module=<旧名> -NewName=<新名> [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -MoveFiles -From=<模块A> -To=<模块B> -Files=<文件1,文件2> [-Folder=<目标目录>] [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -LoadingPhases [-Apply]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -CompileTimes [-Module=<模块名>]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -StartupProfile [-Module=<模块名>]
+ *   UnrealEditor-Cmd <Project>.uproject -run=ModuleBuilder -nullrhi -ExportTemplates
+ *
+ * 清单格式：
+ *   { "Modules": [ { "Name": "Foo", "Type": "Runtime", "LoadingPhase": "Default", "Plugin": "可选插件名",
+ *                    "PCH": "None | Private | Shared", "PCHHeaders": [ "CoreMinimal.h" ],
+ *                    "Instrumented": false } ] }
+ */
+UCLASS()
+class UModuleBuilderCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UModuleBuilderCommandlet();
+
+	// UCommandlet
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 RunManifest(const FString& ManifestPath, bool bDryRun);
+
+	// 输出模块依赖分析报告；存在依赖环时返回 1
+	int32 RunGraph(const FString& OutPath);
+
+	// Public → Private 依赖降级；默认只预览
+	int32 RunDemote(bool bApply);
+
+	// 按包含频率输出 PCH 内容建议
+	int32 RunSuggestPCH(const FString& ModuleName);
+
+	// 增量更新包含图索引，输出头文件与模块的传递包含开销
+	int32 RunIncludes(const FString& ModuleName);
+
+	// 按源码规模调整各模块的 unity / PCH 阈值；默认只预览
+	int32 RunUnity(bool bApply);
+
+	// 按模块内包含图拆分模块；默认只预览
+	int32 RunSplit(const FString& ModuleName, int32 MaxClusters, bool bApply);
+
+	// 把若干模块并入目标模块；默认只预览
+	int32 RunMerge(const FString& TargetModule, const TArray<FString>& SourceModules, bool bApply);
+
+	// 重命名模块 / 把文件移到另一个模块；默认只预览
+	int32 RunRename(const FString& OldName, const FString& NewName, bool bApply);
+	int32 RunMoveFiles(const FModuleFileMoveRequest& Request, bool bApply);
+	int32 ApplyRefactor(const FModuleRefactorPlan& Plan, bool bApply);
+
+	// 按上次编辑器启动的加载耗时调整模块 LoadingPhase；默认只预览
+	int32 RunLoadingPhases(bool bApply);
+
+	// 汇总 clang -ftime-trace 记录，按模块与头文件输出编译耗时
+	int32 RunCompileTimes(const FString& ModuleName);
+
+	// 输出历次编辑器启动中各加载阶段与工程 / 插件模块的加载耗时
+	int32 RunStartupProfile(const FString& ModuleName);
+
+	// 把内置的生成模板导出到工程模板目录，作为自定义的起点
+	int32 RunExportTemplates();
+};
@@ -2,9 +2,15 @@
 
 #pragma once
 
+#include "Logging/LogMacros.h"
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogModuleBuilder, Log, All);
+
 struct FNewModuleParams;
+class FModuleBuildOperation;
+class FModuleCompileOperation;
+struct FTargetResolveResult;
 
 class FModuleBuilderEditorModule : public IModuleInterface
 {
@@ -16,7 +22,27 @@ public:
 private:
 	void RegisterMenus();
 	void OnClickAddModule();
+	void OnClickDependencyGraph();
+	void OnClickDemoteDependencies();
+	void OnClickSuggestPCH();
+	void OnClickIncludeIndex();
+	void OnClickUnitySettings();
+	void OnClickSplitModule();
+	void OnClickMergeModules();
+	void OnClickRefactorModule();
+	void OnClickLoadingPhases();
+	void OnClickCompileTimes();
+	void OnClickStartupProfile();
+
+	// 返回进行中的异步生成；为空表示参数校验失败（窗口保持打开）
+	TSharedPtr<FModuleBuildOperation, ESPMode::ThreadSafe> HandleConfirm(const FNewModuleParams& Params);
+
+	// 游戏线程上收到生成结果；ConfirmTime 为用户点击确认的时刻，用于统计热加载全程耗时
+	void HandleBuildCompleted(bool bSuccess, const FString& Message, TWeakPtr<FModuleBuildOperation, ESPMode::ThreadSafe> WeakOperation, double ConfirmTime);
+
+	// 生成成功后在后台只编译新模块并热加载，进度、输出与各阶段耗时显示在非模态通知中
+	void StartModuleCompile(const FString& ModuleName, const FTargetResolveResult& Target, double GenerateSeconds);
 
-	// 返回 true 表示成功（窗口会关闭），false 表示失败（窗口保持打开）
-	bool HandleConfirm(const FNewModuleParams& Params);
+	// 编译中的模块（完成后移除）
+	TArray<TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe>> ActiveCompiles;
 };
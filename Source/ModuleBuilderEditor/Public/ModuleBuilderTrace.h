@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// Unreal Insights 中的 ModuleBuilder 通道：-trace=cpu,counters,ModuleBuilder，或运行中 Trace.Enable ModuleBuilder
+UE_TRACE_CHANNEL_EXTERN(ModuleBuilderChannel)
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(ModuleBuilder_FilesWritten);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(ModuleBuilder_BytesWritten);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ModuleBuilder_DirsCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ModuleBuilder_DescriptorsPatched);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ModuleBuilder_PluginsScanned);
+
+/**
+ * 操作中的一个分项
+ */
+struct FModuleOperationStep
+{
+	FString Name;
+	double Seconds = 0.0;
+	int32 Calls = 0;
+};
+
+/**
+ * 一次操作（添加模块、批量生成、热加载）的分项耗时与计数
+ *
+ * 分项由 MODULEBUILDER_SCOPE 记录：既是 Insights 中 ModuleBuilder 通道的 CPU 事件，
+ * 也累加到当前线程挂着的操作上。分项名不会自动加上父项前缀，嵌套的分项由调用处直接写成
+ * "父.子"（如 "CompileTimes.Parse"），其耗时包含在父项中。
+ * Finish 时输出一行摘要；开启 CSV（-ModuleBuilderTimingCsv 或 ModuleBuilder.TimingCsv 1）时
+ * 追加到 Saved/Logs/ModuleBuilderTimings.csv，便于对比不同机器、不同磁盘上的耗时。线程安全。
+ */
+class FModuleOperationTiming : public TSharedFromThis<FModuleOperationTiming, ESPMode::ThreadSafe>
+{
+public:
+	static TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> Create(const FString& Operation);
+
+	// 当前线程上挂着的操作，没有时为空
+	static FModuleOperationTiming* GetCurrent();
+
+	static bool IsCsvEnabled();
+	static FString GetCsvPath();
+
+	explicit FModuleOperationTiming(const FString& InOperation);
+
+	void AddStep(const TCHAR* Step, double Seconds);
+	void AddCount(const TCHAR* Counter, int64 Value);
+
+	// 当前线程上有操作时计入
+	static void AddCountToCurrent(const TCHAR* Counter, int64 Value);
+
+	// 输出摘要与 CSV；只在第一次调用时生效
+	void Finish(bool bSuccess);
+
+	FString FormatSummary() const;
+
+private:
+	const FString Operation;
+	const FDateTime Timestamp;
+	const double StartTime;
+
+	mutable FCriticalSection Lock;
+	TArray<FModuleOperationStep> Steps;
+	TArray<TPair<FString, int64>> Counts;
+	double TotalSeconds = 0.0;
+	bool bSuccess = false;
+	bool bFinished = false;
+};
+
+/**
+ * 把操作挂到当前线程，作用域结束时恢复之前的操作
+ */
+class FModuleOperationTimingScope
+{
+public:
+	explicit FModuleOperationTimingScope(const TSharedPtr<FModuleOperationTiming, ESPMode::ThreadSafe>& Timing);
+	~FModuleOperationTimingScope();
+
+private:
+	TSharedPtr<FModuleOperationTiming, ESPMode::ThreadSafe> Timing;
+	FModuleOperationTiming* Previous = nullptr;
+};
+
+/**
+ * 计入当前操作的一个分项；构造时线程上没有操作则只有 Insights 事件
+ */
+class FModuleTimedStep
+{
+public:
+	explicit FModuleTimedStep(const TCHAR* InName);
+	~FModuleTimedStep();
+
+private:
+	const TCHAR* Name;
+	FModuleOperationTiming* Timing;
+	double StartTime;
+};
+
+// Name 为字符串字面量，如 MODULEBUILDER_SCOPE("Descriptor.Patch")
+#define MODULEBUILDER_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, ModuleBuilderChannel); \
+	FModuleTimedStep PREPROCESSOR_JOIN(ModuleBuilderStep_, __LINE__)(TEXT(Name))
+
+// Counter 为上面声明的计数器去掉 ModuleBuilder_ 前缀，如 MODULEBUILDER_COUNT(FilesWritten, 3)
+#define MODULEBUILDER_COUNT(Counter, Value) \
+	TRACE_COUNTER_ADD(ModuleBuilder_##Counter, Value); \
+	FModuleOperationTiming::AddCountToCurrent(TEXT(#Counter), Value)
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleBuilderTrace.h"
+#include "ModuleGenerator.h"
+
+class FMonitoredProcess;
+
+// 一行编译输出（UBT 标准输出 / 标准错误合并）
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnModuleCompileOutput, const FString&);
+
+// bSuccess, Message（失败时为错误信息）
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModuleCompileCompleted, bool, const FString&);
+
+/**
+ * 从确认到模块加载完成的各阶段耗时（秒）
+ */
+struct FModuleHotLoadTimings
+{
+	// 生成文件与修补描述文件（由调用方填写）
+	double Generate = 0.0;
+
+	// UBT 编译与链接
+	double Compile = 0.0;
+
+	// 挂载插件 / 登记二进制目录 / 刷新模块路径
+	double Register = 0.0;
+
+	// LoadModule，含 StartupModule 与 UObject 注册
+	double Load = 0.0;
+
+	double GetTotal() const { return Generate + Compile + Register + Load; }
+
+	// 单行摘要，用于通知与日志
+	FString ToString() const;
+};
+
+/**
+ * 只编译新模块的后台 UBT 调用，并热加载到正在运行的编辑器
+ *
+ * 以编辑器 Target 调用 UnrealBuildTool 并加 -Module=<Name>，UBT 只执行该模块的编译与链接动作，
+ * 不重新生成项目文件，也不重链整个编辑器。编译成功后在游戏线程登记二进制位置
+ * （未挂载的插件通过 IPluginManager 挂载），再通过 FModuleManager 加载模块，StartupModule 立即执行。
+ * 输出与完成回调都在游戏线程广播；调用方应在 Launch 所在的同一帧内绑定。
+ */
+class FModuleCompileOperation : public TSharedFromThis<FModuleCompileOperation, ESPMode::ThreadSafe>
+{
+public:
+	// 需在游戏线程调用；命令行无法构造（如纯蓝图工程没有 Editor Target）时返回空并填写 OutError
+	static TSharedPtr<FModuleCompileOperation, ESPMode::ThreadSafe> Launch(const FString& ModuleName, const FTargetResolveResult& Target, FString& OutError);
+
+	// UBT 可执行文件与参数
+	static bool MakeCommandLine(const FString& ModuleName, FString& OutExecutable, FString& OutArguments, FString& OutError);
+
+	// 工程 Source 目录下的 *Editor.Target.cs 对应的 Target 名
+	static FString FindEditorTargetName();
+
+	// Live Coding 会话持有编辑器 Target 时 UBT 拒绝编译，返回原因；未启用时为空
+	static FString GetLiveCodingBlocker();
+
+	FModuleCompileOperation(const FString& InModuleName, const FTargetResolveResult& InTarget);
+	~FModuleCompileOperation();
+
+	const FString& GetModuleName() const { return ModuleName; }
+	const FTargetResolveResult& GetTarget() const { return Target; }
+
+	bool IsRunning() const { return bRunning; }
+
+	// UBT -Progress 报告的进度，未收到时为 0
+	float GetProgress() const { return Progress; }
+
+	// 结束 UBT 及其子进程（编译器、链接器）
+	void Cancel();
+	bool IsCancelRequested() const { return bCancelRequested; }
+
+	// 完整输出，便于失败时查看
+	const TArray<FString>& GetOutputLines() const { return OutputLines; }
+
+	// Compile / Register / Load 由本对象计时，Generate 由调用方补上
+	const FModuleHotLoadTimings& GetTimings() const { return Timings; }
+
+	FOnModuleCompileOutput& OnOutput() { return OutputEvent; }
+	FOnModuleCompileCompleted& OnCompleted() { return CompletedEvent; }
+
+private:
+	bool Start(const FString& Executable, const FString& Arguments, FString& OutError);
+
+	// 以下均在游戏线程执行
+	void HandleOutputLine(const FString& Line);
+	void HandleProcessCompleted(int32 ReturnCode);
+	bool RegisterCompiledModule(FString& OutError);
+	bool LoadCompiledModule(FString& OutError);
+	void Finish(bool bSuccess, const FString& Message);
+
+	const FString ModuleName;
+	const FTargetResolveResult Target;
+
+	TSharedPtr<FMonitoredProcess> Process;
+
+	// 仅游戏线程访问
+	bool bRunning = false;
+	bool bCancelRequested = false;
+	float Progress = 0.f;
+	TArray<FString> OutputLines;
+	double StartTime = 0.0;
+	FModuleHotLoadTimings Timings;
+
+	// 编译、登记与加载的分项，结束时输出摘要
+	TSharedRef<FModuleOperationTiming, ESPMode::ThreadSafe> Timing;
+
+	FOnModuleCompileOutput OutputEvent;
+	FOnModuleCompileCompleted CompletedEvent;
+};
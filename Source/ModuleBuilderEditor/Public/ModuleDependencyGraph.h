@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 一个包含 Build.cs 的源码根目录（工程 Source 或某个插件的 Source）
+ */
+struct FModuleSourceRoot
+{
+	FString Dir;
+
+	// 工程名或插件名
+	FString Owner;
+};
+
+/**
+ * Build.cs 中的一个模块名字符串
+ */
+struct FBuildCsLiteral
+{
+	FString Name;
+
+	// 含引号的范围 [Begin, End)
+	int32 Begin = INDEX_NONE;
+	int32 End = INDEX_NONE;
+};
+
+/**
+ * Build.cs 中一次 Public/PrivateDependencyModuleNames.Add / AddRange 调用
+ */
+struct FBuildCsDependencyList
+{
+	bool bPublic = true;
+	bool bAddRange = true;
+
+	// 列表名起始位置与调用的 ( 和 )
+	int32 NameBegin = INDEX_NONE;
+	int32 ParenOpen = INDEX_NONE;
+	int32 ParenClose = INDEX_NONE;
+
+	TArray<FBuildCsLiteral> Literals;
+};
+
+/**
+ * Build.cs 中一条简单赋值语句：Key = Value;
+ */
+struct FBuildCsAssignment
+{
+	FString Key;
+	FString Value;
+
+	// 语句起点（Key 第一个字符）、值的范围 [ValueBegin, ValueEnd)、分号之后的位置
+	int32 StatementBegin = INDEX_NONE;
+	int32 ValueBegin = INDEX_NONE;
+	int32 ValueEnd = INDEX_NONE;
+	int32 StatementEnd = INDEX_NONE;
+};
+
+/**
+ * 从 Build.cs 解析出的一个模块
+ */
+struct FModuleNode
+{
+	FString Name;
+	FString Owner;
+	FString ModuleDir;
+	FString BuildCsPath;
+
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+
+	// .cpp 数量，作为编译开销的估计
+	int32 SourceFiles = 0;
+
+	// 解析到图中节点的依赖（外部模块不在图中）
+	TArray<int32> PublicEdges;
+	TArray<int32> AllEdges;
+};
+
+/**
+ * 工程与插件的模块依赖图
+ */
+class FModuleDependencyGraph
+{
+public:
+	// 游戏线程：工程 Source 与所有工程插件（含未挂载）的 Source
+	static TArray<FModuleSourceRoot> GetProjectSourceRoots();
+
+	// 任意线程：解析所有 *.Build.cs，统计源文件数量
+	void Build(const TArray<FModuleSourceRoot>& Roots);
+
+	const TArray<FModuleNode>& GetNodes() const { return Nodes; }
+	int32 FindNode(const FString& ModuleName) const;
+
+	// 直接依赖本模块的图内模块
+	const TArray<int32>& GetDependents(int32 Node) const { return Dependents[Node]; }
+
+	// 强连通分量中大于 1 个节点（或自依赖）的环
+	TArray<TArray<int32>> FindCycles() const;
+
+	// 沿 Public 依赖传递可见的全部模块名（含图外模块）
+	TSet<FString> GetPublicClosure(int32 Node) const;
+
+	// 本模块公开头文件变化时需要重新编译的图内模块
+	TSet<int32> GetRebuildExposure(int32 Node) const;
+
+	// 按源文件数加权的最长依赖链（从最底层依赖到最上层模块）
+	TArray<int32> ComputeCriticalPath(int32& OutCost) const;
+
+	FString BuildReport() const;
+
+	// 解析单个 Build.cs 文本中的依赖列表（会忽略注释）
+	static void ParseBuildCs(const FString& Text, TArray<FString>& OutPublic, TArray<FString>& OutPrivate);
+
+	// 同上，保留每个调用与字符串在原文中的位置，供改写 Build.cs 使用
+	static void ParseBuildCsLists(const FString& Text, TArray<FBuildCsDependencyList>& OutLists);
+
+	// 形如 Key = Value; 的语句（忽略注释，不含 == 比较）
+	static void ParseBuildCsAssignments(const FString& Text, TArray<FBuildCsAssignment>& OutAssignments);
+
+	// 源文件中的 #include 路径（忽略注释）
+	static void ParseIncludes(const FString& Text, TArray<FString>& OutIncludes);
+
+private:
+	TArray<FModuleNode> Nodes;
+	TMap<FString, int32> NodeByName;
+	TArray<TArray<int32>> Dependents;
+};
+
+/**
+ * 图外模块（引擎与引擎插件）的索引
+ * 只记录 Build.cs 位置，依赖列表按需解析
+ */
+class FExternalModuleIndex
+{
+public:
+	// 游戏线程：引擎 Source 与已启用的非工程插件的 Source
+	static TArray<FModuleSourceRoot> GetEngineSourceRoots();
+
+	// 任意线程：遍历目录收集 *.Build.cs
+	void Build(const TArray<FModuleSourceRoot>& Roots);
+
+	// 模块目录，未找到时返回空
+	FString FindModuleDir(const FString& ModuleName) const;
+
+	// 解析并缓存 Public 依赖（非线程安全）
+	const TArray<FString>& GetPublicDependencies(const FString& ModuleName);
+
+	// #include 写法对应的文件位于哪个模块的 Public / Classes / Internal 下；逐个模块查磁盘，未找到时返回空
+	FString FindHeaderOwner(const FString& Include) const;
+
+private:
+	TMap<FString, FString> BuildCsByName;
+	TMap<FString, TArray<FString>> PublicDependencyCache;
+};
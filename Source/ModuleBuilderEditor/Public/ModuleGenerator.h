@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NewModuleParams.h"
+
+struct FDescriptorPatchResult;
+class FExternalModuleIndex;
+class FModuleStagingArea;
+
+/**
+ * 目标解析结果
+ */
+struct FTargetResolveResult
+{
+	FString ContainerRoot;   // ProjectRoot 或 PluginRoot
+	FString DescriptorPath;  // .uproject 或 .uplugin
+	bool bIsProject = true;
+};
+
+/**
+ * 渲染出的单个模块文件（尚未写盘）
+ */
+struct FGeneratedModuleFile
+{
+	FString Path;
+	FString Text;
+};
+
+/**
+ * 批量生成结果
+ */
+struct FModuleBatchResult
+{
+	// 成功生成并注册的模块
+	TArray<FString> SucceededModules;
+
+	// 失败信息（每条对应一个模块或一个描述文件）
+	TArray<FString> Errors;
+
+	// 实际写回的描述文件数量
+	int32 DescriptorsWritten = 0;
+
+	// 写回后会导致 UBT makefile 失效的描述文件
+	TArray<FString> MakefileInvalidations;
+
+	// 一次性写盘的文件数与耗时；预览时为 0
+	int32 FilesWritten = 0;
+	double FlushSeconds = 0.0;
+
+	// 预览模式下全部文件的 diff
+	FString Diff;
+};
+
+/**
+ * 模块生成流程
+ * 编辑器窗口与 Commandlet 共用
+ */
+namespace ModuleBuilder
+{
+	bool ResolveTargetFromParams(const FNewModuleParams& Params, FTargetResolveResult& Out, FString& OutError);
+
+	// <ContainerRoot>/Source/<ModuleName> 的绝对路径
+	FString GetModuleDir(const FString& ContainerRoot, const FString& ModuleName);
+
+	// 模板对应的默认 PCH 头文件集合
+	TArray<FString> GetDefaultPCHHeaders(const FNewModuleParams& Params);
+
+	// 所属模块不在内置表中、也还没有解析过的 PCH 头文件
+	TArray<FString> GetUnknownPCHHeaders(const FNewModuleParams& Params);
+
+	// 在 Index（由工程与引擎的 Source 构建）的模块中查找未知 PCH 头文件的所属模块，写入 Params.PCHHeaderOwners；
+	// 找不到的生成时不加入依赖并记录警告
+	void ResolvePCHHeaderOwners(FNewModuleParams& Params, const FExternalModuleIndex& Index);
+
+	// PCH 文件相对模块目录的路径；None 时返回空
+	FString GetPCHHeaderRelativePath(const FString& ModuleName, EModulePCHMode Mode);
+
+	// PCH 头文件内容
+	FString MakePCHHeaderText(const FString& ModuleName, const TArray<FString>& Headers, EModulePCHMode Mode);
+
+	// 渲染 Build.cs / 头文件 / cpp（及可选 PCH），不访问磁盘
+	void RenderModuleFiles(const FString& ContainerRoot, const FNewModuleParams& Params, TArray<FGeneratedModuleFile>& OutFiles);
+
+	// 写入生成的 Build.cs 的 Public / Private 依赖
+	void GetModuleDependencies(const FNewModuleParams& Params, TArray<FString>& OutPublic, TArray<FString>& OutPrivate);
+
+	// 把渲染结果加入暂存区；任一文件已存在时一个也不加入
+	bool StageModuleFiles(FModuleStagingArea& Staging, const TArray<FGeneratedModuleFile>& Files, FString& OutError);
+
+	// 在暂存区中把模块加入描述文件，同一描述文件多次调用会累加
+	bool StageModulesInDescriptor(FModuleStagingArea& Staging, const FString& DescriptorPath, const TArray<FNewModuleParams>& Modules, FString& OutError);
+
+	// 改写已有文件时保留原有的 UTF-8 BOM 有无
+	bool LoadTextPreservingEncoding(const FString& Path, FString& OutText, bool& bOutHasBom);
+	bool SaveTextPreservingEncoding(const FString& Path, const FString& Text, bool bHasBom);
+
+	// 经暂存区一次性写盘，失败时不留下任何文件
+	bool GenerateModuleFilesToTarget(const FString& ContainerRoot, const FNewModuleParams& Params, FString& OutError);
+
+	bool AddModuleToDescriptor(
+		const FString& DescriptorPath,
+		const FString& ModuleName,
+		const FString& InModuleType,
+		const FString& InLoadingPhase,
+		FDescriptorPatchResult& OutPatch,
+		FString& OutError);
+
+	// 一次读取、一次写回，把多个模块加入同一个描述文件
+	bool AddModulesToDescriptor(const FString& DescriptorPath, const TArray<FNewModuleParams>& Modules, FDescriptorPatchResult& OutPatch, FString& OutError);
+
+	// 读取批量清单（JSON）
+	bool LoadModuleManifest(const FString& ManifestPath, TArray<FNewModuleParams>& OutModules, FString& OutError);
+
+	// 批量生成：并行渲染到暂存区，描述文件按路径分组修补，最后一次性写盘；
+	// bDryRun 时不写盘，只在 OutResult.Diff 中给出全部改动
+	void GenerateModuleBatch(const TArray<FNewModuleParams>& Modules, FModuleBatchResult& OutResult, bool bDryRun = false);
+}
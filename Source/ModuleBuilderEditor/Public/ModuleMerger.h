@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+class FExternalModuleIndex;
+
+/**
+ * 合并参数
+ */
+struct FModuleMergeOptions
+{
+	// 每个独立二进制在编辑器启动时的固定开销估计（加载动态库、符号重定位、模块注册），毫秒
+	double PerBinaryLoadMilliseconds = 2.0;
+};
+
+/**
+ * 被并入目标模块的一个模块
+ */
+struct FModuleMergeSource
+{
+	FString ModuleName;
+	FString ModuleDir;
+	FString BuildCsPath;
+
+	// 要移动的文件（绝对路径，不含 Build.cs 与删除的样板文件）
+	TArray<FString> Files;
+	int32 SourceFiles = 0;
+
+	// IMPLEMENT_MODULE 所在文件；只剩模块样板时整个删除，否则只删掉这一行
+	FString ModuleImplFile;
+	bool bDeleteModuleImpl = false;
+
+	// 生成器留下的空模块头文件，没有其他文件包含时一并删除
+	FString ModuleHeaderFile;
+
+	// 有反射类型时需要 /Script/<Name> 的包重定向
+	bool bHasReflectedTypes = false;
+
+	// 编辑器二进制大小（未编译时为 0）
+	int64 BinaryBytes = 0;
+};
+
+/**
+ * 依赖被合并模块的下游模块需要的改写
+ */
+struct FMergeDependentFix
+{
+	FString ModuleName;
+	FString BuildCsPath;
+
+	// 删掉的被合并模块
+	TArray<FString> RemovedDependencies;
+
+	// 任一被删依赖为 Public 时目标模块也加为 Public
+	bool bPublic = false;
+};
+
+/**
+ * 合并方案
+ */
+struct FModuleMergePlan
+{
+	FString TargetModule;
+	FString TargetDir;
+	FString TargetBuildCsPath;
+	int32 TargetSourceFiles = 0;
+	int64 TargetBinaryBytes = 0;
+
+	// 所在工程 / 插件（所有模块必须相同）
+	FString ContainerRoot;
+	FString DescriptorPath;
+	FString ModuleType;
+
+	// 目标模块原来的加载阶段，与合并后取的最早阶段
+	FString LoadingPhase;
+	FString MergedLoadingPhase;
+
+	TArray<FModuleMergeSource> Sources;
+
+	// 目标模块 Build.cs 需新增的依赖（来自被合并模块，已去掉合并组内的模块）
+	TArray<FString> AddedPublicDependencies;
+	TArray<FString> AddedPrivateDependencies;
+
+	TArray<FMergeDependentFix> DependentFixes;
+
+	// ExtraModuleNames 中列出了被合并模块的 *.Target.cs
+	TArray<FString> TargetCsFiles;
+
+	TArray<FString> Warnings;
+
+	// 模块化（编辑器）构建中需要链接与加载的二进制数
+	int32 BinariesBefore = 0;
+	int32 BinariesAfter = 0;
+
+	// 下游模块链接时引用的导入库数减少量
+	int32 DependentLinkInputsSaved = 0;
+
+	double EstimatedStartupSavingMs = 0.0;
+};
+
+/**
+ * 把若干小模块并入一个目标模块，减少链接步骤与编辑器启动时加载的动态库数量
+ *
+ * 被合并模块的文件按原相对路径移入目标模块，API 宏改为目标模块的宏，IMPLEMENT_MODULE 去掉（样板文件直接删除）；
+ * 依赖合并进目标 Build.cs，所有下游 Build.cs 改为依赖目标模块，描述文件删除旧条目，
+ * 反射类型通过 PackageRedirects 指向新包。要求模块同属一个工程 / 插件、Type 相同、合并后依赖无环。
+ */
+namespace ModuleBuilder
+{
+	// 任意线程；失败时填写 OutError（模块不存在、类型不同、会成环、StartupModule 有代码等）
+	bool PlanModuleMerge(const FModuleDependencyGraph& Graph, const FString& TargetModule, const TArray<FString>& SourceModules,
+		const FModuleMergeOptions& Options, FModuleMergePlan& OutPlan, FString& OutError);
+
+	FString FormatMergePlan(const FModuleMergePlan& Plan);
+
+	// 未指定模块时按工程 / 插件列出源文件最少的模块，供选择
+	FString FormatMergeCandidates(const FModuleDependencyGraph& Graph, int32 MaxModules = 30);
+
+	// bDryRun 时只列出动作与 diff；否则移动文件并改写 Build.cs、描述文件与配置
+	// 所有改动经暂存区一次写盘，任一步失败时磁盘保持原样
+	bool ApplyModuleMerge(const FModuleMergePlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+class IPlugin;
+
+/**
+ * 模块名的来源
+ */
+enum class EModuleNameOwner : uint8
+{
+	// 引擎模块（含引擎插件）
+	Engine,
+
+	// 当前工程描述文件中的模块
+	Project,
+
+	// 工程插件中的模块
+	ProjectPlugin,
+
+	// 只存在 Source/<Name> 目录，尚未注册
+	SourceFolder,
+};
+
+struct FModuleNameEntry
+{
+	EModuleNameOwner Owner = EModuleNameOwner::Engine;
+
+	// 插件名或目录路径，用于提示
+	FString OwnerName;
+};
+
+/**
+ * 全局模块名索引
+ *
+ * 收集引擎、工程、插件声明的模块以及工程 / 插件 Source 下已有的目录，
+ * 首次构建在后台完成，之后随插件挂载、磁盘扫描和新建模块增量更新。
+ * 查询为哈希查找（不区分大小写），可以在每次按键时调用。
+ */
+class FModuleNameIndex
+{
+public:
+	static FModuleNameIndex& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	// 在游戏线程收集已知模块，目录遍历放到工作线程
+	void StartBuild();
+
+	// 同步构建（Commandlet 使用）
+	void BuildBlocking();
+
+	bool IsReady() const { return bReady; }
+
+	// 以下仅限游戏线程
+	const FModuleNameEntry* Find(const FString& ModuleName) const { return Entries.Find(ModuleName); }
+	void AddModule(const FString& ModuleName, EModuleNameOwner Owner, const FString& OwnerName);
+
+	// 名称语法 + 冲突检查；返回 false 时 OutReason 为可直接显示的原因
+	bool ValidateNewModuleName(const FString& ModuleName, FText& OutReason) const;
+
+	// [A-Za-z_][A-Za-z0-9_]*
+	static bool IsValidModuleIdentifier(const FString& ModuleName);
+
+private:
+	// 游戏线程：插件、工程描述文件、模块管理器中的模块
+	void CollectKnownModules(TMap<FString, FModuleNameEntry>& OutEntries, TArray<FString>& OutSourceRoots) const;
+
+	// 任意线程：Source 下的目录
+	static void CollectSourceFolders(const TArray<FString>& SourceRoots, TMap<FString, FModuleNameEntry>& OutEntries);
+
+	void ApplyBuild(TMap<FString, FModuleNameEntry>&& Known, TMap<FString, FModuleNameEntry>&& Folders);
+
+	void HandlePluginMounted(IPlugin& Plugin);
+	void HandleScanCompleted();
+
+	TMap<FString, FModuleNameEntry> Entries;
+	bool bReady = false;
+	std::atomic<bool> bBuilding { false };
+
+	FDelegateHandle MountedHandle;
+	FDelegateHandle ScanHandle;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SourceRewrite.h"
+
+class FModuleDependencyGraph;
+struct FModuleSourceRoot;
+
+/**
+ * 把文件从一个模块移到另一个模块
+ */
+struct FModuleFileMoveRequest
+{
+	FString FromModule;
+	FString ToModule;
+
+	// 相对源模块目录的路径（如 Public/Inventory/Item.h）
+	TArray<FString> Files;
+
+	// 非空时放到目标模块的该目录下（如 Private/Inventory）；否则保持相对路径
+	FString DestinationFolder;
+};
+
+/**
+ * 重命名 / 移动文件的改写方案
+ */
+struct FModuleRefactorPlan
+{
+	// 一行描述，用于报告标题
+	FString Title;
+
+	// (原路径, 新路径)，按原路径排序
+	TArray<TPair<FString, FString>> Moves;
+
+	// 内容有变化的文件（按移动前的路径）
+	TArray<FPendingTextEdit> Edits;
+
+	// 移空后可删除的目录
+	TArray<FString> EmptiedDirs;
+
+	// 改名时需登记到名称索引的新模块名与所属
+	FString NewModuleName;
+	FString DescriptorPath;
+
+	// C++ 中模块加载调用以外仍有 "旧名" 字符串的文件；这些字符串不改写，需人工确认
+	TArray<FString> ReviewFiles;
+
+	TArray<FString> Warnings;
+
+	FRewriteScanStats Stats;
+};
+
+/**
+ * 模块重命名与跨模块移动文件
+ *
+ * 对工程与插件 Source 下的全部文件做一次并行扫描：内存映射读取，按字节预筛出含旧名的文件，
+ * 只有这些文件解码并改写 #include、*_API、IMPLEMENT_MODULE、Build.cs 类名与依赖、Target.cs 与描述文件，
+ * 内容未变化的文件不写回，不改变时间戳，增量编译不受影响。
+ */
+namespace ModuleBuilder
+{
+	// 任意线程；Roots 为 GetProjectSourceRoots 的结果（与 Graph 一致）
+	bool PlanModuleRename(const FModuleDependencyGraph& Graph, const TArray<FModuleSourceRoot>& Roots,
+		const FString& OldName, const FString& NewName, FModuleRefactorPlan& OutPlan, FString& OutError);
+
+	bool PlanModuleFileMove(const FModuleDependencyGraph& Graph, const TArray<FModuleSourceRoot>& Roots,
+		const FModuleFileMoveRequest& Request, FModuleRefactorPlan& OutPlan, FString& OutError);
+
+	FString FormatRefactorPlan(const FModuleRefactorPlan& Plan);
+
+	// bDryRun 时只输出 diff（最多 MaxDiffFiles 个文件）；否则移动与改动经暂存区一次写盘，失败时磁盘保持原样
+	bool ApplyModuleRefactor(const FModuleRefactorPlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors, int32 MaxDiffFiles = 40);
+}
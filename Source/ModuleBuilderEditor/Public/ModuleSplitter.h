@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+class FExternalModuleIndex;
+
+/**
+ * 拆分参数
+ */
+struct FModuleSplitOptions
+{
+	// 最多拆成几个模块（含保留原名的模块）
+	int32 MaxClusters = 6;
+
+	// 少于该文件数的簇并入联系最紧的簇；0 表示按模块大小自动取
+	int32 MinClusterFiles = 0;
+
+	// 被超过该比例的文件直接包含的头文件视为公共头，单独成 <Module>Core 簇
+	float HubShare = 0.25f;
+};
+
+/**
+ * 拆分出的一组文件
+ */
+struct FModuleSplitCluster
+{
+	// 新模块名；保留原模块的簇为原名
+	FString ModuleName;
+	bool bKeepsOriginal = false;
+
+	// 原模块目录下的绝对路径
+	TArray<FString> Files;
+	int32 SourceFiles = 0;
+
+	// 依赖的其他簇（模块名）；公开头文件包含到的为 Public
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+
+	// 需要 CoreRedirects 的反射类型：(Redirects 类别, 类型名)
+	TArray<TPair<FString, FString>> ReflectedTypes;
+};
+
+/**
+ * 一次编辑平均需要重编的 .cpp 数
+ */
+struct FRebuildEstimate
+{
+	double MeanHeaderEdit = 0.0;
+	int32 P90HeaderEdit = 0;
+	int32 MaxHeaderEdit = 0;
+
+	// 改一个 .cpp 时同一 unity 文件里被连带重编的 .cpp 数
+	double MeanSourceEdit = 0.0;
+};
+
+/**
+ * 下游模块需补的依赖
+ */
+struct FSplitDependentFix
+{
+	FString ModuleName;
+	FString BuildCsPath;
+	TArray<FString> Dependencies;
+
+	// 与原模块在该下游中的可见性一致
+	bool bPublic = false;
+};
+
+/**
+ * 拆分方案
+ */
+struct FModuleSplitPlan
+{
+	FString ModuleName;
+	FString ModuleDir;
+	FString BuildCsPath;
+
+	// 原模块所在工程 / 插件
+	FString ContainerRoot;
+	FString DescriptorPath;
+	FString ModuleType;
+	FString LoadingPhase;
+
+	// 原模块的依赖，新模块沿用
+	TArray<FString> PublicDependencies;
+	TArray<FString> PrivateDependencies;
+
+	int32 TotalFiles = 0;
+	int32 IncludeEdges = 0;
+	TArray<FString> HubHeaders;
+
+	TArray<FModuleSplitCluster> Clusters;
+
+	// 依赖原模块、包含了被移出头文件的下游模块
+	TArray<FSplitDependentFix> DependentFixes;
+
+	// 移动后无法编译、需要手工处理的包含（跨模块包含私有头文件）
+	TArray<FString> Warnings;
+
+	FRebuildEstimate Before;
+	FRebuildEstimate After;
+};
+
+/**
+ * 按模块内部 #include 图把大模块拆成若干内聚的小模块
+ *
+ * 聚类：文件为节点、包含关系为边（同名 .h/.cpp 加权），做加权标签传播；
+ * 被大多数文件包含的公共头单独成簇，过小的簇并入联系最紧的簇，簇之间成环的合并，保证新模块依赖无环。
+ * 应用：新模块经 GenerateModuleFilesToTarget / AddModuleToDescriptor 生成并注册，
+ * 文件按原相对路径移动，API 宏改为新模块的宏，原模块与下游模块的 Build.cs 补上依赖。
+ */
+namespace ModuleBuilder
+{
+	// 任意线程；失败时填写 OutError（模块不存在、文件太少等）
+	bool PlanModuleSplit(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, const FString& ModuleName,
+		const FModuleSplitOptions& Options, FModuleSplitPlan& OutPlan, FString& OutError);
+
+	FString FormatSplitPlan(const FModuleSplitPlan& Plan);
+
+	// 未指定模块时列出源文件最多的模块，供选择
+	FString FormatSplitCandidates(const FModuleDependencyGraph& Graph, int32 MaxModules = 20);
+
+	// bDryRun 时只列出动作与全部改动的 diff；否则生成模块、移动文件并改写 Build.cs 与描述文件，
+	// 全部经暂存区一次写盘，任一步失败时不改动磁盘
+	bool ApplyModuleSplit(const FModuleSplitPlan& Plan, bool bDryRun, FString& OutLog, TArray<FString>& OutErrors);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 暂存区中的一个文件
+ */
+struct FStagedFile
+{
+	FString Path;
+	FString Text;
+
+	// 已有文件的原内容与读取时的时间戳；新文件为空
+	FString OriginalText;
+	FDateTime Timestamp;
+	bool bExisting = false;
+	bool bHasBom = false;
+
+	// 写盘时删除的已有文件
+	bool bDelete = false;
+
+	// 由已有文件移动而来：原路径；OriginalText 为原文件内容，编码沿用原文件
+	FString MovedFrom;
+
+	bool IsChanged() const { return bDelete || !bExisting || !Text.Equals(OriginalText, ESearchCase::CaseSensitive); }
+};
+
+/**
+ * 一次写盘的结果
+ */
+struct FStagingFlushResult
+{
+	// 实际写入（新建或替换）的文件
+	TArray<FString> WrittenFiles;
+
+	// 删除（含移走）的文件
+	TArray<FString> DeletedFiles;
+
+	// 暂存后内容未变、没有写回的已有文件
+	int32 UnchangedFiles = 0;
+
+	int32 CreatedDirs = 0;
+	int64 BytesWritten = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * 生成流程的内存暂存区
+ *
+ * 新文件、对已有文件（描述文件等）的修改以及文件的移动、删除先记录在内存，可在不写盘的情况下校验并输出 diff。
+ * Flush 先把所有内容写成同目录下的临时文件，全部成功后再逐个改名替换；
+ * 要删除的文件改名为备份；任一步失败时删除临时文件、恢复被替换或删除的原文件并删掉新建的目录，磁盘回到写盘前的状态。
+ * 非线程安全。
+ */
+class FModuleStagingArea
+{
+public:
+	// 磁盘上或暂存区中已存在时失败
+	bool AddNewFile(const FString& Path, const FString& Text, FString& OutError);
+
+	// 第一次调用时读入已有文件，之后返回暂存中的文本。
+	// 指针在下一次 AddNewFile / EditFile / MoveFile / DeleteFile / Reset（含 StagePendingEdits 等间接调用）之前有效
+	FString* EditFile(const FString& Path, FString& OutError);
+
+	// 已有文件移到 To（To 不能已存在），返回 To 的暂存文本，可继续修改；原文件在写盘时删除。指针有效期同 EditFile
+	FString* MoveFile(const FString& From, const FString& To, FString& OutError);
+
+	// 写盘时删除已有文件；已在暂存区中的文件不能删除
+	bool DeleteFile(const FString& Path, FString& OutError);
+
+	bool Contains(const FString& Path) const;
+
+	const TArray<FStagedFile>& GetFiles() const { return Files; }
+	int32 NumChanged() const;
+
+	// 所有有变化的文件的 diff（新文件整段为新增），最多 MaxFiles 个
+	FString MakeDiff(int32 MaxFiles = MAX_int32) const;
+
+	// 一次性写盘：临时文件 → 改名替换；失败时恢复到写盘前的状态
+	bool Flush(FStagingFlushResult& OutResult, FString& OutError);
+
+	void Reset();
+
+private:
+	TArray<FStagedFile> Files;
+	TMap<FString, int32> FileByPath;
+};
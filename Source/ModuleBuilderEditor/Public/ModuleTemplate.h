@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 渲染模板时的变量
+ * 值为空的变量在 {{#if}} 中为假。以 FName 为键，变量名不区分大小写：{{modulename}} 与 {{ModuleName}} 是同一个变量
+ */
+class FModuleTemplateVariables
+{
+public:
+	void Set(FName Name, FString Value) { Values.Add(Name, MoveTemp(Value)); }
+
+	// 真为 "1"，假为空
+	void SetFlag(FName Name, bool bValue) { Values.Add(Name, bValue ? TEXT("1") : TEXT("")); }
+
+	const FString* Find(FName Name) const { return Values.Find(Name); }
+
+private:
+	TMap<FName, FString> Values;
+};
+
+/**
+ * 编译后的模板
+ *
+ * 语法：
+ *   {{Name}}                       变量；前面只有缩进时，多行的值逐行补上同样的缩进
+ *   {{#if Name}} {{#if !Name}}     条件块，可嵌套，可带 {{else}}，以 {{/if}} 结束
+ * 独占一行的条件标签连同所在行一起去掉，不留空行。{{ }} 中不是变量名或条件标签的内容原样输出。
+ * 未设置的变量输出为空。
+ *
+ * 编译时切分为文本片段与变量、跳转指令，渲染时一次遍历写入预先按长度分配好的缓冲区。
+ * 编译后只读，可在多个线程上同时渲染。
+ */
+class FModuleTemplate
+{
+public:
+	// 失败时 OutError 给出行号
+	static TSharedPtr<const FModuleTemplate, ESPMode::ThreadSafe> Compile(const FString& Source, FString& OutError);
+
+	void Render(const FModuleTemplateVariables& Variables, FString& OutText) const;
+	FString Render(const FModuleTemplateVariables& Variables) const;
+
+private:
+	enum class EOp : uint8
+	{
+		Text,
+		Variable,
+		If,
+		Else,
+		EndIf,
+	};
+
+	struct FToken
+	{
+		EOp Op = EOp::Text;
+		bool bNegate = false;
+
+		// Text：Source 中的范围；Variable：所在行的缩进
+		int32 Start = 0;
+		int32 Len = 0;
+
+		// Variable / If：Names 中的下标
+		int32 Name = INDEX_NONE;
+
+		// If：条件为假时跳到的指令；Else：跳到 EndIf
+		int32 Jump = INDEX_NONE;
+	};
+
+	FString Source;
+	TArray<FToken> Tokens;
+	TArray<FName> Names;
+
+	// 每个变量被输出的次数，用于预估长度
+	TArray<int32> NameUses;
+	int32 LiteralLen = 0;
+};
+
+/**
+ * 生成模块用的模板库
+ *
+ * 每个模板先找工程下 Config/ModuleBuilder/Templates/<名称>.template，没有时用内置模板；
+ * 第一次使用时编译并缓存，之后只在 Refresh 发现文件变化时重新编译。
+ * 工程模板编译失败时记录警告并改用内置模板。线程安全。
+ */
+class FModuleTemplateLibrary
+{
+public:
+	// 内置模板名称
+	static const TCHAR* BuildCs;
+	static const TCHAR* ModuleHeader;
+	static const TCHAR* ModuleCpp;
+	static const TCHAR* ModuleStatsHeader;
+	static const TCHAR* PCHHeader;
+
+	static FModuleTemplateLibrary& Get();
+
+	static FString GetTemplateDir();
+	static FString GetTemplatePath(const FString& Name);
+
+	// 所有内置模板的名称
+	static TArray<FString> GetBuiltInNames();
+
+	// 渲染一批文件前调用：检查已缓存的工程模板是否新增、修改或删除
+	void Refresh();
+
+	TSharedRef<const FModuleTemplate, ESPMode::ThreadSafe> Find(const FString& Name);
+
+	FString Render(const FString& Name, const FModuleTemplateVariables& Variables);
+
+	// 把内置模板写到模板目录作为自定义的起点，已有的文件不覆盖
+	bool ExportBuiltInTemplates(TArray<FString>& OutWritten, FString& OutError);
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<const FModuleTemplate, ESPMode::ThreadSafe> Template;
+
+		// 加载时工程模板文件的时间戳；没有文件时为 MinValue
+		FDateTime Timestamp;
+	};
+
+	FEntry Load(const FString& Name) const;
+
+	FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+};
@@ -14,6 +14,33 @@ enum class EModuleTargetType : uint8
 	ProjectPlugin,
 };
 
+/**
+ * 模块模板
+ */
+enum class EModuleArchetype : uint8
+{
+	// 标准模块：私有依赖 CoreUObject / Engine
+	Standard,
+
+	// 仅依赖 Core：不含 UObject 反射，UHT 不处理，启动时无 UObject 注册
+	CoreOnly,
+};
+
+/**
+ * 预编译头
+ */
+enum class EModulePCHMode : uint8
+{
+	// 不生成，沿用 UBT 的共享 PCH
+	None,
+
+	// Private/<Module>PCH.h，只供本模块使用（PrivatePCHHeaderFile）
+	Private,
+
+	// Public/<Module>SharedPCH.h，依赖本模块的模块也可复用（SharedPCHHeaderFile）
+	Shared,
+};
+
 /**
  * 新建模块所需参数
  * 由 SAddModuleWindow 收集，传递给 ModuleBuilderEditorModule 处理
@@ -29,9 +56,31 @@ struct FNewModuleParams
 	// 加载阶段（Default / PostEngineInit / ...）
 	FString LoadingPhase;
 
+	// 模块模板
+	EModuleArchetype Archetype = EModuleArchetype::Standard;
+
+	// 预编译头及其包含的头文件；头文件为空时按模板取默认集合
+	EModulePCHMode PCHMode = EModulePCHMode::None;
+	TArray<FString> PCHHeaders;
+
+	// 内置表之外的 PCH 头文件 → 所属模块，由 ResolvePCHHeaderOwners 填入
+	TMap<FString, FString> PCHHeaderOwners;
+
+	// 生成 Public/<Module>Stats.h：stat 分组、LLM 标签、CSV 分类与 Trace 通道，StartupModule / ShutdownModule 已埋点
+	bool bInstrumented = false;
+
+	// 追加到生成的 Build.cs 的依赖（拆分模块时沿用原模块的依赖）
+	TArray<FString> ExtraPublicDependencies;
+	TArray<FString> ExtraPrivateDependencies;
+
 	// 目标类型
 	EModuleTargetType TargetType = EModuleTargetType::Project;
 
 	// 当 TargetType = ProjectPlugin 时有效
 	FString TargetPluginName;
+
+	bool IsEditorModule() const
+	{
+		return ModuleType.Equals(TEXT("Editor"), ESearchCase::IgnoreCase);
+	}
 };
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+class FExternalModuleIndex;
+
+/**
+ * 一个候选 PCH 头文件的统计
+ */
+struct FPCHHeaderCandidate
+{
+	// #include 中的写法
+	FString Include;
+
+	// 直接包含它的 .cpp 数
+	int32 IncludingSources = 0;
+
+	// 传递包含的头文件数量与总字节数（解析不到的包含不计入）
+	int32 ClosureFiles = 0;
+	int64 ClosureBytes = 0;
+};
+
+/**
+ * 单个模块的 PCH 内容建议
+ */
+struct FPCHSuggestion
+{
+	FString ModuleName;
+	int32 SourceFiles = 0;
+
+	// Build.cs 中已有的 PrivatePCHHeaderFile / SharedPCHHeaderFile
+	FString ExistingPCH;
+
+	// 模块外、被足够多 .cpp 直接包含的头文件，按 包含次数 × 闭包大小 排序
+	TArray<FPCHHeaderCandidate> Candidates;
+
+	// 建议放入 PCH 的头文件
+	TArray<FString> Suggested;
+
+	// 建议集合的闭包大小（编译一次 PCH 的解析量）
+	int64 PCHBytes = 0;
+
+	// 不用 PCH 时，各 .cpp 为建议集合中的头文件解析的总字节数
+	int64 ParsedBytesWithoutPCH = 0;
+};
+
+/**
+ * 按实际包含频率给出 PCH 内容建议
+ */
+namespace ModuleBuilder
+{
+	// MinShare：至少被多少比例的 .cpp 直接包含才进入候选
+	void SuggestPCHContents(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, int32 ModuleNode,
+		float MinShare, int32 MaxHeaders, FPCHSuggestion& OutSuggestion);
+
+	FString FormatPCHSuggestion(const FPCHSuggestion& Suggestion);
+
+	// 图中所有模块（或仅 OnlyModule）的建议，按可省解析量排序
+	FString BuildPCHReport(const FModuleDependencyGraph& Graph, FExternalModuleIndex& External, const FString& OnlyModule = FString());
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * 磁盘上发现的一个插件描述文件
+ */
+struct FScannedPlugin
+{
+	// 插件名（.uplugin 文件名）
+	FString Name;
+
+	// .uplugin 绝对路径
+	FString DescriptorPath;
+
+	FString FriendlyName;
+
+	// 描述文件中声明的模块
+	TArray<FString> ModuleNames;
+
+	bool bEnabledByDefault = false;
+
+	// 缓存键：修改时间 + 文件大小 + 内容哈希
+	int64 TimestampTicks = 0;
+	int64 FileSize = 0;
+	uint32 ContentHash = 0;
+
+	FString GetBaseDir() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FScannedPlugin& Plugin);
+};
+
+/**
+ * 扫描统计
+ */
+struct FPluginScanStats
+{
+	int32 DescriptorsFound = 0;
+	int32 DescriptorsParsed = 0;   // 缓存未命中，重新解析
+	int32 DescriptorsRehashed = 0; // 时间戳变了但内容未变
+	double Seconds = 0.0;
+};
+
+/**
+ * 工程 Plugins/ 目录的后台扫描器
+ *
+ * 覆盖未启用、未挂载的工程插件。解析结果以时间戳 + 哈希为键缓存在
+ * Intermediate/ModuleBuilder 下，下次启动只重新解析变化过的描述文件。
+ */
+class FPluginDescriptorScanner
+{
+public:
+	static FPluginDescriptorScanner& Get();
+
+	// 在工作线程上扫描，完成后在游戏线程广播 OnScanCompleted
+	void StartScan();
+
+	// 在调用线程上同步扫描（Commandlet 使用）
+	void ScanBlocking();
+
+	bool IsScanning() const { return bScanning.load(); }
+
+	// 以下仅限游戏线程
+	const TArray<FScannedPlugin>& GetPlugins() const { return Plugins; }
+	const FScannedPlugin* FindPlugin(const FString& Name) const;
+	const FPluginScanStats& GetLastStats() const { return LastStats; }
+
+	FSimpleMulticastDelegate& OnScanCompleted() { return ScanCompletedEvent; }
+
+private:
+	static void Scan(const FString& PluginsDir, const FString& CachePath, TArray<FScannedPlugin>& OutPlugins, FPluginScanStats& OutStats);
+	static FString GetCachePath();
+
+	void ApplyResult(TArray<FScannedPlugin>&& InPlugins, const FPluginScanStats& InStats);
+
+	TArray<FScannedPlugin> Plugins;
+	TMap<FString, int32> PluginsByName;
+	FPluginScanStats LastStats;
+
+	std::atomic<bool> bScanning { false };
+	FSimpleMulticastDelegate ScanCompletedEvent;
+};
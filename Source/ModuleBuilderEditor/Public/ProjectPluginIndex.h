@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IPlugin;
+
+/**
+ * 工程插件索引
+ *
+ * 缓存已排序的工程插件名，随插件挂载 / 卸载事件增量更新，
+ * 插件选择器打开时不再遍历 IPluginManager。
+ * 同时合并磁盘扫描到的未启用 / 未挂载插件。
+ */
+class FProjectPluginIndex
+{
+public:
+	static FProjectPluginIndex& Get();
+
+	// 由模块启动 / 关闭时调用
+	void Initialize();
+	void Shutdown();
+
+	// 按名称排序；元素指针在缓存内复用，可直接作为 SListView 数据源
+	const TArray<TSharedPtr<FString>>& GetProjectPlugins();
+
+	// 每次内容变化递增，UI 据此判断是否需要刷新
+	uint32 GetRevision() const { return Revision; }
+
+private:
+	void Rebuild();
+	void HandlePluginMounted(IPlugin& Plugin);
+	void HandlePluginUnmounted(IPlugin& Plugin);
+	void HandleScanCompleted();
+
+	TArray<TSharedPtr<FString>> Plugins;
+	bool bDirty = true;
+	uint32 Revision = 0;
+
+	FDelegateHandle MountedHandle;
+	FDelegateHandle CreatedHandle;
+	FDelegateHandle UnmountedHandle;
+	FDelegateHandle ScanHandle;
+};
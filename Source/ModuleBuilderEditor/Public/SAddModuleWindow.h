@@ -6,8 +6,17 @@
 
 class SWindow;
 class SEditableTextBox;
+class SMultiLineEditableTextBox;
+class SComboButton;
+class SSearchBox;
+class ITableRow;
+class FActiveTimerHandle;
+class STableViewBase;
+template <typename ItemType> class SListView;
+class FModuleBuildOperation;
 
-DECLARE_DELEGATE_RetVal_OneParam(bool, FOnConfirmModule, const FNewModuleParams&);
+// 返回启动的异步生成；为空表示未启动（窗口保持可编辑）
+DECLARE_DELEGATE_RetVal_OneParam(TSharedPtr<FModuleBuildOperation, ESPMode::ThreadSafe>, FOnConfirmModule, const FNewModuleParams&);
 
 class SAddModuleWindow : public SCompoundWidget
 {
@@ -29,27 +38,80 @@ private:
 	// 输入控件
 	TSharedPtr<SEditableTextBox> ModuleNameText;
 
+	// 模块名实时校验（输入停顿后再查索引）
+	double LastNameEditTime = 0.0;
+	bool bNameValidationPending = false;
+	bool bNameValid = true;
+	FText NameValidationMessage;
+	TWeakPtr<FActiveTimerHandle> NameValidationTimer;
+
 	// 下拉选项：模块类型、加载阶段
 	TArray<TSharedPtr<FString>> ModuleTypeOptions;
 	TArray<TSharedPtr<FString>> LoadingPhaseOptions;
 	TSharedPtr<FString> SelectedModuleType;
 	TSharedPtr<FString> SelectedLoadingPhase;
 
+	// Core-only 模板相对标准模板的节省说明
+	FText CoreOnlySavingsText;
+
+	// 预编译头：模式下拉与头文件列表（每行一个）
+	TArray<TSharedPtr<FString>> PCHModeOptions;
+	TSharedPtr<FString> SelectedPCHMode;
+	TSharedPtr<SMultiLineEditableTextBox> PCHHeadersText;
+	FString PCHDefaultsText; // 最近一次填入的默认值，用户未改动时随模块类型更新
+
+	// 性能埋点：生成 stat 分组、LLM 标签、CSV 分类与 Trace 通道
+	bool bInstrumented = false;
+
 	// 目标类型下拉（工程 / 工程插件）
 	TArray<TSharedPtr<FString>> TargetTypeOptions;
 	TSharedPtr<FString> SelectedTargetType; // "Project" / "ProjectPlugin"
 
-	// 工程插件列表下拉（仅当选 ProjectPlugin 时显示）
-	TArray<TSharedPtr<FString>> ProjectPluginOptions; // 存插件名
+	// 工程插件选择器（仅当选 ProjectPlugin 时显示）
+	TArray<TSharedPtr<FString>> ProjectPluginOptions;  // 插件索引快照，元素与索引共享
+	TArray<TSharedPtr<FString>> FilteredPluginOptions; // 当前搜索结果
 	TSharedPtr<FString> SelectedProjectPlugin;
+	FString PluginFilter;
+	uint32 PluginIndexRevision = MAX_uint32;
+
+	TSharedPtr<SComboButton> PluginPickerButton;
+	TSharedPtr<SSearchBox> PluginSearchBox;
+	TSharedPtr<SListView<TSharedPtr<FString>>> PluginListView;
+	TSharedPtr<SWidget> PluginPickerMenu;
+
+	// 进行中的异步生成
+	TSharedPtr<FModuleBuildOperation, ESPMode::ThreadSafe> ActiveOperation;
 
 private:
 	void InitOptions();
 	void RefreshProjectPlugins();
 
+	// 插件选择器：虚拟化列表 + 输入即筛选
+	void ApplyPluginFilter(const FString& NewFilter, bool bFromScratch);
+	TSharedRef<SWidget> GetPluginPickerMenu();
+	TSharedRef<ITableRow> MakePluginRow(TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void HandlePluginSelected(TSharedPtr<FString> Item, ESelectInfo::Type SelectInfo);
+
 	// Slate 可见性：只有选了 ProjectPlugin 才显示插件下拉
 	EVisibility GetPluginPickerVisibility() const;
 
+	bool IsCoreOnlySelected() const;
+
+	// 预编译头
+	EModulePCHMode GetSelectedPCHMode() const;
+	void RefreshPCHDefaults(bool bForce);
+	TArray<FString> GetPCHHeaders() const;
+
+	// 模块名校验
+	void HandleModuleNameChanged(const FText& NewText);
+	EActiveTimerReturnType HandleNameValidationTimer(double InCurrentTime, float InDeltaTime);
+	void ValidateModuleName();
+
+	// 生成进行中：显示进度，取消按钮改为取消生成
+	bool IsBuilding() const;
+	EVisibility GetProgressVisibility() const;
+	void HandleBuildCompleted(bool bSuccess, const FString& Message);
+
 	// 按钮
 	FReply HandleConfirm();
 	FReply HandleCancel();
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/SlateDelegates.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SMultiLineEditableTextBox;
+
+// 游戏线程调用：收集所需状态，返回在工作线程执行的报告生成函数
+DECLARE_DELEGATE_RetVal(TFunction<FString()>, FOnPrepareReport);
+
+/**
+ * 通用的只读分析报告窗口
+ * 报告在工作线程生成，可刷新、可复制；可选一个修改类操作（结果替换报告内容）
+ * 可选一个输入框（例如模块名），回车即刷新
+ */
+class SModuleReportWindow : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SModuleReportWindow) {}
+	SLATE_EVENT(FOnPrepareReport, OnPrepareReport)
+	SLATE_ARGUMENT(FText, ActionText)
+	SLATE_EVENT(FOnPrepareReport, OnPrepareAction)
+	SLATE_ARGUMENT(FText, InputHint)
+	SLATE_EVENT(FOnTextChanged, OnInputChanged)
+SLATE_END_ARGS()
+
+void Construct(const FArguments& InArgs);
+
+	// 打开一个新窗口并立即开始生成
+	static void Open(const FText& Title, FOnPrepareReport OnPrepareReport,
+		const FText& ActionText = FText::GetEmpty(), FOnPrepareReport OnPrepareAction = FOnPrepareReport(),
+		const FText& InputHint = FText::GetEmpty(), FOnTextChanged OnInputChanged = FOnTextChanged());
+
+private:
+	void StartTask(const FOnPrepareReport& Prepare);
+	void HandleReportReady(uint32 RequestId, FString Report);
+
+	FReply HandleRefreshClicked();
+	FReply HandleCopyClicked();
+	FReply HandleActionClicked();
+	void HandleInputCommitted(const FText& Text, ETextCommit::Type CommitType);
+
+	FOnPrepareReport OnPrepareReport;
+	FOnPrepareReport OnPrepareAction;
+	FText ActionText;
+
+	TSharedPtr<SMultiLineEditableTextBox> ReportText;
+	FString Report;
+
+	// 只接受最后一次请求的结果
+	uint32 LatestRequestId = 0;
+	bool bGenerating = false;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleDescriptor.h"
+
+class FModuleStagingArea;
+
+/**
+ * 一个待写回的文本文件：保留原内容用于 diff 与"未变化则不写"
+ */
+struct FPendingTextEdit
+{
+	FString Path;
+	FString OldText;
+	FString NewText;
+	bool bHasBom = false;
+
+	bool IsChanged() const { return !NewText.Equals(OldText, ESearchCase::CaseSensitive); }
+};
+
+/**
+ * 改写规则的匹配方式
+ */
+enum class ETextRewriteKind : uint8
+{
+	// 整词标识符（XXX_API、类名）
+	Identifier,
+
+	// 带引号的完整字符串 "From"
+	QuotedString,
+
+	// #include "From" / <From> 的路径
+	IncludePath,
+
+	// IMPLEMENT_*MODULE(类名, From) 的模块名参数
+	ImplementModuleName,
+
+	// 模块加载类调用的第一个参数 "From" / TEXT("From")：LoadModule*、GetModule*、IsModuleLoaded 与 FModuleManager 的成员函数
+	ModuleLoadArgument,
+};
+
+/**
+ * 规则作用的文件类别
+ */
+enum class ETextRewriteFiles : uint8
+{
+	All,
+
+	// C++ 源文件与头文件
+	Code,
+
+	// *.Build.cs / *.Target.cs
+	Scripts,
+};
+
+/**
+ * 一条文本改写规则；From 与 To 相同时只记录命中，不改内容
+ */
+struct FTextRewriteRule
+{
+	ETextRewriteKind Kind = ETextRewriteKind::Identifier;
+	FString From;
+	FString To;
+	ETextRewriteFiles Files = ETextRewriteFiles::All;
+
+	// 非空时只作用于该文件或目录（bScopeRecursive 为 false 时不含子目录）
+	FString Scope;
+	bool bScopeRecursive = true;
+};
+
+/**
+ * 一次并行扫描的统计
+ */
+struct FRewriteScanStats
+{
+	int32 Files = 0;
+	int64 Bytes = 0;
+
+	// 通过内存映射读取的文件（其余回退为普通读取）
+	int32 MappedFiles = 0;
+
+	// 字节预筛命中、解码后逐条应用规则的文件
+	int32 Candidates = 0;
+	int32 Changed = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * 命中了至少一条规则的文件
+ */
+struct FRewrittenFile
+{
+	FPendingTextEdit Edit;
+
+	// 命中的规则下标（升序）
+	TArray<int32> Rules;
+};
+
+/**
+ * 只读匹配时命中了至少一条规则的文件
+ */
+struct FRuleMatchedFile
+{
+	FString Path;
+
+	// 命中的规则下标（升序）
+	TArray<int32> Rules;
+};
+
+/**
+ * 拆分 / 合并 / 重命名等跨模块改写共用的源码与配置文本操作
+ */
+namespace ModuleBuilder
+{
+	// 从模块目录向上查找 .uplugin / .uproject
+	bool FindModuleContainer(const FString& ModuleDir, FString& OutRoot, FString& OutDescriptor);
+
+	// 描述文件中模块的 Type / LoadingPhase；找不到时为 Runtime / Default
+	void ReadDescriptorModuleEntry(const FString& DescriptorPath, const FString& ModuleName, FString& OutType, FString& OutLoadingPhase);
+
+	// LoadingPhase 字符串；无法识别时为 Default
+	ELoadingPhase::Type ParseLoadingPhase(const FString& Phase);
+
+	// 去掉 // 与 /* */ 注释，字符串原样保留
+	FString StripCodeComments(const FString& Text);
+
+	// 去掉注释后 StartupModule 等函数各处函数体的内容（去掉首尾空白）；只有声明或函数体为空时为空
+	FString FindModuleFunctionBody(const FString& Text, const TCHAR* Function);
+
+	// StartupModule / ShutdownModule 的函数体里有代码
+	bool HasModuleLifecycleCode(const FString& Text);
+
+	// 行首 UCLASS / USTRUCT / UENUM / UINTERFACE 声明的类型：(Redirects 类别, 反射名)
+	void FindReflectedTypes(const FString& Text, TArray<TPair<FString, FString>>& OutTypes);
+
+	// 整词替换（避免 GAME_API 命中 MYGAME_API），返回是否有替换
+	bool ReplaceIdentifier(FString& Text, const FString& From, const FString& To);
+
+	// 在 [CoreRedirects] 节开头插入尚不存在的行，没有该节时追加到末尾
+	FString AddCoreRedirects(const FString& IniText, const TArray<FString>& Lines);
+
+	// 同一路径只读一次；bAllowMissing 时不存在的文件按空文本处理。返回的指针在下一次调用前有效
+	FPendingTextEdit* FindOrLoadPendingEdit(TArray<FPendingTextEdit>& Edits, const FString& Path, bool bAllowMissing, TArray<FString>& OutErrors);
+
+	// 所有有变化的文件的 diff
+	FString MakePendingDiff(const TArray<FPendingTextEdit>& Edits);
+
+	// 只写回内容有变化的文件
+	void SavePendingEdits(const TArray<FPendingTextEdit>& Edits, TArray<FString>& OutErrors);
+
+	// 把有变化的文件加入暂存区；读取后文件又被改过时失败
+	bool StagePendingEdits(FModuleStagingArea& Staging, const TArray<FPendingTextEdit>& Edits, FString& OutError);
+
+	// 纯文本：对 Path 应用作用域内的规则，OutHits 为命中的规则下标；返回内容是否变化
+	bool ApplyRewriteRules(const FString& Path, const FString& InText, const TArray<FTextRewriteRule>& Rules, FString& OutText, TArray<int32>& OutHits);
+
+	// 只读：Text 中命中的作用域内规则下标，不改写；每条规则按原文单独匹配，互不影响
+	void MatchRewriteRules(const FString& Path, const FString& Text, const TArray<FTextRewriteRule>& Rules, TArray<int32>& OutHits);
+
+	// Dirs 下可改写的文件：C++ 源码、Build.cs / Target.cs、.uproject / .uplugin
+	void CollectRewritableFiles(const TArray<FString>& Dirs, TArray<FString>& OutFiles);
+
+	// 任意线程；并行内存映射读取，按字节预筛出含任一规则原文的文件，只有这些文件解码并应用规则
+	void RewriteFiles(const TArray<FString>& Files, const TArray<FTextRewriteRule>& Rules, TArray<FRewrittenFile>& OutFiles, FRewriteScanStats& OutStats);
+
+	// 与 RewriteFiles 相同的扫描，只返回各文件命中的规则下标；规则的 To 不使用
+	void MatchFiles(const TArray<FString>& Files, const TArray<FTextRewriteRule>& Rules, TArray<FRuleMatchedFile>& OutFiles, FRewriteScanStats& OutStats);
+}
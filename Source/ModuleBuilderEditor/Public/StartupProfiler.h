@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleLoadRecorder.h"
+
+/**
+ * 最近一次启动中一个工程 / 插件模块的加载耗时，以及与之前几次启动的对比
+ */
+struct FStartupModuleProfile
+{
+	FString ModuleName;
+
+	// 工程名或插件名
+	FString Owner;
+
+	FModuleLoadSample Sample;
+
+	// 之前各次启动的中位数；没有记录时小于 0
+	double BaselineMs = -1.0;
+	double BaselineStartupMs = -1.0;
+	int32 BaselineSessions = 0;
+
+	// 与基线相比增加的耗时（有 StartupModule 拆分时按 StartupModule 比较）
+	double GetIncreaseMs() const;
+	bool IsRegression() const;
+};
+
+/**
+ * 启动耗时历史与最近一次启动的分析结果
+ */
+struct FStartupProfile
+{
+	// 按时间先后，最后一项为最近一次启动
+	TArray<FModuleLoadSession> History;
+
+	// 最近一次启动中的工程 / 插件模块，按耗时降序
+	TArray<FStartupModuleProfile> Modules;
+
+	const FModuleLoadSession* GetLatest() const { return History.Num() > 0 ? &History.Last() : nullptr; }
+};
+
+/**
+ * 编辑器启动时各加载阶段与工程 / 插件模块的加载耗时（映射动态库、StartupModule），
+ * 跨多次启动对比，找出逐渐变慢的模块
+ */
+namespace ModuleBuilder
+{
+	// 游戏线程：工程模块与所有已启用插件的模块 → 所属工程 / 插件名
+	TMap<FString, FString> GetProjectAndPluginModules();
+
+	// 任意线程
+	void AnalyzeStartupProfile(const FString& HistoryPath, const TMap<FString, FString>& ModuleOwners, FStartupProfile& OutProfile);
+
+	// OnlyModule 非空时列出该模块在历次启动中的耗时
+	FString FormatStartupProfileReport(const FStartupProfile& Profile, const FString& OnlyModule = FString());
+}
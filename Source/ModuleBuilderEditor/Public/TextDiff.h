@@ -0,0 +1,12 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 预览用的行级差异
+ */
+namespace ModuleBuilder
+{
+	// 统一 diff 格式（--- / +++ / @@），内容相同时返回空
+	FString MakeUnifiedDiff(const FString& Path, const FString& OldText, const FString& NewText, int32 ContextLines = 2);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FModuleDependencyGraph;
+
+/**
+ * 模块源码规模
+ */
+struct FModuleSourceStats
+{
+	int32 SourceFiles = 0;
+	int64 SourceLines = 0;
+	int64 SourceBytes = 0;
+};
+
+/**
+ * Build.cs 中与 unity / PCH 阈值相关的设置，未设置的项保持 UBT 默认
+ */
+struct FUnityBuildSettings
+{
+	TOptional<bool> bUseUnity;
+	TOptional<int32> MinSourceFilesForUnityBuildOverride;
+	TOptional<int32> MinFilesUsingPrecompiledHeaderOverride;
+	TOptional<int32> NumIncludedBytesPerUnityCPPOverride;
+};
+
+/**
+ * 单个模块的建议
+ */
+struct FUnityRecommendation
+{
+	FString ModuleName;
+	FString BuildCsPath;
+	FModuleSourceStats Stats;
+
+	bool bHasExplicitPCH = false;
+	FUnityBuildSettings Current;
+	FUnityBuildSettings Recommended;
+	TArray<FString> Reasons;
+
+	// 建议中有与当前 Build.cs 不同的项
+	bool NeedsChange() const;
+};
+
+/**
+ * 按源文件数量与行数调整 unity build 与 PCH 阈值
+ */
+namespace ModuleBuilder
+{
+	// 新模块写入的阈值：随模块增长自动生效，不写死 bUseUnity
+	FUnityBuildSettings GetGeneratedModuleUnitySettings(bool bHasExplicitPCH);
+
+	// Build.cs 中的赋值行，Indent 为每行前缀
+	FString FormatUnitySettings(const FUnityBuildSettings& Settings, const FString& Indent);
+
+	FModuleSourceStats CountModuleSources(const FString& ModuleDir);
+
+	FUnityBuildSettings RecommendUnitySettings(const FModuleSourceStats& Stats, bool bHasExplicitPCH, TArray<FString>* OutReasons = nullptr);
+
+	void ReadUnitySettings(const FString& BuildCsText, FUnityBuildSettings& OutSettings, bool& bOutHasExplicitPCH);
+
+	// 纯文本：已有赋值改值，缺少的插入到 PCHUsage（或构造函数开头）之后；
+	// 同一设置有多处赋值时不修改并返回 false
+	bool ApplyUnitySettingsToBuildCs(const FString& InText, const FUnityBuildSettings& Settings, FString& OutText, FString& OutError);
+
+	void AnalyzeUnitySettings(const FModuleDependencyGraph& Graph, TArray<FUnityRecommendation>& OutRecommendations);
+
+	// bDryRun 时只生成 diff；否则写回需要修改的 Build.cs
+	bool ApplyUnityRecommendations(const TArray<FUnityRecommendation>& Recommendations, bool bDryRun, FString& OutDiff, TArray<FString>& OutErrors);
+
+	FString FormatUnityReport(const TArray<FUnityRecommendation>& Recommendations);
+}
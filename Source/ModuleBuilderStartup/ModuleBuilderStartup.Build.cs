@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// 以 EarliestPossible 加载，只依赖 Core / Projects，尽早开始记录模块加载耗时
+public class ModuleBuilderStartup : ModuleRules
+{
+	public ModuleBuilderStartup(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"Projects"
+			}
+			);
+	}
+}
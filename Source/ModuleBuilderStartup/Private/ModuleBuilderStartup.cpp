@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ModuleBuilderStartup.h"
+#include "ModuleLoadRecorder.h"
+
+DEFINE_LOG_CATEGORY(LogModuleBuilderStartup);
+
+void FModuleBuilderStartupModule::StartupModule()
+{
+	// Commandlet 不记录，免得覆盖上次编辑器启动的结果
+	if (!IsRunningCommandlet())
+	{
+		FModuleLoadRecorder::Get().Start();
+	}
+}
+
+void FModuleBuilderStartupModule::ShutdownModule()
+{
+	FModuleLoadRecorder::Get().Stop();
+}
+
+IMPLEMENT_MODULE(FModuleBuilderStartupModule, ModuleBuilderStartup)
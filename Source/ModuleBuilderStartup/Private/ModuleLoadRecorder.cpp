@@ -0,0 +1,376 @@
+#include "ModuleLoadRecorder.h"
+#include "ModuleBuilderStartup.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// 记录文件格式，结构变化时递增
+static constexpr uint32 GModuleLoadMagic = 0x4D424C54; // 'MBLT'
+static constexpr int32 GModuleLoadVersion = 2;
+
+static constexpr uint32 GModuleLoadHistoryMagic = 0x4D424C48; // 'MBLH'
+static constexpr int32 GModuleLoadHistoryVersion = 1;
+
+// 历史中保留的启动次数
+static constexpr int32 GMaxHistorySessions = 20;
+
+// 最后一个加载阶段之后、引擎循环初始化完成之前的窗口
+static const TCHAR* const GEngineInitPhase = TEXT("EngineLoopInit");
+
+FArchive& operator<<(FArchive& Ar, FModuleLoadSample& Sample)
+{
+	Ar << Sample.ModuleName;
+	Ar << Sample.Milliseconds;
+	Ar << Sample.MapMilliseconds;
+	Ar << Sample.StartupMilliseconds;
+	Ar << Sample.Phase;
+	Ar << Sample.bUpperBound;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FModuleLoadPhaseTime& PhaseTime)
+{
+	Ar << PhaseTime.Phase;
+	Ar << PhaseTime.Seconds;
+	Ar << PhaseTime.Modules;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FModuleLoadSession& Session)
+{
+	Ar << Session.Timestamp;
+	Ar << Session.BootSeconds;
+	Ar << Session.Samples;
+	Ar << Session.Phases;
+	Ar << Session.PreloadedModules;
+	return Ar;
+}
+
+const FModuleLoadSample* FModuleLoadSession::FindSample(const FString& ModuleName) const
+{
+	return Samples.FindByPredicate([&ModuleName](const FModuleLoadSample& Sample)
+	{
+		return Sample.ModuleName == ModuleName;
+	});
+}
+
+const FModuleLoadPhaseTime* FModuleLoadSession::FindPhase(const FString& Phase) const
+{
+	return Phases.FindByPredicate([&Phase](const FModuleLoadPhaseTime& PhaseTime)
+	{
+		return PhaseTime.Phase == Phase;
+	});
+}
+
+FModuleLoadRecorder& FModuleLoadRecorder::Get()
+{
+	static FModuleLoadRecorder Instance;
+	return Instance;
+}
+
+FString FModuleLoadRecorder::GetSessionPath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("ModuleLoadTimes.bin"));
+}
+
+FString FModuleLoadRecorder::GetHistoryPath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("ModuleBuilder") / TEXT("ModuleLoadHistory.bin"));
+}
+
+bool FModuleLoadRecorder::SaveSession(const FModuleLoadSession& Session, const FString& Path)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = GModuleLoadMagic;
+	int32 Version = GModuleLoadVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << const_cast<FModuleLoadSession&>(Session);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FModuleLoadRecorder::LoadSession(const FString& Path, FModuleLoadSession& OutSession)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != GModuleLoadMagic || Version != GModuleLoadVersion)
+	{
+		return false;
+	}
+
+	FModuleLoadSession Session;
+	Reader << Session;
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	OutSession = MoveTemp(Session);
+	return true;
+}
+
+bool FModuleLoadRecorder::LoadHistory(const FString& Path, TArray<FModuleLoadSession>& OutSessions)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != GModuleLoadHistoryMagic || Version != GModuleLoadHistoryVersion)
+	{
+		return false;
+	}
+
+	TArray<FModuleLoadSession> Sessions;
+	Reader << Sessions;
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	OutSessions = MoveTemp(Sessions);
+	return true;
+}
+
+bool FModuleLoadRecorder::AppendToHistory(const FModuleLoadSession& Session, const FString& Path)
+{
+	// 格式不符或不存在时从头开始
+	TArray<FModuleLoadSession> Sessions;
+	LoadHistory(Path, Sessions);
+
+	Sessions.Add(Session);
+	if (Sessions.Num() > GMaxHistorySessions)
+	{
+		Sessions.RemoveAt(0, Sessions.Num() - GMaxHistorySessions);
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = GModuleLoadHistoryMagic;
+	int32 Version = GModuleLoadHistoryVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << Sessions;
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+void FModuleLoadRecorder::Start()
+{
+	check(IsInGameThread());
+
+	if (ModulesChangedHandle.IsValid() || GIsRunning)
+	{
+		return;
+	}
+
+	Session = FModuleLoadSession();
+	Session.Timestamp = FDateTime::Now();
+	Pending.Reset();
+	bBootComplete = false;
+
+	TArray<FModuleStatus> Modules;
+	FModuleManager::Get().QueryModules(Modules);
+	for (const FModuleStatus& Module : Modules)
+	{
+		if (Module.bIsLoaded)
+		{
+			Session.PreloadedModules.Add(Module.Name);
+		}
+	}
+
+	// 本模块的 StartupModule 返回后的通知是第一个样本，只含它的剩余部分
+	LastEventTime = FPlatformTime::Seconds();
+	LoadBeginTime = 0.0;
+	PhaseStartTime = LastEventTime;
+	PhaseFirstSample = 0;
+	bPhaseBoundary = true;
+
+	ModuleMappedHandle = FModuleManager::Get().OnProcessLoadedObjectsCallback().AddRaw(this, &FModuleLoadRecorder::HandleModuleMapped);
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FModuleLoadRecorder::HandleModulesChanged);
+	PhaseCompleteHandle = IPluginManager::Get().OnLoadingPhaseComplete().AddRaw(this, &FModuleLoadRecorder::HandleLoadingPhaseComplete);
+	BootCompleteHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddRaw(this, &FModuleLoadRecorder::HandleBootComplete);
+}
+
+void FModuleLoadRecorder::Stop()
+{
+	if (ModuleMappedHandle.IsValid())
+	{
+		FModuleManager::Get().OnProcessLoadedObjectsCallback().Remove(ModuleMappedHandle);
+		ModuleMappedHandle.Reset();
+	}
+	if (ModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+	if (PhaseCompleteHandle.IsValid())
+	{
+		IPluginManager::Get().OnLoadingPhaseComplete().Remove(PhaseCompleteHandle);
+		PhaseCompleteHandle.Reset();
+	}
+	if (BootCompleteHandle.IsValid())
+	{
+		FCoreDelegates::OnFEngineLoopInitComplete.Remove(BootCompleteHandle);
+		BootCompleteHandle.Reset();
+	}
+}
+
+void FModuleLoadRecorder::HandleModuleMapped(FName ModuleName, bool bCanProcessNewlyLoadedObjects)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// 加载动态库之前 FModuleManager 先以 NAME_None 广播一次，即加载开始的时刻
+	if (ModuleName.IsNone())
+	{
+		LoadBeginTime = Now;
+		return;
+	}
+
+	// 动态库已映射、静态初始化已完成，StartupModule 即将执行
+	FPendingLoad& Load = Pending.AddDefaulted_GetRef();
+	Load.ModuleName = ModuleName;
+	Load.MappedTime = Now;
+	Load.bUpperBound = bPhaseBoundary;
+
+	// 嵌套加载：上一次通知之后外层的 StartupModule 还执行了一段，映射从加载开始算起；
+	// 没有加载开始的通知时只能从上一次通知算起，是上限
+	double MapStart = LastEventTime;
+	if (Pending.Num() > 1)
+	{
+		if (LoadBeginTime >= LastEventTime)
+		{
+			MapStart = LoadBeginTime;
+		}
+		else
+		{
+			Load.bUpperBound = true;
+		}
+	}
+	Load.MapSeconds = Now - MapStart;
+
+	LastEventTime = Now;
+	LoadBeginTime = 0.0;
+	bPhaseBoundary = false;
+}
+
+void FModuleLoadRecorder::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason != EModuleChangeReason::ModuleLoaded)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	FModuleLoadSample& Sample = Session.Samples.AddDefaulted_GetRef();
+	Sample.ModuleName = ModuleName.ToString();
+
+	// 嵌套加载时在栈顶附近；没有映射通知的模块（如静态链接、重复通知）只记总耗时
+	const int32 PendingIndex = Pending.FindLastByPredicate([ModuleName](const FPendingLoad& Load) { return Load.ModuleName == ModuleName; });
+	double InclusiveSeconds = 0.0;
+	if (PendingIndex != INDEX_NONE)
+	{
+		const FPendingLoad Load = Pending[PendingIndex];
+		Pending.RemoveAt(PendingIndex);
+
+		InclusiveSeconds = Load.MapSeconds + (Now - Load.MappedTime);
+		Sample.MapMilliseconds = Load.MapSeconds * 1000.0;
+		Sample.StartupMilliseconds = FMath::Max(0.0, Now - Load.MappedTime - Load.ChildSeconds) * 1000.0;
+		Sample.Milliseconds = Sample.MapMilliseconds + Sample.StartupMilliseconds;
+		Sample.bUpperBound = Load.bUpperBound;
+	}
+	else
+	{
+		const bool bNestedBegin = Pending.Num() > 0 && LoadBeginTime >= LastEventTime;
+		InclusiveSeconds = Now - (bNestedBegin ? LoadBeginTime : LastEventTime);
+		Sample.Milliseconds = InclusiveSeconds * 1000.0;
+		Sample.bUpperBound = bPhaseBoundary || (Pending.Num() > 0 && !bNestedBegin);
+	}
+
+	// 在外层模块的 StartupModule 中加载的，从外层的 StartupModule 耗时中扣除
+	if (Pending.Num() > 0)
+	{
+		Pending.Last().ChildSeconds += InclusiveSeconds;
+	}
+
+	LastEventTime = Now;
+	LoadBeginTime = 0.0;
+	bPhaseBoundary = false;
+}
+
+void FModuleLoadRecorder::HandleLoadingPhaseComplete(ELoadingPhase::Type Phase, bool bSuccess)
+{
+	ClosePhase(ELoadingPhase::ToString(Phase));
+
+	// 阶段之间引擎还有别的初始化，下一个模块的间隔不再只是它自己的加载
+	LastEventTime = FPlatformTime::Seconds();
+	bPhaseBoundary = true;
+}
+
+void FModuleLoadRecorder::ClosePhase(const FString& Phase)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FModuleLoadPhaseTime& PhaseTime = Session.Phases.AddDefaulted_GetRef();
+	PhaseTime.Phase = Phase;
+	PhaseTime.Seconds = Now - PhaseStartTime;
+	PhaseTime.Modules = Session.Samples.Num() - PhaseFirstSample;
+
+	for (int32 Index = PhaseFirstSample; Index < Session.Samples.Num(); ++Index)
+	{
+		Session.Samples[Index].Phase = Phase;
+	}
+
+	PhaseStartTime = Now;
+	PhaseFirstSample = Session.Samples.Num();
+}
+
+void FModuleLoadRecorder::HandleBootComplete()
+{
+	Stop();
+
+	ClosePhase(GEngineInitPhase);
+	Pending.Reset();
+
+	bBootComplete = true;
+	Session.BootSeconds = FPlatformTime::Seconds() - GStartTime;
+
+	const FString Path = GetSessionPath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	if (!SaveSession(Session, Path) || !AppendToHistory(Session, GetHistoryPath()))
+	{
+		UE_LOG(LogModuleBuilderStartup, Warning, TEXT("写入模块加载记录失败：%s"), *FPaths::GetPath(Path));
+	}
+	else
+	{
+		UE_LOG(LogModuleBuilderStartup, Log, TEXT("启动耗时 %.2f 秒，记录了 %d 个模块的加载耗时"), Session.BootSeconds, Session.Samples.Num());
+	}
+}
@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+#include "Modules/ModuleManager.h"
+
+MODULEBUILDERSTARTUP_API DECLARE_LOG_CATEGORY_EXTERN(LogModuleBuilderStartup, Log, All);
+
+/**
+ * 启动记录模块
+ *
+ * 以 EarliestPossible 加载，先于其他插件模块开始记录启动期的模块加载耗时。
+ */
+class FModuleBuilderStartupModule : public IModuleInterface
+{
+public:
+	// IModuleInterface
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleDescriptor.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * 一个模块的加载耗时
+ */
+struct MODULEBUILDERSTARTUP_API FModuleLoadSample
+{
+	FString ModuleName;
+
+	// 映射动态库 + StartupModule，期间嵌套加载的依赖已单独计入
+	double Milliseconds = 0.0;
+
+	// 从上一次通知到模块对象创建：映射动态库、静态初始化（通常也含 UObject 注册）；无法区分时小于 0
+	double MapMilliseconds = -1.0;
+
+	// StartupModule，不含其中嵌套加载的模块；无法区分时小于 0
+	double StartupMilliseconds = -1.0;
+
+	// 加载时所在的加载阶段窗口（该阶段完成前加载）
+	FString Phase;
+
+	// 前面隔着一次加载阶段切换，耗时里可能混有引擎初始化，只能作为上限
+	bool bUpperBound = false;
+
+	friend MODULEBUILDERSTARTUP_API FArchive& operator<<(FArchive& Ar, FModuleLoadSample& Sample);
+};
+
+/**
+ * 一个加载阶段窗口的耗时：上一阶段完成到本阶段完成
+ */
+struct MODULEBUILDERSTARTUP_API FModuleLoadPhaseTime
+{
+	FString Phase;
+	double Seconds = 0.0;
+	int32 Modules = 0;
+
+	friend MODULEBUILDERSTARTUP_API FArchive& operator<<(FArchive& Ar, FModuleLoadPhaseTime& PhaseTime);
+};
+
+/**
+ * 一次编辑器启动的模块加载记录
+ */
+struct MODULEBUILDERSTARTUP_API FModuleLoadSession
+{
+	FDateTime Timestamp;
+
+	// 进程启动到引擎循环初始化完成
+	double BootSeconds = 0.0;
+
+	// 按加载顺序
+	TArray<FModuleLoadSample> Samples;
+
+	// 按完成顺序；最后一项为最后一个阶段之后到引擎循环初始化完成
+	TArray<FModuleLoadPhaseTime> Phases;
+
+	// 开始记录前已加载、没有耗时的模块
+	TArray<FString> PreloadedModules;
+
+	const FModuleLoadSample* FindSample(const FString& ModuleName) const;
+	const FModuleLoadPhaseTime* FindPhase(const FString& Phase) const;
+
+	friend MODULEBUILDERSTARTUP_API FArchive& operator<<(FArchive& Ar, FModuleLoadSession& Session);
+};
+
+/**
+ * 启动期模块加载耗时记录
+ *
+ * 由以 EarliestPossible 加载的 ModuleBuilderStartup 模块开始记录，监听 FModuleManager 的两个通知：
+ * 模块对象创建前的 ProcessLoadedObjects（动态库已映射）与加载完成的 OnModulesChanged，
+ * 两者之间为 StartupModule，上一次通知到前者为映射与静态初始化。
+ * 在外层 StartupModule 中嵌套加载时，映射从加载动态库之前以 NAME_None 发出的 ProcessLoadedObjects 算起，
+ * 外层在此之前执行的代码仍计入外层。
+ * 引擎循环初始化完成时结束记录，写入 Intermediate/ModuleBuilder 并追加到历史，Commandlet 与下次启动可以读取。
+ * 记录开始前加载的引擎核心模块没有耗时。仅限游戏线程。
+ */
+class MODULEBUILDERSTARTUP_API FModuleLoadRecorder
+{
+public:
+	static FModuleLoadRecorder& Get();
+
+	static FString GetSessionPath();
+	static FString GetHistoryPath();
+
+	static bool SaveSession(const FModuleLoadSession& Session, const FString& Path);
+	static bool LoadSession(const FString& Path, FModuleLoadSession& OutSession);
+
+	// 最近若干次启动，按时间先后
+	static bool LoadHistory(const FString& Path, TArray<FModuleLoadSession>& OutSessions);
+	static bool AppendToHistory(const FModuleLoadSession& Session, const FString& Path);
+
+	// 引擎初始化完成后调用时不记录
+	void Start();
+	void Stop();
+
+	bool IsBootComplete() const { return bBootComplete; }
+
+	// 本次启动的记录（启动完成前为部分结果）
+	const FModuleLoadSession& GetSession() const { return Session; }
+
+private:
+	// 已映射、StartupModule 尚未返回的模块；StartupModule 中嵌套加载时有多个
+	struct FPendingLoad
+	{
+		FName ModuleName;
+		double MappedTime = 0.0;
+		double MapSeconds = 0.0;
+		double ChildSeconds = 0.0;
+		bool bUpperBound = false;
+	};
+
+	void HandleModuleMapped(FName ModuleName, bool bCanProcessNewlyLoadedObjects);
+	void HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void HandleLoadingPhaseComplete(ELoadingPhase::Type Phase, bool bSuccess);
+	void HandleBootComplete();
+
+	// 把上一阶段完成以来的样本归到 Phase
+	void ClosePhase(const FString& Phase);
+
+	FModuleLoadSession Session;
+	TArray<FPendingLoad> Pending;
+	double LastEventTime = 0.0;
+
+	// 最近一次加载开始（NAME_None 通知）的时刻；用过后清零
+	double LoadBeginTime = 0.0;
+	double PhaseStartTime = 0.0;
+	int32 PhaseFirstSample = 0;
+	bool bPhaseBoundary = false;
+	bool bBootComplete = false;
+
+	FDelegateHandle ModuleMappedHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle PhaseCompleteHandle;
+	FDelegateHandle BootCompleteHandle;
+};